@@ -58,18 +58,27 @@
 #define VGPU_MAX_COLOR_ATTACHMENTS (8u)
 #define VGPU_MAX_BIND_GROUPS (8u)
 #define VGPU_MAX_VERTEX_ATTRIBUTES (16u)
+#define VGPU_MAX_MEMORY_HEAPS (16u)
+#define VGPU_MAX_MEMORY_TYPES (32u)
 #define VGPU_WHOLE_SIZE (0xffffffffffffffffULL)
+#define VGPU_INVALID_DESCRIPTOR_INDEX (0xffffffffu)
+#define VGPU_INVALID_RENDER_GRAPH_RESOURCE (0xffffffffu)
+#define VGPU_INVALID_READBACK_TICKET (0ull)
+#define VGPU_INVALID_PROFILE_SCOPE (0xffffffffu)
 #define VGPU_ADAPTER_NAME_MAX_LENGTH (256u)
 
 typedef uint32_t VGPUBool32;
 typedef uint32_t VGPUFlags;
 typedef uint64_t VGPUDeviceAddress;
+typedef uint32_t VGPURenderGraphResource;
+typedef uint64_t VGPUReadbackTicket;
 
 typedef struct VGPUInstanceImpl*        VGPUInstance VGPU_OBJECT_ATTRIBUTE;
 typedef struct VGPUAdapterImpl*         VGPUAdapter VGPU_OBJECT_ATTRIBUTE;
 typedef struct VGPUDeviceImpl*          VGPUDevice VGPU_OBJECT_ATTRIBUTE;
 typedef struct VGPUBufferImpl*          VGPUBuffer VGPU_OBJECT_ATTRIBUTE;
 typedef struct VGPUTextureImpl*         VGPUTexture VGPU_OBJECT_ATTRIBUTE;
+typedef struct VGPUMemoryHeapImpl*      VGPUMemoryHeap VGPU_OBJECT_ATTRIBUTE;
 typedef struct VGPUTextureViewImpl*     VGPUTextureView VGPU_OBJECT_ATTRIBUTE;
 typedef struct VGPUSamplerImpl*         VGPUSampler VGPU_OBJECT_ATTRIBUTE;
 typedef struct VGPUBindGroupLayoutImpl* VGPUBindGroupLayout VGPU_OBJECT_ATTRIBUTE;
@@ -80,6 +89,8 @@ typedef struct VGPUQueryHeapImpl*       VGPUQueryHeap VGPU_OBJECT_ATTRIBUTE;
 typedef struct VGPUSurfaceImpl*         VGPUSurface VGPU_OBJECT_ATTRIBUTE;
 typedef struct VGPUSwapChainImpl*       VGPUSwapChain VGPU_OBJECT_ATTRIBUTE;
 typedef struct VGPUCommandBufferImpl*   VGPUCommandBuffer VGPU_OBJECT_ATTRIBUTE;
+typedef struct VGPURenderGraphImpl*     VGPURenderGraph VGPU_OBJECT_ATTRIBUTE;
+typedef struct VGPUReadbackRingImpl*    VGPUReadbackRing VGPU_OBJECT_ATTRIBUTE;
 
 typedef enum VGPULogLevel {
     VGPULogLevel_Off = 0,
@@ -98,6 +109,9 @@ typedef enum VGPUBackend {
     VGPUBackend_Vulkan,
     VGPUBackend_D3D12,
     VGPUBackend_WGPU,
+    /// No GPU: objects are tracked and commands counted but nothing executes, for CI and CPU overhead measurements.
+    /// Only created when it is the preferredBackend, never picked automatically or as a fallback.
+    VGPUBackend_Null,
 
     _VGPUBackend_Count,
     _VGPUBackend_Force32 = 0x7FFFFFFF
@@ -149,6 +163,18 @@ typedef enum VGPUCpuAccessMode {
     _VGPUCpuAccessMode_Force32 = 0x7FFFFFFF
 } VGPUCpuAccessMode VGPU_ENUM_ATTRIBUTE;
 
+typedef enum VGPUMemoryClass {
+    /// Device local memory for GPU only buffers and textures.
+    VGPUMemoryClass_Default = 0,
+    /// Host visible memory for buffers with VGPUCpuAccessMode_Write.
+    VGPUMemoryClass_Upload = 1,
+    /// Host visible, preferably cached, memory for buffers with VGPUCpuAccessMode_Read.
+    VGPUMemoryClass_Readback = 2,
+
+    _VGPUMemoryClass_Count,
+    _VGPUMemoryClass_Force32 = 0x7FFFFFFF
+} VGPUMemoryClass VGPU_ENUM_ATTRIBUTE;
+
 typedef enum VGPUBufferUsage {
     VGPUBufferUsage_None = 0,
     VGPUBufferUsage_Vertex = (1 << 0),
@@ -179,6 +205,8 @@ typedef enum VGPUTextureUsage {
     VGPUTextureUsage_ShaderRead = (1 << 0),
     VGPUTextureUsage_ShaderWrite = (1 << 1),
     VGPUTextureUsage_RenderTarget = (1 << 2),
+    /// Render target whose contents never leave the render pass (MSAA or depth intermediates).
+    /// Backed by lazily allocated memory where available, stores are always discarded and it cannot be sampled or copied.
     VGPUTextureUsage_Transient = (1 << 3),
     VGPUTextureUsage_ShadingRate = (1 << 4),
     VGPUTextureUsage_Shared = (1 << 5),
@@ -602,6 +630,15 @@ typedef enum VGPUPipelineType
     _VGPUPipelineType_Force32 = 0x7FFFFFFF
 } VGPUPipelineType VGPU_ENUM_ATTRIBUTE;
 
+typedef enum VGPUPipelineStatus
+{
+    VGPUPipelineStatus_Ready = 0,
+    VGPUPipelineStatus_Pending = 1,
+    VGPUPipelineStatus_Failed = 2,
+
+    _VGPUPipelineStatus_Force32 = 0x7FFFFFFF
+} VGPUPipelineStatus VGPU_ENUM_ATTRIBUTE;
+
 typedef enum VGPUQueryType {
     /// Used for occlusion query heap or occlusion queries
     VGPUQueryType_Occlusion = 0,
@@ -628,6 +665,20 @@ typedef enum VGPUNativeObjectType {
     _VGPUNativeObjectType_Force32 = 0x7FFFFFFF
 } VGPUNativeObjectType VGPU_ENUM_ATTRIBUTE;
 
+/// How a render graph pass uses a resource. Writes keep earlier contents, so earlier writers are never culled by them.
+typedef enum VGPURenderGraphAccess {
+    /// Sampled or read through bind groups; for buffers also vertex, index and indirect reads.
+    VGPURenderGraphAccess_ShaderRead = 0,
+    /// Storage writes (and reads) through bind groups.
+    VGPURenderGraphAccess_ShaderWrite = 1,
+    /// Color or depth-stencil attachment of a render pass recorded by the pass.
+    VGPURenderGraphAccess_RenderTarget = 2,
+    VGPURenderGraphAccess_CopySource = 3,
+    VGPURenderGraphAccess_CopyDestination = 4,
+
+    _VGPURenderGraphAccess_Force32 = 0x7FFFFFFF
+} VGPURenderGraphAccess VGPU_ENUM_ATTRIBUTE;
+
 typedef struct VGPUColor {
     float r;
     float g;
@@ -646,6 +697,12 @@ typedef struct VGPUExtent3D {
     uint32_t depth;
 } VGPUExtent3D VGPU_STRUCT_ATTRIBUTE;
 
+typedef struct VGPUOrigin3D {
+    uint32_t x;
+    uint32_t y;
+    uint32_t z;
+} VGPUOrigin3D VGPU_STRUCT_ATTRIBUTE;
+
 typedef struct VGPURect {
     int32_t x;
     int32_t y;
@@ -693,6 +750,11 @@ typedef struct VGPURenderPassColorAttachment {
     VGPULoadAction      loadAction;
     VGPUStoreAction     storeAction;
     VGPUColor           clearColor;
+    /// Optional single-sample texture the multisampled contents are resolved into at the end of the pass.
+    /// Float and normalized formats average their samples, integer formats take sample 0 (not supported on D3D12).
+    VGPUTexture         resolveTexture;
+    uint32_t            resolveLevel;
+    uint32_t            resolveSlice;
 } VGPURenderPassColorAttachment VGPU_STRUCT_ATTRIBUTE;
 
 typedef struct VGPURenderPassDepthStencilAttachment {
@@ -714,6 +776,12 @@ typedef struct VGPURenderPassDesc {
     const VGPURenderPassDepthStencilAttachment* depthStencilAttachment;
 } VGPURenderPassDesc VGPU_STRUCT_ATTRIBUTE;
 
+/// Memory a buffer or texture needs when placed in a VGPUMemoryHeap, placement offsets must be multiples of alignment.
+typedef struct VGPUResourceAllocationInfo {
+    uint64_t size;
+    uint64_t alignment;
+} VGPUResourceAllocationInfo VGPU_STRUCT_ATTRIBUTE;
+
 typedef struct VGPUBufferDesc {
     const char* label;
     uint64_t size;
@@ -722,6 +790,29 @@ typedef struct VGPUBufferDesc {
     void* existingHandle;
 } VGPUBufferDesc VGPU_STRUCT_ATTRIBUTE;
 
+/// Transient CPU-writable memory returned by vgpuCommandBufferAllocate.
+typedef struct VGPUBufferAllocation {
+    VGPUBuffer buffer;
+    uint64_t offset;
+    void* data;
+} VGPUBufferAllocation VGPU_STRUCT_ATTRIBUTE;
+
+typedef struct VGPUBufferCopyLocation {
+    VGPUBuffer buffer;
+    uint64_t offset;
+    /// Bytes between rows, 0 means tightly packed.
+    uint32_t bytesPerRow;
+    /// Rows between array layers or depth slices, 0 means tightly packed.
+    uint32_t rowsPerImage;
+} VGPUBufferCopyLocation VGPU_STRUCT_ATTRIBUTE;
+
+typedef struct VGPUTextureCopyLocation {
+    VGPUTexture texture;
+    uint32_t mipLevel;
+    uint32_t arrayLayer;
+    VGPUOrigin3D origin;
+} VGPUTextureCopyLocation VGPU_STRUCT_ATTRIBUTE;
+
 typedef struct VGPUTextureDesc {
     const char* label;
     VGPUTextureDimension dimension;
@@ -800,6 +891,9 @@ typedef struct VGPUPipelineLayoutDesc {
     const VGPUBindGroupLayout* bindGroupLayouts;
     uint32_t pushConstantRangeCount;
     const VGPUPushConstantRange* pushConstantRanges;
+    /// Append the bindless descriptor heaps after the bind groups: sampled images at set bindGroupLayoutCount,
+    /// storage buffers at +1 and samplers at +2, each a runtime array at binding 0 indexed by vgpu*GetDescriptorIndex.
+    VGPUBool32 bindless;
 } VGPUPipelineLayoutDesc VGPU_STRUCT_ATTRIBUTE;
 
 typedef struct VGPUBindGroupEntry {
@@ -946,6 +1040,9 @@ typedef struct VGPUDeviceDesc {
     VGPUBackend preferredBackend;
     VGPUValidationMode validationMode;
     VGPUPowerPreference powerPreference;
+    /// Optional blob previously returned by vgpuDeviceGetPipelineCacheData, used to seed the pipeline cache.
+    const void* pipelineCacheData;
+    size_t pipelineCacheDataSize;
 } VGPUDeviceDesc VGPU_STRUCT_ATTRIBUTE;
 
 typedef struct VGPUInstanceDesc {
@@ -994,7 +1091,151 @@ typedef struct VGPULimits {
     uint32_t rayTracingMaxGeometryCount;
 } VGPULimits VGPU_STRUCT_ATTRIBUTE;
 
+/// Upload staging memory usage, sizes in bytes.
+typedef struct VGPUStagingStatistics {
+    /// Size of the shared staging arena.
+    uint64_t arenaSize;
+    /// Arena bytes held by uploads the GPU has not finished yet.
+    uint64_t usedBytes;
+    uint64_t peakUsedBytes;
+    uint32_t allocationCount;
+    /// Bytes in dedicated staging buffers for uploads larger than the arena.
+    uint64_t dedicatedBytes;
+    /// Number of times an upload waited for the GPU to free arena space.
+    uint64_t stallCount;
+} VGPUStagingStatistics VGPU_STRUCT_ATTRIBUTE;
+
+/// Budget and usage of one device memory heap, sizes in bytes.
+typedef struct VGPUMemoryHeapBudget {
+    /// Memory the process can use before allocations may fail or start to evict.
+    uint64_t budget;
+    /// Memory the process currently uses on this heap, including allocations made outside vgpu.
+    uint64_t usage;
+    /// Device memory blocks vgpu allocated and the part of them handed out to resources.
+    uint64_t blockBytes;
+    uint64_t allocationBytes;
+    VGPUBool32 deviceLocal;
+} VGPUMemoryHeapBudget VGPU_STRUCT_ATTRIBUTE;
+
+typedef struct VGPUMemoryBudget {
+    uint32_t heapCount;
+    VGPUMemoryHeapBudget heaps[VGPU_MAX_MEMORY_HEAPS];
+} VGPUMemoryBudget VGPU_STRUCT_ATTRIBUTE;
+
+/// Allocation statistics of one memory type (or all of them), sizes in bytes.
+typedef struct VGPUMemoryTypeStatistics {
+    uint32_t heapIndex;
+    uint32_t blockCount;
+    uint32_t allocationCount;
+    uint32_t unusedRangeCount;
+    uint64_t blockBytes;
+    uint64_t allocationBytes;
+    uint64_t allocationSizeMin;
+    uint64_t allocationSizeMax;
+    uint64_t unusedRangeSizeMax;
+    /// 0 when the free space of the blocks is one range, approaching 1 as it splits into many small ranges.
+    float fragmentation;
+} VGPUMemoryTypeStatistics VGPU_STRUCT_ATTRIBUTE;
+
+typedef struct VGPUMemoryStatistics {
+    uint32_t memoryTypeCount;
+    VGPUMemoryTypeStatistics memoryTypes[VGPU_MAX_MEMORY_TYPES];
+    VGPUMemoryTypeStatistics total;
+} VGPUMemoryStatistics VGPU_STRUCT_ATTRIBUTE;
+
+/// GPU time of one debug group, render pass or labelled command buffer.
+typedef struct VGPUProfileScope {
+    const char* label;
+    /// Enclosing scope, always stored before its children; VGPU_INVALID_PROFILE_SCOPE for roots.
+    uint32_t parent;
+    uint32_t depth;
+    VGPUCommandQueue queue;
+    /// Milliseconds since the earliest timestamp of the frame.
+    double begin;
+    double duration;
+} VGPUProfileScope VGPU_STRUCT_ATTRIBUTE;
+
+typedef struct VGPUFrameProfile {
+    /// Frame the timings belong to, VGPU_MAX_INFLIGHT_FRAMES behind the current frame count.
+    uint64_t frame;
+    uint32_t scopeCount;
+    /// Owned by the device, valid until the next vgpuDeviceSubmit.
+    const VGPUProfileScope* scopes;
+} VGPUFrameProfile VGPU_STRUCT_ATTRIBUTE;
+
+/// CPU-side work of the last submitted frame.
+typedef struct VGPUFrameStatistics {
+    uint64_t frame;
+    uint32_t commandBufferCount;
+    /// Queue submissions, including initial-data upload flushes.
+    uint32_t submitCount;
+    uint32_t drawCount;
+    uint32_t dispatchCount;
+    uint32_t pipelineBindCount;
+    uint32_t bindGroupBindCount;
+    /// Pipeline, bind group, vertex and index buffer, viewport, scissor and stencil reference calls skipped because
+    /// the command buffer had the same state already, plus descriptor sets left bound instead of rebound.
+    uint32_t redundantStateCount;
+    uint32_t barrierCount;
+    uint32_t descriptorWriteCount;
+    /// Buffers and textures.
+    uint32_t resourcesCreated;
+    uint32_t resourcesDestroyed;
+    /// Deferred destructions executed by the submit.
+    uint32_t deferredDeletions;
+    /// Initial data copied into staging memory.
+    uint64_t uploadBytes;
+    /// Bytes bump allocated with vgpuCommandBufferAllocate.
+    uint64_t allocatedBytes;
+    /// Time the submit blocked waiting for the GPU to release the next frame.
+    double submitWaitMilliseconds;
+} VGPUFrameStatistics VGPU_STRUCT_ATTRIBUTE;
+
+typedef struct VGPURenderGraphPassResource {
+    VGPURenderGraphResource resource;
+    VGPURenderGraphAccess access;
+} VGPURenderGraphPassResource VGPU_STRUCT_ATTRIBUTE;
+
+/// Records the pass; physical resources are available through vgpuRenderGraphGetTexture/vgpuRenderGraphGetBuffer.
+typedef void (*VGPURenderGraphPassCallback)(VGPURenderGraph graph, VGPUCommandBuffer commandBuffer, void* userData);
+
+typedef struct VGPURenderGraphPassDesc {
+    const char* label;
+    /// VGPUCommandQueue_Compute passes run on the async compute queue when they share no resource with graphics passes.
+    VGPUCommandQueue queue;
+    uint32_t resourceCount;
+    const VGPURenderGraphPassResource* resources;
+    /// Passes with effects the graph cannot see are never culled.
+    VGPUBool32 hasSideEffects;
+    VGPURenderGraphPassCallback callback;
+    void* userData;
+} VGPURenderGraphPassDesc VGPU_STRUCT_ATTRIBUTE;
+
+/// Results of the last vgpuRenderGraphExecute, sizes in bytes.
+typedef struct VGPURenderGraphStatistics {
+    uint32_t passCount;
+    uint32_t culledPassCount;
+    uint32_t asyncComputePassCount;
+    uint32_t transientTextureCount;
+    uint32_t transientBufferCount;
+    /// Memory backing transient resources after aliasing.
+    uint64_t transientMemorySize;
+    /// Memory transient resources would need without aliasing.
+    uint64_t unaliasedMemorySize;
+} VGPURenderGraphStatistics VGPU_STRUCT_ATTRIBUTE;
+
+/// Layout of a completed readback, texture rows are bytesPerRow apart.
+typedef struct VGPUReadbackData {
+    const void* data;
+    uint64_t size;
+    uint32_t bytesPerRow;
+    uint32_t rowsPerImage;
+} VGPUReadbackData VGPU_STRUCT_ATTRIBUTE;
+
 typedef void (*VGPULogCallback)(VGPULogLevel level, const char* message, void* userData);
+/// Called from a worker thread once an asynchronously created pipeline finished compiling.
+typedef void (*VGPUPipelineCallback)(VGPUPipeline pipeline, VGPUPipelineStatus status, void* userData);
+typedef void (*VGPUMemoryBudgetCallback)(VGPUDevice device, uint32_t heapIndex, const VGPUMemoryHeapBudget* heap, void* userData);
 VGPU_API VGPULogLevel vgpuGetLogLevel(void);
 VGPU_API void vgpuSetLogLevel(VGPULogLevel level);
 VGPU_API void vgpuSetLogCallback(VGPULogCallback func, void* userData);
@@ -1014,17 +1255,73 @@ VGPU_API VGPUBackend vgpuDeviceGetBackend(VGPUDevice device);
 VGPU_API VGPUBool32 vgpuDeviceQueryFeatureSupport(VGPUDevice device, VGPUFeature feature);
 VGPU_API void vgpuDeviceGetAdapterProperties(VGPUDevice device, VGPUAdapterProperties* properties);
 VGPU_API void vgpuDeviceGetLimits(VGPUDevice device, VGPULimits* limits);
+/// Submit command buffers and return the value every queue timeline reaches once they complete.
 VGPU_API uint64_t vgpuDeviceSubmit(VGPUDevice device, VGPUCommandBuffer* commandBuffers, uint32_t count);
+/// Last submission value the GPU has completed on the given queue.
+VGPU_API uint64_t vgpuDeviceGetCompletedValue(VGPUDevice device, VGPUCommandQueue queue);
+/// Block until the queue reaches value or timeout (nanoseconds) expires; returns false on timeout.
+VGPU_API VGPUBool32 vgpuDeviceWaitValue(VGPUDevice device, VGPUCommandQueue queue, uint64_t value, uint64_t timeout);
+/// Submit pending initial-data uploads (batched by vgpuCreateBuffer/vgpuCreateTexture) and return a token for vgpuDeviceWaitUploads.
+/// Uploads are also flushed automatically when the staging arena fills up, after a short latency budget and by vgpuDeviceSubmit.
+VGPU_API uint64_t vgpuDeviceFlushUploads(VGPUDevice device);
+/// Block until the uploads flushed under token completed or timeout (nanoseconds) expires; returns false on timeout.
+VGPU_API VGPUBool32 vgpuDeviceWaitUploads(VGPUDevice device, uint64_t token, uint64_t timeout);
+VGPU_API void vgpuDeviceGetStagingStatistics(VGPUDevice device, VGPUStagingStatistics* statistics);
+/// Per-heap budget and usage, cheap enough to query every frame.
+VGPU_API void vgpuDeviceGetMemoryBudget(VGPUDevice device, VGPUMemoryBudget* budget);
+/// Per memory type allocation statistics; walks every allocation, meant for tools rather than every frame.
+VGPU_API void vgpuDeviceGetMemoryStatistics(VGPUDevice device, VGPUMemoryStatistics* statistics);
+/// Write a JSON dump of every memory block (and allocation if detailed) into data (if not NULL, truncated to dataSize)
+/// and return the size of the whole dump in bytes including the null terminator, 0 if unsupported.
+VGPU_API size_t vgpuDeviceGetMemoryDump(VGPUDevice device, VGPUBool32 detailed, char* data, size_t dataSize);
+/// Called from vgpuDeviceSubmit when a heap's usage exceeds its budget, once until usage drops back under it.
+VGPU_API void vgpuDeviceSetMemoryBudgetCallback(VGPUDevice device, VGPUMemoryBudgetCallback callback, void* userData);
+/// Write timestamps around every debug group, render pass and command buffer label, starting with the next frame.
+VGPU_API void vgpuDeviceSetProfilerEnabled(VGPUDevice device, VGPUBool32 enabled);
+/// Timings of the newest resolved frame, read back without stalling; returns false if none are available.
+VGPU_API VGPUBool32 vgpuDeviceGetFrameProfile(VGPUDevice device, VGPUFrameProfile* profile);
+/// Counters are always on, command buffers count locally and fold into the frame when submitted.
+VGPU_API void vgpuDeviceGetFrameStatistics(VGPUDevice device, VGPUFrameStatistics* statistics);
+/// Record CPU spans of device work (submits, waits, uploads, pipeline creation, deferred deletion) and GPU timestamps
+/// of debug groups on one timeline; returns false if a trace is already running or path cannot be created.
+VGPU_API VGPUBool32 vgpuDeviceBeginTrace(VGPUDevice device, const char* path);
+/// Stop tracing and write the Chrome trace JSON (opens in chrome://tracing and ui.perfetto.dev); returns false if nothing was written.
+/// GPU spans of the last VGPU_MAX_INFLIGHT_FRAMES frames resolve after this call and are not part of the trace.
+VGPU_API VGPUBool32 vgpuDeviceEndTrace(VGPUDevice device);
+/// Serialize resource creation (with initial data), pipelines, command buffers and submits into a binary stream for
+/// tools/vgpu_replay; returns false if a capture is already running or path cannot be created.
+/// Objects created before this call are unknown to the stream, begin right after vgpuCreateDevice to replay a whole session.
+VGPU_API VGPUBool32 vgpuDeviceBeginCapture(VGPUDevice device, const char* path);
+/// Stop capturing; fails while command buffers begun during the capture are not submitted yet.
+VGPU_API VGPUBool32 vgpuDeviceEndCapture(VGPUDevice device);
+/// Command buffers begun after enabling append their commands to a packet stream and only reach the backend in
+/// vgpuDeviceSubmit, which translates the streams of a submit in parallel on worker threads. Objects used by a command
+/// buffer are referenced until it is submitted, so they may be released while it records. Toggle between frames, not
+/// while other threads begin command buffers.
+VGPU_API void vgpuDeviceSetDeferredRecording(VGPUDevice device, VGPUBool32 enabled);
 VGPU_API uint64_t vgpuDeviceGetFrameCount(VGPUDevice device);
 VGPU_API uint32_t vgpuDeviceGetFrameIndex(VGPUDevice device);
 VGPU_API uint64_t vgpuDeviceGetTimestampFrequency(VGPUDevice device);
+/// Largest number of bytes one command buffer allocated with vgpuCommandBufferAllocate in a single frame.
+VGPU_API uint64_t vgpuDeviceGetAllocatorHighWaterMark(VGPUDevice device);
 VGPU_API void* vgpuDeviceGetNativeObject(VGPUDevice device, VGPUNativeObjectType objectType);
+/// Copy the pipeline cache blob into data (if not NULL) and return its size in bytes, 0 if unsupported.
+VGPU_API size_t vgpuDeviceGetPipelineCacheData(VGPUDevice device, void* data, size_t dataSize);
 
 /* Buffer */
 VGPU_API VGPUBuffer vgpuCreateBuffer(VGPUDevice device, const VGPUBufferDesc* desc, const void* pInitialData);
 VGPU_API uint64_t vgpuBufferGetSize(VGPUBuffer buffer);
 VGPU_API VGPUBufferUsageFlags vgpuBufferGetUsage(VGPUBuffer buffer);
 VGPU_API VGPUDeviceAddress vgpuBufferGetAddress(VGPUBuffer buffer);
+/// Index of the buffer in the bindless storage buffer heap, VGPU_INVALID_DESCRIPTOR_INDEX if it has none.
+VGPU_API uint32_t vgpuBufferGetDescriptorIndex(VGPUBuffer buffer);
+/// Persistent CPU mapping of a buffer created with VGPUCpuAccessMode_Write or VGPUCpuAccessMode_Read, NULL otherwise.
+/// The pointer stays valid for the lifetime of the buffer; the caller must not rewrite ranges the GPU may still read.
+VGPU_API void* vgpuBufferGetMappedData(VGPUBuffer buffer);
+/// Make CPU writes to [offset, offset + size) visible to the GPU; size may be VGPU_WHOLE_SIZE. No-op on host coherent memory.
+VGPU_API void vgpuBufferFlushRange(VGPUBuffer buffer, uint64_t offset, uint64_t size);
+/// Make completed GPU writes to [offset, offset + size) visible through the mapping; size may be VGPU_WHOLE_SIZE. No-op on host coherent memory.
+VGPU_API void vgpuBufferInvalidateRange(VGPUBuffer buffer, uint64_t offset, uint64_t size);
 VGPU_API void vgpuBufferSetLabel(VGPUBuffer buffer, const char* label);
 VGPU_API uint32_t vgpuBufferAddRef(VGPUBuffer buffer);
 VGPU_API uint32_t vgpuBufferRelease(VGPUBuffer buffer);
@@ -1033,23 +1330,48 @@ VGPU_API uint32_t vgpuBufferRelease(VGPUBuffer buffer);
 VGPU_API VGPUTexture vgpuCreateTexture(VGPUDevice device, const VGPUTextureDesc* desc, const VGPUTextureData* pInitialData);
 VGPU_API VGPUTextureDimension vgpuTextureGetDimension(VGPUTexture texture);
 VGPU_API VGPUTextureFormat vgpuTextureGetFormat(VGPUTexture texture);
+/// Index of the texture in the bindless sampled image heap, VGPU_INVALID_DESCRIPTOR_INDEX if it has none.
+/// The view covers every mip and layer as a 1D, 1D array, 2D, 2D array, cube (square 2D with exactly 6 layers) or 3D
+/// image, shaders declare the heap with the matching type.
+VGPU_API uint32_t vgpuTextureGetDescriptorIndex(VGPUTexture texture);
 VGPU_API void vgpuTextureSetLabel(VGPUTexture texture, const char* label);
 VGPU_API uint32_t vgpuTextureAddRef(VGPUTexture texture);
 VGPU_API uint32_t vgpuTextureRelease(VGPUTexture texture);
 
+/* MemoryHeap */
+/// Allocate one block of memory buffers and textures can be placed into; the caller manages offsets and aliasing.
+VGPU_API VGPUMemoryHeap vgpuCreateMemoryHeap(VGPUDevice device, uint64_t size, VGPUMemoryClass memoryClass);
+VGPU_API uint64_t vgpuMemoryHeapGetSize(VGPUMemoryHeap heap);
+VGPU_API VGPUMemoryClass vgpuMemoryHeapGetMemoryClass(VGPUMemoryHeap heap);
+VGPU_API void vgpuMemoryHeapSetLabel(VGPUMemoryHeap heap, const char* label);
+VGPU_API uint32_t vgpuMemoryHeapAddRef(VGPUMemoryHeap heap);
+VGPU_API uint32_t vgpuMemoryHeapRelease(VGPUMemoryHeap heap);
+/// Query the placement size and alignment of exactly one of bufferDesc or textureDesc; returns false if it cannot be placed.
+VGPU_API VGPUBool32 vgpuGetResourceAllocationInfo(VGPUDevice device, const VGPUBufferDesc* bufferDesc, const VGPUTextureDesc* textureDesc, VGPUResourceAllocationInfo* info);
+/// Create a buffer bound to heap memory at offset. The buffer keeps the heap alive, resources may alias the same range
+/// but the contents are undefined after another aliased resource was written.
+VGPU_API VGPUBuffer vgpuCreatePlacedBuffer(VGPUDevice device, VGPUMemoryHeap heap, uint64_t offset, const VGPUBufferDesc* desc);
+/// Create a texture bound to heap memory at offset, same rules as vgpuCreatePlacedBuffer. Only VGPUMemoryClass_Default heaps hold textures.
+VGPU_API VGPUTexture vgpuCreatePlacedTexture(VGPUDevice device, VGPUMemoryHeap heap, uint64_t offset, const VGPUTextureDesc* desc);
+
 /* Sampler */
+/// Identical descriptors may return the same sampler with an added reference; labels are ignored for matching.
 VGPU_API VGPUSampler vgpuCreateSampler(VGPUDevice device, const VGPUSamplerDesc* desc);
 VGPU_API void vgpuSamplerSetLabel(VGPUSampler sampler, const char* label);
+/// Index of the sampler in the bindless sampler heap, VGPU_INVALID_DESCRIPTOR_INDEX if it has none.
+VGPU_API uint32_t vgpuSamplerGetDescriptorIndex(VGPUSampler sampler);
 VGPU_API uint32_t vgpuSamplerAddRef(VGPUSampler sampler);
 VGPU_API uint32_t vgpuSamplerRelease(VGPUSampler sampler);
 
 /* BindGroupLayout */
+/// Identical descriptors may return the same layout with an added reference.
 VGPU_API VGPUBindGroupLayout vgpuCreateBindGroupLayout(VGPUDevice device, const VGPUBindGroupLayoutDesc* desc);
 VGPU_API void vgpuBindGroupLayoutSetLabel(VGPUBindGroupLayout bindGroupLayout, const char* label);
 VGPU_API uint32_t vgpuBindGroupLayoutAddRef(VGPUBindGroupLayout bindGroupLayout);
 VGPU_API uint32_t vgpuBindGroupLayoutRelease(VGPUBindGroupLayout bindGroupLayout);
 
 /* PipelineLayout */
+/// Identical descriptors may return the same layout with an added reference.
 VGPU_API VGPUPipelineLayout vgpuCreatePipelineLayout(VGPUDevice device, const VGPUPipelineLayoutDesc* desc);
 VGPU_API void vgpuPipelineLayoutSetLabel(VGPUPipelineLayout pipelineLayout, const char* label);
 VGPU_API uint32_t vgpuPipelineLayoutAddRef(VGPUPipelineLayout pipelineLayout);
@@ -1065,7 +1387,11 @@ VGPU_API uint32_t vgpuBindGroupRelease(VGPUBindGroup bindGroup);
 VGPU_API VGPUPipeline vgpuCreateRenderPipeline(VGPUDevice device, const VGPURenderPipelineDesc* desc);
 VGPU_API VGPUPipeline vgpuCreateComputePipeline(VGPUDevice device, const VGPUComputePipelineDesc* desc);
 VGPU_API VGPUPipeline vgpuCreateRayTracingPipeline(VGPUDevice device, const VGPURayTracingPipelineDesc* desc);
+VGPU_API VGPUPipeline vgpuCreateRenderPipelineAsync(VGPUDevice device, const VGPURenderPipelineDesc* desc, VGPUPipelineCallback callback, void* userData);
+VGPU_API VGPUPipeline vgpuCreateComputePipelineAsync(VGPUDevice device, const VGPUComputePipelineDesc* desc, VGPUPipelineCallback callback, void* userData);
 VGPU_API VGPUPipelineType vgpuPipelineGetType(VGPUPipeline pipeline);
+VGPU_API VGPUPipelineStatus vgpuPipelineGetStatus(VGPUPipeline pipeline);
+VGPU_API VGPUPipelineStatus vgpuPipelineWait(VGPUPipeline pipeline);
 VGPU_API void vgpuPipelineSetLabel(VGPUPipeline pipeline, const char* label);
 VGPU_API uint32_t vgpuPipelineAddRef(VGPUPipeline pipeline);
 VGPU_API uint32_t vgpuPipelineRelease(VGPUPipeline pipeline);
@@ -1086,11 +1412,19 @@ VGPU_API uint32_t vgpuSwapChainAddRef(VGPUSwapChain swapChain);
 VGPU_API uint32_t vgpuSwapChainRelease(VGPUSwapChain swapChain);
 
 /* Commands */
+/// Safe to call from multiple threads; each call returns a distinct command buffer, valid until the next vgpuDeviceSubmit.
 VGPU_API VGPUCommandBuffer vgpuBeginCommandBuffer(VGPUDevice device, VGPUCommandQueue queueType, const char* label);
 VGPU_API void vgpuPushDebugGroup(VGPUCommandBuffer commandBuffer, const char* groupLabel);
 VGPU_API void vgpuPopDebugGroup(VGPUCommandBuffer commandBuffer);
 VGPU_API void vgpuInsertDebugMarker(VGPUCommandBuffer commandBuffer, const char* markerLabel);
 VGPU_API void vgpuClearBuffer(VGPUCommandBuffer commandBuffer, VGPUBuffer buffer, uint64_t offset, uint64_t size);
+/// Copy commands can be recorded on any queue, including VGPUCommandQueue_Copy.
+VGPU_API void vgpuCopyBufferToBuffer(VGPUCommandBuffer commandBuffer, VGPUBuffer source, uint64_t sourceOffset, VGPUBuffer destination, uint64_t destinationOffset, uint64_t size);
+VGPU_API void vgpuCopyBufferToTexture(VGPUCommandBuffer commandBuffer, const VGPUBufferCopyLocation* source, const VGPUTextureCopyLocation* destination, const VGPUExtent3D* extent);
+VGPU_API void vgpuCopyTextureToBuffer(VGPUCommandBuffer commandBuffer, const VGPUTextureCopyLocation* source, const VGPUBufferCopyLocation* destination, const VGPUExtent3D* extent);
+VGPU_API void vgpuCopyTextureToTexture(VGPUCommandBuffer commandBuffer, const VGPUTextureCopyLocation* source, const VGPUTextureCopyLocation* destination, const VGPUExtent3D* extent);
+/// Bump allocate size bytes from the command buffer's per-frame ring; valid until the GPU finishes the frame. alignment 0 means constant buffer alignment.
+VGPU_API VGPUBufferAllocation vgpuCommandBufferAllocate(VGPUCommandBuffer commandBuffer, uint64_t size, uint64_t alignment);
 VGPU_API void vgpuSetPipeline(VGPUCommandBuffer commandBuffer, VGPUPipeline pipeline);
 VGPU_API void vgpuSetBindGroup(VGPUCommandBuffer commandBuffer, uint32_t groupIndex, VGPUBindGroup bindGroup);
 VGPU_API void vgpuSetPushConstants(VGPUCommandBuffer commandBuffer, uint32_t pushConstantIndex, const void* data, uint32_t size);
@@ -1126,6 +1460,45 @@ VGPU_API void vgpuDispatchMesh(VGPUCommandBuffer commandBuffer, uint32_t threadG
 VGPU_API void vgpuDispatchMeshIndirect(VGPUCommandBuffer commandBuffer, VGPUBuffer indirectBuffer, uint64_t indirectBufferOffset);
 VGPU_API void vgpuDispatchMeshIndirectCount(VGPUCommandBuffer commandBuffer, VGPUBuffer indirectBuffer, uint64_t indirectBufferOffset, VGPUBuffer countBuffer, uint64_t countBufferOffset, uint32_t maxCount);
 
+/* RenderGraph */
+VGPU_API VGPURenderGraph vgpuCreateRenderGraph(VGPUDevice device);
+/// Transient resources live for one vgpuRenderGraphExecute and may share memory with transients whose lifetimes do not overlap.
+VGPU_API VGPURenderGraphResource vgpuRenderGraphCreateTexture(VGPURenderGraph graph, const VGPUTextureDesc* desc);
+VGPU_API VGPURenderGraphResource vgpuRenderGraphCreateBuffer(VGPURenderGraph graph, const VGPUBufferDesc* desc);
+/// Imported resources outlive the graph, passes writing them are never culled.
+VGPU_API VGPURenderGraphResource vgpuRenderGraphImportTexture(VGPURenderGraph graph, VGPUTexture texture);
+VGPU_API VGPURenderGraphResource vgpuRenderGraphImportBuffer(VGPURenderGraph graph, VGPUBuffer buffer);
+/// The swap chain texture is acquired when the graph executes and presented by the graphics submit.
+VGPU_API VGPURenderGraphResource vgpuRenderGraphImportSwapChain(VGPURenderGraph graph, VGPUSwapChain swapChain);
+VGPU_API void vgpuRenderGraphAddPass(VGPURenderGraph graph, const VGPURenderGraphPassDesc* desc);
+/// Physical resources are only valid inside pass callbacks.
+VGPU_API VGPUTexture vgpuRenderGraphGetTexture(VGPURenderGraph graph, VGPURenderGraphResource resource);
+VGPU_API VGPUBuffer vgpuRenderGraphGetBuffer(VGPURenderGraph graph, VGPURenderGraphResource resource);
+/// Cull, allocate, record and submit the declared passes in order, then clear the graph for the next frame.
+/// Returns the submission value, as vgpuDeviceSubmit.
+VGPU_API uint64_t vgpuRenderGraphExecute(VGPURenderGraph graph);
+VGPU_API void vgpuRenderGraphGetStatistics(VGPURenderGraph graph, VGPURenderGraphStatistics* statistics);
+VGPU_API uint32_t vgpuRenderGraphAddRef(VGPURenderGraph graph);
+VGPU_API uint32_t vgpuRenderGraphRelease(VGPURenderGraph graph);
+
+/* ReadbackRing */
+/// Host readable memory of size bytes, sub-allocated in submission order; copies that do not fit get their own buffer.
+VGPU_API VGPUReadbackRing vgpuCreateReadbackRing(VGPUDevice device, uint64_t size);
+/// Record a copy into the ring. The command buffer must be submitted before the next vgpuDeviceSubmit returns,
+/// the ticket completes with that submission.
+VGPU_API VGPUReadbackTicket vgpuReadbackRingCopyBuffer(VGPUReadbackRing ring, VGPUCommandBuffer commandBuffer, VGPUBuffer buffer, uint64_t offset, uint64_t size);
+VGPU_API VGPUReadbackTicket vgpuReadbackRingCopyTexture(VGPUReadbackRing ring, VGPUCommandBuffer commandBuffer, const VGPUTextureCopyLocation* source, const VGPUExtent3D* extent);
+/// Non-blocking completion check.
+VGPU_API VGPUBool32 vgpuReadbackRingIsReady(VGPUReadbackRing ring, VGPUReadbackTicket ticket);
+/// Block until the ticket completes or timeout (nanoseconds) expires; returns false on timeout.
+VGPU_API VGPUBool32 vgpuReadbackRingWait(VGPUReadbackRing ring, VGPUReadbackTicket ticket, uint64_t timeout);
+/// Returns false until the ticket completes, data stays valid until vgpuReadbackRingFree.
+VGPU_API VGPUBool32 vgpuReadbackRingGetData(VGPUReadbackRing ring, VGPUReadbackTicket ticket, VGPUReadbackData* data);
+/// Return the ticket's memory to the ring, pending tickets are reclaimed once the GPU is done with them.
+VGPU_API void vgpuReadbackRingFree(VGPUReadbackRing ring, VGPUReadbackTicket ticket);
+VGPU_API uint32_t vgpuReadbackRingAddRef(VGPUReadbackRing ring);
+VGPU_API uint32_t vgpuReadbackRingRelease(VGPUReadbackRing ring);
+
 /* Helper functions */
 typedef struct VGPUPixelFormatInfo {
     VGPUTextureFormat format;
@@ -0,0 +1,347 @@
+// Copyright © Amer Koleci and Contributors.
+// Distributed under the MIT license. See the LICENSE file in the project root for more information.
+
+// Samples 2D, 2D array and 3D textures through the bindless heaps with indices from push constants and checks the results.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <iostream>
+#include <vector>
+
+#include <vgpu.h>
+
+constexpr uint32_t kWidth = 64u;
+constexpr uint32_t kTextureCount = 3u;
+
+// SPIR-V 1.3 for the following GLSL, no shader compiler is needed to build the sample:
+//
+// #version 450
+// #extension GL_EXT_nonuniform_qualifier : require
+// layout(local_size_x = 64) in;
+// layout(set = 0, binding = 0) uniform texture2D textures2D[];
+// layout(set = 0, binding = 0) uniform texture2DArray textures2DArray[];
+// layout(set = 0, binding = 0) uniform texture3D textures3D[];
+// layout(set = 1, binding = 0) buffer Output { uint values[]; } buffers[];
+// layout(push_constant) uniform Push { uint texture2DIndex, texture2DArrayIndex, texture3DIndex, bufferIndex, count; } push;
+//
+// void main()
+// {
+//     uint i = gl_GlobalInvocationID.x;
+//     if (i < push.count)
+//     {
+//         buffers[push.bufferIndex].values[i * 3 + 0] = uint(texelFetch(textures2D[push.texture2DIndex], ivec2(i, 0), 0).r * 255.0 + 0.5);
+//         buffers[push.bufferIndex].values[i * 3 + 1] = uint(texelFetch(textures2DArray[push.texture2DArrayIndex], ivec3(i, 0, 1), 0).r * 255.0 + 0.5);
+//         buffers[push.bufferIndex].values[i * 3 + 2] = uint(texelFetch(textures3D[push.texture3DIndex], ivec3(i, 0, 1), 0).r * 255.0 + 0.5);
+//     }
+// }
+static const uint32_t kSampleShader[] = {
+    0x07230203, 0x00010300, 0x00000000, 0x00000061, 0x00000000, 0x00020011, 0x00000001, 0x00020011,
+    0x000014b6, 0x0008000a, 0x5f565053, 0x5f545845, 0x63736564, 0x74706972, 0x695f726f, 0x7865646e,
+    0x00676e69, 0x0003000e, 0x00000000, 0x00000001, 0x0006000f, 0x00000005, 0x00000001, 0x6e69616d,
+    0x00000000, 0x00000002, 0x00060010, 0x00000001, 0x00000011, 0x00000040, 0x00000001, 0x00000001,
+    0x00040047, 0x00000002, 0x0000000b, 0x0000001c, 0x00040047, 0x00000003, 0x00000022, 0x00000000,
+    0x00040047, 0x00000003, 0x00000021, 0x00000000, 0x00040047, 0x00000004, 0x00000022, 0x00000000,
+    0x00040047, 0x00000004, 0x00000021, 0x00000000, 0x00040047, 0x00000005, 0x00000022, 0x00000000,
+    0x00040047, 0x00000005, 0x00000021, 0x00000000, 0x00040047, 0x00000006, 0x00000022, 0x00000001,
+    0x00040047, 0x00000006, 0x00000021, 0x00000000, 0x00040047, 0x00000007, 0x00000006, 0x00000004,
+    0x00050048, 0x00000008, 0x00000000, 0x00000023, 0x00000000, 0x00030047, 0x00000008, 0x00000002,
+    0x00050048, 0x00000009, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000009, 0x00000001,
+    0x00000023, 0x00000004, 0x00050048, 0x00000009, 0x00000002, 0x00000023, 0x00000008, 0x00050048,
+    0x00000009, 0x00000003, 0x00000023, 0x0000000c, 0x00050048, 0x00000009, 0x00000004, 0x00000023,
+    0x00000010, 0x00030047, 0x00000009, 0x00000002, 0x00020013, 0x0000000a, 0x00030021, 0x0000000b,
+    0x0000000a, 0x00020014, 0x0000000c, 0x00040015, 0x0000000d, 0x00000020, 0x00000000, 0x00040015,
+    0x0000000e, 0x00000020, 0x00000001, 0x00030016, 0x0000000f, 0x00000020, 0x00040017, 0x00000010,
+    0x0000000f, 0x00000004, 0x00040017, 0x00000011, 0x0000000d, 0x00000003, 0x00040017, 0x00000012,
+    0x0000000e, 0x00000002, 0x00040017, 0x00000013, 0x0000000e, 0x00000003, 0x00090019, 0x00000014,
+    0x0000000f, 0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0x00000000, 0x00090019,
+    0x00000015, 0x0000000f, 0x00000001, 0x00000000, 0x00000001, 0x00000000, 0x00000001, 0x00000000,
+    0x00090019, 0x00000016, 0x0000000f, 0x00000002, 0x00000000, 0x00000000, 0x00000000, 0x00000001,
+    0x00000000, 0x0003001d, 0x00000017, 0x00000014, 0x00040020, 0x00000018, 0x00000000, 0x00000017,
+    0x00040020, 0x00000019, 0x00000000, 0x00000014, 0x0003001d, 0x0000001a, 0x00000015, 0x00040020,
+    0x0000001b, 0x00000000, 0x0000001a, 0x00040020, 0x0000001c, 0x00000000, 0x00000015, 0x0003001d,
+    0x0000001d, 0x00000016, 0x00040020, 0x0000001e, 0x00000000, 0x0000001d, 0x00040020, 0x0000001f,
+    0x00000000, 0x00000016, 0x0003001d, 0x00000007, 0x0000000d, 0x0003001e, 0x00000008, 0x00000007,
+    0x0003001d, 0x00000020, 0x00000008, 0x00040020, 0x00000021, 0x0000000c, 0x00000020, 0x00040020,
+    0x00000022, 0x0000000c, 0x0000000d, 0x0007001e, 0x00000009, 0x0000000d, 0x0000000d, 0x0000000d,
+    0x0000000d, 0x0000000d, 0x00040020, 0x00000023, 0x00000009, 0x00000009, 0x00040020, 0x00000024,
+    0x00000009, 0x0000000d, 0x00040020, 0x00000025, 0x00000001, 0x00000011, 0x0004002b, 0x0000000e,
+    0x00000026, 0x00000000, 0x0004002b, 0x0000000e, 0x00000027, 0x00000001, 0x0004002b, 0x0000000e,
+    0x00000028, 0x00000002, 0x0004002b, 0x0000000e, 0x00000029, 0x00000003, 0x0004002b, 0x0000000e,
+    0x0000002a, 0x00000004, 0x0004002b, 0x0000000d, 0x0000002b, 0x00000000, 0x0004002b, 0x0000000d,
+    0x0000002c, 0x00000001, 0x0004002b, 0x0000000d, 0x0000002d, 0x00000002, 0x0004002b, 0x0000000d,
+    0x0000002e, 0x00000003, 0x0004002b, 0x0000000f, 0x0000002f, 0x437f0000, 0x0004002b, 0x0000000f,
+    0x00000030, 0x3f000000, 0x0004003b, 0x00000025, 0x00000002, 0x00000001, 0x0004003b, 0x00000023,
+    0x00000031, 0x00000009, 0x0004003b, 0x00000018, 0x00000003, 0x00000000, 0x0004003b, 0x0000001b,
+    0x00000004, 0x00000000, 0x0004003b, 0x0000001e, 0x00000005, 0x00000000, 0x0004003b, 0x00000021,
+    0x00000006, 0x0000000c, 0x00050036, 0x0000000a, 0x00000001, 0x00000000, 0x0000000b, 0x000200f8,
+    0x00000032, 0x0004003d, 0x00000011, 0x00000033, 0x00000002, 0x00050051, 0x0000000d, 0x00000034,
+    0x00000033, 0x00000000, 0x00050041, 0x00000024, 0x00000035, 0x00000031, 0x0000002a, 0x0004003d,
+    0x0000000d, 0x00000036, 0x00000035, 0x000500b0, 0x0000000c, 0x00000037, 0x00000034, 0x00000036,
+    0x000300f7, 0x00000038, 0x00000000, 0x000400fa, 0x00000037, 0x00000039, 0x00000038, 0x000200f8,
+    0x00000039, 0x0004007c, 0x0000000e, 0x0000003a, 0x00000034, 0x00050050, 0x00000012, 0x0000003b,
+    0x0000003a, 0x00000026, 0x00060050, 0x00000013, 0x0000003c, 0x0000003a, 0x00000026, 0x00000027,
+    0x00050041, 0x00000024, 0x0000003d, 0x00000031, 0x00000029, 0x0004003d, 0x0000000d, 0x0000003e,
+    0x0000003d, 0x00050084, 0x0000000d, 0x0000003f, 0x00000034, 0x0000002e, 0x00050041, 0x00000024,
+    0x00000040, 0x00000031, 0x00000026, 0x0004003d, 0x0000000d, 0x00000041, 0x00000040, 0x00050041,
+    0x00000019, 0x00000042, 0x00000003, 0x00000041, 0x0004003d, 0x00000014, 0x00000043, 0x00000042,
+    0x0007005f, 0x00000010, 0x00000044, 0x00000043, 0x0000003b, 0x00000002, 0x00000026, 0x00050051,
+    0x0000000f, 0x00000045, 0x00000044, 0x00000000, 0x00050085, 0x0000000f, 0x00000046, 0x00000045,
+    0x0000002f, 0x00050081, 0x0000000f, 0x00000047, 0x00000046, 0x00000030, 0x0004006d, 0x0000000d,
+    0x00000048, 0x00000047, 0x00050080, 0x0000000d, 0x00000049, 0x0000003f, 0x0000002b, 0x00070041,
+    0x00000022, 0x0000004a, 0x00000006, 0x0000003e, 0x00000026, 0x00000049, 0x0003003e, 0x0000004a,
+    0x00000048, 0x00050041, 0x00000024, 0x0000004b, 0x00000031, 0x00000027, 0x0004003d, 0x0000000d,
+    0x0000004c, 0x0000004b, 0x00050041, 0x0000001c, 0x0000004d, 0x00000004, 0x0000004c, 0x0004003d,
+    0x00000015, 0x0000004e, 0x0000004d, 0x0007005f, 0x00000010, 0x0000004f, 0x0000004e, 0x0000003c,
+    0x00000002, 0x00000026, 0x00050051, 0x0000000f, 0x00000050, 0x0000004f, 0x00000000, 0x00050085,
+    0x0000000f, 0x00000051, 0x00000050, 0x0000002f, 0x00050081, 0x0000000f, 0x00000052, 0x00000051,
+    0x00000030, 0x0004006d, 0x0000000d, 0x00000053, 0x00000052, 0x00050080, 0x0000000d, 0x00000054,
+    0x0000003f, 0x0000002c, 0x00070041, 0x00000022, 0x00000055, 0x00000006, 0x0000003e, 0x00000026,
+    0x00000054, 0x0003003e, 0x00000055, 0x00000053, 0x00050041, 0x00000024, 0x00000056, 0x00000031,
+    0x00000028, 0x0004003d, 0x0000000d, 0x00000057, 0x00000056, 0x00050041, 0x0000001f, 0x00000058,
+    0x00000005, 0x00000057, 0x0004003d, 0x00000016, 0x00000059, 0x00000058, 0x0007005f, 0x00000010,
+    0x0000005a, 0x00000059, 0x0000003c, 0x00000002, 0x00000026, 0x00050051, 0x0000000f, 0x0000005b,
+    0x0000005a, 0x00000000, 0x00050085, 0x0000000f, 0x0000005c, 0x0000005b, 0x0000002f, 0x00050081,
+    0x0000000f, 0x0000005d, 0x0000005c, 0x00000030, 0x0004006d, 0x0000000d, 0x0000005e, 0x0000005d,
+    0x00050080, 0x0000000d, 0x0000005f, 0x0000003f, 0x0000002d, 0x00070041, 0x00000022, 0x00000060,
+    0x00000006, 0x0000003e, 0x00000026, 0x0000005f, 0x0003003e, 0x00000060, 0x0000005e, 0x000200f9,
+    0x00000038, 0x000200f8, 0x00000038, 0x000100fd, 0x00010038,
+};
+
+struct PushData
+{
+    uint32_t textureIndices[kTextureCount];
+    uint32_t bufferIndex;
+    uint32_t count;
+};
+
+struct SamplePass
+{
+    VGPUPipeline pipeline;
+    VGPURenderGraphResource output;
+    PushData push;
+};
+
+struct ReadbackPass
+{
+    VGPUReadbackRing ring;
+    VGPURenderGraphResource output;
+    VGPUReadbackTicket ticket;
+};
+
+// Red channel of texel x in layer (or depth slice) layer of texture index.
+static uint8_t texel_value(uint32_t index, uint32_t layer, uint32_t x)
+{
+    return uint8_t(x * 2u + index * 40u + layer * 100u);
+}
+
+static VGPUTexture create_texture(VGPUDevice device, uint32_t index, const char* label, VGPUTextureDimension dimension, uint32_t layers)
+{
+    std::vector<uint8_t> pixels(kWidth * 4u * layers);
+    for (uint32_t layer = 0; layer < layers; ++layer)
+    {
+        for (uint32_t x = 0; x < kWidth; ++x)
+        {
+            uint8_t* texel = &pixels[(layer * kWidth + x) * 4u];
+            texel[0] = texel_value(index, layer, x);
+            texel[1] = 0;
+            texel[2] = 0;
+            texel[3] = 255;
+        }
+    }
+
+    VGPUTextureDesc desc = {};
+    desc.label = label;
+    desc.dimension = dimension;
+    desc.format = VGPUTextureFormat_RGBA8Unorm;
+    desc.usage = VGPUTextureUsage_ShaderRead;
+    desc.width = kWidth;
+    desc.height = 1u;
+    desc.depthOrArrayLayers = layers;
+    desc.mipLevelCount = 1u;
+    desc.sampleCount = 1u;
+
+    // Array textures take one entry per layer, 3D textures one entry with a slice pitch.
+    VGPUTextureData data[2] = {};
+    const uint32_t dataCount = dimension == VGPUTextureDimension_3D ? 1u : layers;
+    for (uint32_t i = 0; i < dataCount; ++i)
+    {
+        data[i].pData = &pixels[i * kWidth * 4u];
+        data[i].rowPitch = kWidth * 4u;
+        data[i].slicePitch = kWidth * 4u;
+    }
+
+    return vgpuCreateTexture(device, &desc, data);
+}
+
+static void execute_sample(VGPURenderGraph graph, VGPUCommandBuffer commandBuffer, void* userData)
+{
+    SamplePass* pass = (SamplePass*)userData;
+    pass->push.bufferIndex = vgpuBufferGetDescriptorIndex(vgpuRenderGraphGetBuffer(graph, pass->output));
+
+    vgpuSetPipeline(commandBuffer, pass->pipeline);
+    vgpuSetPushConstants(commandBuffer, 0, &pass->push, sizeof(PushData));
+    vgpuDispatch(commandBuffer, (kWidth + 63u) / 64u, 1u, 1u);
+}
+
+static void execute_readback(VGPURenderGraph graph, VGPUCommandBuffer commandBuffer, void* userData)
+{
+    ReadbackPass* pass = (ReadbackPass*)userData;
+    pass->ticket = vgpuReadbackRingCopyBuffer(pass->ring, commandBuffer, vgpuRenderGraphGetBuffer(graph, pass->output), 0, kWidth * kTextureCount * sizeof(uint32_t));
+}
+
+int main()
+{
+    vgpuSetLogLevel(VGPULogLevel_Warn);
+
+    VGPUDeviceDesc deviceDesc{};
+    deviceDesc.label = "Bindless";
+    if (vgpuIsBackendSupported(VGPUBackend_Vulkan))
+    {
+        deviceDesc.preferredBackend = VGPUBackend_Vulkan;
+    }
+
+    VGPUDevice device = vgpuCreateDevice(&deviceDesc);
+    if (device == nullptr)
+    {
+        std::cerr << "Error: Failed to initialize device\n";
+        return EXIT_FAILURE;
+    }
+
+    VGPUTexture textures[kTextureCount] = {
+        create_texture(device, 0u, "Texture2D", VGPUTextureDimension_2D, 1u),
+        create_texture(device, 1u, "Texture2DArray", VGPUTextureDimension_2D, 2u),
+        create_texture(device, 2u, "Texture3D", VGPUTextureDimension_3D, 2u),
+    };
+
+    VGPUBufferDesc outputDesc = {};
+    outputDesc.label = "Output";
+    outputDesc.size = kWidth * kTextureCount * sizeof(uint32_t);
+    outputDesc.usage = VGPUBufferUsage_ShaderWrite;
+    VGPUBuffer outputBuffer = vgpuCreateBuffer(device, &outputDesc, nullptr);
+
+    // The shader is SPIR-V and only the Vulkan backend fills the bindless heaps.
+    bool supported = vgpuDeviceGetBackend(device) == VGPUBackend_Vulkan
+        && vgpuDeviceQueryFeatureSupport(device, VGPUFeature_DescriptorIndexing)
+        && vgpuBufferGetDescriptorIndex(outputBuffer) != VGPU_INVALID_DESCRIPTOR_INDEX;
+    for (uint32_t i = 0; i < kTextureCount; ++i)
+    {
+        supported = supported && vgpuTextureGetDescriptorIndex(textures[i]) != VGPU_INVALID_DESCRIPTOR_INDEX;
+    }
+
+    int exitCode = EXIT_SUCCESS;
+    if (!supported)
+    {
+        printf("bindless descriptors are not supported, skipping\n");
+    }
+    else
+    {
+        VGPUPushConstantRange pushConstantRange = {};
+        pushConstantRange.shaderRegister = 0;
+        pushConstantRange.size = sizeof(PushData);
+        pushConstantRange.visibility = VGPUShaderStage_Compute;
+
+        VGPUPipelineLayoutDesc layoutDesc = {};
+        layoutDesc.label = "Bindless";
+        layoutDesc.pushConstantRangeCount = 1u;
+        layoutDesc.pushConstantRanges = &pushConstantRange;
+        layoutDesc.bindless = true;
+        VGPUPipelineLayout pipelineLayout = vgpuCreatePipelineLayout(device, &layoutDesc);
+
+        VGPUComputePipelineDesc pipelineDesc = {};
+        pipelineDesc.label = "Sample";
+        pipelineDesc.layout = pipelineLayout;
+        pipelineDesc.shader.stage = VGPUShaderStage_Compute;
+        pipelineDesc.shader.bytecode = kSampleShader;
+        pipelineDesc.shader.size = sizeof(kSampleShader);
+        pipelineDesc.shader.entryPointName = "main";
+        VGPUPipeline pipeline = vgpuCreateComputePipeline(device, &pipelineDesc);
+
+        VGPURenderGraph graph = vgpuCreateRenderGraph(device);
+        VGPUReadbackRing ring = vgpuCreateReadbackRing(device, 64u * 1024u);
+
+        SamplePass samplePass = {};
+        samplePass.pipeline = pipeline;
+        samplePass.output = vgpuRenderGraphImportBuffer(graph, outputBuffer);
+        samplePass.push.count = kWidth;
+
+        // Bindless accesses are invisible to the graph, the pass declares them so it transitions the resources.
+        VGPURenderGraphPassResource sampleResources[kTextureCount + 1] = {};
+        for (uint32_t i = 0; i < kTextureCount; ++i)
+        {
+            samplePass.push.textureIndices[i] = vgpuTextureGetDescriptorIndex(textures[i]);
+            sampleResources[i].resource = vgpuRenderGraphImportTexture(graph, textures[i]);
+            sampleResources[i].access = VGPURenderGraphAccess_ShaderRead;
+        }
+        sampleResources[kTextureCount].resource = samplePass.output;
+        sampleResources[kTextureCount].access = VGPURenderGraphAccess_ShaderWrite;
+
+        VGPURenderGraphPassDesc passDesc = {};
+        passDesc.label = "Sample";
+        passDesc.queue = VGPUCommandQueue_Graphics;
+        passDesc.resourceCount = kTextureCount + 1;
+        passDesc.resources = sampleResources;
+        passDesc.callback = execute_sample;
+        passDesc.userData = &samplePass;
+        vgpuRenderGraphAddPass(graph, &passDesc);
+
+        ReadbackPass readbackPass = {};
+        readbackPass.ring = ring;
+        readbackPass.output = samplePass.output;
+
+        VGPURenderGraphPassResource readbackResource = {};
+        readbackResource.resource = samplePass.output;
+        readbackResource.access = VGPURenderGraphAccess_CopySource;
+
+        passDesc.label = "Readback";
+        passDesc.resourceCount = 1u;
+        passDesc.resources = &readbackResource;
+        passDesc.hasSideEffects = true;
+        passDesc.callback = execute_readback;
+        passDesc.userData = &readbackPass;
+        vgpuRenderGraphAddPass(graph, &passDesc);
+
+        vgpuRenderGraphExecute(graph);
+
+        VGPUReadbackData data = {};
+        if (!vgpuReadbackRingWait(ring, readbackPass.ticket, UINT64_MAX) || !vgpuReadbackRingGetData(ring, readbackPass.ticket, &data))
+        {
+            std::cerr << "Error: Readback did not complete\n";
+            exitCode = EXIT_FAILURE;
+        }
+        else
+        {
+            // The shader reads layer 1 of the array and depth slice 1 of the 3D texture.
+            const uint32_t* values = (const uint32_t*)data.data;
+            uint32_t mismatches = 0;
+            for (uint32_t x = 0; x < kWidth; ++x)
+            {
+                for (uint32_t i = 0; i < kTextureCount; ++i)
+                {
+                    const uint32_t expected = texel_value(i, i == 0 ? 0u : 1u, x);
+                    if (values[x * kTextureCount + i] != expected)
+                        mismatches++;
+                }
+            }
+
+            printf("bindless: %u texels sampled, %u mismatches\n", kWidth * kTextureCount, mismatches);
+            if (mismatches > 0)
+                exitCode = EXIT_FAILURE;
+        }
+
+        vgpuReadbackRingFree(ring, readbackPass.ticket);
+        vgpuDeviceWaitIdle(device);
+        vgpuReadbackRingRelease(ring);
+        vgpuRenderGraphRelease(graph);
+        vgpuPipelineRelease(pipeline);
+        vgpuPipelineLayoutRelease(pipelineLayout);
+    }
+
+    vgpuBufferRelease(outputBuffer);
+    for (VGPUTexture texture : textures)
+    {
+        vgpuTextureRelease(texture);
+    }
+    vgpuDeviceRelease(device);
+    return exitCode;
+}
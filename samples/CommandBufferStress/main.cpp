@@ -0,0 +1,318 @@
+// Copyright © Amer Koleci and Contributors.
+// Distributed under the MIT license. See the LICENSE file in the project root for more information.
+
+// Records draws from 1..N threads at once into an offscreen target and reports draws/second scaling.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <fstream>
+#include <assert.h>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
+
+#include <vgpu.h>
+
+constexpr uint32_t kRenderTargetSize = 256u;
+constexpr uint32_t kDrawsPerCommandBuffer = 10000u;
+constexpr uint32_t kFramesPerRun = 16u;
+
+VGPUDevice device = nullptr;
+VGPUTexture colorTexture = nullptr;
+VGPUBuffer vertexBuffer = nullptr;
+VGPUBuffer constantBuffer = nullptr;
+VGPUBindGroup bindGroup = nullptr;
+VGPUPipelineLayout pipelineLayout = nullptr;
+VGPUPipeline renderPipeline = nullptr;
+
+static std::vector<uint8_t> LoadShader(const char* fileName)
+{
+    std::string shaderExt = ".spv";
+    if (vgpuDeviceGetBackend(device) == VGPUBackend_D3D12)
+    {
+        shaderExt = ".cso";
+    }
+
+    std::ifstream is(std::string("assets/shaders/") + fileName + shaderExt, std::ios::binary | std::ios::in | std::ios::ate);
+
+    if (is.is_open())
+    {
+        size_t size = is.tellg();
+        is.seekg(0, std::ios::beg);
+
+        std::vector<uint8_t> bytecode(size);
+        is.read((char*)bytecode.data(), size);
+        is.close();
+
+        return bytecode;
+    }
+    else
+    {
+        std::cerr << "Error: Could not open shader file \"" << fileName << "\"" << "\n";
+        return {};
+    }
+}
+
+static bool init_vgpu()
+{
+    VGPUDeviceDesc deviceDesc{};
+    deviceDesc.label = "CommandBufferStress";
+    if (vgpuIsBackendSupported(VGPUBackend_Vulkan))
+    {
+        deviceDesc.preferredBackend = VGPUBackend_Vulkan;
+    }
+
+    device = vgpuCreateDevice(&deviceDesc);
+    if (device == nullptr)
+        return false;
+
+    VGPUTextureDesc textureDesc = {};
+    textureDesc.label = "Color Target";
+    textureDesc.dimension = VGPUTextureDimension_2D;
+    textureDesc.width = kRenderTargetSize;
+    textureDesc.height = kRenderTargetSize;
+    textureDesc.depthOrArrayLayers = 1u;
+    textureDesc.format = VGPUTextureFormat_RGBA8Unorm;
+    textureDesc.usage = VGPUTextureUsage_RenderTarget;
+    textureDesc.mipLevelCount = 1u;
+    textureDesc.sampleCount = 1u;
+    colorTexture = vgpuCreateTexture(device, &textureDesc, nullptr);
+
+    const float vertices[] = {
+        /* positions            colors */
+         0.0f,  0.5f, 0.5f,     1.0f, 0.0f, 0.0f, 1.0f,
+         0.5f, -0.5f, 0.5f,     0.0f, 1.0f, 0.0f, 1.0f,
+        -0.5f, -0.5f, 0.5f,     0.0f, 0.0f, 1.0f, 1.0f,
+    };
+
+    VGPUBufferDesc vertexBufferDesc{};
+    vertexBufferDesc.label = "Vertex Buffer";
+    vertexBufferDesc.size = sizeof(vertices);
+    vertexBufferDesc.usage = VGPUBufferUsage_Vertex;
+    vertexBuffer = vgpuCreateBuffer(device, &vertexBufferDesc, vertices);
+
+    const float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    VGPUBufferDesc constantBufferDesc{};
+    constantBufferDesc.label = "Constant Buffer";
+    constantBufferDesc.size = sizeof(color);
+    constantBufferDesc.usage = VGPUBufferUsage_Constant;
+    constantBuffer = vgpuCreateBuffer(device, &constantBufferDesc, color);
+
+    std::vector<uint8_t> vertexBytecode = LoadShader("triangleVertex");
+    std::vector<uint8_t> fragmentBytecode = LoadShader("triangleFragment");
+    if (vertexBytecode.empty() || fragmentBytecode.empty())
+        return false;
+
+    VGPUShaderStageDesc shaderStages[2] = {};
+    shaderStages[0].stage = VGPUShaderStage_Vertex;
+    shaderStages[0].bytecode = vertexBytecode.data();
+    shaderStages[0].size = vertexBytecode.size();
+    shaderStages[0].entryPointName = "vertexMain";
+
+    shaderStages[1].stage = VGPUShaderStage_Fragment;
+    shaderStages[1].bytecode = fragmentBytecode.data();
+    shaderStages[1].size = fragmentBytecode.size();
+    shaderStages[1].entryPointName = "fragmentMain";
+
+    VGPUBindGroupLayoutEntry bindGroupLayoutEntry{};
+    bindGroupLayoutEntry.binding = 0;
+    bindGroupLayoutEntry.count = 1;
+    bindGroupLayoutEntry.visibility = VGPUShaderStage_Fragment;
+    bindGroupLayoutEntry.descriptorType = VGPUDescriptorType_ConstantBuffer;
+
+    VGPUBindGroupLayoutDesc bindGroupLayoutDesc{};
+    bindGroupLayoutDesc.entryCount = 1;
+    bindGroupLayoutDesc.entries = &bindGroupLayoutEntry;
+    VGPUBindGroupLayout bindGroupLayout = vgpuCreateBindGroupLayout(device, &bindGroupLayoutDesc);
+
+    VGPUBindGroupEntry bindGroupEntry{};
+    bindGroupEntry.binding = 0;
+    bindGroupEntry.buffer = constantBuffer;
+    bindGroupEntry.size = VGPU_WHOLE_SIZE;
+
+    VGPUBindGroupDesc bindGroupDesc{};
+    bindGroupDesc.entryCount = 1;
+    bindGroupDesc.entries = &bindGroupEntry;
+    bindGroup = vgpuCreateBindGroup(device, bindGroupLayout, &bindGroupDesc);
+
+    VGPUPipelineLayoutDesc pipelineLayoutDesc{};
+    pipelineLayoutDesc.bindGroupLayoutCount = 1;
+    pipelineLayoutDesc.bindGroupLayouts = &bindGroupLayout;
+    pipelineLayout = vgpuCreatePipelineLayout(device, &pipelineLayoutDesc);
+
+    VGPUVertexAttribute vertexAttributes[2] = {};
+    vertexAttributes[0].format = VGPUVertexFormat_Float3;
+    vertexAttributes[0].offset = 0;
+    vertexAttributes[0].shaderLocation = 0;
+    vertexAttributes[1].format = VGPUVertexFormat_Float4;
+    vertexAttributes[1].offset = 12;
+    vertexAttributes[1].shaderLocation = 1;
+
+    VGPUVertexBufferLayout vertexBufferLayout{};
+    vertexBufferLayout.stride = 28;
+    vertexBufferLayout.attributeCount = 2;
+    vertexBufferLayout.attributes = vertexAttributes;
+
+    VGPUTextureFormat colorFormat = VGPUTextureFormat_RGBA8Unorm;
+
+    VGPURenderPipelineDesc renderPipelineDesc{};
+    renderPipelineDesc.label = "Triangle";
+    renderPipelineDesc.layout = pipelineLayout;
+    renderPipelineDesc.shaderStageCount = 2u;
+    renderPipelineDesc.shaderStages = shaderStages;
+    renderPipelineDesc.vertex.layoutCount = 1u;
+    renderPipelineDesc.vertex.layouts = &vertexBufferLayout;
+    renderPipelineDesc.colorFormatCount = 1u;
+    renderPipelineDesc.colorFormats = &colorFormat;
+    renderPipelineDesc.blendState.renderTargets[0].colorWriteMask = VGPUColorWriteMask_All;
+    renderPipeline = vgpuCreateRenderPipeline(device, &renderPipelineDesc);
+
+    vgpuBindGroupLayoutRelease(bindGroupLayout);
+    return renderPipeline != nullptr;
+}
+
+static void record_draws(VGPUCommandBuffer commandBuffer)
+{
+    VGPURenderPassColorAttachment colorAttachment = {};
+    colorAttachment.texture = colorTexture;
+    colorAttachment.loadAction = VGPULoadAction_Load;
+    colorAttachment.storeAction = VGPUStoreAction_Store;
+
+    VGPURenderPassDesc renderPass{};
+    renderPass.colorAttachmentCount = 1u;
+    renderPass.colorAttachments = &colorAttachment;
+    vgpuBeginRenderPass(commandBuffer, &renderPass);
+    vgpuSetPipeline(commandBuffer, renderPipeline);
+    vgpuSetBindGroup(commandBuffer, 0, bindGroup);
+    vgpuSetVertexBuffer(commandBuffer, 0, vertexBuffer, 0);
+
+    for (uint32_t i = 0; i < kDrawsPerCommandBuffer; ++i)
+    {
+        vgpuDraw(commandBuffer, 0, 3, 1, 0);
+    }
+
+    vgpuEndRenderPass(commandBuffer);
+}
+
+// Returns draws recorded per second of CPU wall time for the given thread count.
+// The threads are started before timing and woken once per frame, so only the recording is measured.
+static double run(uint32_t threadCount)
+{
+    std::vector<VGPUCommandBuffer> commandBuffers(threadCount);
+    std::mutex mutex;
+    std::condition_variable frameStarted;
+    std::condition_variable frameRecorded;
+    uint32_t frame = 0;
+    uint32_t pendingThreads = 0;
+    bool quit = false;
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back([&, i]() {
+            uint32_t recordedFrame = 0;
+            for (;;)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    frameStarted.wait(lock, [&]() { return quit || frame != recordedFrame; });
+                    if (quit)
+                        return;
+                    recordedFrame = frame;
+                }
+
+                commandBuffers[i] = vgpuBeginCommandBuffer(device, VGPUCommandQueue_Graphics, nullptr);
+                record_draws(commandBuffers[i]);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--pendingThreads == 0)
+                {
+                    frameRecorded.notify_one();
+                }
+            }
+        });
+    }
+
+    double recordSeconds = 0.0;
+    for (uint32_t i = 1; i <= kFramesPerRun; ++i)
+    {
+        const auto start = std::chrono::high_resolution_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            frame = i;
+            pendingThreads = threadCount;
+        }
+        frameStarted.notify_all();
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            frameRecorded.wait(lock, [&]() { return pendingThreads == 0; });
+        }
+        recordSeconds += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+        vgpuDeviceSubmit(device, commandBuffers.data(), threadCount);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    frameStarted.notify_all();
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    return double(kDrawsPerCommandBuffer) * threadCount * kFramesPerRun / recordSeconds;
+}
+
+int main()
+{
+    vgpuSetLogLevel(VGPULogLevel_Warn);
+
+    if (!init_vgpu())
+    {
+        std::cerr << "Error: Failed to initialize device\n";
+        return EXIT_FAILURE;
+    }
+
+    const uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    // Warm up so every thread finds a pooled command buffer.
+    run(maxThreads);
+
+    // Powers of two, plus the core count itself when it is not one.
+    std::vector<uint32_t> threadCounts;
+    for (uint32_t threadCount = 1; threadCount <= maxThreads; threadCount *= 2)
+    {
+        threadCounts.push_back(threadCount);
+    }
+    if (threadCounts.back() != maxThreads)
+    {
+        threadCounts.push_back(maxThreads);
+    }
+
+    const double baseline = run(1);
+    printf("%8s %16s %10s\n", "threads", "draws/sec", "scaling");
+    for (uint32_t threadCount : threadCounts)
+    {
+        const double drawsPerSecond = (threadCount == 1) ? baseline : run(threadCount);
+        printf("%8u %16.0f %9.2fx\n", threadCount, drawsPerSecond, drawsPerSecond / baseline);
+    }
+
+    vgpuDeviceWaitIdle(device);
+    vgpuBufferRelease(vertexBuffer);
+    vgpuBufferRelease(constantBuffer);
+    vgpuTextureRelease(colorTexture);
+    vgpuBindGroupRelease(bindGroup);
+    vgpuPipelineLayoutRelease(pipelineLayout);
+    vgpuPipelineRelease(renderPipeline);
+    vgpuDeviceRelease(device);
+    return EXIT_SUCCESS;
+}
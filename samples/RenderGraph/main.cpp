@@ -0,0 +1,169 @@
+// Copyright © Amer Koleci and Contributors.
+// Distributed under the MIT license. See the LICENSE file in the project root for more information.
+
+// Runs a deferred-style frame through the render graph offscreen and reports culling and transient memory aliasing.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <chrono>
+
+#include <vgpu.h>
+
+constexpr uint32_t kTargetSize = 1024u;
+constexpr uint32_t kFrameCount = 64u;
+
+VGPUDevice device = nullptr;
+VGPUTexture outputTexture = nullptr;
+
+struct ClearPass
+{
+    VGPURenderGraphResource target;
+    float color[4];
+};
+
+// Clears the pass target, standing in for real draws.
+static void execute_clear(VGPURenderGraph graph, VGPUCommandBuffer commandBuffer, void* userData)
+{
+    const ClearPass* pass = (const ClearPass*)userData;
+
+    VGPURenderPassColorAttachment colorAttachment = {};
+    colorAttachment.texture = vgpuRenderGraphGetTexture(graph, pass->target);
+    colorAttachment.loadAction = VGPULoadAction_Clear;
+    colorAttachment.storeAction = VGPUStoreAction_Store;
+    colorAttachment.clearColor.r = pass->color[0];
+    colorAttachment.clearColor.g = pass->color[1];
+    colorAttachment.clearColor.b = pass->color[2];
+    colorAttachment.clearColor.a = pass->color[3];
+
+    VGPURenderPassDesc renderPass{};
+    renderPass.colorAttachmentCount = 1u;
+    renderPass.colorAttachments = &colorAttachment;
+    vgpuBeginRenderPass(commandBuffer, &renderPass);
+    vgpuEndRenderPass(commandBuffer);
+}
+
+static void add_pass(VGPURenderGraph graph, const char* label, ClearPass* pass, VGPURenderGraphResource input)
+{
+    VGPURenderGraphPassResource resources[2] = {};
+    resources[0].resource = pass->target;
+    resources[0].access = VGPURenderGraphAccess_RenderTarget;
+    resources[1].resource = input;
+    resources[1].access = VGPURenderGraphAccess_ShaderRead;
+
+    VGPURenderGraphPassDesc passDesc{};
+    passDesc.label = label;
+    passDesc.queue = VGPUCommandQueue_Graphics;
+    passDesc.resourceCount = input != VGPU_INVALID_RENDER_GRAPH_RESOURCE ? 2u : 1u;
+    passDesc.resources = resources;
+    passDesc.callback = execute_clear;
+    passDesc.userData = pass;
+    vgpuRenderGraphAddPass(graph, &passDesc);
+}
+
+// GBuffer -> Lighting -> Bloom -> Output, plus a debug view nobody reads.
+static void build_frame(VGPURenderGraph graph, ClearPass passes[5])
+{
+    VGPUTextureDesc textureDesc = {};
+    textureDesc.dimension = VGPUTextureDimension_2D;
+    textureDesc.width = kTargetSize;
+    textureDesc.height = kTargetSize;
+    textureDesc.usage = VGPUTextureUsage_RenderTarget | VGPUTextureUsage_ShaderRead;
+
+    textureDesc.label = "GBuffer";
+    textureDesc.format = VGPUTextureFormat_RGBA8Unorm;
+    const VGPURenderGraphResource gbuffer = vgpuRenderGraphCreateTexture(graph, &textureDesc);
+
+    textureDesc.label = "Lighting";
+    textureDesc.format = VGPUTextureFormat_RGBA16Float;
+    const VGPURenderGraphResource lighting = vgpuRenderGraphCreateTexture(graph, &textureDesc);
+
+    textureDesc.label = "Bloom";
+    textureDesc.format = VGPUTextureFormat_RGBA8Unorm;
+    const VGPURenderGraphResource bloom = vgpuRenderGraphCreateTexture(graph, &textureDesc);
+
+    textureDesc.label = "Debug";
+    const VGPURenderGraphResource debug = vgpuRenderGraphCreateTexture(graph, &textureDesc);
+
+    const VGPURenderGraphResource output = vgpuRenderGraphImportTexture(graph, outputTexture);
+
+    passes[0] = { gbuffer, { 0.2f, 0.3f, 0.4f, 1.0f } };
+    passes[1] = { lighting, { 0.5f, 0.5f, 0.5f, 1.0f } };
+    passes[2] = { bloom, { 0.1f, 0.1f, 0.1f, 1.0f } };
+    passes[3] = { debug, { 1.0f, 0.0f, 1.0f, 1.0f } };
+    passes[4] = { output, { 0.0f, 0.0f, 0.0f, 1.0f } };
+
+    add_pass(graph, "GBuffer", &passes[0], VGPU_INVALID_RENDER_GRAPH_RESOURCE);
+    add_pass(graph, "Lighting", &passes[1], gbuffer);
+    add_pass(graph, "Bloom", &passes[2], lighting);
+    add_pass(graph, "Debug", &passes[3], gbuffer);
+    add_pass(graph, "Composite", &passes[4], bloom);
+}
+
+int main()
+{
+    vgpuSetLogLevel(VGPULogLevel_Warn);
+
+    VGPUDeviceDesc deviceDesc{};
+    deviceDesc.label = "RenderGraph";
+    if (vgpuIsBackendSupported(VGPUBackend_Vulkan))
+    {
+        deviceDesc.preferredBackend = VGPUBackend_Vulkan;
+    }
+
+    device = vgpuCreateDevice(&deviceDesc);
+    if (device == nullptr)
+    {
+        std::cerr << "Error: Failed to initialize device\n";
+        return EXIT_FAILURE;
+    }
+
+    VGPUTextureDesc outputDesc = {};
+    outputDesc.label = "Output";
+    outputDesc.dimension = VGPUTextureDimension_2D;
+    outputDesc.format = VGPUTextureFormat_RGBA8Unorm;
+    outputDesc.usage = VGPUTextureUsage_RenderTarget;
+    outputDesc.width = kTargetSize;
+    outputDesc.height = kTargetSize;
+    outputTexture = vgpuCreateTexture(device, &outputDesc, nullptr);
+
+    VGPURenderGraph graph = vgpuCreateRenderGraph(device);
+    ClearPass passes[5];
+    vgpuDeviceSetProfilerEnabled(device, true);
+
+    double seconds = 0.0;
+    for (uint32_t frame = 0; frame < kFrameCount; ++frame)
+    {
+        const auto start = std::chrono::high_resolution_clock::now();
+        build_frame(graph, passes);
+        vgpuRenderGraphExecute(graph);
+        seconds += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    VGPURenderGraphStatistics statistics;
+    vgpuRenderGraphGetStatistics(graph, &statistics);
+
+    printf("passes: %u, culled: %u, async compute: %u\n", statistics.passCount, statistics.culledPassCount, statistics.asyncComputePassCount);
+    printf("transient textures: %u, buffers: %u\n", statistics.transientTextureCount, statistics.transientBufferCount);
+    printf("transient memory: %.2f MB (%.2f MB without aliasing)\n",
+        double(statistics.transientMemorySize) / (1024.0 * 1024.0),
+        double(statistics.unaliasedMemorySize) / (1024.0 * 1024.0));
+    printf("cpu: %.3f ms/frame\n", seconds * 1000.0 / kFrameCount);
+
+    VGPUFrameProfile profile;
+    if (vgpuDeviceGetFrameProfile(device, &profile))
+    {
+        printf("gpu frame %llu:\n", (unsigned long long)profile.frame);
+        for (uint32_t i = 0; i < profile.scopeCount; ++i)
+        {
+            const VGPUProfileScope& scope = profile.scopes[i];
+            printf("%*s%s: %.3f ms\n", (int)(scope.depth + 1) * 2, "", scope.label, scope.duration);
+        }
+    }
+
+    vgpuDeviceWaitIdle(device);
+    vgpuRenderGraphRelease(graph);
+    vgpuTextureRelease(outputTexture);
+    vgpuDeviceRelease(device);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,106 @@
+// Copyright © Amer Koleci and Contributors.
+// Distributed under the MIT license. See the LICENSE file in the project root for more information.
+
+// Compares per-resource initial-data uploads against batched uploads and reports MB/s and submits/s.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+#include <chrono>
+
+#include <vgpu.h>
+
+constexpr uint32_t kBufferCount = 512u;
+constexpr uint64_t kBufferSize = 64u * 1024u;
+constexpr uint32_t kRunCount = 8u;
+
+VGPUDevice device = nullptr;
+
+struct UploadResult
+{
+    double megabytesPerSecond;
+    double submitsPerSecond;
+};
+
+// Uploads kBufferCount buffers, waiting for the GPU after every flushInterval creations.
+static UploadResult run(const std::vector<uint8_t>& data, uint32_t flushInterval)
+{
+    std::vector<VGPUBuffer> buffers(kBufferCount);
+
+    VGPUBufferDesc bufferDesc{};
+    bufferDesc.size = kBufferSize;
+    bufferDesc.usage = VGPUBufferUsage_Vertex;
+
+    double seconds = 0.0;
+    uint64_t submits = 0;
+    for (uint32_t iteration = 0; iteration < kRunCount; ++iteration)
+    {
+        const uint64_t startToken = vgpuDeviceFlushUploads(device);
+        uint64_t token = startToken;
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < kBufferCount; ++i)
+        {
+            buffers[i] = vgpuCreateBuffer(device, &bufferDesc, data.data());
+
+            if ((i + 1) % flushInterval == 0 || i + 1 == kBufferCount)
+            {
+                token = vgpuDeviceFlushUploads(device);
+                vgpuDeviceWaitUploads(device, token, UINT64_MAX);
+            }
+        }
+        seconds += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+        // Tokens increase by one per flush, including the automatic ones.
+        submits += token - startToken;
+
+        for (VGPUBuffer buffer : buffers)
+        {
+            vgpuBufferRelease(buffer);
+        }
+    }
+
+    const double megabytes = double(kBufferSize) * kBufferCount * kRunCount / (1024.0 * 1024.0);
+    return { megabytes / seconds, double(submits) / seconds };
+}
+
+int main()
+{
+    vgpuSetLogLevel(VGPULogLevel_Warn);
+
+    VGPUDeviceDesc deviceDesc{};
+    deviceDesc.label = "UploadBenchmark";
+    if (vgpuIsBackendSupported(VGPUBackend_Vulkan))
+    {
+        deviceDesc.preferredBackend = VGPUBackend_Vulkan;
+    }
+
+    device = vgpuCreateDevice(&deviceDesc);
+    if (device == nullptr)
+    {
+        std::cerr << "Error: Failed to initialize device\n";
+        return EXIT_FAILURE;
+    }
+
+    std::vector<uint8_t> data(kBufferSize);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = uint8_t(i);
+    }
+
+    // Warm up staging buffers and allocator pools.
+    run(data, kBufferCount);
+
+    const UploadResult perResource = run(data, 1u);
+    const UploadResult batched = run(data, kBufferCount);
+
+    printf("%12s %12s %14s\n", "mode", "MB/s", "submits/sec");
+    printf("%12s %12.1f %14.1f\n", "per-resource", perResource.megabytesPerSecond, perResource.submitsPerSecond);
+    printf("%12s %12.1f %14.1f\n", "batched", batched.megabytesPerSecond, batched.submitsPerSecond);
+    printf("speedup: %.2fx\n", batched.megabytesPerSecond / perResource.megabytesPerSecond);
+
+    vgpuDeviceWaitIdle(device);
+    vgpuDeviceRelease(device);
+    return EXIT_SUCCESS;
+}
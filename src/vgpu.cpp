@@ -79,6 +79,82 @@ void vgpuSetLogCallback(VGPULogCallback func, void* userData)
     s_userData = userData;
 }
 
+/* VGPUWorkerPool */
+VGPUWorkerPool::VGPUWorkerPool(uint32_t threadCount)
+{
+    if (threadCount == 0)
+    {
+        const uint32_t coreCount = std::thread::hardware_concurrency();
+        threadCount = coreCount > 1 ? coreCount - 1 : 1;
+    }
+
+    threads.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back(&VGPUWorkerPool::WorkerLoop, this);
+    }
+}
+
+VGPUWorkerPool::~VGPUWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex);
+        shutdown = true;
+    }
+    wakeCondition.notify_all();
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+void VGPUWorkerPool::Execute(std::function<void()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex);
+        jobs.push_back(std::move(job));
+    }
+    wakeCondition.notify_one();
+}
+
+void VGPUWorkerPool::WaitIdle()
+{
+    std::unique_lock<std::mutex> lock(jobsMutex);
+    idleCondition.wait(lock, [this] { return jobs.empty() && activeJobs == 0; });
+}
+
+void VGPUWorkerPool::WorkerLoop()
+{
+    for (;;)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(jobsMutex);
+            wakeCondition.wait(lock, [this] { return shutdown || !jobs.empty(); });
+
+            // Drain pending jobs before exiting so callbacks always fire.
+            if (jobs.empty())
+                return;
+
+            job = std::move(jobs.front());
+            jobs.pop_front();
+            activeJobs++;
+        }
+
+        job();
+
+        {
+            std::lock_guard<std::mutex> lock(jobsMutex);
+            activeJobs--;
+            if (jobs.empty() && activeJobs == 0)
+            {
+                idleCondition.notify_all();
+            }
+        }
+    }
+}
+
 static const VGPUDriver* drivers[] = {
     #if defined(VGPU_D3D12_DRIVER)
         &D3D12_Driver,
@@ -88,6 +164,9 @@ static const VGPUDriver* drivers[] = {
     #endif
     #if defined(VGPU_WGPU_DRIVER)
         &WGPU_Driver,
+    #endif
+    #if defined(VGPU_NULL_DRIVER)
+        &Null_Driver,
     #endif
         nullptr
 };
@@ -128,6 +207,10 @@ retry:
             if (!drivers[i])
                 break;
 
+            // As in vgpuCreateDevice, the Null backend is only created when it is asked for.
+            if (drivers[i]->backend == VGPUBackend_Null)
+                continue;
+
             if (drivers[i]->isSupported())
             {
                 instance = drivers[i]->CreateInstance(&creationDesc);
@@ -189,6 +272,10 @@ retry:
             if (!drivers[i])
                 break;
 
+            // A device that renders nothing is never a fallback, the Null backend must be asked for.
+            if (drivers[i]->backend == VGPUBackend_Null)
+                continue;
+
             if (drivers[i]->isSupported())
             {
                 device = drivers[i]->createDevice(&creationDesc);
@@ -246,6 +333,10 @@ uint32_t vgpuDeviceRelease(VGPUDevice device)
 
 void vgpuDeviceWaitIdle(VGPUDevice device)
 {
+    VGPUTraceScope traceScope(device, "WaitIdle");
+    if (std::shared_ptr<VGPUCaptureRecorder> capture = device->GetCapture())
+        capture->WaitIdle();
+
     device->WaitIdle();
 }
 
@@ -285,7 +376,153 @@ uint64_t vgpuDeviceSubmit(VGPUDevice device, VGPUCommandBuffer* commandBuffers,
     VGPU_ASSERT(commandBuffers);
     VGPU_ASSERT(count);
 
-    return device->Submit(commandBuffers, count);
+    VGPUTraceScope traceScope(device, "Submit");
+    std::shared_ptr<VGPUCaptureRecorder> capture = device->GetCapture();
+    if (capture == nullptr && device->deferred == nullptr)
+        return device->Submit(commandBuffers, count);
+
+    // Recording wrappers are replaced by the command buffers they wrap, capture first as it wraps the deferred ones.
+    std::vector<VGPUCommandBuffer> backendCommandBuffers(commandBuffers, commandBuffers + count);
+    if (capture)
+        capture->Submit(backendCommandBuffers.data(), count);
+
+    if (device->deferred)
+    {
+        VGPUTraceScope translateScope(device, "TranslateCommands");
+        device->deferred->Submit(backendCommandBuffers.data(), count);
+    }
+
+    return device->Submit(backendCommandBuffers.data(), count);
+}
+
+uint64_t vgpuDeviceGetCompletedValue(VGPUDevice device, VGPUCommandQueue queue)
+{
+    VGPU_ASSERT(device);
+
+    return device->GetCompletedValue(queue);
+}
+
+VGPUBool32 vgpuDeviceWaitValue(VGPUDevice device, VGPUCommandQueue queue, uint64_t value, uint64_t timeout)
+{
+    VGPU_ASSERT(device);
+
+    VGPUTraceScope traceScope(device, "WaitValue");
+    return device->WaitValue(queue, value, timeout);
+}
+
+uint64_t vgpuDeviceFlushUploads(VGPUDevice device)
+{
+    VGPU_ASSERT(device);
+
+    VGPUTraceScope traceScope(device, "FlushUploads");
+    return device->FlushUploads();
+}
+
+VGPUBool32 vgpuDeviceWaitUploads(VGPUDevice device, uint64_t token, uint64_t timeout)
+{
+    VGPU_ASSERT(device);
+
+    VGPUTraceScope traceScope(device, "WaitUploads");
+    return device->WaitUploads(token, timeout);
+}
+
+void vgpuDeviceGetStagingStatistics(VGPUDevice device, VGPUStagingStatistics* statistics)
+{
+    VGPU_ASSERT(device);
+    NULL_RETURN(statistics);
+
+    device->GetStagingStatistics(statistics);
+}
+
+void vgpuDeviceGetMemoryBudget(VGPUDevice device, VGPUMemoryBudget* budget)
+{
+    VGPU_ASSERT(device);
+    NULL_RETURN(budget);
+
+    device->GetMemoryBudget(budget);
+}
+
+void vgpuDeviceGetMemoryStatistics(VGPUDevice device, VGPUMemoryStatistics* statistics)
+{
+    VGPU_ASSERT(device);
+    NULL_RETURN(statistics);
+
+    device->GetMemoryStatistics(statistics);
+}
+
+size_t vgpuDeviceGetMemoryDump(VGPUDevice device, VGPUBool32 detailed, char* data, size_t dataSize)
+{
+    VGPU_ASSERT(device);
+
+    return device->GetMemoryDump(detailed != 0, data, dataSize);
+}
+
+void vgpuDeviceSetMemoryBudgetCallback(VGPUDevice device, VGPUMemoryBudgetCallback callback, void* userData)
+{
+    VGPU_ASSERT(device);
+
+    device->memoryBudgetCallback = callback;
+    device->memoryBudgetUserData = userData;
+}
+
+void vgpuDeviceSetProfilerEnabled(VGPUDevice device, VGPUBool32 enabled)
+{
+    VGPU_ASSERT(device);
+
+    device->SetProfilerEnabled(enabled != 0);
+}
+
+VGPUBool32 vgpuDeviceGetFrameProfile(VGPUDevice device, VGPUFrameProfile* profile)
+{
+    VGPU_ASSERT(device);
+    VGPU_ASSERT(profile);
+
+    return device->GetFrameProfile(profile);
+}
+
+void vgpuDeviceGetFrameStatistics(VGPUDevice device, VGPUFrameStatistics* statistics)
+{
+    VGPU_ASSERT(device);
+    NULL_RETURN(statistics);
+
+    device->GetFrameStatistics(statistics);
+}
+
+VGPUBool32 vgpuDeviceBeginTrace(VGPUDevice device, const char* path)
+{
+    VGPU_ASSERT(device);
+    VGPU_ASSERT(path);
+
+    return device->BeginTrace(path);
+}
+
+VGPUBool32 vgpuDeviceEndTrace(VGPUDevice device)
+{
+    VGPU_ASSERT(device);
+
+    return device->EndTrace();
+}
+
+VGPUBool32 vgpuDeviceBeginCapture(VGPUDevice device, const char* path)
+{
+    VGPU_ASSERT(device);
+    VGPU_ASSERT(path);
+
+    return device->BeginCapture(path);
+}
+
+VGPUBool32 vgpuDeviceEndCapture(VGPUDevice device)
+{
+    VGPU_ASSERT(device);
+
+    return device->EndCapture();
+}
+
+void vgpuDeviceSetDeferredRecording(VGPUDevice device, VGPUBool32 enabled)
+{
+    VGPU_ASSERT(device);
+
+    device->SetDeferredRecording(enabled);
 }
 
 uint64_t vgpuDeviceGetFrameCount(VGPUDevice device)
@@ -305,11 +542,25 @@ uint64_t vgpuDeviceGetTimestampFrequency(VGPUDevice device)
     return device->GetTimestampFrequency();
 }
 
+uint64_t vgpuDeviceGetAllocatorHighWaterMark(VGPUDevice device)
+{
+    VGPU_ASSERT(device);
+
+    return device->GetAllocatorHighWaterMark();
+}
+
 void* vgpuDeviceGetNativeObject(VGPUDevice device, VGPUNativeObjectType objectType)
 {
     return device->GetNativeObject(objectType);
 }
 
+size_t vgpuDeviceGetPipelineCacheData(VGPUDevice device, void* data, size_t dataSize)
+{
+    VGPU_ASSERT(device);
+
+    return device->GetPipelineCacheData(data, dataSize);
+}
+
 /* Buffer */
 static VGPUBufferDesc _vgpu_buffer_desc_def(const VGPUBufferDesc* desc)
 {
@@ -318,33 +569,46 @@ static VGPUBufferDesc _vgpu_buffer_desc_def(const VGPUBufferDesc* desc)
     return def;
 }
 
-VGPUBuffer vgpuCreateBuffer(VGPUDevice device, const VGPUBufferDesc* desc, const void* pInitialData)
+static bool _vgpuValidateBufferDesc(VGPUDevice device, const VGPUBufferDesc* desc)
 {
-    VGPU_ASSERT(device);
-    NULL_RETURN_NULL(desc);
-
-    VGPUBufferDesc desc_def = _vgpu_buffer_desc_def(desc);
-
     // Check for caps
-    if (desc_def.usage & VGPUBufferUsage_Predication)
+    if (desc->usage & VGPUBufferUsage_Predication)
     {
         if (!device->QueryFeatureSupport(VGPUFeature_Predication))
         {
             vgpuLogError("vgpuCreateBuffer: Predication is not supported");
-            return nullptr;
+            return false;
         }
     }
 
-    if (desc_def.usage & VGPUBufferUsage_RayTracing)
+    if (desc->usage & VGPUBufferUsage_RayTracing)
     {
         if (!device->QueryFeatureSupport(VGPUFeature_RayTracing))
         {
             vgpuLogError("vgpuCreateBuffer: RayTracing is not supported");
-            return nullptr;
+            return false;
         }
     }
 
-    return device->CreateBuffer(&desc_def, pInitialData);
+    return true;
+}
+
+VGPUBuffer vgpuCreateBuffer(VGPUDevice device, const VGPUBufferDesc* desc, const void* pInitialData)
+{
+    VGPU_ASSERT(device);
+    NULL_RETURN_NULL(desc);
+
+    VGPUBufferDesc desc_def = _vgpu_buffer_desc_def(desc);
+    if (!_vgpuValidateBufferDesc(device, &desc_def))
+        return nullptr;
+
+    VGPUTraceScope traceScope(device, "CreateBuffer");
+    VGPUBuffer buffer = device->CreateBuffer(&desc_def, pInitialData);
+    std::shared_ptr<VGPUCaptureRecorder> capture = device->GetCapture();
+    if (buffer && capture)
+        capture->CreateBuffer(buffer, &desc_def, pInitialData);
+
+    return buffer;
 }
 
 uint64_t vgpuBufferGetSize(VGPUBuffer buffer)
@@ -368,6 +632,34 @@ VGPUDeviceAddress vgpuBufferGetAddress(VGPUBuffer buffer)
     return buffer->GetGpuAddress();
 }
 
+uint32_t vgpuBufferGetDescriptorIndex(VGPUBuffer buffer)
+{
+    VGPU_ASSERT(buffer);
+
+    return buffer->GetDescriptorIndex();
+}
+
+void* vgpuBufferGetMappedData(VGPUBuffer buffer)
+{
+    VGPU_ASSERT(buffer);
+
+    return buffer->GetMappedData();
+}
+
+void vgpuBufferFlushRange(VGPUBuffer buffer, uint64_t offset, uint64_t size)
+{
+    VGPU_ASSERT(buffer);
+
+    buffer->FlushRange(offset, size);
+}
+
+void vgpuBufferInvalidateRange(VGPUBuffer buffer, uint64_t offset, uint64_t size)
+{
+    VGPU_ASSERT(buffer);
+
+    buffer->InvalidateRange(offset, size);
+}
+
 void vgpuBufferSetLabel(VGPUBuffer buffer, const char* label)
 {
     NULL_RETURN(buffer);
@@ -412,51 +704,46 @@ static VGPUTextureDesc _vgpuTextureDescDef(const VGPUTextureDesc* desc)
     return def;
 }
 
-VGPUTexture vgpuCreateTexture(VGPUDevice device, const VGPUTextureDesc* desc, const VGPUTextureData* pInitialData)
+static bool _vgpuValidateTextureDesc(const VGPUTextureDesc* desc, const VGPUTextureData* pInitialData)
 {
-    VGPU_ASSERT(device);
-    NULL_RETURN_NULL(desc);
-
-    VGPUTextureDesc desc_def = _vgpuTextureDescDef(desc);
-
-    VGPU_ASSERT(desc_def.width > 0 && desc_def.height > 0 && desc_def.mipLevelCount >= 0);
+    VGPU_ASSERT(desc->width > 0 && desc->height > 0 && desc->mipLevelCount >= 0);
 
-    const bool is3D = desc_def.dimension == VGPUTextureDimension_3D;
-    const bool isDepthStencil = vgpuIsDepthStencilFormat(desc_def.format);
+    const bool is3D = desc->dimension == VGPUTextureDimension_3D;
+    const bool isDepthStencil = vgpuIsDepthStencilFormat(desc->format);
     bool isCube = false;
 
-    if (desc_def.dimension == VGPUTextureDimension_2D &&
-        desc_def.width == desc_def.height &&
-        desc_def.depthOrArrayLayers >= 6)
+    if (desc->dimension == VGPUTextureDimension_2D &&
+        desc->width == desc->height &&
+        desc->depthOrArrayLayers >= 6)
     {
         isCube = true;
     }
 
-    if (desc_def.sampleCount > 1u)
+    if (desc->sampleCount > 1u)
     {
         if (isCube)
         {
             vgpuLogWarn("Cubemap texture cannot be multisample");
-            return NULL;
+            return false;
         }
 
         if (is3D)
         {
             vgpuLogWarn("3D texture cannot be multisample");
-            return NULL;
+            return false;
         }
 
-        if (desc_def.mipLevelCount > 1)
+        if (desc->mipLevelCount > 1)
         {
             vgpuLogWarn("Multisample texture cannot have mipmaps");
-            return NULL;
+            return false;
         }
     }
 
-    if (isDepthStencil && desc_def.mipLevelCount > 1)
+    if (isDepthStencil && desc->mipLevelCount > 1)
     {
         vgpuLogWarn("Depth texture cannot have mipmaps");
-        return NULL;
+        return false;
     }
 
     //if (isCube)
@@ -473,13 +760,53 @@ VGPUTexture vgpuCreateTexture(VGPUDevice device, const VGPUTextureDesc* desc, co
     //}
 
     // Check if depth texture and ShaderWrite
-    if (isDepthStencil && (desc_def.usage & VGPUTextureUsage_ShaderWrite))
+    if (isDepthStencil && (desc->usage & VGPUTextureUsage_ShaderWrite))
     {
         vgpuLogWarn("Cannot create Depth texture with ShaderWrite usage");
-        return NULL;
+        return false;
+    }
+
+    // Transient attachment contents never leave the render pass, nothing else may observe them.
+    if (desc->usage & VGPUTextureUsage_Transient)
+    {
+        if (!(desc->usage & VGPUTextureUsage_RenderTarget))
+        {
+            vgpuLogWarn("Transient texture must have RenderTarget usage");
+            return false;
+        }
+
+        if (desc->usage & (VGPUTextureUsage_ShaderRead | VGPUTextureUsage_ShaderWrite | VGPUTextureUsage_ShadingRate | VGPUTextureUsage_Shared))
+        {
+            vgpuLogWarn("Transient texture cannot be sampled, written by shaders or shared");
+            return false;
+        }
+
+        if (desc->cpuAccess != VGPUCpuAccessMode_None || pInitialData != nullptr)
+        {
+            vgpuLogWarn("Transient texture cannot have CPU access or initial data");
+            return false;
+        }
     }
 
-    return device->CreateTexture(&desc_def, pInitialData);
+    return true;
+}
+
+VGPUTexture vgpuCreateTexture(VGPUDevice device, const VGPUTextureDesc* desc, const VGPUTextureData* pInitialData)
+{
+    VGPU_ASSERT(device);
+    NULL_RETURN_NULL(desc);
+
+    VGPUTextureDesc desc_def = _vgpuTextureDescDef(desc);
+    if (!_vgpuValidateTextureDesc(&desc_def, pInitialData))
+        return nullptr;
+
+    VGPUTraceScope traceScope(device, "CreateTexture");
+    VGPUTexture texture = device->CreateTexture(&desc_def, pInitialData);
+    std::shared_ptr<VGPUCaptureRecorder> capture = device->GetCapture();
+    if (texture && capture)
+        capture->CreateTexture(texture, &desc_def, pInitialData);
+
+    return texture;
 }
 
 VGPUTextureDimension vgpuTextureGetDimension(VGPUTexture texture)
@@ -496,6 +823,13 @@ VGPUTextureFormat vgpuTextureGetFormat(VGPUTexture texture)
     return texture->GetFormat();
 }
 
+uint32_t vgpuTextureGetDescriptorIndex(VGPUTexture texture)
+{
+    VGPU_ASSERT(texture);
+
+    return texture->GetDescriptorIndex();
+}
+
 void vgpuTextureSetLabel(VGPUTexture texture, const char* label)
 {
     NULL_RETURN(texture);
@@ -517,6 +851,152 @@ uint32_t vgpuTextureRelease(VGPUTexture texture)
     return texture->Release();
 }
 
+/* MemoryHeap */
+VGPUMemoryHeap vgpuCreateMemoryHeap(VGPUDevice device, uint64_t size, VGPUMemoryClass memoryClass)
+{
+    VGPU_ASSERT(device);
+
+    if (size == 0)
+    {
+        vgpuLogWarn("Cannot create empty memory heap");
+        return nullptr;
+    }
+
+    // Caller placed resources pick their own alignment, the heap gets a memory block of its own.
+    VGPUAllocationRequirements requirements = {};
+    requirements.size = size;
+    requirements.alignment = 0;
+    requirements.memoryTypeBits = UINT32_MAX;
+    return device->CreateMemoryHeap(&requirements, memoryClass);
+}
+
+uint64_t vgpuMemoryHeapGetSize(VGPUMemoryHeap heap)
+{
+    VGPU_ASSERT(heap);
+
+    return heap->GetSize();
+}
+
+VGPUMemoryClass vgpuMemoryHeapGetMemoryClass(VGPUMemoryHeap heap)
+{
+    VGPU_ASSERT(heap);
+
+    return heap->GetMemoryClass();
+}
+
+void vgpuMemoryHeapSetLabel(VGPUMemoryHeap heap, const char* label)
+{
+    NULL_RETURN(heap);
+
+    heap->SetLabel(label);
+}
+
+uint32_t vgpuMemoryHeapAddRef(VGPUMemoryHeap heap)
+{
+    assert(heap);
+
+    return heap->AddRef();
+}
+
+uint32_t vgpuMemoryHeapRelease(VGPUMemoryHeap heap)
+{
+    assert(heap);
+
+    return heap->Release();
+}
+
+VGPUBool32 vgpuGetResourceAllocationInfo(VGPUDevice device, const VGPUBufferDesc* bufferDesc, const VGPUTextureDesc* textureDesc, VGPUResourceAllocationInfo* info)
+{
+    VGPU_ASSERT(device);
+    VGPU_ASSERT(info);
+
+    if ((bufferDesc == nullptr) == (textureDesc == nullptr))
+    {
+        vgpuLogWarn("vgpuGetResourceAllocationInfo: Expected exactly one of bufferDesc or textureDesc");
+        return false;
+    }
+
+    VGPUAllocationRequirements requirements = {};
+    bool result;
+    if (bufferDesc != nullptr)
+    {
+        VGPUBufferDesc desc_def = _vgpu_buffer_desc_def(bufferDesc);
+        result = device->GetBufferAllocationRequirements(&desc_def, &requirements);
+    }
+    else
+    {
+        VGPUTextureDesc desc_def = _vgpuTextureDescDef(textureDesc);
+        result = device->GetTextureAllocationRequirements(&desc_def, &requirements);
+    }
+
+    info->size = requirements.size;
+    info->alignment = requirements.alignment;
+    return result;
+}
+
+// Host access decides the memory class a placed buffer needs.
+static VGPUMemoryClass _vgpuGetMemoryClass(VGPUCpuAccessMode cpuAccess)
+{
+    switch (cpuAccess)
+    {
+        case VGPUCpuAccessMode_Write:
+            return VGPUMemoryClass_Upload;
+        case VGPUCpuAccessMode_Read:
+            return VGPUMemoryClass_Readback;
+        default:
+            return VGPUMemoryClass_Default;
+    }
+}
+
+VGPUBuffer vgpuCreatePlacedBuffer(VGPUDevice device, VGPUMemoryHeap heap, uint64_t offset, const VGPUBufferDesc* desc)
+{
+    VGPU_ASSERT(device);
+    NULL_RETURN_NULL(heap);
+    NULL_RETURN_NULL(desc);
+
+    VGPUBufferDesc desc_def = _vgpu_buffer_desc_def(desc);
+    if (!_vgpuValidateBufferDesc(device, &desc_def))
+        return nullptr;
+
+    if (heap->GetMemoryClass() != _vgpuGetMemoryClass(desc_def.cpuAccess))
+    {
+        vgpuLogWarn("vgpuCreatePlacedBuffer: Buffer CPU access does not match the heap memory class");
+        return nullptr;
+    }
+
+    // Captured as a committed buffer, replay does not recreate the heap.
+    VGPUBuffer buffer = device->CreatePlacedBuffer(heap, offset, &desc_def);
+    std::shared_ptr<VGPUCaptureRecorder> capture = device->GetCapture();
+    if (buffer && capture)
+        capture->CreateBuffer(buffer, &desc_def, nullptr);
+
+    return buffer;
+}
+
+VGPUTexture vgpuCreatePlacedTexture(VGPUDevice device, VGPUMemoryHeap heap, uint64_t offset, const VGPUTextureDesc* desc)
+{
+    VGPU_ASSERT(device);
+    NULL_RETURN_NULL(heap);
+    NULL_RETURN_NULL(desc);
+
+    VGPUTextureDesc desc_def = _vgpuTextureDescDef(desc);
+    if (!_vgpuValidateTextureDesc(&desc_def, nullptr))
+        return nullptr;
+
+    if (heap->GetMemoryClass() != VGPUMemoryClass_Default || desc_def.cpuAccess != VGPUCpuAccessMode_None)
+    {
+        vgpuLogWarn("vgpuCreatePlacedTexture: Textures can only be placed in VGPUMemoryClass_Default heaps");
+        return nullptr;
+    }
+
+    VGPUTexture texture = device->CreatePlacedTexture(heap, offset, &desc_def);
+    std::shared_ptr<VGPUCaptureRecorder> capture = device->GetCapture();
+    if (texture && capture)
+        capture->CreateTexture(texture, &desc_def, nullptr);
+
+    return texture;
+}
+
 /* Sampler*/
 static VGPUSamplerDesc _vgpuSamplerDescDef(const VGPUSamplerDesc* desc)
 {
@@ -532,7 +1012,12 @@ VGPUSampler vgpuCreateSampler(VGPUDevice device, const VGPUSamplerDesc* desc)
     NULL_RETURN_NULL(desc);
 
     VGPUSamplerDesc desc_def = _vgpuSamplerDescDef(desc);
-    return device->CreateSampler(&desc_def);
+    VGPUSampler sampler = device->CreateSampler(&desc_def);
+    std::shared_ptr<VGPUCaptureRecorder> capture = device->GetCapture();
+    if (sampler && capture)
+        capture->CreateSampler(sampler, &desc_def);
+
+    return sampler;
 }
 
 void vgpuSamplerSetLabel(VGPUSampler sampler, const char* label)
@@ -542,6 +1027,13 @@ void vgpuSamplerSetLabel(VGPUSampler sampler, const char* label)
     sampler->SetLabel(label);
 }
 
+uint32_t vgpuSamplerGetDescriptorIndex(VGPUSampler sampler)
+{
+    VGPU_ASSERT(sampler);
+
+    return sampler->GetDescriptorIndex();
+}
+
 uint32_t vgpuSamplerAddRef(VGPUSampler sampler)
 {
     assert(sampler);
@@ -569,7 +1061,12 @@ VGPUBindGroupLayout vgpuCreateBindGroupLayout(VGPUDevice device, const VGPUBindG
     NULL_RETURN_NULL(desc);
 
     VGPUBindGroupLayoutDesc desc_def = _VGPUBindGroupLayoutDesc_Def(desc);
-    return device->CreateBindGroupLayout(&desc_def);
+    VGPUBindGroupLayout bindGroupLayout = device->CreateBindGroupLayout(&desc_def);
+    std::shared_ptr<VGPUCaptureRecorder> capture = device->GetCapture();
+    if (bindGroupLayout && capture)
+        capture->CreateBindGroupLayout(bindGroupLayout, &desc_def);
+
+    return bindGroupLayout;
 }
 
 void vgpuBindGroupLayoutSetLabel(VGPUBindGroupLayout bindGroupLayout, const char* label)
@@ -606,7 +1103,12 @@ VGPUPipelineLayout vgpuCreatePipelineLayout(VGPUDevice device, const VGPUPipelin
     NULL_RETURN_NULL(desc);
 
     VGPUPipelineLayoutDesc desc_def = _VGPUPipelineLayoutDesc_Def(desc);
-    return device->CreatePipelineLayout(&desc_def);
+    VGPUPipelineLayout pipelineLayout = device->CreatePipelineLayout(&desc_def);
+    std::shared_ptr<VGPUCaptureRecorder> capture = device->GetCapture();
+    if (pipelineLayout && capture)
+        capture->CreatePipelineLayout(pipelineLayout, &desc_def);
+
+    return pipelineLayout;
 }
 
 void vgpuPipelineLayoutSetLabel(VGPUPipelineLayout pipelineLayout, const char* label)
@@ -644,7 +1146,12 @@ VGPUBindGroup vgpuCreateBindGroup(VGPUDevice device, const VGPUBindGroupLayout l
     NULL_RETURN_NULL(desc);
 
     VGPUBindGroupDesc desc_def = _VGPUBindGroupDesc_Def(desc);
-    return device->CreateBindGroup(layout, &desc_def);
+    VGPUBindGroup bindGroup = device->CreateBindGroup(layout, &desc_def);
+    std::shared_ptr<VGPUCaptureRecorder> capture = device->GetCapture();
+    if (bindGroup && capture)
+        capture->CreateBindGroup(bindGroup, layout, &desc_def);
+
+    return bindGroup;
 }
 
 void vgpuBindGroupSetLabel(VGPUBindGroup bindGroup, const char* label)
@@ -715,7 +1222,13 @@ VGPUPipeline vgpuCreateRenderPipeline(VGPUDevice device, const VGPURenderPipelin
     VGPU_ASSERT(desc->shaderStages != nullptr);
 
     VGPURenderPipelineDesc desc_def = _vgpuRenderPipelineDescDef(desc);
-    return device->CreateRenderPipeline(&desc_def);
+    VGPUTraceScope traceScope(device, "CreateRenderPipeline");
+    VGPUPipeline pipeline = device->CreateRenderPipeline(&desc_def);
+    std::shared_ptr<VGPUCaptureRecorder> capture = device->GetCapture();
+    if (pipeline && capture)
+        capture->CreateRenderPipeline(pipeline, &desc_def);
+
+    return pipeline;
 }
 
 VGPUPipeline vgpuCreateComputePipeline(VGPUDevice device, const VGPUComputePipelineDesc* desc)
@@ -727,7 +1240,13 @@ VGPUPipeline vgpuCreateComputePipeline(VGPUDevice device, const VGPUComputePipel
     VGPU_ASSERT(desc->shader.stage == VGPUShaderStage_Compute);
     VGPU_ASSERT(desc->shader.entryPointName);
 
-    return device->CreateComputePipeline(desc);
+    VGPUTraceScope traceScope(device, "CreateComputePipeline");
+    VGPUPipeline pipeline = device->CreateComputePipeline(desc);
+    std::shared_ptr<VGPUCaptureRecorder> capture = device->GetCapture();
+    if (pipeline && capture)
+        capture->CreateComputePipeline(pipeline, desc);
+
+    return pipeline;
 }
 
 VGPUPipeline vgpuCreateRayTracingPipeline(VGPUDevice device, const VGPURayTracingPipelineDesc* desc)
@@ -738,6 +1257,40 @@ VGPUPipeline vgpuCreateRayTracingPipeline(VGPUDevice device, const VGPURayTracin
     return device->CreateRayTracingPipeline(desc);
 }
 
+VGPUPipeline vgpuCreateRenderPipelineAsync(VGPUDevice device, const VGPURenderPipelineDesc* desc, VGPUPipelineCallback callback, void* userData)
+{
+    VGPU_ASSERT(device);
+    NULL_RETURN_NULL(desc);
+    VGPU_ASSERT(desc->layout);
+    VGPU_ASSERT(desc->shaderStageCount > 0);
+    VGPU_ASSERT(desc->shaderStages != nullptr);
+
+    // Replayed as a synchronous creation.
+    VGPURenderPipelineDesc desc_def = _vgpuRenderPipelineDescDef(desc);
+    VGPUPipeline pipeline = device->CreateRenderPipelineAsync(&desc_def, callback, userData);
+    std::shared_ptr<VGPUCaptureRecorder> capture = device->GetCapture();
+    if (pipeline && capture)
+        capture->CreateRenderPipeline(pipeline, &desc_def);
+
+    return pipeline;
+}
+
+VGPUPipeline vgpuCreateComputePipelineAsync(VGPUDevice device, const VGPUComputePipelineDesc* desc, VGPUPipelineCallback callback, void* userData)
+{
+    VGPU_ASSERT(device);
+    NULL_RETURN_NULL(desc);
+    VGPU_ASSERT(desc->layout);
+    VGPU_ASSERT(desc->shader.stage == VGPUShaderStage_Compute);
+    VGPU_ASSERT(desc->shader.entryPointName);
+
+    VGPUPipeline pipeline = device->CreateComputePipelineAsync(desc, callback, userData);
+    std::shared_ptr<VGPUCaptureRecorder> capture = device->GetCapture();
+    if (pipeline && capture)
+        capture->CreateComputePipeline(pipeline, desc);
+
+    return pipeline;
+}
+
 VGPUPipelineType vgpuPipelineGetType(VGPUPipeline pipeline)
 {
     VGPU_ASSERT(pipeline);
@@ -745,6 +1298,20 @@ VGPUPipelineType vgpuPipelineGetType(VGPUPipeline pipeline)
     return pipeline->GetType();
 }
 
+VGPUPipelineStatus vgpuPipelineGetStatus(VGPUPipeline pipeline)
+{
+    VGPU_ASSERT(pipeline);
+
+    return pipeline->GetStatus();
+}
+
+VGPUPipelineStatus vgpuPipelineWait(VGPUPipeline pipeline)
+{
+    VGPU_ASSERT(pipeline);
+
+    return pipeline->Wait();
+}
+
 void vgpuPipelineSetLabel(VGPUPipeline pipeline, const char* label)
 {
     NULL_RETURN(pipeline);
@@ -772,7 +1339,12 @@ VGPUQueryHeap vgpuCreateQueryHeap(VGPUDevice device, const VGPUQueryHeapDesc* de
     VGPU_ASSERT(device);
     NULL_RETURN_NULL(desc);
 
-    return device->CreateQueryHeap(desc);
+    VGPUQueryHeap queryHeap = device->CreateQueryHeap(desc);
+    std::shared_ptr<VGPUCaptureRecorder> capture = device->GetCapture();
+    if (queryHeap && capture)
+        capture->CreateQueryHeap(queryHeap, desc);
+
+    return queryHeap;
 }
 
 VGPUQueryType vgpuQueryHeapGetType(VGPUQueryHeap queryHeap)
@@ -827,7 +1399,12 @@ VGPUSwapChain vgpuCreateSwapChain(VGPUDevice device, const VGPUSwapChainDesc* de
         return nullptr;
 
     VGPUSwapChainDesc def = _vgpuSwapChainDescDef(desc);
-    return device->CreateSwapChain(&def);
+    VGPUSwapChain swapChain = device->CreateSwapChain(&def);
+    std::shared_ptr<VGPUCaptureRecorder> capture = device->GetCapture();
+    if (swapChain && capture)
+        capture->CreateSwapChain(swapChain, &def);
+
+    return swapChain;
 }
 
 VGPUTextureFormat vgpuSwapChainGetFormat(VGPUSwapChain swapChain)
@@ -867,7 +1444,14 @@ VGPUCommandBuffer vgpuBeginCommandBuffer(VGPUDevice device, VGPUCommandQueue que
 {
     VGPU_ASSERT(device);
 
-    return device->BeginCommandBuffer(queueType, label);
+    VGPUCommandBuffer commandBuffer = device->BeginCommandBuffer(queueType, label);
+    if (commandBuffer && device->deferredRecording)
+        commandBuffer = device->deferred->BeginCommandBuffer(commandBuffer);
+
+    if (commandBuffer)
+        commandBuffer = device->CaptureCommandBuffer(commandBuffer, label);
+
+    return commandBuffer;
 }
 
 void vgpuPushDebugGroup(VGPUCommandBuffer commandBuffer, const char* groupLabel)
@@ -896,6 +1480,66 @@ void vgpuClearBuffer(VGPUCommandBuffer commandBuffer, VGPUBuffer buffer, uint64_
     commandBuffer->ClearBuffer(buffer, offset, size);
 }
 
+void vgpuCopyBufferToBuffer(VGPUCommandBuffer commandBuffer, VGPUBuffer source, uint64_t sourceOffset, VGPUBuffer destination, uint64_t destinationOffset, uint64_t size)
+{
+    VGPU_ASSERT(source);
+    VGPU_ASSERT(destination);
+
+    commandBuffer->CopyBufferToBuffer(source, sourceOffset, destination, destinationOffset, size);
+}
+
+void vgpuCopyBufferToTexture(VGPUCommandBuffer commandBuffer, const VGPUBufferCopyLocation* source, const VGPUTextureCopyLocation* destination, const VGPUExtent3D* extent)
+{
+    NULL_RETURN(source);
+    NULL_RETURN(destination);
+    NULL_RETURN(extent);
+
+    if (destination->texture->GetUsage() & VGPUTextureUsage_Transient)
+    {
+        vgpuLogWarn("Cannot copy transient texture");
+        return;
+    }
+
+    commandBuffer->CopyBufferToTexture(source, destination, extent);
+}
+
+void vgpuCopyTextureToBuffer(VGPUCommandBuffer commandBuffer, const VGPUTextureCopyLocation* source, const VGPUBufferCopyLocation* destination, const VGPUExtent3D* extent)
+{
+    NULL_RETURN(source);
+    NULL_RETURN(destination);
+    NULL_RETURN(extent);
+
+    if (source->texture->GetUsage() & VGPUTextureUsage_Transient)
+    {
+        vgpuLogWarn("Cannot copy transient texture");
+        return;
+    }
+
+    commandBuffer->CopyTextureToBuffer(source, destination, extent);
+}
+
+void vgpuCopyTextureToTexture(VGPUCommandBuffer commandBuffer, const VGPUTextureCopyLocation* source, const VGPUTextureCopyLocation* destination, const VGPUExtent3D* extent)
+{
+    NULL_RETURN(source);
+    NULL_RETURN(destination);
+    NULL_RETURN(extent);
+
+    if ((source->texture->GetUsage() & VGPUTextureUsage_Transient) || (destination->texture->GetUsage() & VGPUTextureUsage_Transient))
+    {
+        vgpuLogWarn("Cannot copy transient texture");
+        return;
+    }
+
+    commandBuffer->CopyTextureToTexture(source, destination, extent);
+}
+
+VGPUBufferAllocation vgpuCommandBufferAllocate(VGPUCommandBuffer commandBuffer, uint64_t size, uint64_t alignment)
+{
+    VGPU_ASSERT(commandBuffer);
+
+    return commandBuffer->Allocate(size, alignment);
+}
+
 void vgpuSetPipeline(VGPUCommandBuffer commandBuffer, VGPUPipeline pipeline)
 {
     VGPU_ASSERT(pipeline);
@@ -1045,6 +1689,194 @@ void vgpuDispatchMeshIndirectCount(VGPUCommandBuffer commandBuffer, VGPUBuffer i
     commandBuffer->DispatchMeshIndirectCount(indirectBuffer, indirectBufferOffset, countBuffer, countBufferOffset, maxCount);
 }
 
+/* RenderGraph */
+VGPURenderGraph vgpuCreateRenderGraph(VGPUDevice device)
+{
+    VGPU_ASSERT(device);
+
+    return CreateRenderGraph(device);
+}
+
+VGPURenderGraphResource vgpuRenderGraphCreateTexture(VGPURenderGraph graph, const VGPUTextureDesc* desc)
+{
+    VGPU_ASSERT(graph);
+    if (desc == nullptr)
+        return VGPU_INVALID_RENDER_GRAPH_RESOURCE;
+
+    VGPUTextureDesc desc_def = _vgpuTextureDescDef(desc);
+    return graph->CreateTexture(&desc_def);
+}
+
+VGPURenderGraphResource vgpuRenderGraphCreateBuffer(VGPURenderGraph graph, const VGPUBufferDesc* desc)
+{
+    VGPU_ASSERT(graph);
+    if (desc == nullptr)
+        return VGPU_INVALID_RENDER_GRAPH_RESOURCE;
+
+    VGPUBufferDesc desc_def = _vgpu_buffer_desc_def(desc);
+    return graph->CreateBuffer(&desc_def);
+}
+
+VGPURenderGraphResource vgpuRenderGraphImportTexture(VGPURenderGraph graph, VGPUTexture texture)
+{
+    VGPU_ASSERT(graph);
+    if (texture == nullptr)
+        return VGPU_INVALID_RENDER_GRAPH_RESOURCE;
+
+    return graph->ImportTexture(texture);
+}
+
+VGPURenderGraphResource vgpuRenderGraphImportBuffer(VGPURenderGraph graph, VGPUBuffer buffer)
+{
+    VGPU_ASSERT(graph);
+    if (buffer == nullptr)
+        return VGPU_INVALID_RENDER_GRAPH_RESOURCE;
+
+    return graph->ImportBuffer(buffer);
+}
+
+VGPURenderGraphResource vgpuRenderGraphImportSwapChain(VGPURenderGraph graph, VGPUSwapChain swapChain)
+{
+    VGPU_ASSERT(graph);
+    if (swapChain == nullptr)
+        return VGPU_INVALID_RENDER_GRAPH_RESOURCE;
+
+    return graph->ImportSwapChain(swapChain);
+}
+
+void vgpuRenderGraphAddPass(VGPURenderGraph graph, const VGPURenderGraphPassDesc* desc)
+{
+    VGPU_ASSERT(graph);
+    NULL_RETURN(desc);
+
+    graph->AddPass(desc);
+}
+
+VGPUTexture vgpuRenderGraphGetTexture(VGPURenderGraph graph, VGPURenderGraphResource resource)
+{
+    VGPU_ASSERT(graph);
+
+    return graph->GetTexture(resource);
+}
+
+VGPUBuffer vgpuRenderGraphGetBuffer(VGPURenderGraph graph, VGPURenderGraphResource resource)
+{
+    VGPU_ASSERT(graph);
+
+    return graph->GetBuffer(resource);
+}
+
+uint64_t vgpuRenderGraphExecute(VGPURenderGraph graph)
+{
+    VGPU_ASSERT(graph);
+
+    return graph->Execute();
+}
+
+void vgpuRenderGraphGetStatistics(VGPURenderGraph graph, VGPURenderGraphStatistics* statistics)
+{
+    VGPU_ASSERT(graph);
+    NULL_RETURN(statistics);
+
+    graph->GetStatistics(statistics);
+}
+
+uint32_t vgpuRenderGraphAddRef(VGPURenderGraph graph)
+{
+    VGPU_ASSERT(graph);
+
+    return graph->AddRef();
+}
+
+uint32_t vgpuRenderGraphRelease(VGPURenderGraph graph)
+{
+    VGPU_ASSERT(graph);
+
+    return graph->Release();
+}
+
+/* ReadbackRing */
+VGPUReadbackRing vgpuCreateReadbackRing(VGPUDevice device, uint64_t size)
+{
+    VGPU_ASSERT(device);
+
+    if (size == 0)
+    {
+        vgpuLogWarn("Cannot create readback ring with zero size");
+        return nullptr;
+    }
+
+    return CreateReadbackRing(device, size);
+}
+
+VGPUReadbackTicket vgpuReadbackRingCopyBuffer(VGPUReadbackRing ring, VGPUCommandBuffer commandBuffer, VGPUBuffer buffer, uint64_t offset, uint64_t size)
+{
+    VGPU_ASSERT(ring);
+    VGPU_ASSERT(commandBuffer);
+    VGPU_ASSERT(buffer);
+
+    return ring->CopyBuffer(commandBuffer, buffer, offset, size);
+}
+
+VGPUReadbackTicket vgpuReadbackRingCopyTexture(VGPUReadbackRing ring, VGPUCommandBuffer commandBuffer, const VGPUTextureCopyLocation* source, const VGPUExtent3D* extent)
+{
+    VGPU_ASSERT(ring);
+    VGPU_ASSERT(commandBuffer);
+    if (source == nullptr || extent == nullptr)
+        return VGPU_INVALID_READBACK_TICKET;
+
+    if (source->texture->GetUsage() & VGPUTextureUsage_Transient)
+    {
+        vgpuLogWarn("Cannot copy transient texture");
+        return VGPU_INVALID_READBACK_TICKET;
+    }
+
+    return ring->CopyTexture(commandBuffer, source, extent);
+}
+
+VGPUBool32 vgpuReadbackRingIsReady(VGPUReadbackRing ring, VGPUReadbackTicket ticket)
+{
+    VGPU_ASSERT(ring);
+
+    return ring->IsReady(ticket);
+}
+
+VGPUBool32 vgpuReadbackRingWait(VGPUReadbackRing ring, VGPUReadbackTicket ticket, uint64_t timeout)
+{
+    VGPU_ASSERT(ring);
+
+    return ring->Wait(ticket, timeout);
+}
+
+VGPUBool32 vgpuReadbackRingGetData(VGPUReadbackRing ring, VGPUReadbackTicket ticket, VGPUReadbackData* data)
+{
+    VGPU_ASSERT(ring);
+    VGPU_ASSERT(data);
+
+    return ring->GetData(ticket, data);
+}
+
+void vgpuReadbackRingFree(VGPUReadbackRing ring, VGPUReadbackTicket ticket)
+{
+    VGPU_ASSERT(ring);
+
+    ring->Free(ticket);
+}
+
+uint32_t vgpuReadbackRingAddRef(VGPUReadbackRing ring)
+{
+    VGPU_ASSERT(ring);
+
+    return ring->AddRef();
+}
+
+uint32_t vgpuReadbackRingRelease(VGPUReadbackRing ring)
+{
+    VGPU_ASSERT(ring);
+
+    return ring->Release();
+}
+
 
 // Format mapping table. The rows must be in the exactly same order as Format enum members are defined.
 static const VGPUPixelFormatInfo c_FormatInfo[] = {
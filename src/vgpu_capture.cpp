@@ -0,0 +1,993 @@
+// Copyright (c) Amer Koleci and Contributors.
+// Licensed under the MIT License (MIT). See LICENSE in the repository root for more information.
+
+#include "vgpu_driver.h"
+#include "vgpu_capture.h"
+#include <stdio.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace
+{
+    // FNV-1a over 8 byte words, only used to detect changed buffer contents between submits.
+    uint64_t HashMemory(const void* data, uint64_t size)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        uint64_t hash = 14695981039346656037ull;
+        uint64_t offset = 0;
+        for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t))
+        {
+            uint64_t word;
+            memcpy(&word, bytes + offset, sizeof(word));
+            hash = (hash ^ word) * 1099511628211ull;
+        }
+
+        for (; offset < size; ++offset)
+        {
+            hash = (hash ^ bytes[offset]) * 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    void WriteShaderStage(VGPUCaptureWriter& payload, const VGPUShaderStageDesc& stage)
+    {
+        payload.Write(stage.stage);
+        payload.Write<uint64_t>(stage.size);
+        payload.WriteBytes(stage.bytecode, stage.size);
+        payload.WriteString(stage.entryPointName);
+    }
+}
+
+class CaptureRecorder;
+
+/// Appends every call to its own stream before forwarding it to the backend command buffer, the stream goes to the
+/// file when the command buffer is submitted.
+class CaptureCommandBuffer final : public VGPUCommandBufferImpl
+{
+public:
+    CaptureCommandBuffer(CaptureRecorder* recorder_)
+        : recorder(recorder_)
+    {
+    }
+
+    void Begin(VGPUCommandBuffer commandBuffer_, const char* label_);
+    // Copies what the application wrote into its allocations, they are only filled after vgpuCommandBufferAllocate returns.
+    void Finish();
+
+    VGPUCommandQueue GetQueueType() const override { return commandBuffer->GetQueueType(); }
+
+    void PushDebugGroup(const char* groupLabel) override;
+    void PopDebugGroup() override;
+    void InsertDebugMarker(const char* markerLabel) override;
+
+    void ClearBuffer(VGPUBuffer buffer, uint64_t offset, uint64_t size) override;
+    VGPUBufferAllocation Allocate(uint64_t size, uint64_t alignment) override;
+
+    void CopyBufferToBuffer(VGPUBuffer source, uint64_t sourceOffset, VGPUBuffer destination, uint64_t destinationOffset, uint64_t size) override;
+    void CopyBufferToTexture(const VGPUBufferCopyLocation* source, const VGPUTextureCopyLocation* destination, const VGPUExtent3D* extent) override;
+    void CopyTextureToBuffer(const VGPUTextureCopyLocation* source, const VGPUBufferCopyLocation* destination, const VGPUExtent3D* extent) override;
+    void CopyTextureToTexture(const VGPUTextureCopyLocation* source, const VGPUTextureCopyLocation* destination, const VGPUExtent3D* extent) override;
+
+    void SetPipeline(VGPUPipeline pipeline) override;
+    void SetBindGroup(uint32_t groupIndex, VGPUBindGroup bindGroup) override;
+    void SetPushConstants(uint32_t pushConstantIndex, const void* data, uint32_t size) override;
+
+    void Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) override;
+    void DispatchIndirect(VGPUBuffer buffer, uint64_t offset) override;
+
+    VGPUTexture AcquireSwapchainTexture(VGPUSwapChain swapChain) override;
+    void BeginRenderPass(const VGPURenderPassDesc* desc) override;
+    void EndRenderPass() override;
+
+    void SetViewport(const VGPUViewport* viewport) override;
+    void SetViewports(uint32_t count, const VGPUViewport* viewports) override;
+    void SetScissorRect(const VGPURect* rect) override;
+    void SetScissorRects(uint32_t count, const VGPURect* rects) override;
+
+    void SetVertexBuffer(uint32_t index, VGPUBuffer buffer, uint64_t offset) override;
+    void SetIndexBuffer(VGPUBuffer buffer, VGPUIndexType type, uint64_t offset) override;
+    void SetStencilReference(uint32_t reference) override;
+
+    void BeginQuery(VGPUQueryHeap heap, uint32_t index) override;
+    void EndQuery(VGPUQueryHeap heap, uint32_t index) override;
+    void ResolveQuery(VGPUQueryHeap heap, uint32_t index, uint32_t count, VGPUBuffer destinationBuffer, uint64_t destinationOffset) override;
+    void ResetQuery(VGPUQueryHeap heap, uint32_t index, uint32_t count) override;
+
+    void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) override;
+    void DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t baseVertex, uint32_t firstInstance) override;
+    void DrawIndirect(VGPUBuffer indirectBuffer, uint64_t indirectBufferOffset) override;
+    void DrawIndexedIndirect(VGPUBuffer indirectBuffer, uint64_t indirectBufferOffset) override;
+
+    void DispatchMesh(uint32_t threadGroupCountX, uint32_t threadGroupCountY, uint32_t threadGroupCountZ) override;
+    void DispatchMeshIndirect(VGPUBuffer indirectBuffer, uint64_t indirectBufferOffset) override;
+    void DispatchMeshIndirectCount(VGPUBuffer indirectBuffer, uint64_t indirectBufferOffset, VGPUBuffer countBuffer, uint64_t countBufferOffset, uint32_t maxCount) override;
+
+    // Only issued by the render graph and readback ring, which replay derives on its own.
+    void RequireTextureAccess(VGPUTexture texture, VGPURenderGraphAccess access) override { commandBuffer->RequireTextureAccess(texture, access); }
+    void RequireBufferAccess(VGPUBuffer buffer, VGPURenderGraphAccess access) override { commandBuffer->RequireBufferAccess(buffer, access); }
+    void DiscardTexture(VGPUTexture texture) override { commandBuffer->DiscardTexture(texture); }
+    void DiscardBuffer(VGPUBuffer buffer) override { commandBuffer->DiscardBuffer(buffer); }
+    void RequireHostRead(VGPUBuffer buffer) override { commandBuffer->RequireHostRead(buffer); }
+
+    VGPUCommandBuffer commandBuffer = nullptr;
+    std::string label;
+    bool recording = false;
+    VGPUCaptureWriter stream;
+
+private:
+    struct Allocation
+    {
+        uint64_t size;
+        const void* data;
+        size_t streamOffset;
+    };
+
+    void WriteObject(const void* object);
+    void WriteBuffer(VGPUBuffer buffer, uint64_t offset);
+    void WriteBufferLocation(const VGPUBufferCopyLocation* location);
+    void WriteTextureLocation(const VGPUTextureCopyLocation* location);
+
+    CaptureRecorder* recorder;
+    std::vector<Allocation> allocations;
+    // Start of each allocation to its index, maps buffer references back to the allocation they point into.
+    std::map<std::pair<uintptr_t, uint64_t>, uint32_t> allocationRanges;
+};
+
+class CaptureRecorder final : public VGPUCaptureRecorder
+{
+public:
+    CaptureRecorder(FILE* file_, VGPUBackend backend);
+    ~CaptureRecorder() override;
+
+    void CreateBuffer(VGPUBuffer buffer, const VGPUBufferDesc* desc, const void* pInitialData) override;
+    void CreateTexture(VGPUTexture texture, const VGPUTextureDesc* desc, const VGPUTextureData* pInitialData) override;
+    void CreateSampler(VGPUSampler sampler, const VGPUSamplerDesc* desc) override;
+    void CreateBindGroupLayout(VGPUBindGroupLayout layout, const VGPUBindGroupLayoutDesc* desc) override;
+    void CreatePipelineLayout(VGPUPipelineLayout layout, const VGPUPipelineLayoutDesc* desc) override;
+    void CreateBindGroup(VGPUBindGroup bindGroup, VGPUBindGroupLayout layout, const VGPUBindGroupDesc* desc) override;
+    void CreateRenderPipeline(VGPUPipeline pipeline, const VGPURenderPipelineDesc* desc) override;
+    void CreateComputePipeline(VGPUPipeline pipeline, const VGPUComputePipelineDesc* desc) override;
+    void CreateQueryHeap(VGPUQueryHeap queryHeap, const VGPUQueryHeapDesc* desc) override;
+    void CreateSwapChain(VGPUSwapChain swapChain, const VGPUSwapChainDesc* desc) override;
+    void WaitIdle() override;
+
+    VGPUCommandBuffer BeginCommandBuffer(VGPUCommandBuffer commandBuffer, const char* label) override;
+    void Submit(VGPUCommandBuffer* commandBuffers, uint32_t count) override;
+    bool HasPendingCommandBuffers() override;
+    bool Finish() override;
+
+    uint32_t GetId(const void* object);
+    // Swapchain textures are only seen once acquired.
+    uint32_t GetOrRegisterId(const void* object);
+
+private:
+    struct MappedBuffer
+    {
+        VGPUBuffer buffer;
+        uint32_t id;
+        uint64_t hash;
+    };
+
+    uint32_t RegisterLocked(const void* object);
+    uint32_t GetIdLocked(const void* object) const;
+    void BeginPacketLocked();
+    void WritePacketLocked(VGPUCaptureOp op);
+    void WriteChangedBuffersLocked();
+
+    FILE* file;
+    std::mutex mutex;
+    std::unordered_map<const void*, uint32_t> ids;
+    uint32_t nextId = 1;
+    std::vector<std::unique_ptr<CaptureCommandBuffer>> commandBuffers;
+    // Referenced until the capture ends so their contents can be compared at every submit.
+    std::vector<MappedBuffer> mappedBuffers;
+    VGPUCaptureWriter payload;
+};
+
+/* CaptureCommandBuffer */
+void CaptureCommandBuffer::Begin(VGPUCommandBuffer commandBuffer_, const char* label_)
+{
+    commandBuffer = commandBuffer_;
+    label = label_ ? label_ : "";
+    recording = true;
+    stream.Clear();
+    allocations.clear();
+    allocationRanges.clear();
+}
+
+void CaptureCommandBuffer::Finish()
+{
+    for (const Allocation& allocation : allocations)
+    {
+        memcpy(stream.data.data() + allocation.streamOffset, allocation.data, allocation.size);
+    }
+}
+
+void CaptureCommandBuffer::WriteObject(const void* object)
+{
+    stream.Write(recorder->GetId(object));
+}
+
+void CaptureCommandBuffer::WriteBuffer(VGPUBuffer buffer, uint64_t offset)
+{
+    uint32_t id = recorder->GetId(buffer);
+    if (id == VGPU_CAPTURE_UNKNOWN_ID && !allocationRanges.empty())
+    {
+        auto it = allocationRanges.upper_bound({ (uintptr_t)buffer, offset });
+        if (it != allocationRanges.begin())
+        {
+            --it;
+            const uint64_t start = it->first.second;
+            if (it->first.first == (uintptr_t)buffer && offset < start + allocations[it->second].size)
+            {
+                id = VGPU_CAPTURE_ALLOCATION_BIT | it->second;
+                offset -= start;
+            }
+        }
+    }
+
+    stream.Write(id);
+    stream.Write(offset);
+}
+
+void CaptureCommandBuffer::WriteBufferLocation(const VGPUBufferCopyLocation* location)
+{
+    WriteBuffer(location->buffer, location->offset);
+    stream.Write(location->bytesPerRow);
+    stream.Write(location->rowsPerImage);
+}
+
+void CaptureCommandBuffer::WriteTextureLocation(const VGPUTextureCopyLocation* location)
+{
+    WriteObject(location->texture);
+    stream.Write(location->mipLevel);
+    stream.Write(location->arrayLayer);
+    stream.Write(location->origin);
+}
+
+void CaptureCommandBuffer::PushDebugGroup(const char* groupLabel)
+{
+    stream.Write(VGPUCaptureCommand::PushDebugGroup);
+    stream.WriteString(groupLabel);
+    commandBuffer->PushDebugGroup(groupLabel);
+}
+
+void CaptureCommandBuffer::PopDebugGroup()
+{
+    stream.Write(VGPUCaptureCommand::PopDebugGroup);
+    commandBuffer->PopDebugGroup();
+}
+
+void CaptureCommandBuffer::InsertDebugMarker(const char* markerLabel)
+{
+    stream.Write(VGPUCaptureCommand::InsertDebugMarker);
+    stream.WriteString(markerLabel);
+    commandBuffer->InsertDebugMarker(markerLabel);
+}
+
+void CaptureCommandBuffer::ClearBuffer(VGPUBuffer buffer, uint64_t offset, uint64_t size)
+{
+    stream.Write(VGPUCaptureCommand::ClearBuffer);
+    WriteBuffer(buffer, offset);
+    stream.Write(size);
+    commandBuffer->ClearBuffer(buffer, offset, size);
+}
+
+VGPUBufferAllocation CaptureCommandBuffer::Allocate(uint64_t size, uint64_t alignment)
+{
+    VGPUBufferAllocation allocation = commandBuffer->Allocate(size, alignment);
+    if (allocation.data == nullptr)
+        size = 0;
+
+    stream.Write(VGPUCaptureCommand::Allocate);
+    stream.Write(size);
+    stream.Write(alignment);
+
+    if (size > 0)
+    {
+        allocationRanges[{ (uintptr_t)allocation.buffer, allocation.offset }] = (uint32_t)allocations.size();
+        allocations.push_back({ size, allocation.data, stream.Reserve(size) });
+    }
+
+    return allocation;
+}
+
+void CaptureCommandBuffer::CopyBufferToBuffer(VGPUBuffer source, uint64_t sourceOffset, VGPUBuffer destination, uint64_t destinationOffset, uint64_t size)
+{
+    stream.Write(VGPUCaptureCommand::CopyBufferToBuffer);
+    WriteBuffer(source, sourceOffset);
+    WriteBuffer(destination, destinationOffset);
+    stream.Write(size);
+    commandBuffer->CopyBufferToBuffer(source, sourceOffset, destination, destinationOffset, size);
+}
+
+void CaptureCommandBuffer::CopyBufferToTexture(const VGPUBufferCopyLocation* source, const VGPUTextureCopyLocation* destination, const VGPUExtent3D* extent)
+{
+    stream.Write(VGPUCaptureCommand::CopyBufferToTexture);
+    WriteBufferLocation(source);
+    WriteTextureLocation(destination);
+    stream.Write(*extent);
+    commandBuffer->CopyBufferToTexture(source, destination, extent);
+}
+
+void CaptureCommandBuffer::CopyTextureToBuffer(const VGPUTextureCopyLocation* source, const VGPUBufferCopyLocation* destination, const VGPUExtent3D* extent)
+{
+    stream.Write(VGPUCaptureCommand::CopyTextureToBuffer);
+    WriteTextureLocation(source);
+    WriteBufferLocation(destination);
+    stream.Write(*extent);
+    commandBuffer->CopyTextureToBuffer(source, destination, extent);
+}
+
+void CaptureCommandBuffer::CopyTextureToTexture(const VGPUTextureCopyLocation* source, const VGPUTextureCopyLocation* destination, const VGPUExtent3D* extent)
+{
+    stream.Write(VGPUCaptureCommand::CopyTextureToTexture);
+    WriteTextureLocation(source);
+    WriteTextureLocation(destination);
+    stream.Write(*extent);
+    commandBuffer->CopyTextureToTexture(source, destination, extent);
+}
+
+void CaptureCommandBuffer::SetPipeline(VGPUPipeline pipeline)
+{
+    stream.Write(VGPUCaptureCommand::SetPipeline);
+    WriteObject(pipeline);
+    commandBuffer->SetPipeline(pipeline);
+}
+
+void CaptureCommandBuffer::SetBindGroup(uint32_t groupIndex, VGPUBindGroup bindGroup)
+{
+    stream.Write(VGPUCaptureCommand::SetBindGroup);
+    stream.Write(groupIndex);
+    WriteObject(bindGroup);
+    commandBuffer->SetBindGroup(groupIndex, bindGroup);
+}
+
+void CaptureCommandBuffer::SetPushConstants(uint32_t pushConstantIndex, const void* data, uint32_t size)
+{
+    stream.Write(VGPUCaptureCommand::SetPushConstants);
+    stream.Write(pushConstantIndex);
+    stream.Write(size);
+    stream.WriteBytes(data, size);
+    commandBuffer->SetPushConstants(pushConstantIndex, data, size);
+}
+
+void CaptureCommandBuffer::Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+    stream.Write(VGPUCaptureCommand::Dispatch);
+    stream.Write(groupCountX);
+    stream.Write(groupCountY);
+    stream.Write(groupCountZ);
+    commandBuffer->Dispatch(groupCountX, groupCountY, groupCountZ);
+}
+
+void CaptureCommandBuffer::DispatchIndirect(VGPUBuffer buffer, uint64_t offset)
+{
+    stream.Write(VGPUCaptureCommand::DispatchIndirect);
+    WriteBuffer(buffer, offset);
+    commandBuffer->DispatchIndirect(buffer, offset);
+}
+
+VGPUTexture CaptureCommandBuffer::AcquireSwapchainTexture(VGPUSwapChain swapChain)
+{
+    VGPUTexture texture = commandBuffer->AcquireSwapchainTexture(swapChain);
+
+    stream.Write(VGPUCaptureCommand::AcquireSwapchainTexture);
+    WriteObject(swapChain);
+    stream.Write(recorder->GetOrRegisterId(texture));
+    return texture;
+}
+
+void CaptureCommandBuffer::BeginRenderPass(const VGPURenderPassDesc* desc)
+{
+    stream.Write(VGPUCaptureCommand::BeginRenderPass);
+    stream.WriteString(desc->label);
+    stream.Write(desc->colorAttachmentCount);
+    for (uint32_t i = 0; i < desc->colorAttachmentCount; ++i)
+    {
+        VGPURenderPassColorAttachment attachment = desc->colorAttachments[i];
+        WriteObject(attachment.texture);
+        WriteObject(attachment.resolveTexture);
+        attachment.texture = nullptr;
+        attachment.resolveTexture = nullptr;
+        stream.Write(attachment);
+    }
+
+    stream.Write<uint8_t>(desc->depthStencilAttachment != nullptr);
+    if (desc->depthStencilAttachment != nullptr)
+    {
+        VGPURenderPassDepthStencilAttachment attachment = *desc->depthStencilAttachment;
+        WriteObject(attachment.texture);
+        attachment.texture = nullptr;
+        stream.Write(attachment);
+    }
+
+    commandBuffer->BeginRenderPass(desc);
+}
+
+void CaptureCommandBuffer::EndRenderPass()
+{
+    stream.Write(VGPUCaptureCommand::EndRenderPass);
+    commandBuffer->EndRenderPass();
+}
+
+void CaptureCommandBuffer::SetViewport(const VGPUViewport* viewport)
+{
+    stream.Write(VGPUCaptureCommand::SetViewport);
+    stream.Write(*viewport);
+    commandBuffer->SetViewport(viewport);
+}
+
+void CaptureCommandBuffer::SetViewports(uint32_t count, const VGPUViewport* viewports)
+{
+    stream.Write(VGPUCaptureCommand::SetViewports);
+    stream.Write(count);
+    stream.WriteBytes(viewports, count * sizeof(VGPUViewport));
+    commandBuffer->SetViewports(count, viewports);
+}
+
+void CaptureCommandBuffer::SetScissorRect(const VGPURect* rect)
+{
+    stream.Write(VGPUCaptureCommand::SetScissorRect);
+    stream.Write(*rect);
+    commandBuffer->SetScissorRect(rect);
+}
+
+void CaptureCommandBuffer::SetScissorRects(uint32_t count, const VGPURect* rects)
+{
+    stream.Write(VGPUCaptureCommand::SetScissorRects);
+    stream.Write(count);
+    stream.WriteBytes(rects, count * sizeof(VGPURect));
+    commandBuffer->SetScissorRects(count, rects);
+}
+
+void CaptureCommandBuffer::SetVertexBuffer(uint32_t index, VGPUBuffer buffer, uint64_t offset)
+{
+    stream.Write(VGPUCaptureCommand::SetVertexBuffer);
+    stream.Write(index);
+    WriteBuffer(buffer, offset);
+    commandBuffer->SetVertexBuffer(index, buffer, offset);
+}
+
+void CaptureCommandBuffer::SetIndexBuffer(VGPUBuffer buffer, VGPUIndexType type, uint64_t offset)
+{
+    stream.Write(VGPUCaptureCommand::SetIndexBuffer);
+    WriteBuffer(buffer, offset);
+    stream.Write(type);
+    commandBuffer->SetIndexBuffer(buffer, type, offset);
+}
+
+void CaptureCommandBuffer::SetStencilReference(uint32_t reference)
+{
+    stream.Write(VGPUCaptureCommand::SetStencilReference);
+    stream.Write(reference);
+    commandBuffer->SetStencilReference(reference);
+}
+
+void CaptureCommandBuffer::BeginQuery(VGPUQueryHeap heap, uint32_t index)
+{
+    stream.Write(VGPUCaptureCommand::BeginQuery);
+    WriteObject(heap);
+    stream.Write(index);
+    commandBuffer->BeginQuery(heap, index);
+}
+
+void CaptureCommandBuffer::EndQuery(VGPUQueryHeap heap, uint32_t index)
+{
+    stream.Write(VGPUCaptureCommand::EndQuery);
+    WriteObject(heap);
+    stream.Write(index);
+    commandBuffer->EndQuery(heap, index);
+}
+
+void CaptureCommandBuffer::ResolveQuery(VGPUQueryHeap heap, uint32_t index, uint32_t count, VGPUBuffer destinationBuffer, uint64_t destinationOffset)
+{
+    stream.Write(VGPUCaptureCommand::ResolveQuery);
+    WriteObject(heap);
+    stream.Write(index);
+    stream.Write(count);
+    WriteBuffer(destinationBuffer, destinationOffset);
+    commandBuffer->ResolveQuery(heap, index, count, destinationBuffer, destinationOffset);
+}
+
+void CaptureCommandBuffer::ResetQuery(VGPUQueryHeap heap, uint32_t index, uint32_t count)
+{
+    stream.Write(VGPUCaptureCommand::ResetQuery);
+    WriteObject(heap);
+    stream.Write(index);
+    stream.Write(count);
+    commandBuffer->ResetQuery(heap, index, count);
+}
+
+void CaptureCommandBuffer::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+{
+    stream.Write(VGPUCaptureCommand::Draw);
+    stream.Write(vertexCount);
+    stream.Write(instanceCount);
+    stream.Write(firstVertex);
+    stream.Write(firstInstance);
+    commandBuffer->Draw(vertexCount, instanceCount, firstVertex, firstInstance);
+}
+
+void CaptureCommandBuffer::DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t baseVertex, uint32_t firstInstance)
+{
+    stream.Write(VGPUCaptureCommand::DrawIndexed);
+    stream.Write(indexCount);
+    stream.Write(instanceCount);
+    stream.Write(firstIndex);
+    stream.Write(baseVertex);
+    stream.Write(firstInstance);
+    commandBuffer->DrawIndexed(indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
+}
+
+void CaptureCommandBuffer::DrawIndirect(VGPUBuffer indirectBuffer, uint64_t indirectBufferOffset)
+{
+    stream.Write(VGPUCaptureCommand::DrawIndirect);
+    WriteBuffer(indirectBuffer, indirectBufferOffset);
+    commandBuffer->DrawIndirect(indirectBuffer, indirectBufferOffset);
+}
+
+void CaptureCommandBuffer::DrawIndexedIndirect(VGPUBuffer indirectBuffer, uint64_t indirectBufferOffset)
+{
+    stream.Write(VGPUCaptureCommand::DrawIndexedIndirect);
+    WriteBuffer(indirectBuffer, indirectBufferOffset);
+    commandBuffer->DrawIndexedIndirect(indirectBuffer, indirectBufferOffset);
+}
+
+void CaptureCommandBuffer::DispatchMesh(uint32_t threadGroupCountX, uint32_t threadGroupCountY, uint32_t threadGroupCountZ)
+{
+    stream.Write(VGPUCaptureCommand::DispatchMesh);
+    stream.Write(threadGroupCountX);
+    stream.Write(threadGroupCountY);
+    stream.Write(threadGroupCountZ);
+    commandBuffer->DispatchMesh(threadGroupCountX, threadGroupCountY, threadGroupCountZ);
+}
+
+void CaptureCommandBuffer::DispatchMeshIndirect(VGPUBuffer indirectBuffer, uint64_t indirectBufferOffset)
+{
+    stream.Write(VGPUCaptureCommand::DispatchMeshIndirect);
+    WriteBuffer(indirectBuffer, indirectBufferOffset);
+    commandBuffer->DispatchMeshIndirect(indirectBuffer, indirectBufferOffset);
+}
+
+void CaptureCommandBuffer::DispatchMeshIndirectCount(VGPUBuffer indirectBuffer, uint64_t indirectBufferOffset, VGPUBuffer countBuffer, uint64_t countBufferOffset, uint32_t maxCount)
+{
+    stream.Write(VGPUCaptureCommand::DispatchMeshIndirectCount);
+    WriteBuffer(indirectBuffer, indirectBufferOffset);
+    WriteBuffer(countBuffer, countBufferOffset);
+    stream.Write(maxCount);
+    commandBuffer->DispatchMeshIndirectCount(indirectBuffer, indirectBufferOffset, countBuffer, countBufferOffset, maxCount);
+}
+
+/* CaptureRecorder */
+CaptureRecorder::CaptureRecorder(FILE* file_, VGPUBackend backend)
+    : file(file_)
+{
+    VGPUCaptureHeader header{};
+    header.magic = VGPU_CAPTURE_MAGIC;
+    header.version = VGPU_CAPTURE_VERSION;
+    header.backend = backend;
+    fwrite(&header, sizeof(header), 1, file);
+}
+
+CaptureRecorder::~CaptureRecorder()
+{
+    for (const MappedBuffer& mappedBuffer : mappedBuffers)
+    {
+        mappedBuffer.buffer->Release();
+    }
+
+    if (file)
+        fclose(file);
+}
+
+uint32_t CaptureRecorder::RegisterLocked(const void* object)
+{
+    // Addresses of destroyed objects are reused, the latest creation wins.
+    const uint32_t id = nextId++;
+    ids[object] = id;
+    return id;
+}
+
+uint32_t CaptureRecorder::GetIdLocked(const void* object) const
+{
+    if (object == nullptr)
+        return VGPU_CAPTURE_NULL_ID;
+
+    auto it = ids.find(object);
+    return it != ids.end() ? it->second : VGPU_CAPTURE_UNKNOWN_ID;
+}
+
+uint32_t CaptureRecorder::GetId(const void* object)
+{
+    std::scoped_lock lock(mutex);
+    return GetIdLocked(object);
+}
+
+uint32_t CaptureRecorder::GetOrRegisterId(const void* object)
+{
+    std::scoped_lock lock(mutex);
+    const uint32_t id = GetIdLocked(object);
+    return id != VGPU_CAPTURE_UNKNOWN_ID ? id : RegisterLocked(object);
+}
+
+void CaptureRecorder::BeginPacketLocked()
+{
+    payload.Clear();
+}
+
+void CaptureRecorder::WritePacketLocked(VGPUCaptureOp op)
+{
+    // Calls that raced with vgpuDeviceEndCapture still hold the recorder after Finish closed the file.
+    if (file == nullptr)
+        return;
+
+    if (payload.data.size() > UINT32_MAX)
+    {
+        vgpuLogError("Capture packet larger than 4GB dropped");
+        return;
+    }
+
+    const uint32_t size = (uint32_t)payload.data.size();
+    fwrite(&op, sizeof(op), 1, file);
+    fwrite(&size, sizeof(size), 1, file);
+    fwrite(payload.data.data(), 1, size, file);
+}
+
+void CaptureRecorder::WriteChangedBuffersLocked()
+{
+    for (MappedBuffer& mappedBuffer : mappedBuffers)
+    {
+        const void* data = mappedBuffer.buffer->GetMappedData();
+        const uint64_t size = mappedBuffer.buffer->GetSize();
+        const uint64_t hash = HashMemory(data, size);
+        if (hash == mappedBuffer.hash)
+            continue;
+
+        mappedBuffer.hash = hash;
+
+        BeginPacketLocked();
+        payload.Write(mappedBuffer.id);
+        payload.Write(size);
+        payload.WriteBytes(data, size);
+        WritePacketLocked(VGPUCaptureOp::WriteBuffer);
+    }
+}
+
+void CaptureRecorder::CreateBuffer(VGPUBuffer buffer, const VGPUBufferDesc* desc, const void* pInitialData)
+{
+    std::scoped_lock lock(mutex);
+    const uint32_t id = RegisterLocked(buffer);
+
+    VGPUBufferDesc bufferDesc = *desc;
+    bufferDesc.label = nullptr;
+    bufferDesc.existingHandle = nullptr;
+
+    BeginPacketLocked();
+    payload.Write(id);
+    payload.Write(bufferDesc);
+    payload.WriteString(desc->label);
+    payload.Write<uint8_t>(pInitialData != nullptr);
+    if (pInitialData != nullptr)
+        payload.WriteBytes(pInitialData, desc->size);
+    WritePacketLocked(VGPUCaptureOp::CreateBuffer);
+
+    if (desc->cpuAccess == VGPUCpuAccessMode_Write && buffer->GetMappedData() != nullptr)
+    {
+        buffer->AddRef();
+        mappedBuffers.push_back({ buffer, id, HashMemory(buffer->GetMappedData(), desc->size) });
+    }
+}
+
+void CaptureRecorder::CreateTexture(VGPUTexture texture, const VGPUTextureDesc* desc, const VGPUTextureData* pInitialData)
+{
+    std::scoped_lock lock(mutex);
+    const uint32_t id = RegisterLocked(texture);
+
+    VGPUTextureDesc textureDesc = *desc;
+    textureDesc.label = nullptr;
+
+    BeginPacketLocked();
+    payload.Write(id);
+    payload.Write(textureDesc);
+    payload.WriteString(desc->label);
+
+    if (pInitialData == nullptr)
+    {
+        payload.Write<uint32_t>(0u);
+        WritePacketLocked(VGPUCaptureOp::CreateTexture);
+        return;
+    }
+
+    // Subresources are stored tightly packed in the order backends consume VGPUTextureData: layers, then mips.
+    const bool is3D = desc->dimension == VGPUTextureDimension_3D;
+    const uint32_t arrayLayers = is3D ? 1u : desc->depthOrArrayLayers;
+
+    VGPUPixelFormatInfo formatInfo;
+    vgpuGetPixelFormatInfo(desc->format, &formatInfo);
+
+    payload.Write<uint32_t>(arrayLayers * desc->mipLevelCount);
+    uint32_t subresource = 0;
+    for (uint32_t arrayIndex = 0; arrayIndex < arrayLayers; ++arrayIndex)
+    {
+        for (uint32_t mipIndex = 0; mipIndex < desc->mipLevelCount; ++mipIndex)
+        {
+            const VGPUTextureData& data = pInitialData[subresource++];
+            const uint32_t levelWidth = _VGPU_MAX(1u, desc->width >> mipIndex);
+            const uint32_t levelHeight = _VGPU_MAX(1u, desc->height >> mipIndex);
+            const uint32_t levelDepth = is3D ? _VGPU_MAX(1u, desc->depthOrArrayLayers >> mipIndex) : 1u;
+            const uint32_t numBlocksX = _VGPU_MAX(1u, levelWidth / formatInfo.blockWidth);
+            const uint32_t numBlocksY = _VGPU_MAX(1u, levelHeight / formatInfo.blockHeight);
+            const uint32_t rowPitch = numBlocksX * formatInfo.bytesPerBlock;
+
+            payload.Write(rowPitch);
+            payload.Write(rowPitch * numBlocksY);
+            for (uint32_t z = 0; z < levelDepth; ++z)
+            {
+                const uint8_t* slice = static_cast<const uint8_t*>(data.pData) + (size_t)data.slicePitch * z;
+                for (uint32_t y = 0; y < numBlocksY; ++y)
+                {
+                    payload.WriteBytes(slice + (size_t)data.rowPitch * y, rowPitch);
+                }
+            }
+        }
+    }
+
+    WritePacketLocked(VGPUCaptureOp::CreateTexture);
+}
+
+void CaptureRecorder::CreateSampler(VGPUSampler sampler, const VGPUSamplerDesc* desc)
+{
+    std::scoped_lock lock(mutex);
+
+    VGPUSamplerDesc samplerDesc = *desc;
+    samplerDesc.label = nullptr;
+
+    BeginPacketLocked();
+    payload.Write(RegisterLocked(sampler));
+    payload.Write(samplerDesc);
+    payload.WriteString(desc->label);
+    WritePacketLocked(VGPUCaptureOp::CreateSampler);
+}
+
+void CaptureRecorder::CreateBindGroupLayout(VGPUBindGroupLayout layout, const VGPUBindGroupLayoutDesc* desc)
+{
+    std::scoped_lock lock(mutex);
+
+    BeginPacketLocked();
+    payload.Write(RegisterLocked(layout));
+    payload.WriteString(desc->label);
+    payload.Write<uint32_t>((uint32_t)desc->entryCount);
+    payload.WriteBytes(desc->entries, desc->entryCount * sizeof(VGPUBindGroupLayoutEntry));
+    WritePacketLocked(VGPUCaptureOp::CreateBindGroupLayout);
+}
+
+void CaptureRecorder::CreatePipelineLayout(VGPUPipelineLayout layout, const VGPUPipelineLayoutDesc* desc)
+{
+    std::scoped_lock lock(mutex);
+
+    BeginPacketLocked();
+    payload.Write(RegisterLocked(layout));
+    payload.WriteString(desc->label);
+    payload.Write<uint32_t>((uint32_t)desc->bindGroupLayoutCount);
+    for (size_t i = 0; i < desc->bindGroupLayoutCount; ++i)
+    {
+        payload.Write(GetIdLocked(desc->bindGroupLayouts[i]));
+    }
+    payload.Write(desc->pushConstantRangeCount);
+    payload.WriteBytes(desc->pushConstantRanges, desc->pushConstantRangeCount * sizeof(VGPUPushConstantRange));
+    payload.Write(desc->bindless);
+    WritePacketLocked(VGPUCaptureOp::CreatePipelineLayout);
+}
+
+void CaptureRecorder::CreateBindGroup(VGPUBindGroup bindGroup, VGPUBindGroupLayout layout, const VGPUBindGroupDesc* desc)
+{
+    std::scoped_lock lock(mutex);
+
+    BeginPacketLocked();
+    payload.Write(RegisterLocked(bindGroup));
+    payload.Write(GetIdLocked(layout));
+    payload.WriteString(desc->label);
+    payload.Write<uint32_t>((uint32_t)desc->entryCount);
+    for (size_t i = 0; i < desc->entryCount; ++i)
+    {
+        const VGPUBindGroupEntry& entry = desc->entries[i];
+        payload.Write(entry.binding);
+        payload.Write(entry.arrayElement);
+        payload.Write(GetIdLocked(entry.buffer));
+        payload.Write(entry.offset);
+        payload.Write(entry.size);
+        payload.Write(GetIdLocked(entry.sampler));
+    }
+    WritePacketLocked(VGPUCaptureOp::CreateBindGroup);
+}
+
+void CaptureRecorder::CreateRenderPipeline(VGPUPipeline pipeline, const VGPURenderPipelineDesc* desc)
+{
+    std::scoped_lock lock(mutex);
+
+    BeginPacketLocked();
+    payload.Write(RegisterLocked(pipeline));
+    payload.WriteString(desc->label);
+    payload.Write(GetIdLocked(desc->layout));
+
+    payload.Write(desc->shaderStageCount);
+    for (uint32_t i = 0; i < desc->shaderStageCount; ++i)
+    {
+        WriteShaderStage(payload, desc->shaderStages[i]);
+    }
+
+    payload.Write(desc->vertex.layoutCount);
+    for (uint32_t i = 0; i < desc->vertex.layoutCount; ++i)
+    {
+        const VGPUVertexBufferLayout& layout = desc->vertex.layouts[i];
+        payload.Write(layout.stride);
+        payload.Write(layout.stepMode);
+        payload.Write(layout.attributeCount);
+        payload.WriteBytes(layout.attributes, layout.attributeCount * sizeof(VGPUVertexAttribute));
+    }
+
+    payload.Write(desc->blendState);
+    payload.Write(desc->rasterizerState);
+    payload.Write(desc->depthStencilState);
+    payload.Write(desc->primitiveTopology);
+    payload.Write(desc->patchControlPoints);
+    payload.Write(desc->colorFormatCount);
+    payload.WriteBytes(desc->colorFormats, desc->colorFormatCount * sizeof(VGPUTextureFormat));
+    payload.Write(desc->depthStencilFormat);
+    payload.Write(desc->sampleCount);
+    WritePacketLocked(VGPUCaptureOp::CreateRenderPipeline);
+}
+
+void CaptureRecorder::CreateComputePipeline(VGPUPipeline pipeline, const VGPUComputePipelineDesc* desc)
+{
+    std::scoped_lock lock(mutex);
+
+    BeginPacketLocked();
+    payload.Write(RegisterLocked(pipeline));
+    payload.WriteString(desc->label);
+    payload.Write(GetIdLocked(desc->layout));
+    WriteShaderStage(payload, desc->shader);
+    WritePacketLocked(VGPUCaptureOp::CreateComputePipeline);
+}
+
+void CaptureRecorder::CreateQueryHeap(VGPUQueryHeap queryHeap, const VGPUQueryHeapDesc* desc)
+{
+    std::scoped_lock lock(mutex);
+
+    VGPUQueryHeapDesc queryHeapDesc = *desc;
+    queryHeapDesc.label = nullptr;
+
+    BeginPacketLocked();
+    payload.Write(RegisterLocked(queryHeap));
+    payload.Write(queryHeapDesc);
+    payload.WriteString(desc->label);
+    WritePacketLocked(VGPUCaptureOp::CreateQueryHeap);
+}
+
+void CaptureRecorder::CreateSwapChain(VGPUSwapChain swapChain, const VGPUSwapChainDesc* desc)
+{
+    std::scoped_lock lock(mutex);
+
+    BeginPacketLocked();
+    payload.Write(RegisterLocked(swapChain));
+    payload.Write(swapChain->GetWidth());
+    payload.Write(swapChain->GetHeight());
+    payload.Write(desc->format);
+    WritePacketLocked(VGPUCaptureOp::CreateSwapChain);
+}
+
+void CaptureRecorder::WaitIdle()
+{
+    std::scoped_lock lock(mutex);
+
+    BeginPacketLocked();
+    WritePacketLocked(VGPUCaptureOp::WaitIdle);
+}
+
+VGPUCommandBuffer CaptureRecorder::BeginCommandBuffer(VGPUCommandBuffer commandBuffer, const char* label)
+{
+    std::scoped_lock lock(mutex);
+
+    CaptureCommandBuffer* captureCommandBuffer = nullptr;
+    for (const std::unique_ptr<CaptureCommandBuffer>& pooled : commandBuffers)
+    {
+        if (!pooled->recording)
+        {
+            captureCommandBuffer = pooled.get();
+            break;
+        }
+    }
+
+    if (captureCommandBuffer == nullptr)
+    {
+        commandBuffers.push_back(std::make_unique<CaptureCommandBuffer>(this));
+        captureCommandBuffer = commandBuffers.back().get();
+    }
+
+    captureCommandBuffer->Begin(commandBuffer, label);
+    return captureCommandBuffer;
+}
+
+void CaptureRecorder::Submit(VGPUCommandBuffer* submitCommandBuffers, uint32_t count)
+{
+    std::scoped_lock lock(mutex);
+
+    // Mapped writes of this frame must be in place before the commands that read them.
+    WriteChangedBuffersLocked();
+
+    BeginPacketLocked();
+    const size_t countOffset = payload.Reserve(sizeof(uint32_t));
+    uint32_t capturedCount = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        CaptureCommandBuffer* captureCommandBuffer = nullptr;
+        for (const std::unique_ptr<CaptureCommandBuffer>& pooled : commandBuffers)
+        {
+            if (pooled.get() == submitCommandBuffers[i] && pooled->recording)
+            {
+                captureCommandBuffer = pooled.get();
+                break;
+            }
+        }
+
+        // Begun before the capture started.
+        if (captureCommandBuffer == nullptr)
+            continue;
+
+        captureCommandBuffer->Finish();
+        payload.Write(captureCommandBuffer->GetQueueType());
+        payload.WriteString(captureCommandBuffer->label.c_str());
+        payload.Write<uint64_t>(captureCommandBuffer->stream.data.size());
+        payload.WriteBytes(captureCommandBuffer->stream.data.data(), captureCommandBuffer->stream.data.size());
+
+        submitCommandBuffers[i] = captureCommandBuffer->commandBuffer;
+        captureCommandBuffer->recording = false;
+        capturedCount++;
+    }
+
+    memcpy(payload.data.data() + countOffset, &capturedCount, sizeof(capturedCount));
+    WritePacketLocked(VGPUCaptureOp::Submit);
+}
+
+bool CaptureRecorder::HasPendingCommandBuffers()
+{
+    std::scoped_lock lock(mutex);
+
+    for (const std::unique_ptr<CaptureCommandBuffer>& pooled : commandBuffers)
+    {
+        if (pooled->recording)
+            return true;
+    }
+
+    return false;
+}
+
+bool CaptureRecorder::Finish()
+{
+    std::scoped_lock lock(mutex);
+
+    const bool written = fflush(file) == 0 && ferror(file) == 0;
+    fclose(file);
+    file = nullptr;
+
+    if (!written)
+        vgpuLogError("Failed to write capture file");
+
+    return written;
+}
+
+VGPUCaptureRecorder* CreateCaptureRecorder(const char* path, VGPUBackend backend)
+{
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr)
+    {
+        vgpuLogError("Failed to create capture file '%s'", path);
+        return nullptr;
+    }
+
+    return new CaptureRecorder(file, backend);
+}
@@ -0,0 +1,197 @@
+// Copyright (c) Amer Koleci and Contributors.
+// Licensed under the MIT License (MIT). See LICENSE in the repository root for more information.
+
+#ifndef _VGPU_CAPTURE_H_
+#define _VGPU_CAPTURE_H_
+
+#include "vgpu.h"
+#include <string.h>
+#include <type_traits>
+#include <vector>
+
+/// Binary stream written between vgpuDeviceBeginCapture and vgpuDeviceEndCapture and replayed by tools/vgpu_replay.
+/// A VGPUCaptureHeader is followed by packets of [uint32 op, uint32 payload size, payload]. Submit packets carry the
+/// command buffer contents as [uint8 command, arguments] sequences.
+/// Objects are referred to by the id assigned when they were created, pointer free structs are stored as raw bytes,
+/// so a stream only replays with the vgpu version that captured it.
+#define VGPU_CAPTURE_MAGIC (0x50434756u) /* "VGCP" */
+#define VGPU_CAPTURE_VERSION (1u)
+
+/// Id of null objects.
+#define VGPU_CAPTURE_NULL_ID (0u)
+/// Id of objects created before the capture began or internally by vgpu, commands using them are skipped on replay.
+#define VGPU_CAPTURE_UNKNOWN_ID (0xFFFFFFFFu)
+/// Buffer ids with this bit refer to the n-th vgpuCommandBufferAllocate of the same command buffer.
+#define VGPU_CAPTURE_ALLOCATION_BIT (0x80000000u)
+
+struct VGPUCaptureHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    VGPUBackend backend;
+    uint32_t reserved;
+};
+
+enum class VGPUCaptureOp : uint32_t
+{
+    CreateBuffer = 1,
+    CreateTexture,
+    CreateSampler,
+    CreateBindGroupLayout,
+    CreatePipelineLayout,
+    CreateBindGroup,
+    CreateRenderPipeline,
+    CreateComputePipeline,
+    CreateQueryHeap,
+    // Replayed as an offscreen texture, vgpu_replay never opens a window.
+    CreateSwapChain,
+    // Contents of a host writable buffer that changed since the previous submit.
+    WriteBuffer,
+    Submit,
+    WaitIdle,
+};
+
+enum class VGPUCaptureCommand : uint8_t
+{
+    PushDebugGroup = 1,
+    PopDebugGroup,
+    InsertDebugMarker,
+    ClearBuffer,
+    // Followed by the bytes written into the allocation, sampled when the command buffer is submitted.
+    Allocate,
+    CopyBufferToBuffer,
+    CopyBufferToTexture,
+    CopyTextureToBuffer,
+    CopyTextureToTexture,
+    SetPipeline,
+    SetBindGroup,
+    SetPushConstants,
+    Dispatch,
+    DispatchIndirect,
+    AcquireSwapchainTexture,
+    BeginRenderPass,
+    EndRenderPass,
+    SetViewport,
+    SetViewports,
+    SetScissorRect,
+    SetScissorRects,
+    SetVertexBuffer,
+    SetIndexBuffer,
+    SetStencilReference,
+    BeginQuery,
+    EndQuery,
+    ResolveQuery,
+    ResetQuery,
+    Draw,
+    DrawIndexed,
+    DrawIndirect,
+    DrawIndexedIndirect,
+    DispatchMesh,
+    DispatchMeshIndirect,
+    DispatchMeshIndirectCount,
+};
+
+class VGPUCaptureWriter
+{
+public:
+    void WriteBytes(const void* bytes, size_t size)
+    {
+        const uint8_t* begin = static_cast<const uint8_t*>(bytes);
+        data.insert(data.end(), begin, begin + size);
+    }
+
+    template<typename T>
+    void Write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types are written as raw bytes");
+        WriteBytes(&value, sizeof(T));
+    }
+
+    // Length including the terminator, 0 for a null string.
+    void WriteString(const char* text)
+    {
+        if (text == nullptr)
+        {
+            Write<uint32_t>(0u);
+            return;
+        }
+
+        const uint32_t length = (uint32_t)strlen(text) + 1u;
+        Write(length);
+        WriteBytes(text, length);
+    }
+
+    // Returns the offset of size zeroed bytes to be filled in later.
+    size_t Reserve(size_t size)
+    {
+        const size_t offset = data.size();
+        data.resize(offset + size);
+        return offset;
+    }
+
+    void Clear() { data.clear(); }
+
+    std::vector<uint8_t> data;
+};
+
+/// Bounds checked reads, a read past the end returns zeroes and sets HasError.
+class VGPUCaptureReader
+{
+public:
+    VGPUCaptureReader(const uint8_t* data_, size_t size_)
+        : data(data_)
+        , size(size_)
+    {
+    }
+
+    const void* ReadBytes(size_t count)
+    {
+        if (count > size - offset)
+        {
+            error = true;
+            offset = size;
+            return nullptr;
+        }
+
+        const void* bytes = data + offset;
+        offset += count;
+        return bytes;
+    }
+
+    template<typename T>
+    T Read()
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types are read as raw bytes");
+        T value{};
+        if (const void* bytes = ReadBytes(sizeof(T)))
+            memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+
+    const char* ReadString()
+    {
+        const uint32_t length = Read<uint32_t>();
+        if (length == 0)
+            return nullptr;
+
+        const char* text = static_cast<const char*>(ReadBytes(length));
+        if (text == nullptr || text[length - 1] != '\0')
+        {
+            error = true;
+            return nullptr;
+        }
+
+        return text;
+    }
+
+    bool IsEnd() const { return offset == size; }
+    bool HasError() const { return error; }
+
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t offset = 0;
+    bool error = false;
+};
+
+#endif /* _VGPU_CAPTURE_H_ */
@@ -0,0 +1,828 @@
+// Copyright (c) Amer Koleci and Contributors.
+// Licensed under the MIT License (MIT). See LICENSE in the repository root for more information.
+
+#include "vgpu_driver.h"
+#include <memory>
+#include <type_traits>
+
+namespace
+{
+    enum class DeferredCommand : uint32_t
+    {
+        PushDebugGroup,
+        PopDebugGroup,
+        InsertDebugMarker,
+        ClearBuffer,
+        CopyBufferToBuffer,
+        CopyBufferToTexture,
+        CopyTextureToBuffer,
+        CopyTextureToTexture,
+        SetPipeline,
+        SetBindGroup,
+        SetPushConstants,
+        Dispatch,
+        DispatchIndirect,
+        BeginRenderPass,
+        EndRenderPass,
+        SetViewport,
+        SetViewports,
+        SetScissorRect,
+        SetScissorRects,
+        SetVertexBuffer,
+        SetIndexBuffer,
+        SetStencilReference,
+        BeginQuery,
+        EndQuery,
+        ResolveQuery,
+        ResetQuery,
+        Draw,
+        DrawIndexed,
+        DrawIndirect,
+        DrawIndexedIndirect,
+        DispatchMesh,
+        DispatchMeshIndirect,
+        DispatchMeshIndirectCount,
+        RequireTextureAccess,
+        RequireBufferAccess,
+        DiscardTexture,
+        DiscardBuffer,
+        RequireHostRead,
+    };
+
+    // Packets are [header, arguments, trailing bytes] padded to kPacketAlignment, size is the distance to the next one.
+    struct PacketHeader
+    {
+        DeferredCommand command;
+        uint32_t size;
+    };
+
+    constexpr size_t kPacketAlignment = 8;
+    constexpr size_t kInitialStreamSize = 64 * 1024;
+    // Smaller streams translate faster than a worker thread wakes up.
+    constexpr size_t kWorkerStreamSize = 16 * 1024;
+
+    struct BufferPacket
+    {
+        VGPUBuffer buffer;
+        uint64_t offset;
+    };
+
+    struct ClearBufferPacket
+    {
+        VGPUBuffer buffer;
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    struct CopyBufferToBufferPacket
+    {
+        VGPUBuffer source;
+        uint64_t sourceOffset;
+        VGPUBuffer destination;
+        uint64_t destinationOffset;
+        uint64_t size;
+    };
+
+    template <typename Source, typename Destination>
+    struct CopyPacket
+    {
+        Source source;
+        Destination destination;
+        VGPUExtent3D extent;
+    };
+
+    struct SetBindGroupPacket
+    {
+        uint32_t groupIndex;
+        VGPUBindGroup bindGroup;
+    };
+
+    // Followed by size bytes of data.
+    struct SetPushConstantsPacket
+    {
+        uint32_t pushConstantIndex;
+        uint32_t size;
+    };
+
+    // Followed by the color attachments and the label, the pointers in desc only mark what is present.
+    struct BeginRenderPassPacket
+    {
+        VGPURenderPassDesc desc;
+        VGPURenderPassDepthStencilAttachment depthStencilAttachment;
+    };
+
+    // Followed by count viewports or rects.
+    struct ArrayPacket
+    {
+        uint32_t count;
+    };
+
+    struct SetVertexBufferPacket
+    {
+        uint32_t index;
+        VGPUBuffer buffer;
+        uint64_t offset;
+    };
+
+    struct SetIndexBufferPacket
+    {
+        VGPUBuffer buffer;
+        VGPUIndexType type;
+        uint64_t offset;
+    };
+
+    struct QueryPacket
+    {
+        VGPUQueryHeap heap;
+        uint32_t index;
+        uint32_t count;
+        VGPUBuffer destinationBuffer;
+        uint64_t destinationOffset;
+    };
+
+    struct DispatchMeshIndirectCountPacket
+    {
+        VGPUBuffer indirectBuffer;
+        uint64_t indirectBufferOffset;
+        VGPUBuffer countBuffer;
+        uint64_t countBufferOffset;
+        uint32_t maxCount;
+    };
+
+    struct TextureAccessPacket
+    {
+        VGPUTexture texture;
+        VGPURenderGraphAccess access;
+    };
+
+    struct BufferAccessPacket
+    {
+        VGPUBuffer buffer;
+        VGPURenderGraphAccess access;
+    };
+
+    template <typename T>
+    const T& PacketArguments(const PacketHeader* header)
+    {
+        return *reinterpret_cast<const T*>(header + 1);
+    }
+
+    template <typename T>
+    const uint8_t* PacketTrailer(const PacketHeader* header)
+    {
+        return reinterpret_cast<const uint8_t*>(header + 1) + sizeof(T);
+    }
+}
+
+/// Appends every call as a POD packet to a linear stream that keeps its capacity across recordings, the backend
+/// command buffer only sees the calls when Translate replays the stream at submit.
+/// Allocate and AcquireSwapchainTexture return values and go straight to the backend command buffer.
+class DeferredCommandBuffer final : public VGPUCommandBufferImpl
+{
+public:
+    void Begin(VGPUCommandBuffer commandBuffer_)
+    {
+        commandBuffer = commandBuffer_;
+        streamSize = 0;
+        recording = true;
+    }
+
+    void Translate();
+    void ReleaseReferences();
+    size_t GetStreamSize() const { return streamSize; }
+
+    VGPUCommandQueue GetQueueType() const override { return commandBuffer->GetQueueType(); }
+
+    void PushDebugGroup(const char* groupLabel) override { AppendString(DeferredCommand::PushDebugGroup, groupLabel); }
+    void PopDebugGroup() override { AppendPacket(DeferredCommand::PopDebugGroup, 0); }
+    void InsertDebugMarker(const char* markerLabel) override { AppendString(DeferredCommand::InsertDebugMarker, markerLabel); }
+
+    void ClearBuffer(VGPUBuffer buffer, uint64_t offset, uint64_t size) override
+    {
+        Reference(buffer);
+        *Append<ClearBufferPacket>(DeferredCommand::ClearBuffer) = { buffer, offset, size };
+    }
+
+    VGPUBufferAllocation Allocate(uint64_t size, uint64_t alignment) override
+    {
+        return commandBuffer->Allocate(size, alignment);
+    }
+
+    void CopyBufferToBuffer(VGPUBuffer source, uint64_t sourceOffset, VGPUBuffer destination, uint64_t destinationOffset, uint64_t size) override
+    {
+        Reference(source);
+        Reference(destination);
+        *Append<CopyBufferToBufferPacket>(DeferredCommand::CopyBufferToBuffer) = { source, sourceOffset, destination, destinationOffset, size };
+    }
+
+    void CopyBufferToTexture(const VGPUBufferCopyLocation* source, const VGPUTextureCopyLocation* destination, const VGPUExtent3D* extent) override
+    {
+        Reference(source->buffer);
+        Reference(destination->texture);
+        *Append<CopyPacket<VGPUBufferCopyLocation, VGPUTextureCopyLocation>>(DeferredCommand::CopyBufferToTexture) = { *source, *destination, *extent };
+    }
+
+    void CopyTextureToBuffer(const VGPUTextureCopyLocation* source, const VGPUBufferCopyLocation* destination, const VGPUExtent3D* extent) override
+    {
+        Reference(source->texture);
+        Reference(destination->buffer);
+        *Append<CopyPacket<VGPUTextureCopyLocation, VGPUBufferCopyLocation>>(DeferredCommand::CopyTextureToBuffer) = { *source, *destination, *extent };
+    }
+
+    void CopyTextureToTexture(const VGPUTextureCopyLocation* source, const VGPUTextureCopyLocation* destination, const VGPUExtent3D* extent) override
+    {
+        Reference(source->texture);
+        Reference(destination->texture);
+        *Append<CopyPacket<VGPUTextureCopyLocation, VGPUTextureCopyLocation>>(DeferredCommand::CopyTextureToTexture) = { *source, *destination, *extent };
+    }
+
+    void SetPipeline(VGPUPipeline pipeline) override
+    {
+        Reference(pipeline);
+        *Append<VGPUPipeline>(DeferredCommand::SetPipeline) = pipeline;
+    }
+
+    void SetBindGroup(uint32_t groupIndex, VGPUBindGroup bindGroup) override
+    {
+        Reference(bindGroup);
+        *Append<SetBindGroupPacket>(DeferredCommand::SetBindGroup) = { groupIndex, bindGroup };
+    }
+
+    void SetPushConstants(uint32_t pushConstantIndex, const void* data, uint32_t size) override
+    {
+        SetPushConstantsPacket* packet = Append<SetPushConstantsPacket>(DeferredCommand::SetPushConstants, size);
+        *packet = { pushConstantIndex, size };
+        memcpy(packet + 1, data, size);
+    }
+
+    void Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) override
+    {
+        *Append<VGPUDispatchIndirectCommand>(DeferredCommand::Dispatch) = { groupCountX, groupCountY, groupCountZ };
+    }
+
+    void DispatchIndirect(VGPUBuffer buffer, uint64_t offset) override
+    {
+        Reference(buffer);
+        *Append<BufferPacket>(DeferredCommand::DispatchIndirect) = { buffer, offset };
+    }
+
+    VGPUTexture AcquireSwapchainTexture(VGPUSwapChain swapChain) override
+    {
+        return commandBuffer->AcquireSwapchainTexture(swapChain);
+    }
+
+    void BeginRenderPass(const VGPURenderPassDesc* desc) override;
+    void EndRenderPass() override { AppendPacket(DeferredCommand::EndRenderPass, 0); }
+
+    void SetViewport(const VGPUViewport* viewport) override { *Append<VGPUViewport>(DeferredCommand::SetViewport) = *viewport; }
+    void SetViewports(uint32_t count, const VGPUViewport* viewports) override { AppendArray(DeferredCommand::SetViewports, count, viewports); }
+    void SetScissorRect(const VGPURect* rect) override { *Append<VGPURect>(DeferredCommand::SetScissorRect) = *rect; }
+    void SetScissorRects(uint32_t count, const VGPURect* rects) override { AppendArray(DeferredCommand::SetScissorRects, count, rects); }
+
+    void SetVertexBuffer(uint32_t index, VGPUBuffer buffer, uint64_t offset) override
+    {
+        Reference(buffer);
+        *Append<SetVertexBufferPacket>(DeferredCommand::SetVertexBuffer) = { index, buffer, offset };
+    }
+
+    void SetIndexBuffer(VGPUBuffer buffer, VGPUIndexType type, uint64_t offset) override
+    {
+        Reference(buffer);
+        *Append<SetIndexBufferPacket>(DeferredCommand::SetIndexBuffer) = { buffer, type, offset };
+    }
+
+    void SetStencilReference(uint32_t reference) override { *Append<uint32_t>(DeferredCommand::SetStencilReference) = reference; }
+
+    void BeginQuery(VGPUQueryHeap heap, uint32_t index) override
+    {
+        Reference(heap);
+        *Append<QueryPacket>(DeferredCommand::BeginQuery) = { heap, index, 1u, nullptr, 0 };
+    }
+
+    void EndQuery(VGPUQueryHeap heap, uint32_t index) override
+    {
+        Reference(heap);
+        *Append<QueryPacket>(DeferredCommand::EndQuery) = { heap, index, 1u, nullptr, 0 };
+    }
+
+    void ResolveQuery(VGPUQueryHeap heap, uint32_t index, uint32_t count, VGPUBuffer destinationBuffer, uint64_t destinationOffset) override
+    {
+        Reference(heap);
+        Reference(destinationBuffer);
+        *Append<QueryPacket>(DeferredCommand::ResolveQuery) = { heap, index, count, destinationBuffer, destinationOffset };
+    }
+
+    void ResetQuery(VGPUQueryHeap heap, uint32_t index, uint32_t count) override
+    {
+        Reference(heap);
+        *Append<QueryPacket>(DeferredCommand::ResetQuery) = { heap, index, count, nullptr, 0 };
+    }
+
+    void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) override
+    {
+        *Append<VGPUDrawIndirectCommand>(DeferredCommand::Draw) = { vertexCount, instanceCount, firstVertex, firstInstance };
+    }
+
+    void DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t baseVertex, uint32_t firstInstance) override
+    {
+        *Append<VGPUDrawIndexedIndirectCommand>(DeferredCommand::DrawIndexed) = { indexCount, instanceCount, firstIndex, baseVertex, firstInstance };
+    }
+
+    void DrawIndirect(VGPUBuffer indirectBuffer, uint64_t indirectBufferOffset) override
+    {
+        Reference(indirectBuffer);
+        *Append<BufferPacket>(DeferredCommand::DrawIndirect) = { indirectBuffer, indirectBufferOffset };
+    }
+
+    void DrawIndexedIndirect(VGPUBuffer indirectBuffer, uint64_t indirectBufferOffset) override
+    {
+        Reference(indirectBuffer);
+        *Append<BufferPacket>(DeferredCommand::DrawIndexedIndirect) = { indirectBuffer, indirectBufferOffset };
+    }
+
+    void DispatchMesh(uint32_t threadGroupCountX, uint32_t threadGroupCountY, uint32_t threadGroupCountZ) override
+    {
+        *Append<VGPUDispatchIndirectCommand>(DeferredCommand::DispatchMesh) = { threadGroupCountX, threadGroupCountY, threadGroupCountZ };
+    }
+
+    void DispatchMeshIndirect(VGPUBuffer indirectBuffer, uint64_t indirectBufferOffset) override
+    {
+        Reference(indirectBuffer);
+        *Append<BufferPacket>(DeferredCommand::DispatchMeshIndirect) = { indirectBuffer, indirectBufferOffset };
+    }
+
+    void DispatchMeshIndirectCount(VGPUBuffer indirectBuffer, uint64_t indirectBufferOffset, VGPUBuffer countBuffer, uint64_t countBufferOffset, uint32_t maxCount) override
+    {
+        Reference(indirectBuffer);
+        Reference(countBuffer);
+        *Append<DispatchMeshIndirectCountPacket>(DeferredCommand::DispatchMeshIndirectCount) = { indirectBuffer, indirectBufferOffset, countBuffer, countBufferOffset, maxCount };
+    }
+
+    // The readback ring issues these on application command buffers, they keep their place in the stream.
+    void RequireTextureAccess(VGPUTexture texture, VGPURenderGraphAccess access) override
+    {
+        Reference(texture);
+        *Append<TextureAccessPacket>(DeferredCommand::RequireTextureAccess) = { texture, access };
+    }
+
+    void RequireBufferAccess(VGPUBuffer buffer, VGPURenderGraphAccess access) override
+    {
+        Reference(buffer);
+        *Append<BufferAccessPacket>(DeferredCommand::RequireBufferAccess) = { buffer, access };
+    }
+
+    void DiscardTexture(VGPUTexture texture) override
+    {
+        Reference(texture);
+        *Append<VGPUTexture>(DeferredCommand::DiscardTexture) = texture;
+    }
+
+    void DiscardBuffer(VGPUBuffer buffer) override
+    {
+        Reference(buffer);
+        *Append<VGPUBuffer>(DeferredCommand::DiscardBuffer) = buffer;
+    }
+
+    void RequireHostRead(VGPUBuffer buffer) override
+    {
+        Reference(buffer);
+        *Append<VGPUBuffer>(DeferredCommand::RequireHostRead) = buffer;
+    }
+
+    VGPUCommandBuffer commandBuffer = nullptr;
+    bool recording = false;
+
+private:
+    // Packets hold raw handles, the stream keeps a reference on each until the command buffer is submitted.
+    void Reference(VGPUObject* object)
+    {
+        if (object == nullptr)
+            return;
+
+        object->AddRef();
+        references.push_back(object);
+    }
+
+    // Returns the start of size bytes after the packet header.
+    uint8_t* AppendPacket(DeferredCommand command, size_t size)
+    {
+        size = AlignUp(sizeof(PacketHeader) + size, kPacketAlignment);
+        if (size > stream.size() - streamSize)
+        {
+            // Doubling keeps the growth amortized, the capacity is reused by every later recording.
+            stream.resize(_VGPU_MAX(_VGPU_MAX(stream.size() * 2, kInitialStreamSize), streamSize + size));
+        }
+
+        PacketHeader* header = reinterpret_cast<PacketHeader*>(stream.data() + streamSize);
+        header->command = command;
+        header->size = (uint32_t)size;
+        streamSize += size;
+        return reinterpret_cast<uint8_t*>(header + 1);
+    }
+
+    template <typename T>
+    T* Append(DeferredCommand command, size_t trailingSize = 0)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Packets are copied as raw bytes");
+        static_assert(alignof(T) <= kPacketAlignment, "Packet arguments must fit the stream alignment");
+        return reinterpret_cast<T*>(AppendPacket(command, sizeof(T) + trailingSize));
+    }
+
+    void AppendString(DeferredCommand command, const char* text)
+    {
+        const size_t length = strlen(text) + 1;
+        memcpy(AppendPacket(command, length), text, length);
+    }
+
+    template <typename T>
+    void AppendArray(DeferredCommand command, uint32_t count, const T* values)
+    {
+        ArrayPacket* packet = Append<ArrayPacket>(command, count * sizeof(T));
+        packet->count = count;
+        memcpy(packet + 1, values, count * sizeof(T));
+    }
+
+    std::vector<uint8_t> stream;
+    size_t streamSize = 0;
+    std::vector<VGPUObject*> references;
+};
+
+void DeferredCommandBuffer::BeginRenderPass(const VGPURenderPassDesc* desc)
+{
+    const size_t attachmentsSize = desc->colorAttachmentCount * sizeof(VGPURenderPassColorAttachment);
+    const size_t labelLength = desc->label ? strlen(desc->label) + 1 : 0;
+
+    for (uint32_t i = 0; i < desc->colorAttachmentCount; ++i)
+    {
+        Reference(desc->colorAttachments[i].texture);
+        Reference(desc->colorAttachments[i].resolveTexture);
+    }
+    if (desc->depthStencilAttachment)
+        Reference(desc->depthStencilAttachment->texture);
+
+    BeginRenderPassPacket* packet = Append<BeginRenderPassPacket>(DeferredCommand::BeginRenderPass, attachmentsSize + labelLength);
+    packet->desc = *desc;
+    packet->depthStencilAttachment = desc->depthStencilAttachment ? *desc->depthStencilAttachment : VGPURenderPassDepthStencilAttachment{};
+
+    uint8_t* trailer = reinterpret_cast<uint8_t*>(packet + 1);
+    if (attachmentsSize > 0)
+        memcpy(trailer, desc->colorAttachments, attachmentsSize);
+    if (labelLength > 0)
+        memcpy(trailer + attachmentsSize, desc->label, labelLength);
+}
+
+void DeferredCommandBuffer::Translate()
+{
+    VGPUCommandBufferImpl* target = commandBuffer;
+
+    const uint8_t* data = stream.data();
+    const uint8_t* end = data + streamSize;
+    while (data < end)
+    {
+        const PacketHeader* header = reinterpret_cast<const PacketHeader*>(data);
+        data += header->size;
+
+        switch (header->command)
+        {
+            case DeferredCommand::PushDebugGroup:
+                target->PushDebugGroup(reinterpret_cast<const char*>(header + 1));
+                break;
+
+            case DeferredCommand::PopDebugGroup:
+                target->PopDebugGroup();
+                break;
+
+            case DeferredCommand::InsertDebugMarker:
+                target->InsertDebugMarker(reinterpret_cast<const char*>(header + 1));
+                break;
+
+            case DeferredCommand::ClearBuffer:
+            {
+                const ClearBufferPacket& packet = PacketArguments<ClearBufferPacket>(header);
+                target->ClearBuffer(packet.buffer, packet.offset, packet.size);
+                break;
+            }
+
+            case DeferredCommand::CopyBufferToBuffer:
+            {
+                const CopyBufferToBufferPacket& packet = PacketArguments<CopyBufferToBufferPacket>(header);
+                target->CopyBufferToBuffer(packet.source, packet.sourceOffset, packet.destination, packet.destinationOffset, packet.size);
+                break;
+            }
+
+            case DeferredCommand::CopyBufferToTexture:
+            {
+                const auto& packet = PacketArguments<CopyPacket<VGPUBufferCopyLocation, VGPUTextureCopyLocation>>(header);
+                target->CopyBufferToTexture(&packet.source, &packet.destination, &packet.extent);
+                break;
+            }
+
+            case DeferredCommand::CopyTextureToBuffer:
+            {
+                const auto& packet = PacketArguments<CopyPacket<VGPUTextureCopyLocation, VGPUBufferCopyLocation>>(header);
+                target->CopyTextureToBuffer(&packet.source, &packet.destination, &packet.extent);
+                break;
+            }
+
+            case DeferredCommand::CopyTextureToTexture:
+            {
+                const auto& packet = PacketArguments<CopyPacket<VGPUTextureCopyLocation, VGPUTextureCopyLocation>>(header);
+                target->CopyTextureToTexture(&packet.source, &packet.destination, &packet.extent);
+                break;
+            }
+
+            case DeferredCommand::SetPipeline:
+                target->SetPipeline(PacketArguments<VGPUPipeline>(header));
+                break;
+
+            case DeferredCommand::SetBindGroup:
+            {
+                const SetBindGroupPacket& packet = PacketArguments<SetBindGroupPacket>(header);
+                target->SetBindGroup(packet.groupIndex, packet.bindGroup);
+                break;
+            }
+
+            case DeferredCommand::SetPushConstants:
+            {
+                const SetPushConstantsPacket& packet = PacketArguments<SetPushConstantsPacket>(header);
+                target->SetPushConstants(packet.pushConstantIndex, PacketTrailer<SetPushConstantsPacket>(header), packet.size);
+                break;
+            }
+
+            case DeferredCommand::Dispatch:
+            {
+                const VGPUDispatchIndirectCommand& packet = PacketArguments<VGPUDispatchIndirectCommand>(header);
+                target->Dispatch(packet.x, packet.y, packet.z);
+                break;
+            }
+
+            case DeferredCommand::DispatchIndirect:
+            {
+                const BufferPacket& packet = PacketArguments<BufferPacket>(header);
+                target->DispatchIndirect(packet.buffer, packet.offset);
+                break;
+            }
+
+            case DeferredCommand::BeginRenderPass:
+            {
+                const BeginRenderPassPacket& packet = PacketArguments<BeginRenderPassPacket>(header);
+                const uint8_t* trailer = PacketTrailer<BeginRenderPassPacket>(header);
+
+                VGPURenderPassDesc desc = packet.desc;
+                desc.colorAttachments = reinterpret_cast<const VGPURenderPassColorAttachment*>(trailer);
+                if (desc.label)
+                    desc.label = reinterpret_cast<const char*>(trailer + desc.colorAttachmentCount * sizeof(VGPURenderPassColorAttachment));
+                if (desc.depthStencilAttachment)
+                    desc.depthStencilAttachment = &packet.depthStencilAttachment;
+
+                target->BeginRenderPass(&desc);
+                break;
+            }
+
+            case DeferredCommand::EndRenderPass:
+                target->EndRenderPass();
+                break;
+
+            case DeferredCommand::SetViewport:
+                target->SetViewport(&PacketArguments<VGPUViewport>(header));
+                break;
+
+            case DeferredCommand::SetViewports:
+                target->SetViewports(PacketArguments<ArrayPacket>(header).count, reinterpret_cast<const VGPUViewport*>(PacketTrailer<ArrayPacket>(header)));
+                break;
+
+            case DeferredCommand::SetScissorRect:
+                target->SetScissorRect(&PacketArguments<VGPURect>(header));
+                break;
+
+            case DeferredCommand::SetScissorRects:
+                target->SetScissorRects(PacketArguments<ArrayPacket>(header).count, reinterpret_cast<const VGPURect*>(PacketTrailer<ArrayPacket>(header)));
+                break;
+
+            case DeferredCommand::SetVertexBuffer:
+            {
+                const SetVertexBufferPacket& packet = PacketArguments<SetVertexBufferPacket>(header);
+                target->SetVertexBuffer(packet.index, packet.buffer, packet.offset);
+                break;
+            }
+
+            case DeferredCommand::SetIndexBuffer:
+            {
+                const SetIndexBufferPacket& packet = PacketArguments<SetIndexBufferPacket>(header);
+                target->SetIndexBuffer(packet.buffer, packet.type, packet.offset);
+                break;
+            }
+
+            case DeferredCommand::SetStencilReference:
+                target->SetStencilReference(PacketArguments<uint32_t>(header));
+                break;
+
+            case DeferredCommand::BeginQuery:
+            {
+                const QueryPacket& packet = PacketArguments<QueryPacket>(header);
+                target->BeginQuery(packet.heap, packet.index);
+                break;
+            }
+
+            case DeferredCommand::EndQuery:
+            {
+                const QueryPacket& packet = PacketArguments<QueryPacket>(header);
+                target->EndQuery(packet.heap, packet.index);
+                break;
+            }
+
+            case DeferredCommand::ResolveQuery:
+            {
+                const QueryPacket& packet = PacketArguments<QueryPacket>(header);
+                target->ResolveQuery(packet.heap, packet.index, packet.count, packet.destinationBuffer, packet.destinationOffset);
+                break;
+            }
+
+            case DeferredCommand::ResetQuery:
+            {
+                const QueryPacket& packet = PacketArguments<QueryPacket>(header);
+                target->ResetQuery(packet.heap, packet.index, packet.count);
+                break;
+            }
+
+            case DeferredCommand::Draw:
+            {
+                const VGPUDrawIndirectCommand& packet = PacketArguments<VGPUDrawIndirectCommand>(header);
+                target->Draw(packet.vertexCount, packet.instanceCount, packet.firstVertex, packet.firstInstance);
+                break;
+            }
+
+            case DeferredCommand::DrawIndexed:
+            {
+                const VGPUDrawIndexedIndirectCommand& packet = PacketArguments<VGPUDrawIndexedIndirectCommand>(header);
+                target->DrawIndexed(packet.indexCount, packet.instanceCount, packet.firstIndex, packet.baseVertex, packet.firstInstance);
+                break;
+            }
+
+            case DeferredCommand::DrawIndirect:
+            {
+                const BufferPacket& packet = PacketArguments<BufferPacket>(header);
+                target->DrawIndirect(packet.buffer, packet.offset);
+                break;
+            }
+
+            case DeferredCommand::DrawIndexedIndirect:
+            {
+                const BufferPacket& packet = PacketArguments<BufferPacket>(header);
+                target->DrawIndexedIndirect(packet.buffer, packet.offset);
+                break;
+            }
+
+            case DeferredCommand::DispatchMesh:
+            {
+                const VGPUDispatchIndirectCommand& packet = PacketArguments<VGPUDispatchIndirectCommand>(header);
+                target->DispatchMesh(packet.x, packet.y, packet.z);
+                break;
+            }
+
+            case DeferredCommand::DispatchMeshIndirect:
+            {
+                const BufferPacket& packet = PacketArguments<BufferPacket>(header);
+                target->DispatchMeshIndirect(packet.buffer, packet.offset);
+                break;
+            }
+
+            case DeferredCommand::DispatchMeshIndirectCount:
+            {
+                const DispatchMeshIndirectCountPacket& packet = PacketArguments<DispatchMeshIndirectCountPacket>(header);
+                target->DispatchMeshIndirectCount(packet.indirectBuffer, packet.indirectBufferOffset, packet.countBuffer, packet.countBufferOffset, packet.maxCount);
+                break;
+            }
+
+            case DeferredCommand::RequireTextureAccess:
+            {
+                const TextureAccessPacket& packet = PacketArguments<TextureAccessPacket>(header);
+                target->RequireTextureAccess(packet.texture, packet.access);
+                break;
+            }
+
+            case DeferredCommand::RequireBufferAccess:
+            {
+                const BufferAccessPacket& packet = PacketArguments<BufferAccessPacket>(header);
+                target->RequireBufferAccess(packet.buffer, packet.access);
+                break;
+            }
+
+            case DeferredCommand::DiscardTexture:
+                target->DiscardTexture(PacketArguments<VGPUTexture>(header));
+                break;
+
+            case DeferredCommand::DiscardBuffer:
+                target->DiscardBuffer(PacketArguments<VGPUBuffer>(header));
+                break;
+
+            case DeferredCommand::RequireHostRead:
+                target->RequireHostRead(PacketArguments<VGPUBuffer>(header));
+                break;
+        }
+    }
+
+    streamSize = 0;
+}
+
+void DeferredCommandBuffer::ReleaseReferences()
+{
+    for (VGPUObject* object : references)
+        object->Release();
+    references.clear();
+}
+
+class DeferredRecorder final : public VGPUDeferredRecorder
+{
+public:
+    VGPUCommandBuffer BeginCommandBuffer(VGPUCommandBuffer commandBuffer) override
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        for (const std::unique_ptr<DeferredCommandBuffer>& deferred : commandBuffers)
+        {
+            if (!deferred->recording)
+            {
+                deferred->Begin(commandBuffer);
+                return deferred.get();
+            }
+        }
+
+        DeferredCommandBuffer* deferred = commandBuffers.emplace_back(std::make_unique<DeferredCommandBuffer>()).get();
+        deferred->Begin(commandBuffer);
+        return deferred;
+    }
+
+    void Submit(VGPUCommandBuffer* submitCommandBuffers, uint32_t count) override
+    {
+        std::vector<DeferredCommandBuffer*> translations;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                for (const std::unique_ptr<DeferredCommandBuffer>& deferred : commandBuffers)
+                {
+                    if (deferred.get() == submitCommandBuffers[i] && deferred->recording)
+                    {
+                        translations.push_back(deferred.get());
+                        submitCommandBuffers[i] = deferred->commandBuffer;
+                        break;
+                    }
+                }
+            }
+        }
+
+        // Backend command buffers record independently, large streams after the first go to the workers while the
+        // calling thread translates the first one and the small ones. Split before dispatching, a stream handed to a
+        // worker is not read again here.
+        std::vector<DeferredCommandBuffer*> inlineTranslations;
+        std::vector<DeferredCommandBuffer*> workerTranslations;
+        bool inlineLarge = false;
+        for (DeferredCommandBuffer* deferred : translations)
+        {
+            if (deferred->GetStreamSize() < kWorkerStreamSize)
+            {
+                inlineTranslations.push_back(deferred);
+            }
+            else if (!inlineLarge)
+            {
+                inlineTranslations.push_back(deferred);
+                inlineLarge = true;
+            }
+            else
+            {
+                workerTranslations.push_back(deferred);
+            }
+        }
+
+        if (!workerTranslations.empty() && workers == nullptr)
+            workers = std::make_unique<VGPUWorkerPool>();
+
+        for (DeferredCommandBuffer* deferred : workerTranslations)
+            workers->Execute([deferred]() { deferred->Translate(); });
+
+        for (DeferredCommandBuffer* deferred : inlineTranslations)
+            deferred->Translate();
+
+        if (!workerTranslations.empty())
+            workers->WaitIdle();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (DeferredCommandBuffer* deferred : translations)
+        {
+            deferred->ReleaseReferences();
+            deferred->commandBuffer = nullptr;
+            deferred->recording = false;
+        }
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<std::unique_ptr<DeferredCommandBuffer>> commandBuffers;
+    std::unique_ptr<VGPUWorkerPool> workers;
+};
+
+VGPUDeferredRecorder* CreateDeferredRecorder()
+{
+    return new DeferredRecorder();
+}
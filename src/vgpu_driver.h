@@ -8,7 +8,14 @@
 #include <stdbool.h>
 #include <string.h> 
 #include <atomic>
+#include <chrono>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+#include <vector>
 
 
 #ifndef VGPU_ASSERT
@@ -124,6 +131,33 @@ namespace
     }
 }
 
+/// Fixed size pool of worker threads executing jobs in FIFO order.
+class VGPUWorkerPool final
+{
+public:
+    /// threadCount of 0 uses one thread per hardware core, minus the calling thread.
+    explicit VGPUWorkerPool(uint32_t threadCount = 0);
+    ~VGPUWorkerPool();
+
+    VGPUWorkerPool(const VGPUWorkerPool&) = delete;
+    VGPUWorkerPool& operator=(const VGPUWorkerPool&) = delete;
+
+    void Execute(std::function<void()> job);
+    void WaitIdle();
+    uint32_t GetThreadCount() const { return (uint32_t)threads.size(); }
+
+private:
+    void WorkerLoop();
+
+    std::vector<std::thread> threads;
+    std::deque<std::function<void()>> jobs;
+    std::mutex jobsMutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable idleCondition;
+    uint32_t activeJobs = 0;
+    bool shutdown = false;
+};
+
 typedef struct VGPURenderer VGPURenderer;
 typedef struct VGPUCommandBufferImpl VGPUCommandBufferImpl;
 
@@ -169,6 +203,11 @@ public:
     virtual uint64_t GetSize() const = 0;
     virtual VGPUBufferUsageFlags GetUsage() const = 0;
     virtual VGPUDeviceAddress GetGpuAddress() const = 0;
+    virtual uint32_t GetDescriptorIndex() const { return VGPU_INVALID_DESCRIPTOR_INDEX; }
+    virtual void* GetMappedData() const { return nullptr; }
+    // Backends that only map host coherent memory leave these as no-ops.
+    virtual void FlushRange(uint64_t offset, uint64_t size) { (void)offset; (void)size; }
+    virtual void InvalidateRange(uint64_t offset, uint64_t size) { (void)offset; (void)size; }
 };
 
 struct VGPUTextureImpl : public VGPUObject
@@ -176,11 +215,14 @@ struct VGPUTextureImpl : public VGPUObject
 public:
     virtual VGPUTextureDimension GetDimension() const = 0;
     virtual VGPUTextureFormat GetFormat() const = 0;
+    virtual VGPUTextureUsageFlags GetUsage() const = 0;
+    virtual uint32_t GetDescriptorIndex() const { return VGPU_INVALID_DESCRIPTOR_INDEX; }
 };
 
 struct VGPUSamplerImpl : public VGPUObject
 {
 public:
+    virtual uint32_t GetDescriptorIndex() const { return VGPU_INVALID_DESCRIPTOR_INDEX; }
 };
 
 struct VGPUBindGroupLayoutImpl : public VGPUObject
@@ -203,6 +245,8 @@ struct VGPUPipelineImpl : public VGPUObject
 {
 public:
     virtual VGPUPipelineType GetType() const = 0;
+    virtual VGPUPipelineStatus GetStatus() const { return VGPUPipelineStatus_Ready; }
+    virtual VGPUPipelineStatus Wait() { return GetStatus(); }
 };
 
 struct VGPUQueryHeapImpl : public VGPUObject
@@ -220,16 +264,55 @@ public:
     virtual uint32_t GetHeight() const = 0;
 };
 
+/// Size, alignment and compatible memory types of a resource placed in a memory heap.
+struct VGPUAllocationRequirements
+{
+    uint64_t size;
+    uint64_t alignment;
+    uint32_t memoryTypeBits;
+};
+
+struct VGPUMemoryHeapImpl : public VGPUObject
+{
+public:
+    virtual uint64_t GetSize() const = 0;
+    virtual VGPUMemoryClass GetMemoryClass() const = 0;
+};
+
 struct VGPUCommandBufferImpl
 {
 public:
     virtual ~VGPUCommandBufferImpl() = default;
 
+    virtual VGPUCommandQueue GetQueueType() const = 0;
+
     virtual void PushDebugGroup(const char* groupLabel) = 0;
     virtual void PopDebugGroup() = 0;
     virtual void InsertDebugMarker(const char* markerLabel) = 0;
 
     virtual void ClearBuffer(VGPUBuffer buffer, uint64_t offset, uint64_t size) = 0;
+    virtual VGPUBufferAllocation Allocate(uint64_t size, uint64_t alignment) { (void)size; (void)alignment; return {}; }
+
+    virtual void CopyBufferToBuffer(VGPUBuffer source, uint64_t sourceOffset, VGPUBuffer destination, uint64_t destinationOffset, uint64_t size)
+    {
+        (void)source; (void)sourceOffset; (void)destination; (void)destinationOffset; (void)size;
+        vgpuLogError("CopyBufferToBuffer is not supported by this backend");
+    }
+    virtual void CopyBufferToTexture(const VGPUBufferCopyLocation* source, const VGPUTextureCopyLocation* destination, const VGPUExtent3D* extent)
+    {
+        (void)source; (void)destination; (void)extent;
+        vgpuLogError("CopyBufferToTexture is not supported by this backend");
+    }
+    virtual void CopyTextureToBuffer(const VGPUTextureCopyLocation* source, const VGPUBufferCopyLocation* destination, const VGPUExtent3D* extent)
+    {
+        (void)source; (void)destination; (void)extent;
+        vgpuLogError("CopyTextureToBuffer is not supported by this backend");
+    }
+    virtual void CopyTextureToTexture(const VGPUTextureCopyLocation* source, const VGPUTextureCopyLocation* destination, const VGPUExtent3D* extent)
+    {
+        (void)source; (void)destination; (void)extent;
+        vgpuLogError("CopyTextureToTexture is not supported by this backend");
+    }
 
     virtual void SetPipeline(VGPUPipeline pipeline) = 0;
     virtual void SetBindGroup(uint32_t groupIndex, VGPUBindGroup bindGroup) = 0;
@@ -264,11 +347,91 @@ public:
     virtual void DispatchMesh(uint32_t threadGroupCountX, uint32_t threadGroupCountY, uint32_t threadGroupCountZ) = 0;
     virtual void DispatchMeshIndirect(VGPUBuffer indirectBuffer, uint64_t indirectBufferOffset) = 0;
     virtual void DispatchMeshIndirectCount(VGPUBuffer indirectBuffer, uint64_t indirectBufferOffset, VGPUBuffer countBuffer, uint64_t countBufferOffset, uint32_t maxCount) = 0;
+
+    // Accesses declared by render graph passes, backends without explicit state tracking ignore them.
+    virtual void RequireTextureAccess(VGPUTexture texture, VGPURenderGraphAccess access) { (void)texture; (void)access; }
+    virtual void RequireBufferAccess(VGPUBuffer buffer, VGPURenderGraphAccess access) { (void)buffer; (void)access; }
+    // Contents become undefined, the next access waits for every earlier access to the (possibly aliased) memory.
+    virtual void DiscardTexture(VGPUTexture texture) { (void)texture; }
+    virtual void DiscardBuffer(VGPUBuffer buffer) { (void)buffer; }
+    // Makes earlier copy writes visible to the host once the submission completes.
+    virtual void RequireHostRead(VGPUBuffer buffer) { (void)buffer; }
 };
 
+/// Collects CPU and GPU spans in memory and writes them as a Chrome trace when tracing ends, see vgpu_trace.cpp.
+/// Times are nanoseconds of std::chrono::steady_clock, GPU spans are converted by the backend.
+class VGPUTraceRecorder
+{
+public:
+    virtual ~VGPUTraceRecorder() = default;
+
+    // name must outlive the recorder, span names are string literals.
+    virtual void AddCpuSpan(const char* name, uint64_t begin, uint64_t end) = 0;
+    virtual void AddGpuSpan(VGPUCommandQueue queue, const char* label, uint64_t begin, uint64_t end) = 0;
+    virtual bool Write() = 0;
+
+    static uint64_t Now()
+    {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+};
+
+/// Opens path for writing, returns nullptr if it cannot be created.
+VGPUTraceRecorder* CreateTraceRecorder(const char* path);
+
+/// Serializes the calls made through the C API into the stream described in vgpu_capture.h, see vgpu_capture.cpp.
+/// Objects and commands vgpu creates internally (render graph, readback ring) are not part of the stream.
+class VGPUCaptureRecorder
+{
+public:
+    virtual ~VGPUCaptureRecorder() = default;
+
+    virtual void CreateBuffer(VGPUBuffer buffer, const VGPUBufferDesc* desc, const void* pInitialData) = 0;
+    virtual void CreateTexture(VGPUTexture texture, const VGPUTextureDesc* desc, const VGPUTextureData* pInitialData) = 0;
+    virtual void CreateSampler(VGPUSampler sampler, const VGPUSamplerDesc* desc) = 0;
+    virtual void CreateBindGroupLayout(VGPUBindGroupLayout layout, const VGPUBindGroupLayoutDesc* desc) = 0;
+    virtual void CreatePipelineLayout(VGPUPipelineLayout layout, const VGPUPipelineLayoutDesc* desc) = 0;
+    virtual void CreateBindGroup(VGPUBindGroup bindGroup, VGPUBindGroupLayout layout, const VGPUBindGroupDesc* desc) = 0;
+    virtual void CreateRenderPipeline(VGPUPipeline pipeline, const VGPURenderPipelineDesc* desc) = 0;
+    virtual void CreateComputePipeline(VGPUPipeline pipeline, const VGPUComputePipelineDesc* desc) = 0;
+    virtual void CreateQueryHeap(VGPUQueryHeap queryHeap, const VGPUQueryHeapDesc* desc) = 0;
+    virtual void CreateSwapChain(VGPUSwapChain swapChain, const VGPUSwapChainDesc* desc) = 0;
+    virtual void WaitIdle() = 0;
+
+    // Returns a command buffer that records into the stream and forwards every call to commandBuffer.
+    virtual VGPUCommandBuffer BeginCommandBuffer(VGPUCommandBuffer commandBuffer, const char* label) = 0;
+    // Writes the captured command buffers and replaces them in place by the backend command buffers they wrap.
+    virtual void Submit(VGPUCommandBuffer* commandBuffers, uint32_t count) = 0;
+    virtual bool HasPendingCommandBuffers() = 0;
+    virtual bool Finish() = 0;
+};
+
+/// Opens path for writing, returns nullptr if it cannot be created.
+VGPUCaptureRecorder* CreateCaptureRecorder(const char* path, VGPUBackend backend);
+
+/// Records command buffers into linear packet streams that are translated to the backend at submit, see vgpu_deferred.cpp.
+class VGPUDeferredRecorder
+{
+public:
+    virtual ~VGPUDeferredRecorder() = default;
+
+    // Returns a command buffer that appends every call to its stream, commandBuffer only records when it is submitted.
+    virtual VGPUCommandBuffer BeginCommandBuffer(VGPUCommandBuffer commandBuffer) = 0;
+    // Translates the deferred command buffers and replaces them in place by the backend command buffers they wrap,
+    // others are left untouched.
+    virtual void Submit(VGPUCommandBuffer* commandBuffers, uint32_t count) = 0;
+};
+
+VGPUDeferredRecorder* CreateDeferredRecorder();
+
 struct VGPUDeviceImpl : public VGPUObject
 {
 public:
+    ~VGPUDeviceImpl() override
+    {
+        delete deferred;
+    }
+
     virtual void WaitIdle() = 0;
     virtual VGPUBackend GetBackendType() const = 0;
     virtual VGPUBool32 QueryFeatureSupport(VGPUFeature feature) const = 0;
@@ -289,6 +452,23 @@ public:
     virtual VGPUPipeline CreateComputePipeline(const VGPUComputePipelineDesc* desc) = 0;
     virtual VGPUPipeline CreateRayTracingPipeline(const VGPURayTracingPipelineDesc* desc) = 0;
 
+    // Backends without a compile thread pool build synchronously and invoke the callback inline.
+    virtual VGPUPipeline CreateRenderPipelineAsync(const VGPURenderPipelineDesc* desc, VGPUPipelineCallback callback, void* userData)
+    {
+        VGPUPipeline pipeline = CreateRenderPipeline(desc);
+        if (callback)
+            callback(pipeline, pipeline ? VGPUPipelineStatus_Ready : VGPUPipelineStatus_Failed, userData);
+        return pipeline;
+    }
+
+    virtual VGPUPipeline CreateComputePipelineAsync(const VGPUComputePipelineDesc* desc, VGPUPipelineCallback callback, void* userData)
+    {
+        VGPUPipeline pipeline = CreateComputePipeline(desc);
+        if (callback)
+            callback(pipeline, pipeline ? VGPUPipelineStatus_Ready : VGPUPipelineStatus_Failed, userData);
+        return pipeline;
+    }
+
     virtual VGPUQueryHeap CreateQueryHeap(const VGPUQueryHeapDesc* desc) = 0;
 
     virtual VGPUSwapChain CreateSwapChain(const VGPUSwapChainDesc* desc) = 0;
@@ -296,11 +476,205 @@ public:
     virtual VGPUCommandBuffer BeginCommandBuffer(VGPUCommandQueue queueType, const char* label) = 0;
     virtual uint64_t Submit(VGPUCommandBuffer* commandBuffers, uint32_t count) = 0;
 
+    virtual size_t GetPipelineCacheData(void* data, size_t dataSize) { (void)data; (void)dataSize; return 0; }
+    virtual uint64_t GetAllocatorHighWaterMark() const { return 0; }
+
+    // Backends without per-queue timelines can only wait for the whole device.
+    virtual uint64_t GetCompletedValue(VGPUCommandQueue queue) { (void)queue; return 0; }
+    virtual VGPUBool32 WaitValue(VGPUCommandQueue queue, uint64_t value, uint64_t timeout) { (void)queue; (void)value; (void)timeout; WaitIdle(); return true; }
+
+    // Backends without upload batching complete initial-data uploads inside Create*.
+    virtual uint64_t FlushUploads() { return 0; }
+    virtual VGPUBool32 WaitUploads(uint64_t token, uint64_t timeout) { (void)token; (void)timeout; WaitIdle(); return true; }
+    virtual void GetStagingStatistics(VGPUStagingStatistics* statistics) { *statistics = {}; }
+
+    virtual void GetMemoryBudget(VGPUMemoryBudget* budget) { *budget = {}; }
+    virtual void GetMemoryStatistics(VGPUMemoryStatistics* statistics) { *statistics = {}; }
+    virtual size_t GetMemoryDump(bool detailed, char* data, size_t dataSize) { (void)detailed; (void)data; (void)dataSize; return 0; }
+
+    // Backends without timestamp support never resolve a frame profile.
+    virtual void SetProfilerEnabled(bool enabled) { (void)enabled; }
+    virtual bool GetFrameProfile(VGPUFrameProfile* profile) { (void)profile; return false; }
+    virtual void GetFrameStatistics(VGPUFrameStatistics* statistics) { *statistics = {}; }
+
+    // Backends with timestamp queries override these to add GPU spans, the base only records CPU spans.
+    virtual bool BeginTrace(const char* path)
+    {
+        std::lock_guard<std::mutex> lock(traceMutex);
+        if (trace != nullptr)
+            return false;
+
+        trace.reset(CreateTraceRecorder(path));
+        tracing.store(trace != nullptr, std::memory_order_release);
+        return trace != nullptr;
+    }
+
+    // Scopes still open on other threads keep the recorder alive, their spans miss the written file.
+    virtual bool EndTrace()
+    {
+        std::shared_ptr<VGPUTraceRecorder> endedTrace;
+        {
+            std::lock_guard<std::mutex> lock(traceMutex);
+            endedTrace = std::move(trace);
+            tracing.store(false, std::memory_order_release);
+        }
+
+        return endedTrace != nullptr && endedTrace->Write();
+    }
+
+    // Null when not tracing, only an atomic load unless a trace is running.
+    std::shared_ptr<VGPUTraceRecorder> GetTrace()
+    {
+        if (!tracing.load(std::memory_order_acquire))
+            return nullptr;
+
+        std::lock_guard<std::mutex> lock(traceMutex);
+        return trace;
+    }
+
+    bool BeginCapture(const char* path)
+    {
+        std::lock_guard<std::mutex> lock(captureMutex);
+        if (capture != nullptr)
+            return false;
+
+        capture.reset(CreateCaptureRecorder(path, GetBackendType()));
+        capturing.store(capture != nullptr, std::memory_order_release);
+        return capture != nullptr;
+    }
+
+    // Calls still running on other threads keep the recorder alive, they miss the written file.
+    bool EndCapture()
+    {
+        std::shared_ptr<VGPUCaptureRecorder> endedCapture;
+        {
+            std::lock_guard<std::mutex> lock(captureMutex);
+            if (capture == nullptr)
+                return false;
+
+            // Their submit would hand the recording wrappers to the backend.
+            if (capture->HasPendingCommandBuffers())
+            {
+                vgpuLogError("Command buffers begun during the capture must be submitted before it ends");
+                return false;
+            }
+
+            endedCapture = std::move(capture);
+            capturing.store(false, std::memory_order_release);
+        }
+
+        return endedCapture->Finish();
+    }
+
+    // Null when not capturing, only an atomic load unless a capture is running.
+    std::shared_ptr<VGPUCaptureRecorder> GetCapture()
+    {
+        if (!capturing.load(std::memory_order_acquire))
+            return nullptr;
+
+        std::lock_guard<std::mutex> lock(captureMutex);
+        return capture;
+    }
+
+    // Wraps under the lock, so EndCapture either sees the new command buffer as pending or it is not wrapped.
+    VGPUCommandBuffer CaptureCommandBuffer(VGPUCommandBuffer commandBuffer, const char* label)
+    {
+        if (!capturing.load(std::memory_order_acquire))
+            return commandBuffer;
+
+        std::lock_guard<std::mutex> lock(captureMutex);
+        return capture ? capture->BeginCommandBuffer(commandBuffer, label) : commandBuffer;
+    }
+
+    // The recorder outlives the mode, command buffers begun before it was disabled still translate at submit.
+    void SetDeferredRecording(bool enabled)
+    {
+        if (enabled && deferred == nullptr)
+            deferred = CreateDeferredRecorder();
+
+        deferredRecording = enabled;
+    }
+
+    // Backends without placed resources return false, the render graph then pools whole resources instead of aliasing memory.
+    virtual bool GetBufferAllocationRequirements(const VGPUBufferDesc* desc, VGPUAllocationRequirements* requirements) { (void)desc; (void)requirements; return false; }
+    virtual bool GetTextureAllocationRequirements(const VGPUTextureDesc* desc, VGPUAllocationRequirements* requirements) { (void)desc; (void)requirements; return false; }
+    // A zero alignment gives the heap its own memory block, so any placement alignment holds relative to offset 0.
+    virtual VGPUMemoryHeap CreateMemoryHeap(const VGPUAllocationRequirements* requirements, VGPUMemoryClass memoryClass) { (void)requirements; (void)memoryClass; return nullptr; }
+    virtual VGPUBuffer CreatePlacedBuffer(VGPUMemoryHeap heap, uint64_t offset, const VGPUBufferDesc* desc) { (void)heap; (void)offset; (void)desc; return nullptr; }
+    virtual VGPUTexture CreatePlacedTexture(VGPUMemoryHeap heap, uint64_t offset, const VGPUTextureDesc* desc) { (void)heap; (void)offset; (void)desc; return nullptr; }
+
     uint64_t GetFrameCount() const { return frameCount; }
     uint32_t GetFrameIndex() const { return frameIndex; }
 
+    // Called by backends once per submit, reports each heap once when its usage goes over budget.
+    void CheckMemoryBudget()
+    {
+        if (memoryBudgetCallback == nullptr)
+            return;
+
+        VGPUMemoryBudget budget;
+        GetMemoryBudget(&budget);
+
+        for (uint32_t i = 0; i < budget.heapCount; ++i)
+        {
+            const uint32_t heapBit = 1u << i;
+            if (budget.heaps[i].usage <= budget.heaps[i].budget)
+            {
+                overBudgetHeapMask &= ~heapBit;
+            }
+            else if ((overBudgetHeapMask & heapBit) == 0)
+            {
+                overBudgetHeapMask |= heapBit;
+                memoryBudgetCallback(this, i, &budget.heaps[i], memoryBudgetUserData);
+            }
+        }
+    }
+
     uint64_t frameCount = 0;
     uint32_t frameIndex = 0;
+
+    // Invoked by the backend after a submit pushed a heap over its budget.
+    VGPUMemoryBudgetCallback memoryBudgetCallback = nullptr;
+    void* memoryBudgetUserData = nullptr;
+    uint32_t overBudgetHeapMask = 0;
+
+    // Set between vgpuDeviceBeginTrace and vgpuDeviceEndTrace, read through GetTrace from any thread.
+    std::shared_ptr<VGPUTraceRecorder> trace;
+    std::atomic<bool> tracing{ false };
+    std::mutex traceMutex;
+    // Set between vgpuDeviceBeginCapture and vgpuDeviceEndCapture, read through GetCapture from any thread.
+    std::shared_ptr<VGPUCaptureRecorder> capture;
+    std::atomic<bool> capturing{ false };
+    std::mutex captureMutex;
+    // Created by the first vgpuDeviceSetDeferredRecording, new command buffers are deferred while deferredRecording is set.
+    VGPUDeferredRecorder* deferred = nullptr;
+    bool deferredRecording = false;
+};
+
+/// Records a CPU span on the device trace for the lifetime of the scope, only an atomic load when not tracing.
+class VGPUTraceScope final
+{
+public:
+    VGPUTraceScope(VGPUDeviceImpl* device, const char* name_)
+        : trace(device->GetTrace())
+        , name(name_)
+        , begin(trace ? VGPUTraceRecorder::Now() : 0)
+    {
+    }
+
+    ~VGPUTraceScope()
+    {
+        if (trace)
+            trace->AddCpuSpan(name, begin, VGPUTraceRecorder::Now());
+    }
+
+    VGPUTraceScope(const VGPUTraceScope&) = delete;
+    VGPUTraceScope& operator=(const VGPUTraceScope&) = delete;
+
+private:
+    std::shared_ptr<VGPUTraceRecorder> trace;
+    const char* name;
+    uint64_t begin;
 };
 
 struct VGPUInstanceImpl : public VGPUObject
@@ -308,6 +682,38 @@ struct VGPUInstanceImpl : public VGPUObject
 
 };
 
+struct VGPURenderGraphImpl : public VGPUObject
+{
+public:
+    virtual VGPURenderGraphResource CreateTexture(const VGPUTextureDesc* desc) = 0;
+    virtual VGPURenderGraphResource CreateBuffer(const VGPUBufferDesc* desc) = 0;
+    virtual VGPURenderGraphResource ImportTexture(VGPUTexture texture) = 0;
+    virtual VGPURenderGraphResource ImportBuffer(VGPUBuffer buffer) = 0;
+    virtual VGPURenderGraphResource ImportSwapChain(VGPUSwapChain swapChain) = 0;
+    virtual void AddPass(const VGPURenderGraphPassDesc* desc) = 0;
+    virtual VGPUTexture GetTexture(VGPURenderGraphResource resource) const = 0;
+    virtual VGPUBuffer GetBuffer(VGPURenderGraphResource resource) const = 0;
+    virtual uint64_t Execute() = 0;
+    virtual void GetStatistics(VGPURenderGraphStatistics* statistics) const = 0;
+};
+
+/// Backend independent render graph recording through VGPUCommandBufferImpl, see vgpu_render_graph.cpp.
+VGPURenderGraphImpl* CreateRenderGraph(VGPUDeviceImpl* device);
+
+struct VGPUReadbackRingImpl : public VGPUObject
+{
+public:
+    virtual VGPUReadbackTicket CopyBuffer(VGPUCommandBuffer commandBuffer, VGPUBuffer buffer, uint64_t offset, uint64_t size) = 0;
+    virtual VGPUReadbackTicket CopyTexture(VGPUCommandBuffer commandBuffer, const VGPUTextureCopyLocation* source, const VGPUExtent3D* extent) = 0;
+    virtual bool IsReady(VGPUReadbackTicket ticket) = 0;
+    virtual bool Wait(VGPUReadbackTicket ticket, uint64_t timeout) = 0;
+    virtual bool GetData(VGPUReadbackTicket ticket, VGPUReadbackData* data) = 0;
+    virtual void Free(VGPUReadbackTicket ticket) = 0;
+};
+
+/// Backend independent readback sub-allocator over a host readable buffer, see vgpu_readback.cpp.
+VGPUReadbackRingImpl* CreateReadbackRing(VGPUDeviceImpl* device, uint64_t size);
+
 typedef struct VGPUDriver
 {
     VGPUBackend backend;
@@ -320,5 +726,6 @@ typedef struct VGPUDriver
 _VGPU_EXTERN VGPUDriver Vulkan_Driver;
 _VGPU_EXTERN VGPUDriver D3D12_Driver;
 _VGPU_EXTERN VGPUDriver WGPU_Driver;
+_VGPU_EXTERN VGPUDriver Null_Driver;
 
 #endif /* _VGPU_DRIVER_H_ */
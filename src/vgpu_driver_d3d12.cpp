@@ -1059,6 +1059,7 @@ struct D3D12Buffer final : public VGPUBufferImpl, public D3D12Resource
     uint64_t GetSize() const override { return size; }
     VGPUBufferUsageFlags GetUsage() const override { return usage; }
     VGPUDeviceAddress GetGpuAddress() const override { return gpuAddress; }
+    void* GetMappedData() const override { return pMappedData; }
 };
 
 struct D3D12Texture final : public VGPUTextureImpl, public D3D12Resource
@@ -1084,6 +1085,7 @@ struct D3D12Texture final : public VGPUTextureImpl, public D3D12Resource
 
     VGPUTextureDimension GetDimension() const override { return desc.dimension; }
     VGPUTextureFormat GetFormat() const override { return desc.format; }
+    VGPUTextureUsageFlags GetUsage() const override { return desc.usage; }
 };
 
 struct D3D12Sampler final : public VGPUSamplerImpl
@@ -1238,6 +1240,7 @@ private:
 
 public:
     ~D3D12CommandBuffer() override;
+    VGPUCommandQueue GetQueueType() const override { return queueType; }
     void Reset();
     void Begin(uint32_t frameIndex, const char* label);
 
@@ -1394,6 +1397,11 @@ public:
 
     VGPUCommandBuffer BeginCommandBuffer(VGPUCommandQueue queueType, const char* label) override;
     uint64_t Submit(VGPUCommandBuffer* commandBuffers, uint32_t count) override;
+    uint64_t GetCompletedValue(VGPUCommandQueue queue) override;
+
+    void GetMemoryBudget(VGPUMemoryBudget* budget) override;
+    void GetMemoryStatistics(VGPUMemoryStatistics* statistics) override;
+    size_t GetMemoryDump(bool detailed, char* data, size_t dataSize) override;
 
     void* GetNativeObject(VGPUNativeObjectType objectType) const override;
 
@@ -2389,6 +2397,7 @@ void D3D12CommandBuffer::BeginRenderPass(const VGPURenderPassDesc* desc)
     uint32_t numRTVS = 0;
     D3D12_RENDER_PASS_FLAGS renderPassFlags = D3D12_RENDER_PASS_FLAG_NONE;
     D3D12_RENDER_PASS_DEPTH_STENCIL_DESC DSV = {};
+    D3D12_RENDER_PASS_ENDING_ACCESS_RESOLVE_SUBRESOURCE_PARAMETERS resolveSubresources[VGPU_MAX_COLOR_ATTACHMENTS] = {};
 
     if (desc->label)
     {
@@ -2408,8 +2417,13 @@ void D3D12CommandBuffer::BeginRenderPass(const VGPURenderPassDesc* desc)
         // Transition to RenderTarget
         TransitionResource(texture, D3D12_RESOURCE_STATE_RENDER_TARGET, true);
 
-        RTVs[numRTVS].BeginningAccess.Type = ToD3D12(attachment->loadAction);
-        if (attachment->loadAction == VGPULoadAction_Clear)
+        // Transient contents never survive the pass, there is nothing to load or store.
+        const bool transient = (texture->desc.usage & VGPUTextureUsage_Transient) != 0;
+        const VGPULoadAction loadAction = (transient && attachment->loadAction == VGPULoadAction_Load) ? VGPULoadAction_DontCare : attachment->loadAction;
+        const VGPUStoreAction storeAction = transient ? VGPUStoreAction_DontCare : attachment->storeAction;
+
+        RTVs[numRTVS].BeginningAccess.Type = ToD3D12(loadAction);
+        if (loadAction == VGPULoadAction_Clear)
         {
             RTVs[numRTVS].BeginningAccess.Clear.ClearValue.Format = texture->dxgiFormat;
             RTVs[numRTVS].BeginningAccess.Clear.ClearValue.Color[0] = attachment->clearColor.r;
@@ -2418,12 +2432,38 @@ void D3D12CommandBuffer::BeginRenderPass(const VGPURenderPassDesc* desc)
             RTVs[numRTVS].BeginningAccess.Clear.ClearValue.Color[3] = attachment->clearColor.a;
         }
 
-        // TODO: Resolve
-        RTVs[numRTVS].EndingAccess.Type = ToD3D12(attachment->storeAction);
+        RTVs[numRTVS].EndingAccess.Type = ToD3D12(storeAction);
 
         width = _VGPU_MIN(width, _VGPU_MAX(1U, texture->desc.width >> level));
         height = _VGPU_MIN(height, _VGPU_MAX(1U, texture->desc.height >> level));
 
+        const VGPUFormatKind formatKind = vgpuGetPixelFormatKind(texture->desc.format);
+        const bool integerFormat = formatKind == VGPUFormatKind_Uint || formatKind == VGPUFormatKind_Sint;
+        if (attachment->resolveTexture != nullptr && integerFormat)
+        {
+            // Integer resolves take sample 0, render pass resolves only offer MIN/MAX/AVERAGE so they are refused instead.
+            vgpuLogError("D3D12: Resolving integer color formats is not supported");
+        }
+        else if (attachment->resolveTexture != nullptr)
+        {
+            D3D12Texture* resolveTexture = (D3D12Texture*)attachment->resolveTexture;
+            TransitionResource(resolveTexture, D3D12_RESOURCE_STATE_RESOLVE_DEST, true);
+
+            D3D12_RENDER_PASS_ENDING_ACCESS_RESOLVE_SUBRESOURCE_PARAMETERS& subresource = resolveSubresources[numRTVS];
+            subresource.SrcSubresource = level + slice * texture->desc.mipLevelCount;
+            subresource.DstSubresource = attachment->resolveLevel + attachment->resolveSlice * resolveTexture->desc.mipLevelCount;
+            subresource.SrcRect = { 0, 0, LONG(_VGPU_MAX(1U, texture->desc.width >> level)), LONG(_VGPU_MAX(1U, texture->desc.height >> level)) };
+
+            RTVs[numRTVS].EndingAccess.Type = D3D12_RENDER_PASS_ENDING_ACCESS_TYPE_RESOLVE;
+            RTVs[numRTVS].EndingAccess.Resolve.pSrcResource = texture->handle;
+            RTVs[numRTVS].EndingAccess.Resolve.pDstResource = resolveTexture->handle;
+            RTVs[numRTVS].EndingAccess.Resolve.SubresourceCount = 1;
+            RTVs[numRTVS].EndingAccess.Resolve.pSubresourceParameters = &subresource;
+            RTVs[numRTVS].EndingAccess.Resolve.Format = texture->dxgiFormat;
+            RTVs[numRTVS].EndingAccess.Resolve.ResolveMode = D3D12_RESOLVE_MODE_AVERAGE;
+            RTVs[numRTVS].EndingAccess.Resolve.PreserveResolveSource = storeAction == VGPUStoreAction_Store;
+        }
+
         numRTVS++;
     }
 
@@ -2440,21 +2480,25 @@ void D3D12CommandBuffer::BeginRenderPass(const VGPURenderPassDesc* desc)
 
         DSV.cpuDescriptor = texture->GetDSV(level, slice);
 
-        DSV.DepthBeginningAccess.Type = ToD3D12(attachment->depthLoadAction);
-        if (attachment->depthLoadAction == VGPULoadAction_Clear)
+        const bool transient = (texture->desc.usage & VGPUTextureUsage_Transient) != 0;
+        const VGPULoadAction depthLoadAction = (transient && attachment->depthLoadAction == VGPULoadAction_Load) ? VGPULoadAction_DontCare : attachment->depthLoadAction;
+        const VGPULoadAction stencilLoadAction = (transient && attachment->stencilLoadAction == VGPULoadAction_Load) ? VGPULoadAction_DontCare : attachment->stencilLoadAction;
+
+        DSV.DepthBeginningAccess.Type = ToD3D12(depthLoadAction);
+        if (depthLoadAction == VGPULoadAction_Clear)
         {
             DSV.DepthBeginningAccess.Clear.ClearValue.Format = texture->dxgiFormat;
             DSV.DepthBeginningAccess.Clear.ClearValue.DepthStencil.Depth = attachment->depthClearValue;
         }
-        DSV.DepthEndingAccess.Type = ToD3D12(attachment->depthStoreAction);
+        DSV.DepthEndingAccess.Type = ToD3D12(transient ? VGPUStoreAction_DontCare : attachment->depthStoreAction);
 
-        DSV.StencilBeginningAccess.Type = ToD3D12(attachment->stencilLoadAction);
-        if (attachment->stencilLoadAction == VGPULoadAction_Clear)
+        DSV.StencilBeginningAccess.Type = ToD3D12(stencilLoadAction);
+        if (stencilLoadAction == VGPULoadAction_Clear)
         {
             DSV.StencilBeginningAccess.Clear.ClearValue.Format = texture->dxgiFormat;
             DSV.StencilBeginningAccess.Clear.ClearValue.DepthStencil.Stencil = static_cast<UINT8>(attachment->stencilClearValue);
         }
-        DSV.StencilEndingAccess.Type = ToD3D12(attachment->stencilStoreAction);
+        DSV.StencilEndingAccess.Type = ToD3D12(transient ? VGPUStoreAction_DontCare : attachment->stencilStoreAction);
     }
 
     commandList->BeginRenderPass(numRTVS, RTVs, hasDepthStencil ? &DSV : nullptr, renderPassFlags);
@@ -4929,7 +4973,8 @@ uint64_t D3D12Device::Submit(VGPUCommandBuffer* commandBuffers, uint32_t count)
             queue.submitCommandLists.clear();
         }
 
-        VHR(queue.handle->Signal(queue.frameFences[frameIndex], 1));
+        // Frame fences take the submission value, it keeps increasing so a reused slot never looks complete early.
+        VHR(queue.handle->Signal(queue.frameFences[frameIndex], frameCount + 1));
     }
 
     cmdBuffersCount = 0;
@@ -4968,14 +5013,16 @@ uint64_t D3D12Device::Submit(VGPUCommandBuffer* commandBuffers, uint32_t count)
     frameCount++;
     frameIndex = frameCount % VGPU_MAX_INFLIGHT_FRAMES;
 
+    // The slot was last signaled by the submit VGPU_MAX_INFLIGHT_FRAMES frames ago.
+    const uint64_t slotValue = frameCount >= VGPU_MAX_INFLIGHT_FRAMES ? frameCount - VGPU_MAX_INFLIGHT_FRAMES + 1 : 0;
     for (uint32_t queue = 0; queue < _VGPUCommandQueue_Count; ++queue)
     {
-        if (frameCount >= VGPU_MAX_INFLIGHT_FRAMES &&
-            queues[queue].frameFences[frameIndex]->GetCompletedValue() < 1)
+        if (slotValue > 0 &&
+            queues[queue].frameFences[frameIndex]->GetCompletedValue() < slotValue)
         {
             // NULL event handle will simply wait immediately:
             // https://docs.microsoft.com/en-us/windows/win32/api/d3d12/nf-d3d12-id3d12fence-seteventoncompletion#remarks
-            hr = queues[queue].frameFences[frameIndex]->SetEventOnCompletion(1, nullptr);
+            hr = queues[queue].frameFences[frameIndex]->SetEventOnCompletion(slotValue, nullptr);
             VHR(hr);
         }
     }
@@ -4983,9 +5030,103 @@ uint64_t D3D12Device::Submit(VGPUCommandBuffer* commandBuffers, uint32_t count)
     // Begin new frame
     // Safe delete deferred destroys
     ProcessDeletionQueue();
+    CheckMemoryBudget();
+
+    return frameCount;
+}
+
+uint64_t D3D12Device::GetCompletedValue(VGPUCommandQueue queue)
+{
+    if (queues[queue].handle == nullptr)
+        return 0;
+
+    // The queue executes in order, the highest value any slot fence reached is the last completed submission.
+    uint64_t value = 0;
+    for (uint32_t i = 0; i < VGPU_MAX_INFLIGHT_FRAMES; ++i)
+    {
+        if (queues[queue].frameFences[i] != nullptr)
+            value = _VGPU_MAX(value, queues[queue].frameFences[i]->GetCompletedValue());
+    }
+    return value;
+}
+
+void D3D12Device::GetMemoryBudget(VGPUMemoryBudget* budget)
+{
+    D3D12MA::Budget localBudget = {};
+    D3D12MA::Budget nonLocalBudget = {};
+    allocator->GetBudget(&localBudget, &nonLocalBudget);
+
+    // Heap 0 is video memory, heap 1 system memory; UMA adapters only have the first.
+    *budget = {};
+    budget->heapCount = allocator->IsUMA() ? 1u : 2u;
+    const D3D12MA::Budget* budgets[2] = { &localBudget, &nonLocalBudget };
+    for (uint32_t i = 0; i < budget->heapCount; ++i)
+    {
+        budget->heaps[i].budget = budgets[i]->BudgetBytes;
+        budget->heaps[i].usage = budgets[i]->UsageBytes;
+        budget->heaps[i].blockBytes = budgets[i]->Stats.BlockBytes;
+        budget->heaps[i].allocationBytes = budgets[i]->Stats.AllocationBytes;
+        budget->heaps[i].deviceLocal = i == 0;
+    }
+}
+
+static void ToMemoryTypeStatistics(const D3D12MA::DetailedStatistics& source, uint32_t heapIndex, VGPUMemoryTypeStatistics* statistics)
+{
+    statistics->heapIndex = heapIndex;
+    statistics->blockCount = source.Stats.BlockCount;
+    statistics->allocationCount = source.Stats.AllocationCount;
+    statistics->unusedRangeCount = source.UnusedRangeCount;
+    statistics->blockBytes = source.Stats.BlockBytes;
+    statistics->allocationBytes = source.Stats.AllocationBytes;
+    statistics->allocationSizeMin = source.Stats.AllocationCount > 0 ? source.AllocationSizeMin : 0;
+    statistics->allocationSizeMax = source.AllocationSizeMax;
+    statistics->unusedRangeSizeMax = source.UnusedRangeCount > 0 ? source.UnusedRangeSizeMax : 0;
+
+    const uint64_t unusedBytes = source.Stats.BlockBytes - source.Stats.AllocationBytes;
+    statistics->fragmentation = unusedBytes > 0 ? 1.0f - float(double(statistics->unusedRangeSizeMax) / double(unusedBytes)) : 0.0f;
+}
+
+void D3D12Device::GetMemoryStatistics(VGPUMemoryStatistics* statistics)
+{
+    D3D12MA::TotalStatistics totalStatistics;
+    allocator->CalculateStatistics(&totalStatistics);
+
+    // Memory types are the D3D12 heap types: default, upload, readback, custom and GPU upload.
+    *statistics = {};
+    statistics->memoryTypeCount = _countof(totalStatistics.HeapType);
+    for (uint32_t i = 0; i < statistics->memoryTypeCount; ++i)
+    {
+        const bool systemMemory = !allocator->IsUMA() && (i == 1 || i == 2);
+        ToMemoryTypeStatistics(totalStatistics.HeapType[i], systemMemory ? 1u : 0u, &statistics->memoryTypes[i]);
+    }
+    ToMemoryTypeStatistics(totalStatistics.Total, UINT32_MAX, &statistics->total);
+}
+
+size_t D3D12Device::GetMemoryDump(bool detailed, char* data, size_t dataSize)
+{
+    WCHAR* statsString = nullptr;
+    allocator->BuildStatsString(&statsString, detailed ? TRUE : FALSE);
+    if (statsString == nullptr)
+        return 0;
+
+    size_t size = 0;
+    const int requiredSize = WideCharToMultiByte(CP_UTF8, 0, statsString, -1, nullptr, 0, nullptr, nullptr);
+    if (requiredSize > 0)
+    {
+        std::string utf8(requiredSize, '\0');
+        WideCharToMultiByte(CP_UTF8, 0, statsString, -1, utf8.data(), requiredSize, nullptr, nullptr);
+        size = (size_t)requiredSize;
+
+        if (data != nullptr && dataSize > 0)
+        {
+            const size_t copySize = _VGPU_MIN(size, dataSize);
+            memcpy(data, utf8.data(), copySize);
+            data[copySize - 1] = '\0';
+        }
+    }
 
-    // Return current frame
-    return frameCount - 1;
+    allocator->FreeStatsString(statsString);
+    return size;
 }
 
 static bool d3d12_isSupported(void)
@@ -0,0 +1,576 @@
+// Copyright (c) Amer Koleci and Contributors.
+// Licensed under the MIT License (MIT). See LICENSE in the repository root for more information.
+
+#if defined(VGPU_NULL_DRIVER)
+
+#include "vgpu_driver.h"
+#include <memory>
+
+/// Backend without a GPU: objects are real, reference counted allocations and command buffers are pooled and
+/// count what they record, but nothing executes. Work completes the moment it is submitted.
+namespace
+{
+    // Fake GPU virtual addresses, spaced like real allocations so address math stays meaningful.
+    constexpr uint64_t kAddressAlignment = 256u;
+    constexpr uint64_t kAllocatorChunkSize = 64u * 1024u;
+}
+
+struct NullDevice;
+
+struct NullBuffer final : public VGPUBufferImpl
+{
+    NullDevice* device = nullptr;
+    uint64_t size = 0;
+    VGPUBufferUsageFlags usage = 0;
+    VGPUDeviceAddress address = 0;
+    // Host memory only backs buffers with CPU access.
+    std::unique_ptr<uint8_t[]> memory;
+
+    ~NullBuffer() override;
+    void SetLabel(const char* label) override { VGPU_UNUSED(label); }
+    uint64_t GetSize() const override { return size; }
+    VGPUBufferUsageFlags GetUsage() const override { return usage; }
+    VGPUDeviceAddress GetGpuAddress() const override { return address; }
+    void* GetMappedData() const override { return memory.get(); }
+};
+
+struct NullTexture final : public VGPUTextureImpl
+{
+    NullDevice* device = nullptr;
+    VGPUTextureDesc desc{};
+
+    ~NullTexture() override;
+    void SetLabel(const char* label) override { VGPU_UNUSED(label); }
+    VGPUTextureDimension GetDimension() const override { return desc.dimension; }
+    VGPUTextureFormat GetFormat() const override { return desc.format; }
+    VGPUTextureUsageFlags GetUsage() const override { return desc.usage; }
+};
+
+struct NullSampler final : public VGPUSamplerImpl
+{
+    void SetLabel(const char* label) override { VGPU_UNUSED(label); }
+};
+
+struct NullBindGroupLayout final : public VGPUBindGroupLayoutImpl
+{
+    void SetLabel(const char* label) override { VGPU_UNUSED(label); }
+};
+
+struct NullPipelineLayout final : public VGPUPipelineLayoutImpl
+{
+    std::vector<VGPUBindGroupLayout> bindGroupLayouts;
+
+    ~NullPipelineLayout() override
+    {
+        for (VGPUBindGroupLayout layout : bindGroupLayouts)
+            layout->Release();
+    }
+
+    void SetLabel(const char* label) override { VGPU_UNUSED(label); }
+};
+
+struct NullBindGroup final : public VGPUBindGroupImpl
+{
+    VGPUBindGroupLayout layout = nullptr;
+
+    ~NullBindGroup() override { layout->Release(); }
+    void SetLabel(const char* label) override { VGPU_UNUSED(label); }
+    void Update(size_t entryCount, const VGPUBindGroupEntry* entries) override { VGPU_UNUSED(entryCount); VGPU_UNUSED(entries); }
+};
+
+struct NullPipeline final : public VGPUPipelineImpl
+{
+    VGPUPipelineType type = VGPUPipelineType_Render;
+    VGPUPipelineLayout layout = nullptr;
+
+    ~NullPipeline() override { layout->Release(); }
+    void SetLabel(const char* label) override { VGPU_UNUSED(label); }
+    VGPUPipelineType GetType() const override { return type; }
+};
+
+struct NullQueryHeap final : public VGPUQueryHeapImpl
+{
+    VGPUQueryType type = VGPUQueryType_Timestamp;
+    uint32_t count = 0;
+
+    void SetLabel(const char* label) override { VGPU_UNUSED(label); }
+    VGPUQueryType GetType() const override { return type; }
+    uint32_t GetCount() const override { return count; }
+};
+
+struct NullSwapChain final : public VGPUSwapChainImpl
+{
+    VGPUTexture backbufferTexture = nullptr;
+    VGPUTextureFormat format = VGPUTextureFormat_Undefined;
+    uint32_t width = 0;
+    uint32_t height = 0;
+
+    ~NullSwapChain() override { backbufferTexture->Release(); }
+    void SetLabel(const char* label) override { VGPU_UNUSED(label); }
+    VGPUTextureFormat GetFormat() const override { return format; }
+    uint32_t GetWidth() const override { return width; }
+    uint32_t GetHeight() const override { return height; }
+};
+
+struct NullCommandBuffer final : public VGPUCommandBufferImpl
+{
+    NullDevice* device = nullptr;
+    VGPUCommandQueue queueType = VGPUCommandQueue_Graphics;
+    VGPUFrameStatistics statistics{};
+
+    // Linear allocator for vgpuCommandBufferAllocate, chunks are kept across frames.
+    std::vector<VGPUBuffer> allocatorChunks;
+    uint32_t allocatorChunk = 0;
+    uint64_t allocatorOffset = 0;
+
+    ~NullCommandBuffer() override;
+    void Begin();
+
+    VGPUCommandQueue GetQueueType() const override { return queueType; }
+
+    void PushDebugGroup(const char* groupLabel) override { VGPU_UNUSED(groupLabel); }
+    void PopDebugGroup() override {}
+    void InsertDebugMarker(const char* markerLabel) override { VGPU_UNUSED(markerLabel); }
+
+    void ClearBuffer(VGPUBuffer buffer, uint64_t offset, uint64_t size) override;
+    VGPUBufferAllocation Allocate(uint64_t size, uint64_t alignment) override;
+
+    void CopyBufferToBuffer(VGPUBuffer source, uint64_t sourceOffset, VGPUBuffer destination, uint64_t destinationOffset, uint64_t size) override;
+    void CopyBufferToTexture(const VGPUBufferCopyLocation* source, const VGPUTextureCopyLocation* destination, const VGPUExtent3D* extent) override { VGPU_UNUSED(source); VGPU_UNUSED(destination); VGPU_UNUSED(extent); }
+    void CopyTextureToBuffer(const VGPUTextureCopyLocation* source, const VGPUBufferCopyLocation* destination, const VGPUExtent3D* extent) override { VGPU_UNUSED(source); VGPU_UNUSED(destination); VGPU_UNUSED(extent); }
+    void CopyTextureToTexture(const VGPUTextureCopyLocation* source, const VGPUTextureCopyLocation* destination, const VGPUExtent3D* extent) override { VGPU_UNUSED(source); VGPU_UNUSED(destination); VGPU_UNUSED(extent); }
+
+    void SetPipeline(VGPUPipeline pipeline) override { VGPU_UNUSED(pipeline); statistics.pipelineBindCount++; }
+    void SetBindGroup(uint32_t groupIndex, VGPUBindGroup bindGroup) override { VGPU_UNUSED(groupIndex); VGPU_UNUSED(bindGroup); statistics.bindGroupBindCount++; }
+    void SetPushConstants(uint32_t pushConstantIndex, const void* data, uint32_t size) override { VGPU_UNUSED(pushConstantIndex); VGPU_UNUSED(data); VGPU_UNUSED(size); }
+
+    void Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) override { VGPU_UNUSED(groupCountX); VGPU_UNUSED(groupCountY); VGPU_UNUSED(groupCountZ); statistics.dispatchCount++; }
+    void DispatchIndirect(VGPUBuffer buffer, uint64_t offset) override { VGPU_UNUSED(buffer); VGPU_UNUSED(offset); statistics.dispatchCount++; }
+
+    VGPUTexture AcquireSwapchainTexture(VGPUSwapChain swapChain) override { return static_cast<NullSwapChain*>(swapChain)->backbufferTexture; }
+    void BeginRenderPass(const VGPURenderPassDesc* desc) override { VGPU_UNUSED(desc); }
+    void EndRenderPass() override {}
+
+    void SetViewport(const VGPUViewport* viewport) override { VGPU_UNUSED(viewport); }
+    void SetViewports(uint32_t count, const VGPUViewport* viewports) override { VGPU_UNUSED(count); VGPU_UNUSED(viewports); }
+    void SetScissorRect(const VGPURect* rect) override { VGPU_UNUSED(rect); }
+    void SetScissorRects(uint32_t count, const VGPURect* rects) override { VGPU_UNUSED(count); VGPU_UNUSED(rects); }
+
+    void SetVertexBuffer(uint32_t index, VGPUBuffer buffer, uint64_t offset) override { VGPU_UNUSED(index); VGPU_UNUSED(buffer); VGPU_UNUSED(offset); }
+    void SetIndexBuffer(VGPUBuffer buffer, VGPUIndexType type, uint64_t offset) override { VGPU_UNUSED(buffer); VGPU_UNUSED(type); VGPU_UNUSED(offset); }
+    void SetStencilReference(uint32_t reference) override { VGPU_UNUSED(reference); }
+
+    void BeginQuery(VGPUQueryHeap heap, uint32_t index) override { VGPU_UNUSED(heap); VGPU_UNUSED(index); }
+    void EndQuery(VGPUQueryHeap heap, uint32_t index) override { VGPU_UNUSED(heap); VGPU_UNUSED(index); }
+    void ResolveQuery(VGPUQueryHeap heap, uint32_t index, uint32_t count, VGPUBuffer destinationBuffer, uint64_t destinationOffset) override;
+    void ResetQuery(VGPUQueryHeap heap, uint32_t index, uint32_t count) override { VGPU_UNUSED(heap); VGPU_UNUSED(index); VGPU_UNUSED(count); }
+
+    void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) override { VGPU_UNUSED(vertexCount); VGPU_UNUSED(instanceCount); VGPU_UNUSED(firstVertex); VGPU_UNUSED(firstInstance); statistics.drawCount++; }
+    void DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t baseVertex, uint32_t firstInstance) override { VGPU_UNUSED(indexCount); VGPU_UNUSED(instanceCount); VGPU_UNUSED(firstIndex); VGPU_UNUSED(baseVertex); VGPU_UNUSED(firstInstance); statistics.drawCount++; }
+    void DrawIndirect(VGPUBuffer indirectBuffer, uint64_t indirectBufferOffset) override { VGPU_UNUSED(indirectBuffer); VGPU_UNUSED(indirectBufferOffset); statistics.drawCount++; }
+    void DrawIndexedIndirect(VGPUBuffer indirectBuffer, uint64_t indirectBufferOffset) override { VGPU_UNUSED(indirectBuffer); VGPU_UNUSED(indirectBufferOffset); statistics.drawCount++; }
+
+    void DispatchMesh(uint32_t threadGroupCountX, uint32_t threadGroupCountY, uint32_t threadGroupCountZ) override { VGPU_UNUSED(threadGroupCountX); VGPU_UNUSED(threadGroupCountY); VGPU_UNUSED(threadGroupCountZ); statistics.drawCount++; }
+    void DispatchMeshIndirect(VGPUBuffer indirectBuffer, uint64_t indirectBufferOffset) override { VGPU_UNUSED(indirectBuffer); VGPU_UNUSED(indirectBufferOffset); statistics.drawCount++; }
+    void DispatchMeshIndirectCount(VGPUBuffer indirectBuffer, uint64_t indirectBufferOffset, VGPUBuffer countBuffer, uint64_t countBufferOffset, uint32_t maxCount) override { VGPU_UNUSED(indirectBuffer); VGPU_UNUSED(indirectBufferOffset); VGPU_UNUSED(countBuffer); VGPU_UNUSED(countBufferOffset); VGPU_UNUSED(maxCount); statistics.drawCount++; }
+};
+
+struct NullDevice final : public VGPUDeviceImpl
+{
+public:
+    std::atomic<uint64_t> nextAddress{ kAddressAlignment };
+
+    std::mutex commandBuffersMutex;
+    std::vector<NullCommandBuffer*> commandBuffersPool;
+    uint32_t commandBuffersCount = 0;
+
+    std::atomic<uint32_t> resourcesCreated{ 0 };
+    std::atomic<uint32_t> resourcesDestroyed{ 0 };
+    VGPUFrameStatistics frameStatistics{};
+
+    ~NullDevice() override;
+
+    void SetLabel(const char* label) override { VGPU_UNUSED(label); }
+    void WaitIdle() override {}
+    VGPUBackend GetBackendType() const override { return VGPUBackend_Null; }
+    VGPUBool32 QueryFeatureSupport(VGPUFeature feature) const override { VGPU_UNUSED(feature); return false; }
+    void GetAdapterProperties(VGPUAdapterProperties* properties) const override;
+    void GetLimits(VGPULimits* limits) const override;
+    uint64_t GetTimestampFrequency() const override { return 1000000000ull; }
+
+    VGPUBuffer CreateBuffer(const VGPUBufferDesc* desc, const void* pInitialData) override;
+    VGPUTexture CreateTexture(const VGPUTextureDesc* desc, const VGPUTextureData* pInitialData) override;
+    VGPUSampler CreateSampler(const VGPUSamplerDesc* desc) override;
+
+    VGPUBindGroupLayout CreateBindGroupLayout(const VGPUBindGroupLayoutDesc* desc) override;
+    VGPUPipelineLayout CreatePipelineLayout(const VGPUPipelineLayoutDesc* desc) override;
+    VGPUBindGroup CreateBindGroup(const VGPUBindGroupLayout layout, const VGPUBindGroupDesc* desc) override;
+
+    VGPUPipeline CreateRenderPipeline(const VGPURenderPipelineDesc* desc) override;
+    VGPUPipeline CreateComputePipeline(const VGPUComputePipelineDesc* desc) override;
+    VGPUPipeline CreateRayTracingPipeline(const VGPURayTracingPipelineDesc* desc) override;
+
+    VGPUQueryHeap CreateQueryHeap(const VGPUQueryHeapDesc* desc) override;
+
+    VGPUSwapChain CreateSwapChain(const VGPUSwapChainDesc* desc) override;
+
+    VGPUCommandBuffer BeginCommandBuffer(VGPUCommandQueue queueType, const char* label) override;
+    uint64_t Submit(VGPUCommandBuffer* commandBuffers, uint32_t count) override;
+
+    // Submitted work is complete by the time Submit returns.
+    uint64_t GetCompletedValue(VGPUCommandQueue queue) override { VGPU_UNUSED(queue); return frameCount; }
+    VGPUBool32 WaitValue(VGPUCommandQueue queue, uint64_t value, uint64_t timeout) override { VGPU_UNUSED(queue); VGPU_UNUSED(timeout); return value <= frameCount; }
+
+    void GetFrameStatistics(VGPUFrameStatistics* statistics) override { *statistics = frameStatistics; }
+
+    VGPUPipeline CreatePipeline(VGPUPipelineType type, VGPUPipelineLayout layout);
+};
+
+NullBuffer::~NullBuffer()
+{
+    device->resourcesDestroyed.fetch_add(1, std::memory_order_relaxed);
+}
+
+NullTexture::~NullTexture()
+{
+    device->resourcesDestroyed.fetch_add(1, std::memory_order_relaxed);
+}
+
+/* NullCommandBuffer */
+NullCommandBuffer::~NullCommandBuffer()
+{
+    for (VGPUBuffer chunk : allocatorChunks)
+        chunk->Release();
+}
+
+void NullCommandBuffer::Begin()
+{
+    statistics = {};
+    allocatorChunk = 0;
+    allocatorOffset = 0;
+}
+
+void NullCommandBuffer::ClearBuffer(VGPUBuffer buffer, uint64_t offset, uint64_t size)
+{
+    NullBuffer* nullBuffer = static_cast<NullBuffer*>(buffer);
+    if (nullBuffer->memory)
+    {
+        if (size == VGPU_WHOLE_SIZE)
+            size = nullBuffer->size - offset;
+
+        memset(nullBuffer->memory.get() + offset, 0, size);
+    }
+}
+
+VGPUBufferAllocation NullCommandBuffer::Allocate(uint64_t size, uint64_t alignment)
+{
+    alignment = _VGPU_MAX(alignment, uint64_t(16));
+    allocatorOffset = AlignUp(allocatorOffset, alignment);
+
+    while (allocatorChunk < allocatorChunks.size() && allocatorOffset + size > allocatorChunks[allocatorChunk]->GetSize())
+    {
+        allocatorChunk++;
+        allocatorOffset = 0;
+    }
+
+    if (allocatorChunk == allocatorChunks.size())
+    {
+        VGPUBufferDesc bufferDesc{};
+        bufferDesc.label = "CommandBuffer Allocator";
+        bufferDesc.size = _VGPU_MAX(kAllocatorChunkSize, vgpuNextPowerOfTwo(size));
+        bufferDesc.usage = VGPUBufferUsage_Vertex | VGPUBufferUsage_Index | VGPUBufferUsage_Constant | VGPUBufferUsage_ShaderRead;
+        bufferDesc.cpuAccess = VGPUCpuAccessMode_Write;
+        allocatorChunks.push_back(device->CreateBuffer(&bufferDesc, nullptr));
+        allocatorOffset = 0;
+    }
+
+    NullBuffer* chunk = static_cast<NullBuffer*>(allocatorChunks[allocatorChunk]);
+
+    VGPUBufferAllocation allocation{};
+    allocation.buffer = chunk;
+    allocation.offset = allocatorOffset;
+    allocation.data = chunk->memory.get() + allocatorOffset;
+
+    allocatorOffset += size;
+    statistics.allocatedBytes += size;
+    return allocation;
+}
+
+void NullCommandBuffer::CopyBufferToBuffer(VGPUBuffer source, uint64_t sourceOffset, VGPUBuffer destination, uint64_t destinationOffset, uint64_t size)
+{
+    // Host visible to host visible copies keep readback paths observable.
+    NullBuffer* nullSource = static_cast<NullBuffer*>(source);
+    NullBuffer* nullDestination = static_cast<NullBuffer*>(destination);
+    if (nullSource->memory && nullDestination->memory)
+    {
+        memcpy(nullDestination->memory.get() + destinationOffset, nullSource->memory.get() + sourceOffset, size);
+    }
+}
+
+void NullCommandBuffer::ResolveQuery(VGPUQueryHeap heap, uint32_t index, uint32_t count, VGPUBuffer destinationBuffer, uint64_t destinationOffset)
+{
+    VGPU_UNUSED(heap);
+    VGPU_UNUSED(index);
+
+    NullBuffer* nullBuffer = static_cast<NullBuffer*>(destinationBuffer);
+    if (nullBuffer->memory)
+    {
+        memset(nullBuffer->memory.get() + destinationOffset, 0, count * sizeof(uint64_t));
+    }
+}
+
+/* NullDevice */
+NullDevice::~NullDevice()
+{
+    for (NullCommandBuffer* commandBuffer : commandBuffersPool)
+    {
+        delete commandBuffer;
+    }
+    commandBuffersPool.clear();
+}
+
+void NullDevice::GetAdapterProperties(VGPUAdapterProperties* properties) const
+{
+    properties->vendorId = 0;
+    properties->deviceId = 0;
+    strncpy(properties->name, "Null Device", VGPU_ADAPTER_NAME_MAX_LENGTH - 1);
+    properties->name[VGPU_ADAPTER_NAME_MAX_LENGTH - 1] = '\0';
+    properties->driverDescription = "vgpu null backend";
+    properties->type = VGPUAdapterType_CPU;
+}
+
+void NullDevice::GetLimits(VGPULimits* limits) const
+{
+    *limits = {};
+    limits->maxTextureDimension1D = 16384u;
+    limits->maxTextureDimension2D = 16384u;
+    limits->maxTextureDimension3D = 2048u;
+    limits->maxTextureDimensionCube = 16384u;
+    limits->maxTextureArrayLayers = 2048u;
+    limits->maxConstantBufferBindingSize = 65536u;
+    limits->maxStorageBufferBindingSize = 1ull << 31;
+    limits->minUniformBufferOffsetAlignment = 256u;
+    limits->minStorageBufferOffsetAlignment = 16u;
+    limits->maxVertexBuffers = 16u;
+    limits->maxVertexAttributes = 16u;
+    limits->maxVertexBufferArrayStride = 2048u;
+    limits->maxComputeWorkgroupStorageSize = 32768u;
+    limits->maxComputeInvocationsPerWorkGroup = 1024u;
+    limits->maxComputeWorkGroupSizeX = 1024u;
+    limits->maxComputeWorkGroupSizeY = 1024u;
+    limits->maxComputeWorkGroupSizeZ = 64u;
+    limits->maxComputeWorkGroupsPerDimension = 65535u;
+    limits->maxViewports = 16u;
+    limits->maxViewportDimensions[0] = 16384u;
+    limits->maxViewportDimensions[1] = 16384u;
+    limits->maxColorAttachments = 8u;
+}
+
+VGPUBuffer NullDevice::CreateBuffer(const VGPUBufferDesc* desc, const void* pInitialData)
+{
+    NullBuffer* buffer = new NullBuffer();
+    buffer->device = this;
+    buffer->size = desc->size;
+    buffer->usage = desc->usage;
+    buffer->address = nextAddress.fetch_add(AlignUp(desc->size, kAddressAlignment), std::memory_order_relaxed);
+
+    if (desc->cpuAccess != VGPUCpuAccessMode_None)
+    {
+        buffer->memory.reset(new uint8_t[desc->size]);
+        if (pInitialData != nullptr)
+            memcpy(buffer->memory.get(), pInitialData, desc->size);
+    }
+
+    resourcesCreated.fetch_add(1, std::memory_order_relaxed);
+    return buffer;
+}
+
+VGPUTexture NullDevice::CreateTexture(const VGPUTextureDesc* desc, const VGPUTextureData* pInitialData)
+{
+    VGPU_UNUSED(pInitialData);
+
+    NullTexture* texture = new NullTexture();
+    texture->device = this;
+    texture->desc = *desc;
+    texture->desc.label = nullptr;
+
+    resourcesCreated.fetch_add(1, std::memory_order_relaxed);
+    return texture;
+}
+
+VGPUSampler NullDevice::CreateSampler(const VGPUSamplerDesc* desc)
+{
+    VGPU_UNUSED(desc);
+
+    return new NullSampler();
+}
+
+VGPUBindGroupLayout NullDevice::CreateBindGroupLayout(const VGPUBindGroupLayoutDesc* desc)
+{
+    VGPU_UNUSED(desc);
+
+    return new NullBindGroupLayout();
+}
+
+VGPUPipelineLayout NullDevice::CreatePipelineLayout(const VGPUPipelineLayoutDesc* desc)
+{
+    NullPipelineLayout* layout = new NullPipelineLayout();
+    for (uint32_t i = 0; i < desc->bindGroupLayoutCount; ++i)
+    {
+        desc->bindGroupLayouts[i]->AddRef();
+        layout->bindGroupLayouts.push_back(desc->bindGroupLayouts[i]);
+    }
+
+    return layout;
+}
+
+VGPUBindGroup NullDevice::CreateBindGroup(const VGPUBindGroupLayout layout, const VGPUBindGroupDesc* desc)
+{
+    VGPU_UNUSED(desc);
+
+    NullBindGroup* bindGroup = new NullBindGroup();
+    bindGroup->layout = layout;
+    bindGroup->layout->AddRef();
+    return bindGroup;
+}
+
+VGPUPipeline NullDevice::CreatePipeline(VGPUPipelineType type, VGPUPipelineLayout layout)
+{
+    NullPipeline* pipeline = new NullPipeline();
+    pipeline->type = type;
+    pipeline->layout = layout;
+    pipeline->layout->AddRef();
+    return pipeline;
+}
+
+VGPUPipeline NullDevice::CreateRenderPipeline(const VGPURenderPipelineDesc* desc)
+{
+    return CreatePipeline(VGPUPipelineType_Render, desc->layout);
+}
+
+VGPUPipeline NullDevice::CreateComputePipeline(const VGPUComputePipelineDesc* desc)
+{
+    return CreatePipeline(VGPUPipelineType_Compute, desc->layout);
+}
+
+VGPUPipeline NullDevice::CreateRayTracingPipeline(const VGPURayTracingPipelineDesc* desc)
+{
+    return CreatePipeline(VGPUPipelineType_RayTracing, desc->layout);
+}
+
+VGPUQueryHeap NullDevice::CreateQueryHeap(const VGPUQueryHeapDesc* desc)
+{
+    NullQueryHeap* heap = new NullQueryHeap();
+    heap->type = desc->type;
+    heap->count = desc->count;
+    return heap;
+}
+
+VGPUSwapChain NullDevice::CreateSwapChain(const VGPUSwapChainDesc* desc)
+{
+    NullSwapChain* swapChain = new NullSwapChain();
+    swapChain->format = desc->format;
+    swapChain->width = desc->width;
+    swapChain->height = desc->height;
+
+    VGPUTextureDesc textureDesc{};
+    textureDesc.dimension = VGPUTextureDimension_2D;
+    textureDesc.format = desc->format;
+    textureDesc.usage = VGPUTextureUsage_RenderTarget;
+    textureDesc.width = desc->width;
+    textureDesc.height = desc->height;
+    textureDesc.depthOrArrayLayers = 1u;
+    textureDesc.mipLevelCount = 1u;
+    textureDesc.sampleCount = 1u;
+    swapChain->backbufferTexture = CreateTexture(&textureDesc, nullptr);
+    return swapChain;
+}
+
+VGPUCommandBuffer NullDevice::BeginCommandBuffer(VGPUCommandQueue queueType, const char* label)
+{
+    VGPU_UNUSED(label);
+
+    NullCommandBuffer* commandBuffer = nullptr;
+
+    commandBuffersMutex.lock();
+    uint32_t cmd_current = commandBuffersCount++;
+    if (cmd_current >= commandBuffersPool.size())
+    {
+        commandBuffer = new NullCommandBuffer();
+        commandBuffer->device = this;
+        commandBuffersPool.push_back(commandBuffer);
+    }
+    else
+    {
+        commandBuffer = commandBuffersPool[cmd_current];
+    }
+    commandBuffersMutex.unlock();
+
+    commandBuffer->queueType = queueType;
+    commandBuffer->Begin();
+    return commandBuffer;
+}
+
+uint64_t NullDevice::Submit(VGPUCommandBuffer* commandBuffers, uint32_t count)
+{
+    VGPUFrameStatistics statistics{};
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const NullCommandBuffer* commandBuffer = static_cast<const NullCommandBuffer*>(commandBuffers[i]);
+        statistics.commandBufferCount++;
+        statistics.drawCount += commandBuffer->statistics.drawCount;
+        statistics.dispatchCount += commandBuffer->statistics.dispatchCount;
+        statistics.pipelineBindCount += commandBuffer->statistics.pipelineBindCount;
+        statistics.bindGroupBindCount += commandBuffer->statistics.bindGroupBindCount;
+        statistics.allocatedBytes += commandBuffer->statistics.allocatedBytes;
+    }
+
+    // Nothing is in flight, every pooled command buffer can be reused right away.
+    commandBuffersMutex.lock();
+    commandBuffersCount = 0;
+    commandBuffersMutex.unlock();
+
+    statistics.frame = frameCount;
+    statistics.submitCount = 1;
+    statistics.resourcesCreated = resourcesCreated.exchange(0, std::memory_order_relaxed);
+    statistics.resourcesDestroyed = resourcesDestroyed.exchange(0, std::memory_order_relaxed);
+    frameStatistics = statistics;
+
+    frameCount++;
+    frameIndex = frameCount % VGPU_MAX_INFLIGHT_FRAMES;
+    return frameCount;
+}
+
+static bool null_IsSupported(void)
+{
+    return true;
+}
+
+struct NullInstance final : public VGPUInstanceImpl
+{
+    void SetLabel(const char* label) override { VGPU_UNUSED(label); }
+};
+
+static VGPUInstanceImpl* null_CreateInstance(const VGPUInstanceDesc* desc)
+{
+    VGPU_UNUSED(desc);
+
+    return new NullInstance();
+}
+
+static VGPUDeviceImpl* null_CreateDevice(const VGPUDeviceDesc* desc)
+{
+    VGPU_UNUSED(desc);
+
+    vgpuLogInfo("VGPU Driver: Null");
+    return new NullDevice();
+}
+
+VGPUDriver Null_Driver = {
+    VGPUBackend_Null,
+    null_IsSupported,
+    null_CreateInstance,
+    null_CreateDevice
+};
+
+#endif /* VGPU_NULL_DRIVER */
@@ -41,6 +41,11 @@ struct wl_surface;
 #include <dlfcn.h>
 #endif
 
+#include <chrono>
+#include <future>
+#include <memory>
+#include <numeric>
+
 //#elif defined(__linux__)
 //#define VK_USE_PLATFORM_XCB_KHR
 //#endif
@@ -48,7 +53,7 @@ struct wl_surface;
 VGPU_DISABLE_WARNINGS()
 
 //#include "third_party/volk.h"
-#define VMA_STATS_STRING_ENABLED 0
+#define VMA_STATS_STRING_ENABLED 1
 #define VMA_STATIC_VULKAN_FUNCTIONS 0
 #define VMA_DYNAMIC_VULKAN_FUNCTIONS 1
 #define VMA_IMPLEMENTATION
@@ -128,6 +133,8 @@ VGPU_ENABLE_WARNINGS()
   X(vkWaitForFences)\
   X(vkCreateSemaphore)\
   X(vkDestroySemaphore)\
+  X(vkGetSemaphoreCounterValue)\
+  X(vkWaitSemaphores)\
   X(vkCmdPipelineBarrier)\
   X(vkCreateQueryPool)\
   X(vkDestroyQueryPool)\
@@ -137,6 +144,7 @@ VGPU_ENABLE_WARNINGS()
   X(vkCmdWriteTimestamp)\
   X(vkCmdCopyQueryPoolResults)\
   X(vkGetQueryPoolResults)\
+  X(vkResetQueryPool)\
   X(vkCreateBuffer)\
   X(vkDestroyBuffer)\
   X(vkGetBufferMemoryRequirements)\
@@ -235,6 +243,10 @@ GPU_DECLARE(vkCmdPipelineBarrier2);
 GPU_DECLARE(vkCmdWriteTimestamp2);
 GPU_DECLARE(vkQueueSubmit2);
 
+// Functions from VK_KHR_calibrated_timestamps or VK_EXT_calibrated_timestamps
+GPU_DECLARE(vkGetPhysicalDeviceCalibrateableTimeDomainsKHR);
+GPU_DECLARE(vkGetCalibratedTimestampsKHR);
+
 GPU_FOREACH_DEVICE_MESH_SHADER(GPU_DECLARE)
 
 
@@ -250,6 +262,7 @@ typedef xcb_connection_t* (*PFN_XGetXCBConnection)(Display* dpy);
 #include <vector>
 #include <deque>
 #include <unordered_map>
+#include <algorithm>
 
 // Requires {}
 #define APPEND_EXT(desc) \
@@ -383,6 +396,158 @@ namespace
         return {};
     }
 
+    // Initial-data uploads are packed into one staging arena and flushed when it fills up,
+    // when the oldest pending upload gets older than the latency budget, or on demand.
+    constexpr uint64_t kUploadBatchSize = 32u * 1024u * 1024u;
+    constexpr std::chrono::microseconds kUploadBatchMaxLatency{ 2000 };
+    // Uploads are staged in one persistently mapped arena, larger requests get a dedicated buffer.
+    constexpr uint64_t kStagingArenaSize = 64u * 1024u * 1024u;
+    // Upper bounds of the bindless descriptor heaps, clamped to the device limits.
+    constexpr uint32_t kBindlessResourceCapacity = 65536u;
+    constexpr uint32_t kBindlessSamplerCapacity = 2048u;
+    // Frames a released transient attachment image stays pooled before it is destroyed.
+    constexpr uint64_t kTransientImagePoolFrames = 8u;
+    // Timestamp queries per in-flight frame for the GPU profiler, two per scope.
+    constexpr uint32_t kProfilerQueryCount = 8192u;
+
+    // Accesses that order a later access or layout transition after them.
+    constexpr VkAccessFlags2 kWriteAccessMask =
+        VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+        VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_HOST_WRITE_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+
+    // Drops the stages a queue does not support, accesses are widened to MEMORY_READ/MEMORY_WRITE when that happens.
+    inline void FilterStageAccess(VkPipelineStageFlags2& stages, VkAccessFlags2& access, VGPUCommandQueue queue)
+    {
+        if (stages == VK_PIPELINE_STAGE_2_NONE || queue == VGPUCommandQueue_Graphics)
+            return;
+
+        VkPipelineStageFlags2 supported = VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT | VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT |
+            VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT | VK_PIPELINE_STAGE_2_HOST_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+        if (queue == VGPUCommandQueue_Compute)
+        {
+            supported |= VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        }
+
+        if ((stages & ~supported) == 0)
+            return;
+
+        stages &= supported;
+        if (stages == VK_PIPELINE_STAGE_2_NONE)
+        {
+            stages = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        }
+
+        access = ((access & kWriteAccessMask) ? VK_ACCESS_2_MEMORY_WRITE_BIT : VK_ACCESS_2_NONE)
+            | ((access & ~kWriteAccessMask) ? VK_ACCESS_2_MEMORY_READ_BIT : VK_ACCESS_2_NONE);
+    }
+
+    inline bool IsPipelineCacheCompatible(const VkPhysicalDeviceProperties& properties, const void* data, size_t dataSize)
+    {
+        if (dataSize < sizeof(VkPipelineCacheHeaderVersionOne))
+            return false;
+
+        VkPipelineCacheHeaderVersionOne header;
+        memcpy(&header, data, sizeof(header));
+
+        return header.headerSize >= sizeof(VkPipelineCacheHeaderVersionOne)
+            && header.headerSize <= dataSize
+            && header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+            && header.vendorID == properties.vendorID
+            && header.deviceID == properties.deviceID
+            && memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+    }
+
+    inline size_t HashSamplerCreateInfo(const VkSamplerCreateInfo& info)
+    {
+        size_t hash = 0;
+        hash_combine(hash, (uint32_t)info.magFilter);
+        hash_combine(hash, (uint32_t)info.minFilter);
+        hash_combine(hash, (uint32_t)info.mipmapMode);
+        hash_combine(hash, (uint32_t)info.addressModeU);
+        hash_combine(hash, (uint32_t)info.addressModeV);
+        hash_combine(hash, (uint32_t)info.addressModeW);
+        hash_combine(hash, info.mipLodBias);
+        hash_combine(hash, info.anisotropyEnable);
+        hash_combine(hash, info.maxAnisotropy);
+        hash_combine(hash, info.compareEnable);
+        hash_combine(hash, (uint32_t)info.compareOp);
+        hash_combine(hash, info.minLod);
+        hash_combine(hash, info.maxLod);
+        hash_combine(hash, (uint32_t)info.borderColor);
+        hash_combine(hash, info.unnormalizedCoordinates);
+        return hash;
+    }
+
+    inline bool IsSameSamplerCreateInfo(const VkSamplerCreateInfo& a, const VkSamplerCreateInfo& b)
+    {
+        return a.magFilter == b.magFilter
+            && a.minFilter == b.minFilter
+            && a.mipmapMode == b.mipmapMode
+            && a.addressModeU == b.addressModeU
+            && a.addressModeV == b.addressModeV
+            && a.addressModeW == b.addressModeW
+            && a.mipLodBias == b.mipLodBias
+            && a.anisotropyEnable == b.anisotropyEnable
+            && a.maxAnisotropy == b.maxAnisotropy
+            && a.compareEnable == b.compareEnable
+            && a.compareOp == b.compareOp
+            && a.minLod == b.minLod
+            && a.maxLod == b.maxLod
+            && a.borderColor == b.borderColor
+            && a.unnormalizedCoordinates == b.unnormalizedCoordinates;
+    }
+
+    inline size_t HashDescriptorSetLayoutBindings(const std::vector<VkDescriptorSetLayoutBinding>& bindings, bool isBindless)
+    {
+        size_t hash = 0;
+        hash_combine(hash, isBindless);
+        for (const VkDescriptorSetLayoutBinding& binding : bindings)
+        {
+            hash_combine(hash, binding.binding);
+            hash_combine(hash, (uint32_t)binding.descriptorType);
+            hash_combine(hash, binding.descriptorCount);
+            hash_combine(hash, binding.stageFlags);
+        }
+        return hash;
+    }
+
+    inline bool IsSameDescriptorSetLayoutBindings(const std::vector<VkDescriptorSetLayoutBinding>& a, const std::vector<VkDescriptorSetLayoutBinding>& b)
+    {
+        if (a.size() != b.size())
+            return false;
+
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (a[i].binding != b[i].binding
+                || a[i].descriptorType != b[i].descriptorType
+                || a[i].descriptorCount != b[i].descriptorCount
+                || a[i].stageFlags != b[i].stageFlags)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    inline bool IsSamePushConstantRanges(const std::vector<VkPushConstantRange>& a, const std::vector<VkPushConstantRange>& b)
+    {
+        if (a.size() != b.size())
+            return false;
+
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (a[i].stageFlags != b[i].stageFlags
+                || a[i].offset != b[i].offset
+                || a[i].size != b[i].size)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
     inline VkBool32 vulkan_queryPresentationSupport(VkPhysicalDevice physicalDevice, uint32_t queueFamilyIndex)
     {
         VGPU_UNUSED(physicalDevice);
@@ -439,6 +604,8 @@ namespace
         bool fragment_shading_rate;
         bool meshShader;
         bool conditionalRendering;
+        bool calibratedTimestamps;
+        bool calibratedTimestampsEXT;
 
         bool externalMemory;
         bool externalSemaphore;
@@ -558,6 +725,14 @@ namespace
             {
                 extensions.conditionalRendering = true;
             }
+            else if (strcmp(vk_extensions[i].extensionName, VK_KHR_CALIBRATED_TIMESTAMPS_EXTENSION_NAME) == 0)
+            {
+                extensions.calibratedTimestamps = true;
+            }
+            else if (strcmp(vk_extensions[i].extensionName, VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME) == 0)
+            {
+                extensions.calibratedTimestampsEXT = true;
+            }
             else if (strcmp(vk_extensions[i].extensionName, VK_KHR_VIDEO_QUEUE_EXTENSION_NAME) == 0)
             {
                 extensions.video.queue = true;
@@ -1239,16 +1414,49 @@ namespace
 
 struct VulkanDevice;
 
+/// Layout, pipeline stages and access of a resource (or texture subresource) as last recorded.
+struct VulkanResourceState final
+{
+    VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    VkPipelineStageFlags2 stages = VK_PIPELINE_STAGE_2_NONE;
+    VkAccessFlags2 access = VK_ACCESS_2_NONE;
+};
+
+// Device memory that placed buffers and textures are bound into at caller chosen offsets.
+struct VulkanMemoryHeap final : public VGPUMemoryHeapImpl
+{
+    VulkanDevice* renderer = nullptr;
+    VmaAllocation allocation = VK_NULL_HANDLE;
+    uint64_t size = 0;
+    VGPUMemoryClass memoryClass = VGPUMemoryClass_Default;
+    uint32_t memoryType = 0;
+    void* pMappedData = nullptr;
+
+    ~VulkanMemoryHeap() override;
+    void SetLabel(const char* label) override;
+
+    uint64_t GetSize() const override { return size; }
+    VGPUMemoryClass GetMemoryClass() const override { return memoryClass; }
+
+    bool CanPlace(uint64_t offset, const VkMemoryRequirements& requirements) const;
+};
+
 struct VulkanBuffer final : public VGPUBufferImpl
 {
     VulkanDevice* renderer = nullptr;
     VkBuffer handle = VK_NULL_HANDLE;
     VmaAllocation  allocation = nullptr;
+    // Placed buffers own no allocation and keep their heap alive instead.
+    VulkanMemoryHeap* heap = nullptr;
+    uint64_t heapOffset = 0;
     uint64_t size = 0;
     VGPUBufferUsageFlags usage = 0;
     uint64_t allocatedSize = 0;
     VkDeviceAddress gpuAddress = 0;
     void* pMappedData = nullptr;
+    uint32_t descriptorIndex = VGPU_INVALID_DESCRIPTOR_INDEX;
+    // State after the last submitted command buffer that used the buffer.
+    VulkanResourceState state;
 
     ~VulkanBuffer() override;
     void SetLabel(const char* label) override;
@@ -1256,6 +1464,10 @@ struct VulkanBuffer final : public VGPUBufferImpl
     uint64_t GetSize() const override { return size; }
     VGPUBufferUsageFlags GetUsage() const override { return usage; }
     VGPUDeviceAddress GetGpuAddress() const override { return gpuAddress; }
+    uint32_t GetDescriptorIndex() const override { return descriptorIndex; }
+    void* GetMappedData() const override { return pMappedData; }
+    void FlushRange(uint64_t offset, uint64_t size) override;
+    void InvalidateRange(uint64_t offset, uint64_t size) override;
 };
 
 struct VulkanTexture final : public VGPUTextureImpl
@@ -1263,32 +1475,57 @@ struct VulkanTexture final : public VGPUTextureImpl
     VulkanDevice* renderer = nullptr;
     VkImage handle = VK_NULL_HANDLE;
     VmaAllocation  allocation = VK_NULL_HANDLE;
+    VulkanMemoryHeap* heap = nullptr;
+    // Transient attachments without lazily allocated memory return their image to the device pool under this key.
+    bool pooled = false;
+    size_t poolKey = 0;
 
     VGPUTextureDimension dimension = VGPUTextureDimension_2D;
     VGPUTextureFormat format{};
     uint32_t width = 0;
     uint32_t height = 0;
     VkFormat vkFormat = VK_FORMAT_UNDEFINED;
+    VGPUTextureUsageFlags usage = 0;
+    uint32_t mipLevelCount = 1;
+    uint32_t arrayLayerCount = 1;
+    // State of every subresource (mip-major) after the last submitted command buffer that used it.
+    std::vector<VulkanResourceState> subresourceStates;
     std::unordered_map<size_t, VkImageView> viewCache;
     void* sharedHandle = nullptr;
+    uint32_t descriptorIndex = VGPU_INVALID_DESCRIPTOR_INDEX;
 
     ~VulkanTexture() override;
     void SetLabel(const char* label) override;
 
     VGPUTextureDimension GetDimension() const override { return dimension; }
     VGPUTextureFormat GetFormat() const override { return format; }
+    VGPUTextureUsageFlags GetUsage() const override { return usage; }
+    uint32_t GetDescriptorIndex() const override { return descriptorIndex; }
 
-    VkImageView GetView(uint32_t baseMipLevel, uint32_t levelCount, uint32_t baseArrayLayer, uint32_t layerCount);
+    VkImageView GetView(uint32_t baseMipLevel, uint32_t levelCount, uint32_t baseArrayLayer, uint32_t layerCount, VkImageViewType viewType = VK_IMAGE_VIEW_TYPE_2D);
     VkImageView GetRTV(uint32_t level, uint32_t slice);
+
+    uint32_t GetSubresourceIndex(uint32_t mipLevel, uint32_t arrayLayer) const { return mipLevel * arrayLayerCount + arrayLayer; }
+    // Layout shader-readable textures return to between passes and copies.
+    VkImageLayout GetRestingLayout() const
+    {
+        return (usage & VGPUTextureUsage_ShaderRead) ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED;
+    }
 };
 
 struct VulkanSampler final : public VGPUSamplerImpl
 {
     VulkanDevice* renderer = nullptr;
     VkSampler handle = VK_NULL_HANDLE;
+    VkSamplerCreateInfo createInfo = {};
+    size_t hash = 0;
+    bool cached = false;
+    uint32_t descriptorIndex = VGPU_INVALID_DESCRIPTOR_INDEX;
 
     ~VulkanSampler() override;
+    uint32_t Release() override;
     void SetLabel(const char* label) override;
+    uint32_t GetDescriptorIndex() const override { return descriptorIndex; }
 };
 
 struct VulkanBindGroupLayout final : public VGPUBindGroupLayoutImpl
@@ -1298,8 +1535,11 @@ struct VulkanBindGroupLayout final : public VGPUBindGroupLayoutImpl
     std::vector<VkDescriptorSetLayoutBinding> layoutBindings;
     std::vector<uint32_t> layoutBindingsOriginal;
     bool isBindless = false;
+    size_t hash = 0;
+    bool cached = false;
 
     ~VulkanBindGroupLayout() override;
+    uint32_t Release() override;
     void SetLabel(const char* label) override;
 };
 
@@ -1309,9 +1549,15 @@ struct VulkanPipelineLayout final : public VGPUPipelineLayoutImpl
     VkPipelineLayout handle = VK_NULL_HANDLE;
 
     uint32_t bindGroupLayoutCount = 0;
+    std::vector<VulkanBindGroupLayout*> bindGroupLayouts;
     std::vector<VkPushConstantRange>  pushConstantRanges;
+    // Bindless heaps are bound after the bind groups, starting at set bindGroupLayoutCount.
+    bool bindless = false;
+    size_t hash = 0;
+    bool cached = false;
 
     ~VulkanPipelineLayout() override;
+    uint32_t Release() override;
     void SetLabel(const char* label) override;
 };
 
@@ -1335,10 +1581,40 @@ struct VulkanPipeline final : public VGPUPipelineImpl
     VkPipelineBindPoint bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
     VulkanPipelineLayout* pipelineLayout = nullptr;
     VkPipeline handle = VK_NULL_HANDLE;
+    std::atomic<VGPUPipelineStatus> status{ VGPUPipelineStatus_Ready };
+    std::shared_future<void> compileFinished;
 
     ~VulkanPipeline() override;
     void SetLabel(const char* label) override;
     VGPUPipelineType GetType() const override { return type; }
+    VGPUPipelineStatus GetStatus() const override { return status.load(); }
+    VGPUPipelineStatus Wait() override;
+};
+
+/// Owning copy of VGPURenderPipelineDesc, kept alive while the pipeline compiles on a worker thread.
+struct VulkanRenderPipelineDescCopy final
+{
+    VGPURenderPipelineDesc desc;
+    std::string label;
+    std::vector<VGPUShaderStageDesc> shaderStages;
+    std::vector<std::vector<uint8_t>> shaderBytecodes;
+    std::vector<std::string> entryPointNames;
+    std::vector<VGPUVertexBufferLayout> vertexLayouts;
+    std::vector<std::vector<VGPUVertexAttribute>> vertexAttributes;
+    std::vector<VGPUTextureFormat> colorFormats;
+
+    explicit VulkanRenderPipelineDescCopy(const VGPURenderPipelineDesc* source);
+};
+
+/// Owning copy of VGPUComputePipelineDesc, kept alive while the pipeline compiles on a worker thread.
+struct VulkanComputePipelineDescCopy final
+{
+    VGPUComputePipelineDesc desc;
+    std::string label;
+    std::vector<uint8_t> shaderBytecode;
+    std::string entryPointName;
+
+    explicit VulkanComputePipelineDescCopy(const VGPUComputePipelineDesc* source);
 };
 
 struct VulkanQueryHeap final : public VGPUQueryHeapImpl
@@ -1378,6 +1654,36 @@ struct VulkanSwapChain final : public VGPUSwapChainImpl
     uint32_t GetHeight() const override { return extent.height; }
 };
 
+// Device-wide counters of the frame being recorded, bumped from whatever thread creates or uploads.
+// Command buffer counters stay in the command buffer and are folded in at submit.
+struct VulkanFrameCounters
+{
+    std::atomic<uint32_t> submits{ 0 };
+    std::atomic<uint32_t> descriptorWrites{ 0 };
+    std::atomic<uint32_t> resourcesCreated{ 0 };
+    std::atomic<uint32_t> resourcesDestroyed{ 0 };
+    std::atomic<uint64_t> uploadBytes{ 0 };
+};
+
+// Scope recorded by the GPU profiler, parent indexes the scopes of the same command buffer until submit.
+struct VulkanProfileScope
+{
+    std::string label;
+    uint32_t parent = VGPU_INVALID_PROFILE_SCOPE;
+    uint32_t depth = 0;
+    VGPUCommandQueue queue = VGPUCommandQueue_Graphics;
+    // First of the begin/end timestamp pair, kProfilerQueryCount when the frame ran out of queries.
+    uint32_t query = kProfilerQueryCount;
+};
+
+// Timestamps of one in-flight frame, the pool is reset from the host once the frame resolved.
+struct VulkanProfilerFrame
+{
+    VkQueryPool queryPool = VK_NULL_HANDLE;
+    std::atomic<uint32_t> queryCount{ 0 };
+    std::vector<VulkanProfileScope> scopes;
+};
+
 class VulkanCommandBuffer final : public VGPUCommandBufferImpl
 {
 public:
@@ -1388,6 +1694,16 @@ public:
     VkCommandBuffer commandBuffers[VGPU_MAX_INFLIGHT_FRAMES];
     VkCommandBuffer commandBuffer;
     VkSemaphore semaphore = VK_NULL_HANDLE;
+    VulkanCommandBuffer* nextFree = nullptr;
+
+    // Linear allocator, the buffer holds one slice per in-flight frame.
+    uint32_t frameIndex = 0;
+    VulkanBuffer* allocatorBuffer = nullptr;
+    uint64_t allocatorSliceSize = 0;
+    uint64_t allocatorOffset = 0;
+    // Bytes used in slices retired by growth during this recording.
+    uint64_t allocatorRetiredBytes = 0;
+    std::vector<VulkanBuffer*> retiredAllocatorBuffers;
 
     uint32_t clearValueCount = 0;
     VkClearValue clearValues[VGPU_MAX_COLOR_ATTACHMENTS + 1];
@@ -1396,58 +1712,118 @@ public:
     bool hasLabel = false;
     bool insideRenderPass = false;
     bool hasRenderPassLabel = false;
+    bool hasRenderPassScope = false;
     std::vector<VulkanSwapChain*> presentSwapChains;
 
+    // Recording thread only, only the command buffer counters are used.
+    VGPUFrameStatistics statistics = {};
+
+    // GPU profiler scopes, moved into the device frame at submit.
+    bool profiling = false;
+    std::vector<VulkanProfileScope> profileScopes;
+    std::vector<uint32_t> profileStack;
+
     bool bindGroupsDirty{ false };
     uint32_t numBoundBindGroups{ 0 };
     VulkanBindGroup* boundBindGroups[VGPU_MAX_BIND_GROUPS] = {};
     VkDescriptorSet descriptorSets[VGPU_MAX_BIND_GROUPS] = {};
 
+    // Sets as recorded per bind point (graphics, compute), FlushBindGroups only rebinds the range that changed.
+    // The layout is referenced so its set layouts can be compared after the pipeline that bound them is released.
+    struct BoundDescriptorSets
+    {
+        VulkanPipelineLayout* layout = nullptr;
+        uint32_t count = 0;
+        VkDescriptorSet sets[VGPU_MAX_BIND_GROUPS] = {};
+    };
+    BoundDescriptorSets boundDescriptorSets[2];
+
+    // Dynamic state as last recorded, every pipeline declares it dynamic so it survives pipeline switches.
+    struct BoundVertexBuffer
+    {
+        VkBuffer handle = VK_NULL_HANDLE;
+        VkDeviceSize offset = 0;
+    };
+    BoundVertexBuffer boundVertexBuffers[VGPU_MAX_VERTEX_ATTRIBUTES];
+    VkBuffer boundIndexBuffer = VK_NULL_HANDLE;
+    VkDeviceSize boundIndexBufferOffset = 0;
+    VkIndexType boundIndexType = VK_INDEX_TYPE_UINT16;
+    bool hasBoundViewport = false;
+    VkViewport boundViewport = {};
+    bool hasBoundScissorRect = false;
+    VkRect2D boundScissorRect = {};
+    bool hasBoundStencilReference = false;
+    uint32_t boundStencilReference = 0;
+
     ~VulkanCommandBuffer() override;
 
     void Reset();
     void Begin(uint32_t frameIndex, const char* label);
+    void BeginProfileScope(const char* label);
+    void EndProfileScope();
+
+    // Per-command buffer view of a tracked resource, resolved against the global state at submit.
+    struct TrackedState
+    {
+        VulkanResourceState first;
+        VulkanResourceState current;
+        bool used = false;
+        bool discard = false;
+        bool transitioned = false;
+        // Flush batch that last required the subresource.
+        uint32_t barrierBatch = 0;
+    };
 
-    void InsertImageMemoryBarrier(
-        VkImage                 image,
-        VkAccessFlags           src_access_mask,
-        VkAccessFlags           dst_access_mask,
-        VkImageLayout           old_layout,
-        VkImageLayout           new_layout,
-        VkPipelineStageFlags    src_stage_mask,
-        VkPipelineStageFlags    dst_stage_mask,
-        VkImageSubresourceRange subresource_range)
-    {
-        VkImageMemoryBarrier barrier{};
-        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.srcAccessMask = src_access_mask;
-        barrier.dstAccessMask = dst_access_mask;
-        barrier.oldLayout = old_layout;
-        barrier.newLayout = new_layout;
-        barrier.image = image;
-        barrier.subresourceRange = subresource_range;
-
-        vkCmdPipelineBarrier(
-            commandBuffer,
-            src_stage_mask,
-            dst_stage_mask,
-            0,
-            0, nullptr,
-            0, nullptr,
-            1, &barrier);
-    }
-
+    std::unordered_map<VulkanTexture*, std::vector<TrackedState>> trackedTextures;
+    std::unordered_map<VulkanBuffer*, TrackedState> trackedBuffers;
+    std::vector<VulkanTexture*> restingTextures;
+    std::vector<VkImageMemoryBarrier2> pendingImageBarriers;
+    std::vector<VkBufferMemoryBarrier2> pendingBufferBarriers;
+    // Transfer writes to buffers read through untracked bindings (vertex, index, indirect, shaders).
+    VkPipelineStageFlags2 pendingWriteStages = VK_PIPELINE_STAGE_2_NONE;
+    VkAccessFlags2 pendingWriteAccess = VK_ACCESS_2_NONE;
+    uint32_t barrierBatch = 1;
+    std::vector<VulkanTexture*> renderPassTextures;
+    VkCommandBuffer prologueCommandBuffers[VGPU_MAX_INFLIGHT_FRAMES];
+
+    void RequireTextureState(VulkanTexture* texture, uint32_t baseMipLevel, uint32_t levelCount, uint32_t baseArrayLayer, uint32_t layerCount,
+        const VulkanResourceState& state, bool discard = false);
+    void RequireBufferState(VulkanBuffer* buffer, VkPipelineStageFlags2 stages, VkAccessFlags2 access);
+    VkPipelineStageFlags2 GetShaderStages() const;
+    void RequireCopyState(VulkanTexture* texture, const VGPUTextureCopyLocation* location, VkImageLayout layout, VkAccessFlags2 access);
+    void AddRestingTexture(VulkanTexture* texture);
+    void ApplyRestingLayouts();
+    void FlushBarriers(bool flushPendingWrites);
+    void EmitBarriers(VkCommandBuffer target,
+        const std::vector<VkImageMemoryBarrier2>& imageBarriers,
+        const std::vector<VkBufferMemoryBarrier2>& bufferBarriers,
+        const VkMemoryBarrier2* memoryBarrier);
+    VkCommandBuffer ResolveTrackedStates();
+
+    void RequireTextureAccess(VGPUTexture texture, VGPURenderGraphAccess access) override;
+    void RequireBufferAccess(VGPUBuffer buffer, VGPURenderGraphAccess access) override;
+    void DiscardTexture(VGPUTexture texture) override;
+    void DiscardBuffer(VGPUBuffer buffer) override;
+    void RequireHostRead(VGPUBuffer buffer) override;
+
+    VGPUCommandQueue GetQueueType() const override { return queueType; }
     void PushDebugGroup(const char* groupLabel) override;
     void PopDebugGroup() override;
     void InsertDebugMarker(const char* debugLabel) override;
     void ClearBuffer(VGPUBuffer buffer, uint64_t offset, uint64_t size) override;
+    void CopyBufferToBuffer(VGPUBuffer source, uint64_t sourceOffset, VGPUBuffer destination, uint64_t destinationOffset, uint64_t size) override;
+    void CopyBufferToTexture(const VGPUBufferCopyLocation* source, const VGPUTextureCopyLocation* destination, const VGPUExtent3D* extent) override;
+    void CopyTextureToBuffer(const VGPUTextureCopyLocation* source, const VGPUBufferCopyLocation* destination, const VGPUExtent3D* extent) override;
+    void CopyTextureToTexture(const VGPUTextureCopyLocation* source, const VGPUTextureCopyLocation* destination, const VGPUExtent3D* extent) override;
+    VGPUBufferAllocation Allocate(uint64_t size, uint64_t alignment) override;
+    void FlushAllocator();
 
     void SetPipeline(VGPUPipeline pipeline) override;
     void SetBindGroup(uint32_t groupIndex, VGPUBindGroup bindGroup) override;
     void SetPushConstants(uint32_t pushConstantIndex, const void* data, uint32_t size) override;
 
+    BoundDescriptorSets& GetBoundDescriptorSets() { return boundDescriptorSets[currentPipeline->bindPoint == VK_PIPELINE_BIND_POINT_COMPUTE ? 1 : 0]; }
+    void SetBoundLayout(BoundDescriptorSets& bound, VulkanPipelineLayout* layout, uint32_t setCount);
     void FlushBindGroups();
     void PrepareDispatch();
     void Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) override;
@@ -1458,6 +1834,8 @@ public:
     void BeginRenderPass(const VGPURenderPassDesc* desc) override;
     void EndRenderPass() override;
 
+    void BindViewport(const VkViewport& viewport);
+    void BindScissorRect(const VkRect2D& rect);
     void SetViewport(const VGPUViewport* viewport) override;
     void SetViewports(uint32_t count, const VGPUViewport* viewports) override;
     void SetScissorRect(const VGPURect* rects) override;
@@ -1489,16 +1867,25 @@ struct VulkanUploadContext final
     VkCommandBuffer transferCommandBuffer = VK_NULL_HANDLE;
     VkCommandPool transitionCommandPool = VK_NULL_HANDLE;
     VkCommandBuffer transitionCommandBuffer = VK_NULL_HANDLE;
-    VkFence fence = VK_NULL_HANDLE;
-    VkSemaphore semaphores[3] = { VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE }; // graphics, compute, video
+    // Timeline semaphore chaining the copy, graphics and compute submits.
+    VkSemaphore semaphore = VK_NULL_HANDLE;
+    uint64_t semaphoreValue = 0;
 
-    uint64_t uploadBufferSize = 0;
-    VulkanBuffer* uploadBuffer = nullptr;
-    void* uploadBufferData = nullptr;
+    // Staging ranges read by this context, retired once semaphoreValue completes.
+    std::vector<VmaVirtualAllocation> stagingAllocations;
+    std::vector<VulkanBuffer*> dedicatedStagingBuffers;
+    uint64_t stagingSize = 0;
 
     inline bool IsValid() const { return transferCommandBuffer != VK_NULL_HANDLE; }
 };
 
+struct VulkanStagingAllocation final
+{
+    VulkanBuffer* buffer = nullptr;
+    uint64_t offset = 0;
+    void* data = nullptr;
+};
+
 struct VulkanQueue final
 {
     VkQueue queue = VK_NULL_HANDLE;
@@ -1511,17 +1898,48 @@ struct VulkanQueue final
     std::vector<VkPipelineStageFlags> submitWaitStages;
     std::vector<VkCommandBuffer> submitCommandBuffers;
     std::vector<VkSemaphore> submitSignalSemaphores;
+    std::vector<uint64_t> submitWaitValues;
+    std::vector<uint64_t> submitSignalValues;
     // KHR_synchronization2
     std::vector<VkSemaphoreSubmitInfo> submitWaitSemaphoreInfos;
     std::vector<VkSemaphoreSubmitInfo> submitSignalSemaphoreInfos;
     std::vector<VkCommandBufferSubmitInfo> submitCommandBufferInfos;
 
     bool sparseBindingSupported = false;
+    uint32_t timestampValidBits = 0;
     std::mutex locker;
 
-    VkFence frameFences[VGPU_MAX_INFLIGHT_FRAMES] = {};
+    // Signaled with the device submission value on every Submit.
+    VkSemaphore timelineSemaphore = VK_NULL_HANDLE;
+
+    void Submit(VulkanDevice* device, uint64_t signalValue, uint64_t uploadWaitValue);
+};
+
+// One update-after-bind descriptor set per resource class, indexed by global descriptor indices.
+// Indices are claimed lock-free; freed ones come back through the deletion queue once no frame can use them.
+struct VulkanBindlessHeap final
+{
+    static constexpr uint64_t kEmptyFreeList = 0xFFFFFFFFull;
 
-    void Submit(VulkanDevice* device, VkFence fence);
+    VkDescriptorType type = VK_DESCRIPTOR_TYPE_MAX_ENUM;
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+    VkDescriptorSet set = VK_NULL_HANDLE;
+    uint32_t capacity = 0;
+    // vkUpdateDescriptorSets requires external synchronization of the set.
+    std::mutex writeMutex;
+
+    // Indices never handed out so far.
+    std::atomic<uint32_t> nextIndex{ 0 };
+    // Stack of recycled indices, the head packs an ABA tag in its upper 32 bits.
+    std::atomic<uint64_t> freeListHead{ kEmptyFreeList };
+    std::unique_ptr<std::atomic<uint32_t>[]> freeListNext;
+
+    bool Init(VkDevice device, VkDescriptorType descriptorType, uint32_t descriptorCapacity);
+    void Shutdown(VkDevice device);
+    uint32_t Allocate();
+    void Free(uint32_t index);
+    void Write(VkDevice device, uint32_t index, const VkDescriptorImageInfo* imageInfo, const VkDescriptorBufferInfo* bufferInfo);
 };
 
 struct VulkanDevice final : public VGPUDeviceImpl
@@ -1542,6 +1960,17 @@ public:
     VGPUTexture CreateTexture(const VGPUTextureDesc* desc, const VGPUTextureData* pInitialData) override;
     VGPUSampler CreateSampler(const VGPUSamplerDesc* desc) override;
 
+    void GetBufferCreateInfo(const VGPUBufferDesc* desc, VkBufferCreateInfo* bufferInfo, uint32_t* sharingIndices) const;
+    bool GetTextureCreateInfo(const VGPUTextureDesc* desc, VkImageCreateInfo* createInfo, uint32_t* sharingIndices) const;
+    void InitBuffer(VulkanBuffer* buffer, const VGPUBufferDesc* desc, const VkBufferCreateInfo& bufferInfo);
+    void InitTexture(VulkanTexture* texture, const VGPUTextureDesc* desc, const VkImageCreateInfo& createInfo);
+
+    bool GetBufferAllocationRequirements(const VGPUBufferDesc* desc, VGPUAllocationRequirements* requirements) override;
+    bool GetTextureAllocationRequirements(const VGPUTextureDesc* desc, VGPUAllocationRequirements* requirements) override;
+    VGPUMemoryHeap CreateMemoryHeap(const VGPUAllocationRequirements* requirements, VGPUMemoryClass memoryClass) override;
+    VGPUBuffer CreatePlacedBuffer(VGPUMemoryHeap heap, uint64_t offset, const VGPUBufferDesc* desc) override;
+    VGPUTexture CreatePlacedTexture(VGPUMemoryHeap heap, uint64_t offset, const VGPUTextureDesc* desc) override;
+
     VGPUBindGroupLayout CreateBindGroupLayout(const VGPUBindGroupLayoutDesc* desc) override;
     VGPUPipelineLayout CreatePipelineLayout(const VGPUPipelineLayoutDesc* desc) override;
     VGPUBindGroup CreateBindGroup(const VGPUBindGroupLayout layout, const VGPUBindGroupDesc* desc) override;
@@ -1549,6 +1978,8 @@ public:
     VGPUPipeline CreateRenderPipeline(const VGPURenderPipelineDesc* desc) override;
     VGPUPipeline CreateComputePipeline(const VGPUComputePipelineDesc* desc) override;
     VGPUPipeline CreateRayTracingPipeline(const VGPURayTracingPipelineDesc* desc) override;
+    VGPUPipeline CreateRenderPipelineAsync(const VGPURenderPipelineDesc* desc, VGPUPipelineCallback callback, void* userData) override;
+    VGPUPipeline CreateComputePipelineAsync(const VGPUComputePipelineDesc* desc, VGPUPipelineCallback callback, void* userData) override;
 
     VGPUQueryHeap CreateQueryHeap(const VGPUQueryHeapDesc* desc) override;
 
@@ -1556,9 +1987,41 @@ public:
 
     VGPUCommandBuffer BeginCommandBuffer(VGPUCommandQueue queueType, const char* label) override;
     uint64_t Submit(VGPUCommandBuffer* commandBuffers, uint32_t count) override;
-
-    VulkanUploadContext Allocate(uint64_t size);
-    void UploadSubmit(VulkanUploadContext context);
+    void RecycleCommandBuffers();
+
+    uint64_t GetCompletedValue(VGPUCommandQueue queue) override;
+    VGPUBool32 WaitValue(VGPUCommandQueue queue, uint64_t value, uint64_t timeout) override;
+
+    size_t GetPipelineCacheData(void* data, size_t dataSize) override;
+    uint64_t GetAllocatorHighWaterMark() const override { return allocatorHighWaterMark.load(); }
+
+    bool InitRenderPipeline(VulkanPipeline* pipeline, const VGPURenderPipelineDesc* desc);
+    bool InitComputePipeline(VulkanPipeline* pipeline, const VGPUComputePipelineDesc* desc);
+    void CompilePipelineAsync(VulkanPipeline* pipeline, std::function<bool()> compile, VGPUPipelineCallback callback, void* userData);
+
+    uint64_t FlushUploads() override;
+    VGPUBool32 WaitUploads(uint64_t token, uint64_t timeout) override;
+
+    void GetStagingStatistics(VGPUStagingStatistics* statistics) override;
+    void GetMemoryBudget(VGPUMemoryBudget* budget) override;
+    void GetMemoryStatistics(VGPUMemoryStatistics* statistics) override;
+    size_t GetMemoryDump(bool detailed, char* data, size_t dataSize) override;
+
+    void SetProfilerEnabled(bool enabled) override;
+    bool GetFrameProfile(VGPUFrameProfile* profile) override;
+    void ResolveProfilerFrame();
+    bool BeginTrace(const char* path) override;
+    bool EndTrace() override;
+    uint64_t CalibrateTraceTimestamps(uint64_t* deviceTimestamp);
+    void GetFrameStatistics(VGPUFrameStatistics* statistics) override { *statistics = frameStatistics; }
+
+    VulkanUploadContext Allocate();
+    void UploadSubmit(VulkanUploadContext context, uint64_t uploadValue = 0);
+    bool AllocateStaging(uint64_t size, uint64_t alignment, VmaVirtualAllocation* allocation, uint64_t* offset);
+    bool RetireUploadsLocked(bool wait);
+    VulkanUploadContext* BeginUpload(uint64_t size, uint64_t alignment, VulkanStagingAllocation* staging);
+    void EndUpload();
+    uint64_t FlushUploadsLocked();
     void SetObjectName(VkObjectType type, uint64_t handle, const char* name);
     void ProcessDeletionQueue();
 
@@ -1630,6 +2093,7 @@ public:
     std::string driverDescription;
     bool synchronization2{ false };
     bool dynamicRendering{ false };
+    bool lazilyAllocatedMemory{ false };
 
     VkPhysicalDevice physicalDevice;
     struct QueueFamilyIndices {
@@ -1660,12 +2124,52 @@ public:
     uint64_t timestampFrequency = 0;
 
     /* Command contexts */
+    // Every command buffer owns one command pool per in-flight frame, so recording threads share nothing.
+    // Buffers are claimed from a lock-free free list per queue type, refilled by Submit;
+    // cmdBuffersLocker only guards creation of new buffers.
     std::mutex cmdBuffersLocker;
-    uint32_t cmdBuffersCount{ 0 };
     std::vector<VulkanCommandBuffer*> commandBuffersPool;
+    std::atomic<VulkanCommandBuffer*> freeCommandBuffers[_VGPUCommandQueue_Count] = {};
+    std::atomic<uint64_t> allocatorHighWaterMark{ 0 };
 
+    // Submitted contexts in submission order, uploadLocker also guards the staging arena.
     std::mutex uploadLocker;
-    std::vector<VulkanUploadContext> uploadFreeList;
+    std::deque<VulkanUploadContext> uploadFreeList;
+    VulkanBuffer* stagingArena = nullptr;
+    VmaVirtualBlock stagingBlock = VK_NULL_HANDLE;
+    uint64_t stagingPeakUsage = 0;
+    uint64_t stagingDedicatedBytes = 0;
+    uint64_t stagingStallCount = 0;
+
+    // Batched uploads, BeginUpload holds uploadBatchMutex until the matching EndUpload.
+    // Every flush signals uploadTimeline with a new token.
+    std::mutex uploadBatchMutex;
+    VulkanUploadContext uploadBatch;
+    std::chrono::steady_clock::time_point uploadBatchStart;
+    VkSemaphore uploadTimeline = VK_NULL_HANDLE;
+    uint64_t uploadTimelineValue = 0;
+    uint64_t uploadWaitValue = 0;
+
+    // GPU profiler, enabling takes effect at the next frame boundary so command buffers never mix states.
+    bool profilerEnabled = false;
+    bool profilerActive = false;
+    VulkanProfilerFrame profilerFrames[VGPU_MAX_INFLIGHT_FRAMES];
+    uint64_t profileFrame = 0;
+    bool hasProfile = false;
+    std::vector<VGPUProfileScope> profileScopes;
+    std::vector<std::string> profileLabels;
+    std::vector<uint64_t> profileResults;
+    bool profilerOverflowReported = false;
+
+    // Tracing records GPU spans through the profiler queries, placed on the CPU timeline by a calibrated
+    // timestamp pair per resolved frame, or by aligning the frame end with the resolve time without calibration.
+    bool traceGpu = false;
+    VkTimeDomainKHR traceHostDomain = VK_TIME_DOMAIN_MAX_ENUM_KHR;
+
+    // Accumulated during the frame, frameStatistics holds the last submitted one.
+    VulkanFrameCounters frameCounters;
+    VGPUFrameStatistics pendingStatistics = {};
+    VGPUFrameStatistics frameStatistics = {};
 
     VkBuffer		nullBuffer = VK_NULL_HANDLE;
     VmaAllocation	nullBufferAllocation = VK_NULL_HANDLE;
@@ -1685,11 +2189,30 @@ public:
     VkImageView		nullImageViewCubeArray = VK_NULL_HANDLE;
     VkImageView		nullImageView3D = VK_NULL_HANDLE;
 
+    // Bindless descriptor heaps, only created when descriptor indexing with update-after-bind is supported.
+    bool bindlessSupported = false;
+    VulkanBindlessHeap bindlessSampledImages;
+    VulkanBindlessHeap bindlessStorageBuffers;
+    VulkanBindlessHeap bindlessSamplers;
+
     std::vector<VkDynamicState> psoDynamicStates;
     VkPipelineDynamicStateCreateInfo dynamicStateInfo = {};
 
     // Caches
     std::vector<VkDescriptorPool> descriptorSetPools;
+    VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+
+    // Deduplicated objects, keyed by hash of their creation info.
+    // Entries are erased under objectCacheMutex when the last reference is released,
+    // recursive since releasing a pipeline layout releases its bind group layouts.
+    std::recursive_mutex objectCacheMutex;
+    std::unordered_map<size_t, VulkanSampler*> samplerCache;
+    std::unordered_map<size_t, VulkanBindGroupLayout*> bindGroupLayoutCache;
+    std::unordered_map<size_t, VulkanPipelineLayout*> pipelineLayoutCache;
+
+    // Pipeline compilation threads, created on first async request.
+    std::mutex pipelineWorkersMutex;
+    std::unique_ptr<VGPUWorkerPool> pipelineWorkers;
 
     // Deletion queue objects
     std::mutex destroyMutex;
@@ -1703,31 +2226,157 @@ public:
     std::deque<std::pair<VkShaderModule, uint64_t>> destroyedShaderModules;
     std::deque<std::pair<VkPipeline, uint64_t>> destroyedPipelines;
     std::deque<std::pair<std::pair<VkDescriptorPool, VkDescriptorSet>, uint64_t>> destroyedDescriptorSets;
+    // Released transient attachment images keyed by create info, reused once the GPU is done with them.
+    std::unordered_map<size_t, std::deque<std::pair<std::pair<VkImage, VmaAllocation>, uint64_t>>> transientImagePool;
     std::deque<std::pair<VkQueryPool, uint64_t>> destroyedQueryPools;
+    std::deque<std::pair<std::pair<VulkanBindlessHeap*, uint32_t>, uint64_t>> destroyedDescriptorIndices;
 };
 
-VulkanUploadContext VulkanDevice::Allocate(uint64_t size)
+bool VulkanBindlessHeap::Init(VkDevice device, VkDescriptorType descriptorType, uint32_t descriptorCapacity)
+{
+    type = descriptorType;
+    capacity = descriptorCapacity;
+    freeListNext.reset(new std::atomic<uint32_t>[capacity]);
+
+    VkDescriptorPoolSize poolSize = {};
+    poolSize.type = type;
+    poolSize.descriptorCount = capacity;
+
+    VkDescriptorPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+    poolInfo.maxSets = 1;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+    VkResult result = vkCreateDescriptorPool(device, &poolInfo, nullptr, &pool);
+    if (result != VK_SUCCESS)
+    {
+        VK_LOG_ERROR(result, "Failed to create bindless descriptor pool");
+        return false;
+    }
+
+    const VkDescriptorBindingFlags bindingFlags =
+        VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+        VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+        VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo = {};
+    bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+    bindingFlagsInfo.bindingCount = 1;
+    bindingFlagsInfo.pBindingFlags = &bindingFlags;
+
+    VkDescriptorSetLayoutBinding binding = {};
+    binding.binding = 0;
+    binding.descriptorType = type;
+    binding.descriptorCount = capacity;
+    binding.stageFlags = VK_SHADER_STAGE_ALL;
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.pNext = &bindingFlagsInfo;
+    layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+    layoutInfo.bindingCount = 1;
+    layoutInfo.pBindings = &binding;
+    result = vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &layout);
+    if (result != VK_SUCCESS)
+    {
+        VK_LOG_ERROR(result, "Failed to create bindless descriptor set layout");
+        return false;
+    }
+
+    VkDescriptorSetAllocateInfo allocateInfo = {};
+    allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocateInfo.descriptorPool = pool;
+    allocateInfo.descriptorSetCount = 1;
+    allocateInfo.pSetLayouts = &layout;
+    result = vkAllocateDescriptorSets(device, &allocateInfo, &set);
+    if (result != VK_SUCCESS)
+    {
+        VK_LOG_ERROR(result, "Failed to allocate bindless descriptor set");
+        return false;
+    }
+
+    return true;
+}
+
+void VulkanBindlessHeap::Shutdown(VkDevice device)
+{
+    // Destroying the pool frees the set.
+    vkDestroyDescriptorPool(device, pool, nullptr);
+    vkDestroyDescriptorSetLayout(device, layout, nullptr);
+    pool = VK_NULL_HANDLE;
+    layout = VK_NULL_HANDLE;
+    set = VK_NULL_HANDLE;
+}
+
+uint32_t VulkanBindlessHeap::Allocate()
+{
+    uint64_t head = freeListHead.load(std::memory_order_acquire);
+    while (uint32_t(head) != uint32_t(kEmptyFreeList))
+    {
+        const uint32_t index = uint32_t(head);
+        const uint64_t next = ((head >> 32) + 1) << 32 | freeListNext[index].load(std::memory_order_relaxed);
+        if (freeListHead.compare_exchange_weak(head, next, std::memory_order_acq_rel, std::memory_order_acquire))
+            return index;
+    }
+
+    const uint32_t index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+    if (index >= capacity)
+    {
+        vgpuLogError("Vulkan: Bindless descriptor heap is full (%u descriptors)", capacity);
+        return VGPU_INVALID_DESCRIPTOR_INDEX;
+    }
+
+    return index;
+}
+
+void VulkanBindlessHeap::Free(uint32_t index)
+{
+    uint64_t head = freeListHead.load(std::memory_order_relaxed);
+    uint64_t next;
+    do
+    {
+        freeListNext[index].store(uint32_t(head), std::memory_order_relaxed);
+        next = ((head >> 32) + 1) << 32 | index;
+    } while (!freeListHead.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void VulkanBindlessHeap::Write(VkDevice device, uint32_t index, const VkDescriptorImageInfo* imageInfo, const VkDescriptorBufferInfo* bufferInfo)
+{
+    VkWriteDescriptorSet write = {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = set;
+    write.dstBinding = 0;
+    write.dstArrayElement = index;
+    write.descriptorCount = 1;
+    write.descriptorType = type;
+    write.pImageInfo = imageInfo;
+    write.pBufferInfo = bufferInfo;
+
+    std::scoped_lock lock(writeMutex);
+    vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+}
+
+VulkanUploadContext VulkanDevice::Allocate()
 {
     VulkanUploadContext context;
 
     uploadLocker.lock();
-    // Try to search for a staging buffer that can fit the request:
-    for (size_t i = 0; i < uploadFreeList.size(); ++i)
+    // Contexts complete in submission order, so only the oldest one can be reusable.
+    if (!uploadFreeList.empty())
     {
-        if (uploadFreeList[i].uploadBufferSize >= size)
+        uint64_t completedValue = 0;
+        VK_CHECK(vkGetSemaphoreCounterValue(device, uploadFreeList.front().semaphore, &completedValue));
+        if (completedValue >= uploadFreeList.front().semaphoreValue)
         {
-            if (vkGetFenceStatus(device, uploadFreeList[i].fence) == VK_SUCCESS)
-            {
-                context = std::move(uploadFreeList[i]);
-                std::swap(uploadFreeList[i], uploadFreeList.back());
-                uploadFreeList.pop_back();
-                break;
-            }
+            RetireUploadsLocked(false);
+            context = std::move(uploadFreeList.front());
+            uploadFreeList.pop_front();
         }
     }
     uploadLocker.unlock();
 
-    // If no buffer was found that fits the data then create new one.
+    // If no context is idle then create new one.
     if (!context.IsValid())
     {
         VkCommandPoolCreateInfo poolCreateInfo = {};
@@ -1749,25 +2398,15 @@ VulkanUploadContext VulkanDevice::Allocate(uint64_t size)
         commandBufferInfo.commandPool = context.transitionCommandPool;
         VK_CHECK(vkAllocateCommandBuffers(device, &commandBufferInfo, &context.transitionCommandBuffer));
 
-        VkFenceCreateInfo fenceInfo = {};
-        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-        VK_CHECK(vkCreateFence(device, &fenceInfo, nullptr, &context.fence));
+        VkSemaphoreTypeCreateInfo timelineInfo = {};
+        timelineInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        timelineInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        timelineInfo.initialValue = 0;
 
         VkSemaphoreCreateInfo semaphoreInfo = {};
         semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-        VK_CHECK(vkCreateSemaphore(device, &semaphoreInfo, nullptr, &context.semaphores[0]));
-        VK_CHECK(vkCreateSemaphore(device, &semaphoreInfo, nullptr, &context.semaphores[1]));
-        VK_CHECK(vkCreateSemaphore(device, &semaphoreInfo, nullptr, &context.semaphores[2]));
-
-        context.uploadBufferSize = VmaNextPow2(size);
-        context.uploadBufferSize = _VGPU_MAX(context.uploadBufferSize, uint64_t(65536));
-
-        VGPUBufferDesc uploadBufferDesc{};
-        uploadBufferDesc.label = "CopyAllocator::UploadBuffer";
-        uploadBufferDesc.size = context.uploadBufferSize;
-        uploadBufferDesc.cpuAccess = VGPUCpuAccessMode_Write;
-        context.uploadBuffer = (VulkanBuffer*)CreateBuffer(&uploadBufferDesc, nullptr);
-        context.uploadBufferData = context.uploadBuffer->pMappedData;
+        semaphoreInfo.pNext = &timelineInfo;
+        VK_CHECK(vkCreateSemaphore(device, &semaphoreInfo, nullptr, &context.semaphore));
     }
 
     // Begin command list in valid state.
@@ -1781,18 +2420,26 @@ VulkanUploadContext VulkanDevice::Allocate(uint64_t size)
 
     VK_CHECK(vkBeginCommandBuffer(context.transferCommandBuffer, &beginInfo));
     VK_CHECK(vkBeginCommandBuffer(context.transitionCommandBuffer, &beginInfo));
-    VK_CHECK(vkResetFences(device, 1, &context.fence));
 
     return context;
 }
 
-void VulkanDevice::UploadSubmit(VulkanUploadContext context)
+void VulkanDevice::UploadSubmit(VulkanUploadContext context, uint64_t uploadValue)
 {
+    VGPUTraceScope traceScope(this, "UploadSubmit");
+
     VK_CHECK(vkEndCommandBuffer(context.transferCommandBuffer));
     VK_CHECK(vkEndCommandBuffer(context.transitionCommandBuffer));
 
+    // Copy -> graphics -> compute, each step waits on the previous timeline value.
+    const uint64_t copyValue = context.semaphoreValue + 1;
+    const uint64_t graphicsValue = context.semaphoreValue + 2;
+    const uint64_t computeValue = context.semaphoreValue + 3;
+    context.semaphoreValue = computeValue;
+
     VkSemaphoreSubmitInfo waitSemaphoreInfo{};
     waitSemaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+    waitSemaphoreInfo.semaphore = context.semaphore;
 
     // Copy queue first
     {
@@ -1802,7 +2449,8 @@ void VulkanDevice::UploadSubmit(VulkanUploadContext context)
 
         VkSemaphoreSubmitInfo signalSemaphoreInfo = {};
         signalSemaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
-        signalSemaphoreInfo.semaphore = context.semaphores[0]; // Signal for graphics queue
+        signalSemaphoreInfo.semaphore = context.semaphore; // Signal for graphics queue
+        signalSemaphoreInfo.value = copyValue;
         signalSemaphoreInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
 
         VkSubmitInfo2 submitInfo = {};
@@ -1816,11 +2464,12 @@ void VulkanDevice::UploadSubmit(VulkanUploadContext context)
 
         std::scoped_lock lock(queues[VGPUCommandQueue_Copy].locker);
         VK_CHECK(vkQueueSubmit2(queues[VGPUCommandQueue_Copy].queue, 1, &submitInfo, VK_NULL_HANDLE));
+        frameCounters.submits.fetch_add(1, std::memory_order_relaxed);
     }
 
     // Graphics queue
     {
-        waitSemaphoreInfo.semaphore = context.semaphores[0]; // Wait for copy queue
+        waitSemaphoreInfo.value = copyValue; // Wait for copy queue
         waitSemaphoreInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
 
         VkCommandBufferSubmitInfo commandBufferInfo{};
@@ -1829,7 +2478,8 @@ void VulkanDevice::UploadSubmit(VulkanUploadContext context)
 
         VkSemaphoreSubmitInfo signalSemaphoreInfos[2] = {};
         signalSemaphoreInfos[0].sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
-        signalSemaphoreInfos[0].semaphore = context.semaphores[1]; // Signal for compute queue
+        signalSemaphoreInfos[0].semaphore = context.semaphore;
+        signalSemaphoreInfos[0].value = graphicsValue; // Signal for compute queue
         signalSemaphoreInfos[0].stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT; // Signal for compute queue
 
         VkSubmitInfo2 submitInfo = {};
@@ -1854,6 +2504,7 @@ void VulkanDevice::UploadSubmit(VulkanUploadContext context)
 
         std::scoped_lock lock(queues[VGPUCommandQueue_Graphics].locker);
         VK_CHECK(vkQueueSubmit2(queues[VGPUCommandQueue_Graphics].queue, 1, &submitInfo, VK_NULL_HANDLE));
+        frameCounters.submits.fetch_add(1, std::memory_order_relaxed);
     }
 
     //if (device->queues[QUEUE_VIDEO_DECODE].queue != VK_NULL_HANDLE)
@@ -1873,120 +2524,400 @@ void VulkanDevice::UploadSubmit(VulkanUploadContext context)
     //    assert(res == VK_SUCCESS);
     //}
 
-    // This must be final submit in this function because it will also signal a fence for state tracking by CPU!
+    // This must be final submit in this function because its signal value is tracked by CPU!
     {
-        waitSemaphoreInfo.semaphore = context.semaphores[1]; // wait for graphics queue
+        waitSemaphoreInfo.value = graphicsValue; // wait for graphics queue
         waitSemaphoreInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
 
+        VkSemaphoreSubmitInfo signalSemaphoreInfos[2] = {};
+        signalSemaphoreInfos[0].sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+        signalSemaphoreInfos[0].semaphore = context.semaphore;
+        signalSemaphoreInfos[0].value = computeValue;
+        signalSemaphoreInfos[0].stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+        // Batched uploads also publish their token on the device upload timeline.
+        signalSemaphoreInfos[1].sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+        signalSemaphoreInfos[1].semaphore = uploadTimeline;
+        signalSemaphoreInfos[1].value = uploadValue;
+        signalSemaphoreInfos[1].stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
         VkSubmitInfo2 submitInfo = {};
         submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
         submitInfo.waitSemaphoreInfoCount = 1;
         submitInfo.pWaitSemaphoreInfos = &waitSemaphoreInfo;
         submitInfo.commandBufferInfoCount = 0;
         submitInfo.pCommandBufferInfos = nullptr;
-        submitInfo.signalSemaphoreInfoCount = 0;
-        submitInfo.pSignalSemaphoreInfos = nullptr;
+        submitInfo.signalSemaphoreInfoCount = uploadValue > 0 ? 2 : 1;
+        submitInfo.pSignalSemaphoreInfos = signalSemaphoreInfos;
 
-        // Final submit also signals fence!
+        // Final value marks the context as reusable.
         std::scoped_lock lock(queues[VGPUCommandQueue_Compute].locker);
-        VK_CHECK(vkQueueSubmit2(queues[VGPUCommandQueue_Compute].queue, 1, &submitInfo, context.fence));
+        VK_CHECK(vkQueueSubmit2(queues[VGPUCommandQueue_Compute].queue, 1, &submitInfo, VK_NULL_HANDLE));
+        frameCounters.submits.fetch_add(1, std::memory_order_relaxed);
     }
 
     std::scoped_lock lock(uploadLocker);
-    uploadFreeList.push_back(context);
+    uploadFreeList.push_back(std::move(context));
 }
 
-void VulkanDevice::SetObjectName(VkObjectType type, uint64_t handle, const char* name)
+bool VulkanDevice::AllocateStaging(uint64_t size, uint64_t alignment, VmaVirtualAllocation* allocation, uint64_t* offset)
 {
-    if (!debugUtils)
+    std::scoped_lock lock(uploadLocker);
+
+    VmaVirtualAllocationCreateInfo allocationInfo = {};
+    allocationInfo.size = size;
+    allocationInfo.alignment = alignment;
+
+    for (;;)
     {
-        return;
-    }
+        if (vmaVirtualAllocate(stagingBlock, &allocationInfo, allocation, offset) == VK_SUCCESS)
+        {
+            VmaStatistics stats;
+            vmaGetVirtualBlockStatistics(stagingBlock, &stats);
+            stagingPeakUsage = _VGPU_MAX(stagingPeakUsage, stats.allocationBytes);
+            return true;
+        }
 
-    VkDebugUtilsObjectNameInfoEXT info;
-    info.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
-    info.pNext = nullptr;
-    info.objectType = type;
-    info.objectHandle = handle;
-    info.pObjectName = name;
-    VK_CHECK(vkSetDebugUtilsObjectNameEXT(device, &info));
+        // Give back ranges of completed uploads, waiting for the oldest one if none completed yet.
+        if (!RetireUploadsLocked(true))
+            return false;
+    }
 }
 
-void* VulkanDevice::GetNativeObject(VGPUNativeObjectType objectType) const
+bool VulkanDevice::RetireUploadsLocked(bool wait)
 {
-    switch (objectType)
+    bool retired = false;
+    for (VulkanUploadContext& context : uploadFreeList)
     {
-        case VGPUNativeObjectType_VkDevice:
-            return device;
-        case VGPUNativeObjectType_VkPhysicalDevice:
-            return physicalDevice;
-        case VGPUNativeObjectType_VkInstance:
-            return instance;
-        default:
-            return nullptr;
+        if (context.stagingAllocations.empty() && context.dedicatedStagingBuffers.empty())
+            continue;
+
+        uint64_t completedValue = 0;
+        VK_CHECK(vkGetSemaphoreCounterValue(device, context.semaphore, &completedValue));
+        if (completedValue < context.semaphoreValue)
+        {
+            if (retired || !wait)
+                break;
+
+            VkSemaphoreWaitInfo waitInfo = {};
+            waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores = &context.semaphore;
+            waitInfo.pValues = &context.semaphoreValue;
+
+            VGPUTraceScope traceScope(this, "WaitForStaging");
+            VK_CHECK(vkWaitSemaphores(device, &waitInfo, UINT64_MAX));
+            stagingStallCount++;
+        }
+
+        for (VmaVirtualAllocation allocation : context.stagingAllocations)
+        {
+            vmaVirtualFree(stagingBlock, allocation);
+        }
+
+        for (VulkanBuffer* buffer : context.dedicatedStagingBuffers)
+        {
+            stagingDedicatedBytes -= buffer->size;
+            buffer->Release();
+        }
+
+        context.stagingAllocations.clear();
+        context.dedicatedStagingBuffers.clear();
+        context.stagingSize = 0;
+        retired = true;
     }
-}
 
-bool VulkanDevice::GetImageFormatProperties(const VkImageCreateInfo& createInfo, const void* pNext, VkImageFormatProperties2* imageFormatProperties2) const
-{
-    return GetImageFormatProperties(createInfo.format, createInfo.imageType, createInfo.tiling, createInfo.usage, createInfo.flags, pNext, imageFormatProperties2);
+    return retired;
 }
 
-bool VulkanDevice::GetImageFormatProperties(VkFormat format, VkImageType type, VkImageTiling tiling, VkImageUsageFlags usage, VkImageCreateFlags flags, const void* pNext, VkImageFormatProperties2* imageFormatProperties2) const
+void VulkanDevice::GetStagingStatistics(VGPUStagingStatistics* statistics)
 {
-    VGPU_ASSERT(imageFormatProperties2->sType == VK_STRUCTURE_TYPE_IMAGE_FORMAT_PROPERTIES_2);
+    std::scoped_lock lock(uploadLocker);
 
-    VkPhysicalDeviceImageFormatInfo2 info = {};
-    info.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGE_FORMAT_INFO_2;
-    info.pNext = pNext;
-    info.format = format;
-    info.type = type;
-    info.tiling = tiling;
-    info.usage = usage;
-    info.flags = flags;
+    VmaStatistics stats;
+    vmaGetVirtualBlockStatistics(stagingBlock, &stats);
 
-    const VkResult result = vkGetPhysicalDeviceImageFormatProperties2(physicalDevice, &info, imageFormatProperties2);
-    return result == VK_SUCCESS;
+    statistics->arenaSize = kStagingArenaSize;
+    statistics->usedBytes = stats.allocationBytes;
+    statistics->peakUsedBytes = stagingPeakUsage;
+    statistics->allocationCount = stats.allocationCount;
+    statistics->dedicatedBytes = stagingDedicatedBytes;
+    statistics->stallCount = stagingStallCount;
 }
 
-VkDescriptorPool VulkanDevice::CreateDescriptorSetPool()
+void VulkanDevice::GetMemoryBudget(VGPUMemoryBudget* budget)
 {
-    const std::vector<VkDescriptorPoolSize> poolSizes{
-            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 512 },
-            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 16 },
-            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 512 },
-            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 128 },
-            { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 128 },
-            { VK_DESCRIPTOR_TYPE_SAMPLER, 8 },
-            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 8 }
-    };
-
-    VkDescriptorPoolCreateInfo poolInfo = {};
-    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    poolInfo.maxSets = 1024;
-    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT; // VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT (bindless)
-    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
-    poolInfo.pPoolSizes = poolSizes.data();
+    VmaBudget heapBudgets[VK_MAX_MEMORY_HEAPS];
+    vmaGetHeapBudgets(allocator, heapBudgets);
 
-    VkDescriptorPool pool = VK_NULL_HANDLE;
-    VkResult result = vkCreateDescriptorPool(device, &poolInfo, nullptr, &pool);
-    if (result != VK_SUCCESS)
+    *budget = {};
+    budget->heapCount = _VGPU_MIN(memoryProperties2.memoryProperties.memoryHeapCount, VGPU_MAX_MEMORY_HEAPS);
+    for (uint32_t i = 0; i < budget->heapCount; ++i)
     {
-        VK_LOG_ERROR(result, "Error when creating descriptor pool: {}");
-        return VK_NULL_HANDLE;
+        VGPUMemoryHeapBudget& heap = budget->heaps[i];
+        heap.budget = heapBudgets[i].budget;
+        heap.usage = heapBudgets[i].usage;
+        heap.blockBytes = heapBudgets[i].statistics.blockBytes;
+        heap.allocationBytes = heapBudgets[i].statistics.allocationBytes;
+        heap.deviceLocal = (memoryProperties2.memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
     }
+}
 
-    return pool;
+static void ToMemoryTypeStatistics(const VmaDetailedStatistics& source, uint32_t heapIndex, VGPUMemoryTypeStatistics* statistics)
+{
+    statistics->heapIndex = heapIndex;
+    statistics->blockCount = source.statistics.blockCount;
+    statistics->allocationCount = source.statistics.allocationCount;
+    statistics->unusedRangeCount = source.unusedRangeCount;
+    statistics->blockBytes = source.statistics.blockBytes;
+    statistics->allocationBytes = source.statistics.allocationBytes;
+    statistics->allocationSizeMin = source.statistics.allocationCount > 0 ? source.allocationSizeMin : 0;
+    statistics->allocationSizeMax = source.allocationSizeMax;
+    statistics->unusedRangeSizeMax = source.unusedRangeCount > 0 ? source.unusedRangeSizeMax : 0;
+
+    const uint64_t unusedBytes = source.statistics.blockBytes - source.statistics.allocationBytes;
+    statistics->fragmentation = unusedBytes > 0 ? 1.0f - float(double(statistics->unusedRangeSizeMax) / double(unusedBytes)) : 0.0f;
 }
 
-VkSurfaceKHR VulkanDevice::CreateSurface(const VGPUSwapChainDesc* desc)
+void VulkanDevice::GetMemoryStatistics(VGPUMemoryStatistics* statistics)
 {
-    VkResult result = VK_SUCCESS;
-    VkSurfaceKHR vk_surface = VK_NULL_HANDLE;
+    VmaTotalStatistics totalStatistics;
+    vmaCalculateStatistics(allocator, &totalStatistics);
 
-#if defined(__ANDROID__)
-    VkAndroidSurfaceCreateInfoKHR createInfo = {};
-    createInfo.sType = VK_STRUCTURE_TYPE_ANDROID_SURFACE_CREATE_INFO_KHR;
+    *statistics = {};
+    statistics->memoryTypeCount = _VGPU_MIN(memoryProperties2.memoryProperties.memoryTypeCount, VGPU_MAX_MEMORY_TYPES);
+    for (uint32_t i = 0; i < statistics->memoryTypeCount; ++i)
+    {
+        ToMemoryTypeStatistics(totalStatistics.memoryType[i], memoryProperties2.memoryProperties.memoryTypes[i].heapIndex, &statistics->memoryTypes[i]);
+    }
+    ToMemoryTypeStatistics(totalStatistics.total, UINT32_MAX, &statistics->total);
+}
+
+size_t VulkanDevice::GetMemoryDump(bool detailed, char* data, size_t dataSize)
+{
+    char* statsString = nullptr;
+    vmaBuildStatsString(allocator, &statsString, detailed ? VK_TRUE : VK_FALSE);
+    if (statsString == nullptr)
+        return 0;
+
+    const size_t size = strlen(statsString) + 1;
+    if (data != nullptr && dataSize > 0)
+    {
+        const size_t copySize = _VGPU_MIN(size, dataSize);
+        memcpy(data, statsString, copySize);
+        data[copySize - 1] = '\0';
+    }
+
+    vmaFreeStatsString(allocator, statsString);
+    return size;
+}
+
+VulkanUploadContext* VulkanDevice::BeginUpload(uint64_t size, uint64_t alignment, VulkanStagingAllocation* staging)
+{
+    // Only contended locks show up in traces.
+    if (!uploadBatchMutex.try_lock())
+    {
+        VGPUTraceScope traceScope(this, "WaitForUploadBatch");
+        uploadBatchMutex.lock();
+    }
+
+    if (uploadBatch.IsValid() && uploadBatch.stagingSize + size > kUploadBatchSize)
+    {
+        FlushUploadsLocked();
+    }
+
+    if (!uploadBatch.IsValid())
+    {
+        uploadBatch = Allocate();
+        uploadBatchStart = std::chrono::steady_clock::now();
+    }
+
+    if (size == 0)
+        return &uploadBatch;
+
+    // Copy offsets must satisfy both the device preference and the texel size of the destination,
+    // the virtual block only aligns to powers of two so pad for odd texel sizes.
+    const uint64_t baseAlignment = _VGPU_MAX(uint64_t(16), uint64_t(properties2.properties.limits.optimalBufferCopyOffsetAlignment));
+    alignment = std::lcm(baseAlignment, _VGPU_MAX(alignment, uint64_t(1)));
+    const uint64_t allocationSize = IsPow2(alignment) ? size : size + alignment - 1;
+    const uint64_t allocationAlignment = IsPow2(alignment) ? alignment : baseAlignment;
+
+    VmaVirtualAllocation allocation = VK_NULL_HANDLE;
+    uint64_t offset = 0;
+    bool allocated = AllocateStaging(allocationSize, allocationAlignment, &allocation, &offset);
+    if (!allocated && uploadBatch.stagingSize > 0)
+    {
+        // Everything in flight is retired, the open batch holds the rest of the arena.
+        FlushUploadsLocked();
+        uploadBatch = Allocate();
+        uploadBatchStart = std::chrono::steady_clock::now();
+        allocated = AllocateStaging(allocationSize, allocationAlignment, &allocation, &offset);
+    }
+
+    if (allocated)
+    {
+        uploadBatch.stagingAllocations.push_back(allocation);
+        staging->buffer = stagingArena;
+        staging->offset = (offset + alignment - 1) / alignment * alignment;
+    }
+    else
+    {
+        VGPUBufferDesc bufferDesc{};
+        bufferDesc.label = "Dedicated Staging Buffer";
+        bufferDesc.size = size;
+        bufferDesc.cpuAccess = VGPUCpuAccessMode_Write;
+        VulkanBuffer* buffer = (VulkanBuffer*)CreateBuffer(&bufferDesc, nullptr);
+
+        uploadBatch.dedicatedStagingBuffers.push_back(buffer);
+        staging->buffer = buffer;
+        staging->offset = 0;
+
+        std::scoped_lock lock(uploadLocker);
+        stagingDedicatedBytes += size;
+    }
+
+    staging->data = (uint8_t*)staging->buffer->pMappedData + staging->offset;
+    uploadBatch.stagingSize += size;
+    frameCounters.uploadBytes.fetch_add(size, std::memory_order_relaxed);
+    return &uploadBatch;
+}
+
+void VulkanDevice::EndUpload()
+{
+    if (uploadBatch.stagingSize >= kUploadBatchSize ||
+        std::chrono::steady_clock::now() - uploadBatchStart >= kUploadBatchMaxLatency)
+    {
+        FlushUploadsLocked();
+    }
+
+    uploadBatchMutex.unlock();
+}
+
+uint64_t VulkanDevice::FlushUploadsLocked()
+{
+    if (!uploadBatch.IsValid())
+        return uploadTimelineValue;
+
+    const uint64_t token = ++uploadTimelineValue;
+    UploadSubmit(uploadBatch, token);
+
+    uploadBatch = {};
+    return token;
+}
+
+uint64_t VulkanDevice::FlushUploads()
+{
+    std::scoped_lock lock(uploadBatchMutex);
+    return FlushUploadsLocked();
+}
+
+VGPUBool32 VulkanDevice::WaitUploads(uint64_t token, uint64_t timeout)
+{
+    VkSemaphoreWaitInfo waitInfo = {};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &uploadTimeline;
+    waitInfo.pValues = &token;
+
+    const VkResult result = vkWaitSemaphores(device, &waitInfo, timeout);
+    if (result == VK_TIMEOUT)
+        return false;
+
+    VK_CHECK(result);
+    return result == VK_SUCCESS;
+}
+
+void VulkanDevice::SetObjectName(VkObjectType type, uint64_t handle, const char* name)
+{
+    if (!debugUtils)
+    {
+        return;
+    }
+
+    VkDebugUtilsObjectNameInfoEXT info;
+    info.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
+    info.pNext = nullptr;
+    info.objectType = type;
+    info.objectHandle = handle;
+    info.pObjectName = name;
+    VK_CHECK(vkSetDebugUtilsObjectNameEXT(device, &info));
+}
+
+void* VulkanDevice::GetNativeObject(VGPUNativeObjectType objectType) const
+{
+    switch (objectType)
+    {
+        case VGPUNativeObjectType_VkDevice:
+            return device;
+        case VGPUNativeObjectType_VkPhysicalDevice:
+            return physicalDevice;
+        case VGPUNativeObjectType_VkInstance:
+            return instance;
+        default:
+            return nullptr;
+    }
+}
+
+bool VulkanDevice::GetImageFormatProperties(const VkImageCreateInfo& createInfo, const void* pNext, VkImageFormatProperties2* imageFormatProperties2) const
+{
+    return GetImageFormatProperties(createInfo.format, createInfo.imageType, createInfo.tiling, createInfo.usage, createInfo.flags, pNext, imageFormatProperties2);
+}
+
+bool VulkanDevice::GetImageFormatProperties(VkFormat format, VkImageType type, VkImageTiling tiling, VkImageUsageFlags usage, VkImageCreateFlags flags, const void* pNext, VkImageFormatProperties2* imageFormatProperties2) const
+{
+    VGPU_ASSERT(imageFormatProperties2->sType == VK_STRUCTURE_TYPE_IMAGE_FORMAT_PROPERTIES_2);
+
+    VkPhysicalDeviceImageFormatInfo2 info = {};
+    info.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGE_FORMAT_INFO_2;
+    info.pNext = pNext;
+    info.format = format;
+    info.type = type;
+    info.tiling = tiling;
+    info.usage = usage;
+    info.flags = flags;
+
+    const VkResult result = vkGetPhysicalDeviceImageFormatProperties2(physicalDevice, &info, imageFormatProperties2);
+    return result == VK_SUCCESS;
+}
+
+VkDescriptorPool VulkanDevice::CreateDescriptorSetPool()
+{
+    const std::vector<VkDescriptorPoolSize> poolSizes{
+            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 512 },
+            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 16 },
+            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 512 },
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 128 },
+            { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 128 },
+            { VK_DESCRIPTOR_TYPE_SAMPLER, 8 },
+            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 8 }
+    };
+
+    VkDescriptorPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets = 1024;
+    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT; // VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT (bindless)
+    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    poolInfo.pPoolSizes = poolSizes.data();
+
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    VkResult result = vkCreateDescriptorPool(device, &poolInfo, nullptr, &pool);
+    if (result != VK_SUCCESS)
+    {
+        VK_LOG_ERROR(result, "Error when creating descriptor pool: {}");
+        return VK_NULL_HANDLE;
+    }
+
+    return pool;
+}
+
+VkSurfaceKHR VulkanDevice::CreateSurface(const VGPUSwapChainDesc* desc)
+{
+    VkResult result = VK_SUCCESS;
+    VkSurfaceKHR vk_surface = VK_NULL_HANDLE;
+
+#if defined(__ANDROID__)
+    VkAndroidSurfaceCreateInfoKHR createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_ANDROID_SURFACE_CREATE_INFO_KHR;
     createInfo.window = (ANativeWindow*)desc->windowHandle;
     result = vkCreateAndroidSurfaceKHR(instance, &createInfo, NULL, &vk_surface);
 #elif defined(_WIN32)
@@ -2039,6 +2970,8 @@ VkSurfaceKHR VulkanDevice::CreateSurface(const VGPUSwapChainDesc* desc)
 
 void VulkanDevice::ProcessDeletionQueue()
 {
+    VGPUTraceScope traceScope(this, "ProcessDeletionQueue");
+
     const auto destroy = [&](auto&& queue, auto&& handler) {
         while (!queue.empty()) {
             if (queue.front().second + VGPU_MAX_INFLIGHT_FRAMES < frameCount)
@@ -2046,6 +2979,7 @@ void VulkanDevice::ProcessDeletionQueue()
                 auto item = queue.front();
                 queue.pop_front();
                 handler(item.first);
+                pendingStatistics.deferredDeletions++;
             }
             else
             {
@@ -2066,14 +3000,71 @@ void VulkanDevice::ProcessDeletionQueue()
     destroy(destroyedPipelines, [&](auto& item) { vkDestroyPipeline(device, item, nullptr); });
     destroy(destroyedQueryPools, [&](auto& item) { vkDestroyQueryPool(device, item, nullptr); });
     destroy(destroyedDescriptorSets, [&](auto& item) { vkFreeDescriptorSets(device, item.first, 1u, &item.second); });
+    destroy(destroyedDescriptorIndices, [&](auto& item) { item.first->Free(item.second); });
+
+    // Pooled transient images nobody asked for in a while are destroyed for real.
+    for (auto it = transientImagePool.begin(); it != transientImagePool.end();)
+    {
+        auto& images = it->second;
+        while (!images.empty() && images.front().second + VGPU_MAX_INFLIGHT_FRAMES + kTransientImagePoolFrames < frameCount)
+        {
+            vmaDestroyImage(allocator, images.front().first.first, images.front().first.second);
+            images.pop_front();
+        }
+        it = images.empty() ? transientImagePool.erase(it) : std::next(it);
+    }
 
     destroyMutex.unlock();
 }
 
+/* VulkanMemoryHeap */
+VulkanMemoryHeap::~VulkanMemoryHeap()
+{
+    renderer->destroyMutex.lock();
+    if (allocation)
+    {
+        renderer->destroyedAllocations.push_back(std::make_pair(allocation, renderer->frameCount));
+    }
+    renderer->destroyMutex.unlock();
+}
+
+void VulkanMemoryHeap::SetLabel(const char* label)
+{
+    vmaSetAllocationName(renderer->allocator, allocation, label);
+}
+
+bool VulkanMemoryHeap::CanPlace(uint64_t offset, const VkMemoryRequirements& requirements) const
+{
+    if ((requirements.memoryTypeBits & (1u << memoryType)) == 0)
+    {
+        vgpuLogError("Vulkan: Heap memory type is not compatible with the placed resource");
+        return false;
+    }
+
+    if (offset % requirements.alignment != 0)
+    {
+        vgpuLogError("Vulkan: Placement offset %llu is not a multiple of the required alignment %llu", (unsigned long long)offset, (unsigned long long)requirements.alignment);
+        return false;
+    }
+
+    if (offset > size || requirements.size > size - offset)
+    {
+        vgpuLogError("Vulkan: Placed resource does not fit in the heap");
+        return false;
+    }
+
+    return true;
+}
+
 /* VulkanBuffer */
 VulkanBuffer::~VulkanBuffer()
 {
+    renderer->frameCounters.resourcesDestroyed.fetch_add(1, std::memory_order_relaxed);
     renderer->destroyMutex.lock();
+    if (descriptorIndex != VGPU_INVALID_DESCRIPTOR_INDEX)
+    {
+        renderer->destroyedDescriptorIndices.push_back(std::make_pair(std::make_pair(&renderer->bindlessStorageBuffers, descriptorIndex), renderer->frameCount));
+    }
     if (handle)
     {
         renderer->destroyedBuffers.push_back(std::make_pair(std::make_pair(handle, allocation), renderer->frameCount));
@@ -2083,6 +3074,12 @@ VulkanBuffer::~VulkanBuffer()
         renderer->destroyedAllocations.push_back(std::make_pair(allocation, renderer->frameCount));
     }
     renderer->destroyMutex.unlock();
+
+    // The heap queues its memory for the same frame, freeing it before the buffer is destroyed is valid.
+    if (heap)
+    {
+        heap->Release();
+    }
 }
 
 void VulkanBuffer::SetLabel(const char* label)
@@ -2090,20 +3087,67 @@ void VulkanBuffer::SetLabel(const char* label)
     renderer->SetObjectName(VK_OBJECT_TYPE_BUFFER, reinterpret_cast<uint64_t>(handle), label);
 }
 
+// VMA rounds the range to nonCoherentAtomSize and skips host coherent memory.
+void VulkanBuffer::FlushRange(uint64_t offset, uint64_t flushSize)
+{
+    if (pMappedData == nullptr || offset >= size)
+        return;
+
+    flushSize = _VGPU_MIN(flushSize, size - offset);
+    if (heap != nullptr)
+    {
+        VK_CHECK(vmaFlushAllocation(renderer->allocator, heap->allocation, heapOffset + offset, flushSize));
+    }
+    else
+    {
+        VK_CHECK(vmaFlushAllocation(renderer->allocator, allocation, offset, flushSize));
+    }
+}
+
+void VulkanBuffer::InvalidateRange(uint64_t offset, uint64_t invalidateSize)
+{
+    if (pMappedData == nullptr || offset >= size)
+        return;
+
+    invalidateSize = _VGPU_MIN(invalidateSize, size - offset);
+    if (heap != nullptr)
+    {
+        VK_CHECK(vmaInvalidateAllocation(renderer->allocator, heap->allocation, heapOffset + offset, invalidateSize));
+    }
+    else
+    {
+        VK_CHECK(vmaInvalidateAllocation(renderer->allocator, allocation, offset, invalidateSize));
+    }
+}
+
 /* VulkanTexture */
 VulkanTexture::~VulkanTexture()
 {
+    renderer->frameCounters.resourcesDestroyed.fetch_add(1, std::memory_order_relaxed);
     renderer->destroyMutex.lock();
+    if (descriptorIndex != VGPU_INVALID_DESCRIPTOR_INDEX)
+    {
+        renderer->destroyedDescriptorIndices.push_back(std::make_pair(std::make_pair(&renderer->bindlessSampledImages, descriptorIndex), renderer->frameCount));
+    }
     for (auto& it : viewCache)
     {
         renderer->destroyedImageViews.push_back(std::make_pair(it.second, renderer->frameCount));
     }
     viewCache.clear();
-    if (allocation)
+    if (pooled)
+    {
+        renderer->transientImagePool[poolKey].push_back(std::make_pair(std::make_pair(handle, allocation), renderer->frameCount));
+    }
+    else if (allocation || heap)
     {
         renderer->destroyedImages.push_back(std::make_pair(std::make_pair(handle, allocation), renderer->frameCount));
     }
     renderer->destroyMutex.unlock();
+
+    if (heap)
+    {
+        heap->Release();
+    }
 }
 
 void VulkanTexture::SetLabel(const char* label)
@@ -2111,13 +3155,14 @@ void VulkanTexture::SetLabel(const char* label)
     renderer->SetObjectName(VK_OBJECT_TYPE_IMAGE, reinterpret_cast<uint64_t>(handle), label);
 }
 
-VkImageView VulkanTexture::GetView(uint32_t baseMipLevel, uint32_t levelCount, uint32_t baseArrayLayer, uint32_t layerCount)
+VkImageView VulkanTexture::GetView(uint32_t baseMipLevel, uint32_t levelCount, uint32_t baseArrayLayer, uint32_t layerCount, VkImageViewType viewType)
 {
     size_t hash = 0;
     hash_combine(hash, baseMipLevel);
     hash_combine(hash, levelCount);
     hash_combine(hash, baseArrayLayer);
     hash_combine(hash, layerCount);
+    hash_combine(hash, viewType);
 
     auto it = viewCache.find(hash);
     if (it == viewCache.end())
@@ -2125,7 +3170,7 @@ VkImageView VulkanTexture::GetView(uint32_t baseMipLevel, uint32_t levelCount, u
         VkImageViewCreateInfo viewInfo{};
         viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
         viewInfo.image = handle;
-        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.viewType = viewType;
         viewInfo.format = vkFormat;
         viewInfo.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
         viewInfo.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
@@ -2135,7 +3180,7 @@ VkImageView VulkanTexture::GetView(uint32_t baseMipLevel, uint32_t levelCount, u
         viewInfo.subresourceRange.baseMipLevel = baseMipLevel;
         viewInfo.subresourceRange.levelCount = levelCount;
         viewInfo.subresourceRange.baseArrayLayer = baseArrayLayer;
-        viewInfo.subresourceRange.layerCount = 1;
+        viewInfo.subresourceRange.layerCount = layerCount;
 
         VkImageView newView;
         const VkResult result = vkCreateImageView(renderer->device, &viewInfo, nullptr, &newView);
@@ -2172,11 +3217,31 @@ void VulkanPipeline::SetLabel(const char* label)
     renderer->SetObjectName(VK_OBJECT_TYPE_PIPELINE, reinterpret_cast<uint64_t>(handle), label);
 }
 
+VGPUPipelineStatus VulkanPipeline::Wait()
+{
+    if (compileFinished.valid())
+    {
+        compileFinished.wait();
+    }
+
+    return status.load();
+}
+
 /* VulkanDevice */
 VulkanDevice::~VulkanDevice()
 {
+    // Finish in-flight pipeline compilations before tearing anything down.
+    pipelineWorkers.reset();
+    FlushUploads();
+
     VK_CHECK(vkDeviceWaitIdle(device));
 
+    for (VulkanProfilerFrame& frame : profilerFrames)
+    {
+        if (frame.queryPool != VK_NULL_HANDLE)
+            vkDestroyQueryPool(device, frame.queryPool, nullptr);
+    }
+
     for (size_t i = 0; i < commandBuffersPool.size(); ++i)
     {
         VulkanCommandBuffer* commandBuffer = commandBuffersPool[i];
@@ -2189,32 +3254,31 @@ VulkanDevice::~VulkanDevice()
         if (queues[i].queue == VK_NULL_HANDLE)
             continue;
 
-        for (uint32_t j = 0; j < VGPU_MAX_INFLIGHT_FRAMES; ++j)
-        {
-            vkDestroyFence(device, queues[i].frameFences[j], nullptr);
-        }
+        vkDestroySemaphore(device, queues[i].timelineSemaphore, nullptr);
     }
 
     // Destroy upload stuff
     vkQueueWaitIdle(queues[VGPUCommandQueue_Copy].queue);
+    RetireUploadsLocked(true);
     for (auto& context : uploadFreeList)
     {
         vkDestroyCommandPool(device, context.transferCommandPool, nullptr);
         vkDestroyCommandPool(device, context.transitionCommandPool, nullptr);
-        vkDestroySemaphore(device, context.semaphores[0], nullptr);
-        vkDestroySemaphore(device, context.semaphores[1], nullptr);
-        vkDestroySemaphore(device, context.semaphores[2], nullptr);
-        vkDestroyFence(device, context.fence, nullptr);
-
-        uint32_t count = context.uploadBuffer->Release();
-        VGPU_UNUSED(count);
-        context.uploadBufferData = nullptr;
+        vkDestroySemaphore(device, context.semaphore, nullptr);
     }
+    uploadFreeList.clear();
+    vmaDestroyVirtualBlock(stagingBlock);
+    stagingArena->Release();
+    vkDestroySemaphore(device, uploadTimeline, nullptr);
 
     frameCount = UINT64_MAX;
     ProcessDeletionQueue();
     frameCount = 0;
 
+    bindlessSampledImages.Shutdown(device);
+    bindlessStorageBuffers.Shutdown(device);
+    bindlessSamplers.Shutdown(device);
+
     vmaDestroyBuffer(allocator, nullBuffer, nullBufferAllocation);
     vkDestroyBufferView(device, nullBufferView, nullptr);
     vmaDestroyImage(allocator, nullImage1D, nullImageAllocation1D);
@@ -2231,6 +3295,12 @@ VulkanDevice::~VulkanDevice()
 
     // Release caches
     {
+        if (pipelineCache != VK_NULL_HANDLE)
+        {
+            vkDestroyPipelineCache(device, pipelineCache, nullptr);
+            pipelineCache = VK_NULL_HANDLE;
+        }
+
         // Destroy Descriptor Pools
         for (VkDescriptorPool descriptorPool : descriptorSetPools)
         {
@@ -2543,6 +3613,18 @@ bool VulkanDevice::Init(const VGPUDeviceDesc* desc)
                 continue;
             }
 
+            // Timeline semaphores drive all CPU/GPU synchronization
+            VkPhysicalDeviceVulkan12Features candidateFeatures1_2 = {};
+            candidateFeatures1_2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+            VkPhysicalDeviceFeatures2 candidateFeatures = {};
+            candidateFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            candidateFeatures.pNext = &candidateFeatures1_2;
+            vkGetPhysicalDeviceFeatures2(candidatePhysicalDevice, &candidateFeatures);
+            if (candidateFeatures1_2.timelineSemaphore != VK_TRUE)
+            {
+                continue;
+            }
+
             PhysicalDeviceExtensions physicalDeviceExt = QueryPhysicalDeviceExtensions(candidatePhysicalDevice);
             bool suitable = physicalDeviceExt.swapchain;
 
@@ -2844,6 +3926,15 @@ bool VulkanDevice::Init(const VGPUDeviceDesc* desc)
             features_chain = &conditionalRenderingFeatures.pNext;
         }
 
+        if (supportedExtensions.calibratedTimestamps)
+        {
+            enabledDeviceExtensions.push_back(VK_KHR_CALIBRATED_TIMESTAMPS_EXTENSION_NAME);
+        }
+        else if (supportedExtensions.calibratedTimestampsEXT)
+        {
+            enabledDeviceExtensions.push_back(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME);
+        }
+
 #if defined(_WIN32)
         if (supportedExtensions.externalMemory)
         {
@@ -2883,6 +3974,15 @@ bool VulkanDevice::Init(const VGPUDeviceDesc* desc)
         memoryProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
         vkGetPhysicalDeviceMemoryProperties2(physicalDevice, &memoryProperties2);
 
+        for (uint32_t i = 0; i < memoryProperties2.memoryProperties.memoryTypeCount; ++i)
+        {
+            if (memoryProperties2.memoryProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT)
+            {
+                lazilyAllocatedMemory = true;
+                break;
+            }
+        }
+
         VGPU_VERIFY(features2.features.robustBufferAccess == VK_TRUE);
         VGPU_VERIFY(features2.features.depthBiasClamp == VK_TRUE);
         VGPU_VERIFY(features2.features.fragmentStoresAndAtomics == VK_TRUE);
@@ -3004,6 +4104,11 @@ bool VulkanDevice::Init(const VGPUDeviceDesc* desc)
             queueFamilyIndices.queueIndices[VGPUCommandQueue_Copy] = queueFamilyIndices.queueIndices[VGPUCommandQueue_Compute];
         }
 
+        for (uint32_t i = 0; i < _VGPUCommandQueue_Count; ++i)
+        {
+            queues[i].timestampValidBits = queueFamilies[queueFamilyIndices.familyIndices[i]].queueFamilyProperties.timestampValidBits;
+        }
+
         VkDeviceCreateInfo createInfo{};
         createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
 
@@ -3057,22 +4162,57 @@ bool VulkanDevice::Init(const VGPUDeviceDesc* desc)
             GPU_FOREACH_DEVICE_MESH_SHADER(GPU_LOAD_DEVICE);
         }
 
-        // Queues
-        VkFenceCreateInfo fenceInfo = {};
-        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        if (supportedExtensions.calibratedTimestamps)
+        {
+            GPU_LOAD_INSTANCE(vkGetPhysicalDeviceCalibrateableTimeDomainsKHR);
+            GPU_LOAD_DEVICE(vkGetCalibratedTimestampsKHR);
+        }
+        else if (supportedExtensions.calibratedTimestampsEXT)
+        {
+            vkGetPhysicalDeviceCalibrateableTimeDomainsKHR = (PFN_vkGetPhysicalDeviceCalibrateableTimeDomainsKHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceCalibrateableTimeDomainsEXT");
+            vkGetCalibratedTimestampsKHR = (PFN_vkGetCalibratedTimestampsKHR)vkGetDeviceProcAddr(device, "vkGetCalibratedTimestampsEXT");
+        }
 
-        for (uint8_t i = 0; i < _VGPUCommandQueue_Count; i++)
+        // Trace timestamps are calibrated against the clock behind std::chrono::steady_clock.
+        if (supportedExtensions.calibratedTimestamps || supportedExtensions.calibratedTimestampsEXT)
         {
-            if (queueFamilyIndices.familyIndices[i] != VK_QUEUE_FAMILY_IGNORED)
+#if defined(_WIN32)
+            const VkTimeDomainKHR hostDomain = VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_KHR;
+#else
+            const VkTimeDomainKHR hostDomain = VK_TIME_DOMAIN_CLOCK_MONOTONIC_KHR;
+#endif
+            uint32_t timeDomainCount = 0;
+            VK_CHECK(vkGetPhysicalDeviceCalibrateableTimeDomainsKHR(physicalDevice, &timeDomainCount, nullptr));
+            std::vector<VkTimeDomainKHR> timeDomains(timeDomainCount);
+            VK_CHECK(vkGetPhysicalDeviceCalibrateableTimeDomainsKHR(physicalDevice, &timeDomainCount, timeDomains.data()));
+
+            const bool hasDevice = std::find(timeDomains.begin(), timeDomains.end(), VK_TIME_DOMAIN_DEVICE_KHR) != timeDomains.end();
+            const bool hasHost = std::find(timeDomains.begin(), timeDomains.end(), hostDomain) != timeDomains.end();
+            if (hasDevice && hasHost)
+            {
+                traceHostDomain = hostDomain;
+            }
+        }
+
+        // Queues
+        VkSemaphoreTypeCreateInfo timelineInfo = {};
+        timelineInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        timelineInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        timelineInfo.initialValue = 0;
+
+        VkSemaphoreCreateInfo semaphoreInfo = {};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphoreInfo.pNext = &timelineInfo;
+
+        for (uint8_t i = 0; i < _VGPUCommandQueue_Count; i++)
+        {
+            if (queueFamilyIndices.familyIndices[i] != VK_QUEUE_FAMILY_IGNORED)
             {
                 vkGetDeviceQueue(device, queueFamilyIndices.familyIndices[i], queueFamilyIndices.queueIndices[i], &queues[i].queue);
 
                 queueFamilyIndices.counts[i] = queueFamilyIndices.queueOffsets[queueFamilyIndices.familyIndices[i]];
 
-                for (uint32_t j = 0; j < VGPU_MAX_INFLIGHT_FRAMES; ++j)
-                {
-                    VK_CHECK(vkCreateFence(device, &fenceInfo, nullptr, &queues[i].frameFences[j]));
-                }
+                VK_CHECK(vkCreateSemaphore(device, &semaphoreInfo, nullptr, &queues[i].timelineSemaphore));
             }
             else
             {
@@ -3080,6 +4220,8 @@ bool VulkanDevice::Init(const VGPUDeviceDesc* desc)
             }
         }
 
+        VK_CHECK(vkCreateSemaphore(device, &semaphoreInfo, nullptr, &uploadTimeline));
+
 #ifdef _DEBUG
         vgpuLogInfo("Enabled %d Device Extensions:", createInfo.enabledExtensionCount);
         for (uint32_t i = 0; i < createInfo.enabledExtensionCount; ++i)
@@ -3188,6 +4330,44 @@ bool VulkanDevice::Init(const VGPUDeviceDesc* desc)
 
     }
 
+    // Staging arena shared by all uploads.
+    {
+        VGPUBufferDesc stagingDesc{};
+        stagingDesc.label = "Staging Arena";
+        stagingDesc.size = kStagingArenaSize;
+        stagingDesc.cpuAccess = VGPUCpuAccessMode_Write;
+        stagingArena = (VulkanBuffer*)CreateBuffer(&stagingDesc, nullptr);
+
+        VmaVirtualBlockCreateInfo blockInfo = {};
+        blockInfo.size = kStagingArenaSize;
+        result = vmaCreateVirtualBlock(&blockInfo, &stagingBlock);
+        if (result != VK_SUCCESS)
+        {
+            VK_LOG_ERROR(result, "Failed to create staging arena");
+            return false;
+        }
+    }
+
+    // Bindless descriptor heaps.
+    if (features1_2.descriptorIndexing == VK_TRUE &&
+        features1_2.runtimeDescriptorArray == VK_TRUE &&
+        features1_2.descriptorBindingPartiallyBound == VK_TRUE &&
+        features1_2.descriptorBindingUpdateUnusedWhilePending == VK_TRUE &&
+        features1_2.descriptorBindingSampledImageUpdateAfterBind == VK_TRUE &&
+        features1_2.descriptorBindingStorageBufferUpdateAfterBind == VK_TRUE &&
+        features1_2.shaderSampledImageArrayNonUniformIndexing == VK_TRUE &&
+        features1_2.shaderStorageBufferArrayNonUniformIndexing == VK_TRUE)
+    {
+        const uint32_t sampledImageCapacity = _VGPU_MIN(kBindlessResourceCapacity, properties_1_2.maxPerStageDescriptorUpdateAfterBindSampledImages);
+        const uint32_t storageBufferCapacity = _VGPU_MIN(kBindlessResourceCapacity, properties_1_2.maxPerStageDescriptorUpdateAfterBindStorageBuffers);
+        const uint32_t samplerCapacity = _VGPU_MIN(kBindlessSamplerCapacity, properties_1_2.maxPerStageDescriptorUpdateAfterBindSamplers);
+
+        bindlessSupported =
+            bindlessSampledImages.Init(device, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, sampledImageCapacity) &&
+            bindlessStorageBuffers.Init(device, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, storageBufferCapacity) &&
+            bindlessSamplers.Init(device, VK_DESCRIPTOR_TYPE_SAMPLER, samplerCapacity);
+    }
+
     // Create default null descriptors.
     {
         VkBufferCreateInfo bufferInfo = {};
@@ -3243,7 +4423,7 @@ bool VulkanDevice::Init(const VGPUDeviceDesc* desc)
 
         // Transitions
         {
-            VulkanUploadContext  uploadContext = Allocate(0);
+            VulkanUploadContext  uploadContext = Allocate();
             if (synchronization2)
             {
                 VkImageMemoryBarrier2 barrier = {};
@@ -3379,6 +4559,32 @@ bool VulkanDevice::Init(const VGPUDeviceDesc* desc)
     // Allocate at least one descriptor pool.
     descriptorSetPools.emplace_back(CreateDescriptorSetPool());
 
+    // Create pipeline cache, seeded with initial data when it matches this device.
+    {
+        VkPipelineCacheCreateInfo createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+        if (desc->pipelineCacheData != nullptr && desc->pipelineCacheDataSize > 0)
+        {
+            if (IsPipelineCacheCompatible(properties2.properties, desc->pipelineCacheData, desc->pipelineCacheDataSize))
+            {
+                createInfo.initialDataSize = desc->pipelineCacheDataSize;
+                createInfo.pInitialData = desc->pipelineCacheData;
+            }
+            else
+            {
+                vgpuLogWarn("Vulkan: Pipeline cache data doesn't match current device, discarding it");
+            }
+        }
+
+        result = vkCreatePipelineCache(device, &createInfo, nullptr, &pipelineCache);
+        if (result != VK_SUCCESS)
+        {
+            VK_LOG_ERROR(result, "Failed to create pipeline cache");
+            pipelineCache = VK_NULL_HANDLE;
+        }
+    }
+
     // Dynamic PSO states:
     psoDynamicStates.push_back(VK_DYNAMIC_STATE_VIEWPORT);
     psoDynamicStates.push_back(VK_DYNAMIC_STATE_SCISSOR);
@@ -3412,8 +4618,38 @@ void VulkanDevice::SetLabel(const char* label)
     SetObjectName(VK_OBJECT_TYPE_DEVICE, reinterpret_cast<uint64_t>(device), label);
 }
 
+size_t VulkanDevice::GetPipelineCacheData(void* data, size_t dataSize)
+{
+    if (pipelineCache == VK_NULL_HANDLE)
+        return 0;
+
+    size_t cacheSize = 0;
+    if (vkGetPipelineCacheData(device, pipelineCache, &cacheSize, nullptr) != VK_SUCCESS)
+        return 0;
+
+    if (data == nullptr)
+        return cacheSize;
+
+    if (dataSize < cacheSize)
+    {
+        vgpuLogError("Vulkan: Pipeline cache data requires %zu bytes, given buffer is %zu bytes", cacheSize, dataSize);
+        return 0;
+    }
+
+    // Async compiles can grow the cache after the size query, VK_INCOMPLETE still writes a valid (smaller) blob.
+    VkResult result = vkGetPipelineCacheData(device, pipelineCache, &cacheSize, data);
+    if (result != VK_SUCCESS && result != VK_INCOMPLETE)
+    {
+        VK_LOG_ERROR(result, "Failed to get pipeline cache data");
+        return 0;
+    }
+
+    return cacheSize;
+}
+
 void VulkanDevice::WaitIdle()
 {
+    FlushUploads();
     VK_CHECK(vkDeviceWaitIdle(device));
 }
 
@@ -3633,107 +4869,146 @@ static void AddUniqueFamily(uint32_t* sharing_indices, uint32_t& count, uint32_t
 }
 
 /* Buffer */
-VGPUBuffer VulkanDevice::CreateBuffer(const VGPUBufferDesc* desc, const void* pInitialData)
+void VulkanDevice::GetBufferCreateInfo(const VGPUBufferDesc* desc, VkBufferCreateInfo* bufferInfo, uint32_t* sharingIndices) const
 {
-    if (desc->existingHandle)
-    {
-        VulkanBuffer* buffer = new VulkanBuffer();
-        buffer->renderer = this;
-        buffer->size = desc->size;
-        buffer->usage = desc->usage;
-        buffer->handle = reinterpret_cast<VkBuffer>(desc->existingHandle);
-        buffer->allocation = VK_NULL_HANDLE;
-        buffer->allocatedSize = 0u;
-        buffer->gpuAddress = 0;
-
-        if (desc->label)
-        {
-            SetObjectName(VK_OBJECT_TYPE_BUFFER, reinterpret_cast<uint64_t>(buffer->handle), desc->label);
-        }
-
-        return buffer;
-    }
-
-    VkBufferCreateInfo bufferInfo = {};
-    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    bufferInfo.size = desc->size;
-    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    bufferInfo->sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo->size = desc->size;
+    bufferInfo->usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
 
     bool needBufferDeviceAddress = false;
     if (desc->usage & VGPUBufferUsage_Vertex)
     {
-        bufferInfo.usage |= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+        bufferInfo->usage |= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
         needBufferDeviceAddress = true;
     }
     if (desc->usage & VGPUBufferUsage_Index)
     {
-        bufferInfo.usage |= VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+        bufferInfo->usage |= VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
         needBufferDeviceAddress = true;
     }
 
     if (desc->usage & VGPUBufferUsage_Constant)
     {
-        bufferInfo.size = VmaAlignUp(bufferInfo.size, properties2.properties.limits.minUniformBufferOffsetAlignment);
-        bufferInfo.usage |= VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+        bufferInfo->size = VmaAlignUp(bufferInfo->size, properties2.properties.limits.minUniformBufferOffsetAlignment);
+        bufferInfo->usage |= VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
     }
 
     if (desc->usage & VGPUBufferUsage_ShaderRead)
     {
         // ReadOnly ByteAddressBuffer is also storage buffer
-        bufferInfo.usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT;
+        bufferInfo->usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT;
     }
 
     if (desc->usage & VGPUBufferUsage_ShaderWrite)
     {
-        bufferInfo.usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT;
+        bufferInfo->usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT;
     }
 
     if (desc->usage & VGPUBufferUsage_Indirect)
     {
-        bufferInfo.usage |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+        bufferInfo->usage |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
         needBufferDeviceAddress = true;
     }
 
     // We check for feature in vgpuCreateBuffer
     if (desc->usage & VGPUBufferUsage_Predication)
     {
-        bufferInfo.usage |= VK_BUFFER_USAGE_CONDITIONAL_RENDERING_BIT_EXT;
+        bufferInfo->usage |= VK_BUFFER_USAGE_CONDITIONAL_RENDERING_BIT_EXT;
     }
 
     if (desc->usage & VGPUBufferUsage_RayTracing)
     {
-        bufferInfo.usage |= VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR;
-        bufferInfo.usage |= VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR;
-        bufferInfo.usage |= VK_BUFFER_USAGE_SHADER_BINDING_TABLE_BIT_KHR;
+        bufferInfo->usage |= VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR;
+        bufferInfo->usage |= VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR;
+        bufferInfo->usage |= VK_BUFFER_USAGE_SHADER_BINDING_TABLE_BIT_KHR;
         needBufferDeviceAddress = true;
     }
 
     if (features1_2.bufferDeviceAddress == VK_TRUE && needBufferDeviceAddress)
     {
-        bufferInfo.usage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+        bufferInfo->usage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
     }
 
-    uint32_t sharingIndices[3] = {};
     for (auto& i : queueFamilyIndices.familyIndices)
     {
-        AddUniqueFamily(sharingIndices, bufferInfo.queueFamilyIndexCount, i);
+        AddUniqueFamily(sharingIndices, bufferInfo->queueFamilyIndexCount, i);
     }
 
-    if (bufferInfo.queueFamilyIndexCount > 1)
+    if (bufferInfo->queueFamilyIndexCount > 1)
     {
         // For buffers, always just use CONCURRENT access modes,
         // so we don't have to deal with acquire/release barriers in async compute.
-        bufferInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        bufferInfo->sharingMode = VK_SHARING_MODE_CONCURRENT;
 
-        bufferInfo.pQueueFamilyIndices = sharingIndices;
+        bufferInfo->pQueueFamilyIndices = sharingIndices;
     }
     else
     {
-        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-        bufferInfo.queueFamilyIndexCount = 0;
-        bufferInfo.pQueueFamilyIndices = nullptr;
+        bufferInfo->sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        bufferInfo->queueFamilyIndexCount = 0;
+        bufferInfo->pQueueFamilyIndices = nullptr;
+    }
+}
+
+void VulkanDevice::InitBuffer(VulkanBuffer* buffer, const VGPUBufferDesc* desc, const VkBufferCreateInfo& bufferInfo)
+{
+    buffer->size = desc->size;
+    buffer->usage = desc->usage;
+
+    if (desc->label)
+    {
+        buffer->SetLabel(desc->label);
+    }
+
+    if (bufferInfo.usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)
+    {
+        VkBufferDeviceAddressInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+        info.buffer = buffer->handle;
+        buffer->gpuAddress = vkGetBufferDeviceAddress(device, &info);
+    }
+
+    if (bindlessSupported && (desc->usage & (VGPUBufferUsage_ShaderRead | VGPUBufferUsage_ShaderWrite)))
+    {
+        buffer->descriptorIndex = bindlessStorageBuffers.Allocate();
+        if (buffer->descriptorIndex != VGPU_INVALID_DESCRIPTOR_INDEX)
+        {
+            VkDescriptorBufferInfo descriptorInfo = {};
+            descriptorInfo.buffer = buffer->handle;
+            descriptorInfo.offset = 0;
+            descriptorInfo.range = VK_WHOLE_SIZE;
+            frameCounters.descriptorWrites.fetch_add(1, std::memory_order_relaxed);
+            bindlessStorageBuffers.Write(device, buffer->descriptorIndex, nullptr, &descriptorInfo);
+        }
+    }
+}
+
+VGPUBuffer VulkanDevice::CreateBuffer(const VGPUBufferDesc* desc, const void* pInitialData)
+{
+    if (desc->existingHandle)
+    {
+        VulkanBuffer* buffer = new VulkanBuffer();
+        buffer->renderer = this;
+        frameCounters.resourcesCreated.fetch_add(1, std::memory_order_relaxed);
+        buffer->size = desc->size;
+        buffer->usage = desc->usage;
+        buffer->handle = reinterpret_cast<VkBuffer>(desc->existingHandle);
+        buffer->allocation = VK_NULL_HANDLE;
+        buffer->allocatedSize = 0u;
+        buffer->gpuAddress = 0;
+
+        if (desc->label)
+        {
+            SetObjectName(VK_OBJECT_TYPE_BUFFER, reinterpret_cast<uint64_t>(buffer->handle), desc->label);
+        }
+
+        return buffer;
     }
 
+    VkBufferCreateInfo bufferInfo = {};
+    uint32_t sharingIndices[3] = {};
+    GetBufferCreateInfo(desc, &bufferInfo, sharingIndices);
+
     VmaAllocationCreateInfo memoryInfo = {};
     memoryInfo.usage = VMA_MEMORY_USAGE_AUTO;
     if (desc->cpuAccess == VGPUCpuAccessMode_Read)
@@ -3742,13 +5017,13 @@ VGPUBuffer VulkanDevice::CreateBuffer(const VGPUBufferDesc* desc, const void* pI
     }
     else if (desc->cpuAccess == VGPUCpuAccessMode_Write)
     {
-        bufferInfo.usage |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
         memoryInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
     }
 
     VmaAllocationInfo allocationInfo{};
     VulkanBuffer* buffer = new VulkanBuffer();
     buffer->renderer = this;
+    frameCounters.resourcesCreated.fetch_add(1, std::memory_order_relaxed);
     VkResult result = vmaCreateBuffer(allocator, &bufferInfo, &memoryInfo,
         &buffer->handle,
         &buffer->allocation,
@@ -3760,31 +5035,18 @@ VGPUBuffer VulkanDevice::CreateBuffer(const VGPUBufferDesc* desc, const void* pI
         return nullptr;
     }
 
-    buffer->size = desc->size;
-    buffer->usage = desc->usage;
-
-    if (desc->label)
-    {
-        buffer->SetLabel(desc->label);
-    }
+    InitBuffer(buffer, desc, bufferInfo);
 
     if (memoryInfo.flags & VMA_ALLOCATION_CREATE_MAPPED_BIT)
     {
         buffer->pMappedData = allocationInfo.pMappedData;
     }
 
-    if (bufferInfo.usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)
-    {
-        VkBufferDeviceAddressInfo info = {};
-        info.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
-        info.buffer = buffer->handle;
-        buffer->gpuAddress = vkGetBufferDeviceAddress(device, &info);
-    }
-
     // Issue data copy.
     if (pInitialData != nullptr)
     {
-        VulkanUploadContext uploadContext;
+        VulkanUploadContext* uploadContext = nullptr;
+        VulkanStagingAllocation staging;
         void* pMappedData = nullptr;
         if (desc->cpuAccess == VGPUCpuAccessMode_Write)
         {
@@ -3792,22 +5054,22 @@ VGPUBuffer VulkanDevice::CreateBuffer(const VGPUBufferDesc* desc, const void* pI
         }
         else
         {
-            uploadContext = Allocate(desc->size);
-            pMappedData = uploadContext.uploadBufferData;
+            uploadContext = BeginUpload(desc->size, 4, &staging);
+            pMappedData = staging.data;
         }
 
         memcpy(pMappedData, pInitialData, desc->size);
 
-        if (uploadContext.IsValid())
+        if (uploadContext != nullptr)
         {
             VkBufferCopy copyRegion = {};
             copyRegion.size = buffer->size;
-            copyRegion.srcOffset = 0;
+            copyRegion.srcOffset = staging.offset;
             copyRegion.dstOffset = 0;
 
             vkCmdCopyBuffer(
-                uploadContext.transferCommandBuffer,
-                uploadContext.uploadBuffer->handle,
+                uploadContext->transferCommandBuffer,
+                staging.buffer->handle,
                 buffer->handle,
                 1,
                 &copyRegion
@@ -3880,7 +5142,7 @@ VGPUBuffer VulkanDevice::CreateBuffer(const VGPUBufferDesc* desc, const void* pI
                 dependencyInfo.bufferMemoryBarrierCount = 1;
                 dependencyInfo.pBufferMemoryBarriers = &barrier;
 
-                vkCmdPipelineBarrier2(uploadContext.transitionCommandBuffer, &dependencyInfo);
+                vkCmdPipelineBarrier2(uploadContext->transitionCommandBuffer, &dependencyInfo);
             }
             else
             {
@@ -3895,7 +5157,7 @@ VGPUBuffer VulkanDevice::CreateBuffer(const VGPUBufferDesc* desc, const void* pI
                 barrier.size = VK_WHOLE_SIZE;
 
                 vkCmdPipelineBarrier(
-                    uploadContext.transferCommandBuffer,
+                    uploadContext->transferCommandBuffer,
                     VK_PIPELINE_STAGE_TRANSFER_BIT,
                     VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
                     0,
@@ -3940,7 +5202,7 @@ VGPUBuffer VulkanDevice::CreateBuffer(const VGPUBufferDesc* desc, const void* pI
                 }
 
                 vkCmdPipelineBarrier(
-                    uploadContext.transitionCommandBuffer,
+                    uploadContext->transitionCommandBuffer,
                     VK_PIPELINE_STAGE_TRANSFER_BIT,
                     VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
                     0,
@@ -3950,7 +5212,7 @@ VGPUBuffer VulkanDevice::CreateBuffer(const VGPUBufferDesc* desc, const void* pI
                 );
             }
 
-            UploadSubmit(uploadContext);
+            EndUpload();
         }
     }
 
@@ -3958,121 +5220,180 @@ VGPUBuffer VulkanDevice::CreateBuffer(const VGPUBufferDesc* desc, const void* pI
 }
 
 /* Texture */
-VGPUTexture VulkanDevice::CreateTexture(const VGPUTextureDesc* desc, const VGPUTextureData* pInitialData)
+bool VulkanDevice::GetTextureCreateInfo(const VGPUTextureDesc* desc, VkImageCreateInfo* createInfo, uint32_t* sharingIndices) const
 {
     const bool isDepthStencilFormat = vgpuIsDepthStencilFormat(desc->format);
 
-    VkImageCreateInfo createInfo = {};
-    createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-    createInfo.pNext = nullptr;
-    createInfo.flags = 0;
-    createInfo.format = ToVkFormat(desc->format);
-    createInfo.extent.width = desc->width;
+    createInfo->sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    createInfo->pNext = nullptr;
+    createInfo->flags = 0;
+    createInfo->format = ToVkFormat(desc->format);
+    createInfo->extent.width = desc->width;
 
     switch (desc->dimension)
     {
         case VGPUTextureDimension_1D:
-            createInfo.imageType = VK_IMAGE_TYPE_1D;
-            createInfo.extent.height = 1;
-            createInfo.extent.depth = 1;
-            createInfo.arrayLayers = desc->depthOrArrayLayers;
+            createInfo->imageType = VK_IMAGE_TYPE_1D;
+            createInfo->extent.height = 1;
+            createInfo->extent.depth = 1;
+            createInfo->arrayLayers = desc->depthOrArrayLayers;
             break;
 
         case VGPUTextureDimension_2D:
-            createInfo.imageType = VK_IMAGE_TYPE_2D;
-            createInfo.extent.height = desc->height;
-            createInfo.extent.depth = 1;
-            createInfo.arrayLayers = desc->depthOrArrayLayers;
-            createInfo.samples = (VkSampleCountFlagBits)desc->sampleCount;
-
-            if (createInfo.extent.width == createInfo.extent.height &&
-                createInfo.arrayLayers >= 6)
+            createInfo->imageType = VK_IMAGE_TYPE_2D;
+            createInfo->extent.height = desc->height;
+            createInfo->extent.depth = 1;
+            createInfo->arrayLayers = desc->depthOrArrayLayers;
+            createInfo->samples = (VkSampleCountFlagBits)desc->sampleCount;
+
+            if (createInfo->extent.width == createInfo->extent.height &&
+                createInfo->arrayLayers >= 6)
             {
-                createInfo.flags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
+                createInfo->flags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
             }
             break;
 
         case VGPUTextureDimension_3D:
-            createInfo.imageType = VK_IMAGE_TYPE_3D;
-            createInfo.flags |= VK_IMAGE_CREATE_2D_ARRAY_COMPATIBLE_BIT;
-            createInfo.extent.height = desc->height;
-            createInfo.extent.depth = desc->depthOrArrayLayers;
-            createInfo.arrayLayers = 1;
-            createInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+            createInfo->imageType = VK_IMAGE_TYPE_3D;
+            createInfo->flags |= VK_IMAGE_CREATE_2D_ARRAY_COMPATIBLE_BIT;
+            createInfo->extent.height = desc->height;
+            createInfo->extent.depth = desc->depthOrArrayLayers;
+            createInfo->arrayLayers = 1;
+            createInfo->samples = VK_SAMPLE_COUNT_1_BIT;
             break;
 
         default:
-            return nullptr;
+            return false;
     }
 
-    createInfo.mipLevels = desc->mipLevelCount;
-    createInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    createInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    createInfo->mipLevels = desc->mipLevelCount;
+    createInfo->initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    createInfo->tiling = VK_IMAGE_TILING_OPTIMAL;
 
     if (desc->usage & VGPUTextureUsage_Transient)
     {
-        createInfo.usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+        createInfo->usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
     }
     else
     {
-        createInfo.usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
-        createInfo.usage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        createInfo->usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        createInfo->usage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
     }
 
     if (desc->usage & VGPUTextureUsage_ShaderRead)
     {
-        createInfo.usage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+        createInfo->usage |= VK_IMAGE_USAGE_SAMPLED_BIT;
     }
 
     if (desc->usage & VGPUTextureUsage_ShaderWrite)
     {
-        createInfo.usage |= VK_IMAGE_USAGE_STORAGE_BIT;
+        createInfo->usage |= VK_IMAGE_USAGE_STORAGE_BIT;
     }
 
     if (desc->usage & VGPUTextureUsage_RenderTarget)
     {
         if (isDepthStencilFormat)
         {
-            createInfo.usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+            createInfo->usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
         }
         else
         {
-            createInfo.usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+            createInfo->usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
         }
     }
 
     if (desc->usage & VGPUTextureUsage_ShadingRate)
     {
-        createInfo.usage |= VK_IMAGE_USAGE_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_KHR;
+        createInfo->usage |= VK_IMAGE_USAGE_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_KHR;
     }
 
     // If ShaderRead and RenderTarget add input attachment
     if (!isDepthStencilFormat &&
         (desc->usage & (VGPUTextureUsage_RenderTarget | VGPUTextureUsage_ShaderRead)))
     {
-        createInfo.usage |= VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+        createInfo->usage |= VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
     }
 
-    uint32_t sharingIndices[3] = {};
     for (auto& i : queueFamilyIndices.familyIndices)
     {
-        AddUniqueFamily(sharingIndices, createInfo.queueFamilyIndexCount, i);
+        AddUniqueFamily(sharingIndices, createInfo->queueFamilyIndexCount, i);
     }
 
-    if (createInfo.queueFamilyIndexCount > 1)
+    if (createInfo->queueFamilyIndexCount > 1)
     {
         // For buffers, always just use CONCURRENT access modes,
         // so we don't have to deal with acquire/release barriers in async compute.
-        createInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        createInfo->sharingMode = VK_SHARING_MODE_CONCURRENT;
 
-        createInfo.pQueueFamilyIndices = sharingIndices;
+        createInfo->pQueueFamilyIndices = sharingIndices;
     }
     else
     {
-        createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-        createInfo.queueFamilyIndexCount = 0;
-        createInfo.pQueueFamilyIndices = nullptr;
+        createInfo->sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo->queueFamilyIndexCount = 0;
+        createInfo->pQueueFamilyIndices = nullptr;
+    }
+
+    return true;
+}
+
+// Square 2D textures with exactly 6 layers are cubes, cube arrays are exposed as 2D arrays.
+static VkImageViewType GetBindlessViewType(const VkImageCreateInfo& createInfo)
+{
+    switch (createInfo.imageType)
+    {
+        case VK_IMAGE_TYPE_1D:
+            return createInfo.arrayLayers > 1 ? VK_IMAGE_VIEW_TYPE_1D_ARRAY : VK_IMAGE_VIEW_TYPE_1D;
+
+        case VK_IMAGE_TYPE_3D:
+            return VK_IMAGE_VIEW_TYPE_3D;
+
+        default:
+            if ((createInfo.flags & VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT) && createInfo.arrayLayers == 6)
+                return VK_IMAGE_VIEW_TYPE_CUBE;
+
+            return createInfo.arrayLayers > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
+    }
+}
+
+void VulkanDevice::InitTexture(VulkanTexture* texture, const VGPUTextureDesc* desc, const VkImageCreateInfo& createInfo)
+{
+    texture->dimension = desc->dimension;
+    texture->format = desc->format;
+    texture->width = createInfo.extent.width;
+    texture->height = createInfo.extent.height;
+    texture->vkFormat = createInfo.format;
+    texture->usage = desc->usage;
+    texture->mipLevelCount = createInfo.mipLevels;
+    texture->arrayLayerCount = createInfo.arrayLayers;
+    texture->subresourceStates.resize(createInfo.mipLevels * createInfo.arrayLayers);
+
+    if (desc->label)
+    {
+        texture->SetLabel(desc->label);
+    }
+
+    // Bindless views cover every mip and layer, depth-stencil textures are only reachable through bind groups.
+    if (bindlessSupported && (desc->usage & VGPUTextureUsage_ShaderRead) && !vgpuIsDepthStencilFormat(desc->format))
+    {
+        texture->descriptorIndex = bindlessSampledImages.Allocate();
+        if (texture->descriptorIndex != VGPU_INVALID_DESCRIPTOR_INDEX)
+        {
+            VkDescriptorImageInfo imageInfo = {};
+            imageInfo.imageView = texture->GetView(0, createInfo.mipLevels, 0, createInfo.arrayLayers, GetBindlessViewType(createInfo));
+            imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            frameCounters.descriptorWrites.fetch_add(1, std::memory_order_relaxed);
+            bindlessSampledImages.Write(device, texture->descriptorIndex, &imageInfo, nullptr);
+        }
     }
+}
+
+VGPUTexture VulkanDevice::CreateTexture(const VGPUTextureDesc* desc, const VGPUTextureData* pInitialData)
+{
+    VkImageCreateInfo createInfo = {};
+    uint32_t sharingIndices[3] = {};
+    if (!GetTextureCreateInfo(desc, &createInfo, sharingIndices))
+        return nullptr;
 
     VmaAllocationCreateInfo memoryInfo = {};
     memoryInfo.usage = VMA_MEMORY_USAGE_AUTO;
@@ -4126,38 +5447,84 @@ VGPUTexture VulkanDevice::CreateTexture(const VGPUTextureDesc* desc, const VGPUT
 
     VmaAllocationInfo allocationInfo{};
 
-    if (desc->cpuAccess == VGPUCpuAccessMode_Write
-        || desc->cpuAccess == VGPUCpuAccessMode_Read)
+    if (desc->cpuAccess == VGPUCpuAccessMode_Read)
     {
-        // TODO: Handle readback texture
+        // Optimal tiling cannot be mapped, texture readbacks are copied into a VGPUReadbackRing instead.
+        vgpuLogError("Vulkan: Readback textures are not supported, use vgpuReadbackRingCopyTexture");
+        return nullptr;
     }
 
     VulkanTexture* texture = new VulkanTexture();
     texture->renderer = this;
-    texture->dimension = desc->dimension;
-    texture->format = desc->format;
-    texture->width = createInfo.extent.width;
-    texture->height = createInfo.extent.height;
-    texture->vkFormat = createInfo.format;
+    frameCounters.resourcesCreated.fetch_add(1, std::memory_order_relaxed);
 
-    VkResult result = vmaCreateImage(allocator,
-        &createInfo, &memoryInfo,
-        &texture->handle,
-        &texture->allocation,
-        &allocationInfo);
-
-    if (result != VK_SUCCESS)
+    if (desc->usage & VGPUTextureUsage_Transient)
     {
-        vgpuLogError("Vulkan: Failed to create texture");
-        delete texture;
-        return nullptr;
+        if (lazilyAllocatedMemory)
+        {
+            // On tilers the attachment lives in tile memory and may never get physical backing.
+            memoryInfo.usage = VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED;
+        }
+        else
+        {
+            size_t hash = 0;
+            hash_combine(hash, createInfo.flags);
+            hash_combine(hash, createInfo.imageType);
+            hash_combine(hash, createInfo.format);
+            hash_combine(hash, createInfo.extent.width);
+            hash_combine(hash, createInfo.extent.height);
+            hash_combine(hash, createInfo.extent.depth);
+            hash_combine(hash, createInfo.mipLevels);
+            hash_combine(hash, createInfo.arrayLayers);
+            hash_combine(hash, createInfo.samples);
+            hash_combine(hash, createInfo.usage);
+            texture->pooled = true;
+            texture->poolKey = hash;
+
+            destroyMutex.lock();
+            auto it = transientImagePool.find(hash);
+            if (it != transientImagePool.end()
+                && !it->second.empty()
+                && it->second.front().second + VGPU_MAX_INFLIGHT_FRAMES < frameCount)
+            {
+                texture->handle = it->second.front().first.first;
+                texture->allocation = it->second.front().first.second;
+                it->second.pop_front();
+            }
+            destroyMutex.unlock();
+        }
     }
 
-    if (desc->label)
+    if (texture->handle == VK_NULL_HANDLE)
     {
-        texture->SetLabel(desc->label);
+        VkResult result = vmaCreateImage(allocator,
+            &createInfo, &memoryInfo,
+            &texture->handle,
+            &texture->allocation,
+            &allocationInfo);
+
+        if (result != VK_SUCCESS && memoryInfo.usage == VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED)
+        {
+            // Not every format can live in lazily allocated memory.
+            memoryInfo.usage = VMA_MEMORY_USAGE_AUTO;
+            result = vmaCreateImage(allocator,
+                &createInfo, &memoryInfo,
+                &texture->handle,
+                &texture->allocation,
+                &allocationInfo);
+        }
+
+        if (result != VK_SUCCESS)
+        {
+            vgpuLogError("Vulkan: Failed to create texture");
+            texture->pooled = false;
+            delete texture;
+            return nullptr;
+        }
     }
 
+    InitTexture(texture, desc, createInfo);
+
     if (isShared)
     {
 #if defined(_WIN32)
@@ -4186,28 +5553,21 @@ VGPUTexture VulkanDevice::CreateTexture(const VGPUTextureDesc* desc, const VGPUT
     subresourceRange.baseArrayLayer = 0;
     subresourceRange.layerCount = createInfo.arrayLayers;
 
+    const VkImageLayout restingLayout = texture->GetRestingLayout();
+
     if (pInitialData != nullptr)
     {
-        VulkanUploadContext uploadContext;
-        void* pMappedData = nullptr;
-        if (desc->cpuAccess == VGPUCpuAccessMode_Write)
-        {
-            //pMappedData = texture->pMappedData;
-        }
-        else
-        {
-            uploadContext = Allocate(allocationInfo.size);
-            pMappedData = uploadContext.uploadBuffer->pMappedData;
-        }
-        VGPU_UNUSED(pMappedData);
-
+        // Textures are not host mappable yet, initial data always goes through the upload batch.
         std::vector<VkBufferImageCopy> copyRegions;
 
         VGPUPixelFormatInfo formatInfo;
         vgpuGetPixelFormatInfo(desc->format, &formatInfo);
         const uint32_t blockSize = formatInfo.blockWidth;
 
-        VkDeviceSize copyOffset = 0;
+        VulkanStagingAllocation staging;
+        VulkanUploadContext* uploadContext = BeginUpload(allocationInfo.size, formatInfo.bytesPerBlock, &staging);
+
+        VkDeviceSize copyOffset = staging.offset;
         uint32_t initDataIndex = 0;
         for (uint32_t arrayIndex = 0; arrayIndex < createInfo.arrayLayers; ++arrayIndex)
         {
@@ -4229,7 +5589,7 @@ VGPUTexture VulkanDevice::CreateTexture(const VGPUTextureDesc* desc, const VGPUT
 
                 for (uint32_t z = 0; z < levelDepth; ++z)
                 {
-                    uint8_t* dstSlice = (uint8_t*)uploadContext.uploadBufferData + copyOffset + dstSlicePitch * z;
+                    uint8_t* dstSlice = (uint8_t*)staging.buffer->pMappedData + copyOffset + dstSlicePitch * z;
                     uint8_t* srcSlice = (uint8_t*)subresourceData.pData + srcSlicePitch * z;
                     for (uint32_t y = 0; y < numBlocksY; ++y)
                     {
@@ -4241,25 +5601,22 @@ VGPUTexture VulkanDevice::CreateTexture(const VGPUTextureDesc* desc, const VGPUT
                     }
                 }
 
-                if (uploadContext.IsValid())
-                {
-                    VkBufferImageCopy copyRegion = {};
-                    copyRegion.bufferOffset = copyOffset;
-                    copyRegion.bufferRowLength = 0;
-                    copyRegion.bufferImageHeight = 0;
-
-                    copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-                    copyRegion.imageSubresource.mipLevel = mipIndex;
-                    copyRegion.imageSubresource.baseArrayLayer = arrayIndex;
-                    copyRegion.imageSubresource.layerCount = 1;
-
-                    copyRegion.imageOffset = { 0, 0, 0 };
-                    copyRegion.imageExtent.width = levelWidth;
-                    copyRegion.imageExtent.height = levelHeight;
-                    copyRegion.imageExtent.depth = levelDepth;
-
-                    copyRegions.push_back(copyRegion);
-                }
+                VkBufferImageCopy copyRegion = {};
+                copyRegion.bufferOffset = copyOffset;
+                copyRegion.bufferRowLength = 0;
+                copyRegion.bufferImageHeight = 0;
+
+                copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                copyRegion.imageSubresource.mipLevel = mipIndex;
+                copyRegion.imageSubresource.baseArrayLayer = arrayIndex;
+                copyRegion.imageSubresource.layerCount = 1;
+
+                copyRegion.imageOffset = { 0, 0, 0 };
+                copyRegion.imageExtent.width = levelWidth;
+                copyRegion.imageExtent.height = levelHeight;
+                copyRegion.imageExtent.depth = levelDepth;
+
+                copyRegions.push_back(copyRegion);
 
                 copyOffset += dstSlicePitch * levelDepth;
 
@@ -4269,116 +5626,121 @@ VGPUTexture VulkanDevice::CreateTexture(const VGPUTextureDesc* desc, const VGPUT
             }
         }
 
-        if (uploadContext.IsValid())
+        if (synchronization2)
         {
-            if (synchronization2)
+            VkImageMemoryBarrier2 barrier = {};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+            barrier.srcStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+            barrier.srcAccessMask = 0;
+            barrier.dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+            barrier.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = texture->handle;
+            barrier.subresourceRange = subresourceRange;
+
+            VkDependencyInfo dependencyInfo = {};
+            dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+            dependencyInfo.imageMemoryBarrierCount = 1;
+            dependencyInfo.pImageMemoryBarriers = &barrier;
+            vkCmdPipelineBarrier2(uploadContext->transferCommandBuffer, &dependencyInfo);
+
+            vkCmdCopyBufferToImage(
+                uploadContext->transferCommandBuffer,
+                staging.buffer->handle,
+                texture->handle,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                (uint32_t)copyRegions.size(),
+                copyRegions.data()
+            );
+
+            // The transition buffer runs after the copy semaphore, which already made the writes available.
+            if (restingLayout != VK_IMAGE_LAYOUT_UNDEFINED)
             {
-                VkImageMemoryBarrier2 barrier = {};
-                barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
                 barrier.srcStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
                 barrier.srcAccessMask = 0;
-                barrier.dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
-                barrier.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
-                barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-                barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-                barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-                barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-                barrier.image = texture->handle;
-                barrier.subresourceRange = subresourceRange;
-
-                VkDependencyInfo dependencyInfo = {};
-                dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
-                dependencyInfo.imageMemoryBarrierCount = 1;
-                dependencyInfo.pImageMemoryBarriers = &barrier;
-                vkCmdPipelineBarrier2(uploadContext.transferCommandBuffer, &dependencyInfo);
-
-                vkCmdCopyBufferToImage(
-                    uploadContext.transferCommandBuffer,
-                    uploadContext.uploadBuffer->handle,
-                    texture->handle,
-                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                    (uint32_t)copyRegions.size(),
-                    copyRegions.data()
-                );
-
-                //const ResourceStateMapping2 mappingAfter = ConvertResourceState2(initialState);
-                //ALIMER_ASSERT(mappingAfter.imageLayout != VK_IMAGE_LAYOUT_UNDEFINED);
-                //
-                //std::swap(barrier.srcStageMask, barrier.dstStageMask);
-                //barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-                //barrier.newLayout = mappingAfter.imageLayout;
-                //barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
-                //barrier.dstAccessMask = mappingAfter.accessMask;
-                //
-                //vkCmdPipelineBarrier2(uploadContext.transitionCommandBuffer, &dependencyInfo);
+                barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+                barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
+                barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                barrier.newLayout = restingLayout;
+                vkCmdPipelineBarrier2(uploadContext->transitionCommandBuffer, &dependencyInfo);
             }
-            else
+        }
+        else
+        {
+            VkImageMemoryBarrier barrier = {};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.oldLayout = createInfo.initialLayout;
+            barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = texture->handle;
+            barrier.subresourceRange = subresourceRange;
+
+            vkCmdPipelineBarrier(uploadContext->transferCommandBuffer,
+                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                0,
+                0, nullptr,
+                0, nullptr,
+                1, &barrier
+            );
+
+            vkCmdCopyBufferToImage(
+                uploadContext->transferCommandBuffer,
+                staging.buffer->handle,
+                texture->handle,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                (uint32_t)copyRegions.size(),
+                copyRegions.data()
+            );
+
+            if (restingLayout != VK_IMAGE_LAYOUT_UNDEFINED)
             {
-                VkImageMemoryBarrier barrier = {};
-                barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
                 barrier.srcAccessMask = 0;
-                barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-                barrier.oldLayout = createInfo.initialLayout;
-                barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-                barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-                barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-                barrier.image = texture->handle;
-                barrier.subresourceRange = subresourceRange;
+                barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+                barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                barrier.newLayout = restingLayout;
 
-                vkCmdPipelineBarrier(uploadContext.transferCommandBuffer,
+                vkCmdPipelineBarrier(uploadContext->transitionCommandBuffer,
+                    VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
                     VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
-                    VK_PIPELINE_STAGE_TRANSFER_BIT,
                     0,
                     0, nullptr,
                     0, nullptr,
                     1, &barrier
                 );
-
-                vkCmdCopyBufferToImage(
-                    uploadContext.transferCommandBuffer,
-                    uploadContext.uploadBuffer->handle,
-                    texture->handle,
-                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                    (uint32_t)copyRegions.size(),
-                    copyRegions.data()
-                );
-
-                //const ResourceStateMapping mappingAfter = ConvertResourceState(initialState);
-                //ALIMER_ASSERT(mappingAfter.imageLayout != VK_IMAGE_LAYOUT_UNDEFINED);
-                //
-                //barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-                //barrier.dstAccessMask = mappingAfter.accessMask;
-                //barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-                //barrier.newLayout = mappingAfter.imageLayout;
-                //
-                //vkCmdPipelineBarrier(uploadContext.transitionCommandBuffer,
-                //    VK_PIPELINE_STAGE_TRANSFER_BIT,
-                //    VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
-                //    0,
-                //    0, nullptr,
-                //    0, nullptr,
-                //    1, &barrier
-                //);
             }
+        }
 
-            UploadSubmit(uploadContext);
+        EndUpload();
+
+        // Frames wait on the upload timeline, so the global state needs no stages to wait on.
+        for (VulkanResourceState& state : texture->subresourceStates)
+        {
+            state.layout = restingLayout != VK_IMAGE_LAYOUT_UNDEFINED ? restingLayout : VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
         }
     }
-    else
+    else if (restingLayout != VK_IMAGE_LAYOUT_UNDEFINED)
     {
-        VulkanUploadContext uploadContext = Allocate(0);
+        // Shader-readable textures start in their resting layout, other textures stay undefined until first use.
+        VulkanStagingAllocation staging;
+        VulkanUploadContext* uploadContext = BeginUpload(0, 1, &staging);
 
-        // Barrier
         if (synchronization2)
         {
             VkImageMemoryBarrier2 barrier = {};
             barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
-            barrier.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+            barrier.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
             barrier.srcAccessMask = 0;
-            barrier.dstStageMask = VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT;
-            barrier.dstAccessMask = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+            barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+            barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
             barrier.oldLayout = createInfo.initialLayout;
-            barrier.newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+            barrier.newLayout = restingLayout;
             barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
             barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
             barrier.image = texture->handle;
@@ -4389,44 +5751,260 @@ VGPUTexture VulkanDevice::CreateTexture(const VGPUTextureDesc* desc, const VGPUT
             dependencyInfo.imageMemoryBarrierCount = 1;
             dependencyInfo.pImageMemoryBarriers = &barrier;
 
-            vkCmdPipelineBarrier2(uploadContext.transitionCommandBuffer, &dependencyInfo);
+            vkCmdPipelineBarrier2(uploadContext->transitionCommandBuffer, &dependencyInfo);
         }
         else
         {
             VkImageMemoryBarrier barrier{};
             barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
             barrier.srcAccessMask = 0u;
-            barrier.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
             barrier.oldLayout = createInfo.initialLayout;
-            barrier.newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+            barrier.newLayout = restingLayout;
             barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
             barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
             barrier.image = texture->handle;
             barrier.subresourceRange = subresourceRange;
 
-            vkCmdPipelineBarrier(uploadContext.transitionCommandBuffer,
-                VK_PIPELINE_STAGE_TRANSFER_BIT,
-                VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+            vkCmdPipelineBarrier(uploadContext->transitionCommandBuffer,
+                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
                 0,
                 0, nullptr,
                 0, nullptr,
                 1, &barrier);
         }
 
-        UploadSubmit(uploadContext);
+        EndUpload();
+
+        for (VulkanResourceState& state : texture->subresourceStates)
+        {
+            state.layout = restingLayout;
+        }
+    }
+
+    return texture;
+}
+
+/* Placed resources */
+bool VulkanDevice::GetBufferAllocationRequirements(const VGPUBufferDesc* desc, VGPUAllocationRequirements* requirements)
+{
+    VkBufferCreateInfo bufferInfo = {};
+    uint32_t sharingIndices[3] = {};
+    GetBufferCreateInfo(desc, &bufferInfo, sharingIndices);
+
+    VkBuffer buffer = VK_NULL_HANDLE;
+    if (vkCreateBuffer(device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS)
+        return false;
+
+    VkMemoryRequirements memoryRequirements;
+    vkGetBufferMemoryRequirements(device, buffer, &memoryRequirements);
+    vkDestroyBuffer(device, buffer, nullptr);
+
+    // Buffers and optimal images may share a heap, keep them on separate granularity pages.
+    requirements->size = memoryRequirements.size;
+    requirements->alignment = _VGPU_MAX(memoryRequirements.alignment, properties2.properties.limits.bufferImageGranularity);
+    requirements->memoryTypeBits = memoryRequirements.memoryTypeBits;
+    return true;
+}
+
+bool VulkanDevice::GetTextureAllocationRequirements(const VGPUTextureDesc* desc, VGPUAllocationRequirements* requirements)
+{
+    if (desc->cpuAccess != VGPUCpuAccessMode_None || (desc->usage & VGPUTextureUsage_Shared))
+        return false;
+
+    // Placing a transient attachment in a heap would commit memory the lazy allocation avoids.
+    if ((desc->usage & VGPUTextureUsage_Transient) && lazilyAllocatedMemory)
+        return false;
+
+    VkImageCreateInfo createInfo = {};
+    uint32_t sharingIndices[3] = {};
+    if (!GetTextureCreateInfo(desc, &createInfo, sharingIndices))
+        return false;
+
+    VkImage image = VK_NULL_HANDLE;
+    if (vkCreateImage(device, &createInfo, nullptr, &image) != VK_SUCCESS)
+        return false;
+
+    VkMemoryRequirements memoryRequirements;
+    vkGetImageMemoryRequirements(device, image, &memoryRequirements);
+    vkDestroyImage(device, image, nullptr);
+
+    requirements->size = memoryRequirements.size;
+    requirements->alignment = _VGPU_MAX(memoryRequirements.alignment, properties2.properties.limits.bufferImageGranularity);
+    requirements->memoryTypeBits = memoryRequirements.memoryTypeBits;
+    return true;
+}
+
+VGPUMemoryHeap VulkanDevice::CreateMemoryHeap(const VGPUAllocationRequirements* requirements, VGPUMemoryClass memoryClass)
+{
+    VkMemoryRequirements memoryRequirements = {};
+    memoryRequirements.size = requirements->size;
+    memoryRequirements.alignment = _VGPU_MAX(requirements->alignment, (uint64_t)1u);
+    memoryRequirements.memoryTypeBits = requirements->memoryTypeBits;
+
+    VmaAllocationCreateInfo memoryInfo = {};
+    switch (memoryClass)
+    {
+        case VGPUMemoryClass_Upload:
+            memoryInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+            memoryInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+            break;
+
+        case VGPUMemoryClass_Readback:
+            memoryInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+            memoryInfo.preferredFlags = VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+            memoryInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+            break;
+
+        default:
+            memoryInfo.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+            break;
+    }
+
+    if (requirements->alignment == 0)
+    {
+        memoryInfo.flags |= VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+    }
+
+    VulkanMemoryHeap* heap = new VulkanMemoryHeap();
+    heap->renderer = this;
+    heap->size = requirements->size;
+    heap->memoryClass = memoryClass;
+
+    VmaAllocationInfo allocationInfo = {};
+    VkResult result = vmaAllocateMemory(allocator, &memoryRequirements, &memoryInfo, &heap->allocation, &allocationInfo);
+    if (result != VK_SUCCESS)
+    {
+        VK_LOG_ERROR(result, "Failed to allocate memory heap.");
+        delete heap;
+        return nullptr;
+    }
+
+    heap->memoryType = allocationInfo.memoryType;
+    heap->pMappedData = allocationInfo.pMappedData;
+    return heap;
+}
+
+VGPUBuffer VulkanDevice::CreatePlacedBuffer(VGPUMemoryHeap heap, uint64_t offset, const VGPUBufferDesc* desc)
+{
+    VulkanMemoryHeap* backendHeap = static_cast<VulkanMemoryHeap*>(heap);
+
+    VkBufferCreateInfo bufferInfo = {};
+    uint32_t sharingIndices[3] = {};
+    GetBufferCreateInfo(desc, &bufferInfo, sharingIndices);
+
+    VulkanBuffer* buffer = new VulkanBuffer();
+    buffer->renderer = this;
+    frameCounters.resourcesCreated.fetch_add(1, std::memory_order_relaxed);
+
+    VkResult result = vkCreateBuffer(device, &bufferInfo, nullptr, &buffer->handle);
+    if (result != VK_SUCCESS)
+    {
+        VK_LOG_ERROR(result, "Failed to create placed buffer.");
+        delete buffer;
+        return nullptr;
+    }
+
+    VkMemoryRequirements memoryRequirements;
+    vkGetBufferMemoryRequirements(device, buffer->handle, &memoryRequirements);
+    if (!backendHeap->CanPlace(offset, memoryRequirements))
+    {
+        delete buffer;
+        return nullptr;
+    }
+
+    result = vmaBindBufferMemory2(allocator, backendHeap->allocation, offset, buffer->handle, nullptr);
+    if (result != VK_SUCCESS)
+    {
+        VK_LOG_ERROR(result, "Failed to bind placed buffer.");
+        delete buffer;
+        return nullptr;
+    }
+
+    backendHeap->AddRef();
+    buffer->heap = backendHeap;
+    buffer->heapOffset = offset;
+    if (backendHeap->pMappedData)
+    {
+        buffer->pMappedData = (uint8_t*)backendHeap->pMappedData + offset;
+    }
+    InitBuffer(buffer, desc, bufferInfo);
+    return buffer;
+}
+
+VGPUTexture VulkanDevice::CreatePlacedTexture(VGPUMemoryHeap heap, uint64_t offset, const VGPUTextureDesc* desc)
+{
+    VulkanMemoryHeap* backendHeap = static_cast<VulkanMemoryHeap*>(heap);
+
+    VkImageCreateInfo createInfo = {};
+    uint32_t sharingIndices[3] = {};
+    if (!GetTextureCreateInfo(desc, &createInfo, sharingIndices))
+        return nullptr;
+
+    VulkanTexture* texture = new VulkanTexture();
+    texture->renderer = this;
+    frameCounters.resourcesCreated.fetch_add(1, std::memory_order_relaxed);
+
+    VkResult result = vkCreateImage(device, &createInfo, nullptr, &texture->handle);
+    if (result == VK_SUCCESS)
+    {
+        // Until the destructor runs the texture owns the image, the heap reference marks it for deletion.
+        texture->heap = backendHeap;
+        backendHeap->AddRef();
+
+        VkMemoryRequirements memoryRequirements;
+        vkGetImageMemoryRequirements(device, texture->handle, &memoryRequirements);
+        if (!backendHeap->CanPlace(offset, memoryRequirements))
+        {
+            delete texture;
+            return nullptr;
+        }
+
+        result = vmaBindImageMemory2(allocator, backendHeap->allocation, offset, texture->handle, nullptr);
+    }
+
+    if (result != VK_SUCCESS)
+    {
+        VK_LOG_ERROR(result, "Failed to create placed texture.");
+        delete texture;
+        return nullptr;
     }
 
+    // Placed memory may hold another resource's data, the contents stay undefined until the first write.
+    InitTexture(texture, desc, createInfo);
     return texture;
 }
 
 /* VulkanSampler */
 VulkanSampler::~VulkanSampler()
 {
+    // Called with objectCacheMutex held from Release.
+    if (cached)
+    {
+        renderer->samplerCache.erase(hash);
+    }
+
+    // Samplers that failed to create have nothing to destroy.
+    if (handle == VK_NULL_HANDLE)
+        return;
+
     renderer->destroyMutex.lock();
+    if (descriptorIndex != VGPU_INVALID_DESCRIPTOR_INDEX)
+    {
+        renderer->destroyedDescriptorIndices.push_back(std::make_pair(std::make_pair(&renderer->bindlessSamplers, descriptorIndex), renderer->frameCount));
+    }
     renderer->destroyedSamplers.push_back(std::make_pair(handle, renderer->frameCount));
     renderer->destroyMutex.unlock();
 }
 
+uint32_t VulkanSampler::Release()
+{
+    // Hold the cache lock so a concurrent lookup can't revive a sampler being destroyed.
+    std::lock_guard<std::recursive_mutex> lock(renderer->objectCacheMutex);
+    return VGPUObject::Release();
+}
+
 void VulkanSampler::SetLabel(const char* label)
 {
     renderer->SetObjectName(VK_OBJECT_TYPE_SAMPLER, reinterpret_cast<uint64_t>(handle), label);
@@ -4471,8 +6049,20 @@ VGPUSampler VulkanDevice::CreateSampler(const VGPUSamplerDesc* desc)
     createInfo.borderColor = ToVkBorderColor(desc->borderColor);
     createInfo.unnormalizedCoordinates = VK_FALSE;
 
+    const size_t hash = HashSamplerCreateInfo(createInfo);
+
+    std::lock_guard<std::recursive_mutex> lock(objectCacheMutex);
+    auto it = samplerCache.find(hash);
+    if (it != samplerCache.end() && IsSameSamplerCreateInfo(it->second->createInfo, createInfo))
+    {
+        it->second->AddRef();
+        return it->second;
+    }
+
     VulkanSampler* sampler = new VulkanSampler();
     sampler->renderer = this;
+    sampler->createInfo = createInfo;
+    sampler->hash = hash;
     VkResult result = vkCreateSampler(device, &createInfo, nullptr, &sampler->handle);
 
     if (result != VK_SUCCESS)
@@ -4487,17 +6077,52 @@ VGPUSampler VulkanDevice::CreateSampler(const VGPUSamplerDesc* desc)
         sampler->SetLabel(desc->label);
     }
 
+    if (bindlessSupported)
+    {
+        sampler->descriptorIndex = bindlessSamplers.Allocate();
+        if (sampler->descriptorIndex != VGPU_INVALID_DESCRIPTOR_INDEX)
+        {
+            VkDescriptorImageInfo imageInfo = {};
+            imageInfo.sampler = sampler->handle;
+            frameCounters.descriptorWrites.fetch_add(1, std::memory_order_relaxed);
+            bindlessSamplers.Write(device, sampler->descriptorIndex, &imageInfo, nullptr);
+        }
+    }
+
+    // On hash collision the new sampler stays uncached.
+    if (it == samplerCache.end())
+    {
+        sampler->cached = true;
+        samplerCache[hash] = sampler;
+    }
+
     return sampler;
 }
 
 /* BindGroupLayout */
 VulkanBindGroupLayout::~VulkanBindGroupLayout()
 {
+    // Called with objectCacheMutex held from Release.
+    if (cached)
+    {
+        device->bindGroupLayoutCache.erase(hash);
+    }
+
+    // Duplicates discarded on a cache hit and failed creations never got a handle.
+    if (handle == VK_NULL_HANDLE)
+        return;
+
     device->destroyMutex.lock();
     device->destroyedDescriptorSetLayouts.push_back(std::make_pair(handle, device->frameCount));
     device->destroyMutex.unlock();
 }
 
+uint32_t VulkanBindGroupLayout::Release()
+{
+    std::lock_guard<std::recursive_mutex> lock(device->objectCacheMutex);
+    return VGPUObject::Release();
+}
+
 void VulkanBindGroupLayout::SetLabel(const char* label)
 {
     device->SetObjectName(VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, reinterpret_cast<uint64_t>(handle), label);
@@ -4603,6 +6228,19 @@ VGPUBindGroupLayout VulkanDevice::CreateBindGroupLayout(const VGPUBindGroupLayou
     }
 
     //layout->isBindless = true;
+    layout->hash = HashDescriptorSetLayoutBindings(layout->layoutBindings, layout->isBindless);
+
+    std::lock_guard<std::recursive_mutex> lock(objectCacheMutex);
+    auto it = bindGroupLayoutCache.find(layout->hash);
+    if (it != bindGroupLayoutCache.end()
+        && it->second->isBindless == layout->isBindless
+        && IsSameDescriptorSetLayoutBindings(it->second->layoutBindings, layout->layoutBindings))
+    {
+        delete layout;
+        it->second->AddRef();
+        return it->second;
+    }
+
     VkDescriptorSetLayoutCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
     createInfo.bindingCount = (uint32_t)layout->layoutBindings.size();
@@ -4632,17 +6270,43 @@ VGPUBindGroupLayout VulkanDevice::CreateBindGroupLayout(const VGPUBindGroupLayou
         layout->SetLabel(desc->label);
     }
 
+    if (it == bindGroupLayoutCache.end())
+    {
+        layout->cached = true;
+        bindGroupLayoutCache[layout->hash] = layout;
+    }
+
     return layout;
 }
 
 /* PipelineLayout */
 VulkanPipelineLayout::~VulkanPipelineLayout()
 {
+    // Called with objectCacheMutex held from Release.
+    if (cached)
+    {
+        device->pipelineLayoutCache.erase(hash);
+    }
+
+    for (VulkanBindGroupLayout* bindGroupLayout : bindGroupLayouts)
+    {
+        bindGroupLayout->Release();
+    }
+
+    if (handle == VK_NULL_HANDLE)
+        return;
+
     device->destroyMutex.lock();
     device->destroyedPipelineLayouts.push_back(std::make_pair(handle, device->frameCount));
     device->destroyMutex.unlock();
 }
 
+uint32_t VulkanPipelineLayout::Release()
+{
+    std::lock_guard<std::recursive_mutex> lock(device->objectCacheMutex);
+    return VGPUObject::Release();
+}
+
 void VulkanPipelineLayout::SetLabel(const char* label)
 {
     device->SetObjectName(VK_OBJECT_TYPE_PIPELINE_LAYOUT, reinterpret_cast<uint64_t>(handle), label);
@@ -4656,9 +6320,29 @@ VGPUPipelineLayout VulkanDevice::CreatePipelineLayout(const VGPUPipelineLayoutDe
     layout->bindGroupLayoutCount = (uint32_t)descriptor->bindGroupLayoutCount;
 
     std::vector<VkDescriptorSetLayout> descriptorSetLayouts(descriptor->bindGroupLayoutCount);
+    layout->bindGroupLayouts.resize(descriptor->bindGroupLayoutCount);
     for (uint32_t i = 0; i < descriptor->bindGroupLayoutCount; i++)
     {
-        descriptorSetLayouts[i] = static_cast<VulkanBindGroupLayout*>(descriptor->bindGroupLayouts[i])->handle;
+        layout->bindGroupLayouts[i] = static_cast<VulkanBindGroupLayout*>(descriptor->bindGroupLayouts[i]);
+        descriptorSetLayouts[i] = layout->bindGroupLayouts[i]->handle;
+        hash_combine(layout->hash, layout->bindGroupLayouts[i]);
+    }
+
+    if (descriptor->bindless)
+    {
+        if (!bindlessSupported)
+        {
+            vgpuLogError("Vulkan: Bindless pipeline layouts require descriptor indexing with update-after-bind");
+            layout->bindGroupLayouts.clear();
+            delete layout;
+            return nullptr;
+        }
+
+        layout->bindless = true;
+        descriptorSetLayouts.push_back(bindlessSampledImages.layout);
+        descriptorSetLayouts.push_back(bindlessStorageBuffers.layout);
+        descriptorSetLayouts.push_back(bindlessSamplers.layout);
+        hash_combine(layout->hash, layout->bindless);
     }
 
     // Push constants
@@ -4678,9 +6362,32 @@ VGPUPipelineLayout VulkanDevice::CreatePipelineLayout(const VGPUPipelineLayoutDe
             range.size = pushConstantRange.size;
 
             offset += pushConstantRange.size;
+
+            hash_combine(layout->hash, range.stageFlags);
+            hash_combine(layout->hash, range.size);
         }
     }
 
+    // Bind group layouts are deduplicated too, so comparing their pointers is enough.
+    std::lock_guard<std::recursive_mutex> lock(objectCacheMutex);
+    auto it = pipelineLayoutCache.find(layout->hash);
+    if (it != pipelineLayoutCache.end()
+        && it->second->bindGroupLayouts == layout->bindGroupLayouts
+        && it->second->bindless == layout->bindless
+        && IsSamePushConstantRanges(it->second->pushConstantRanges, layout->pushConstantRanges))
+    {
+        layout->bindGroupLayouts.clear();
+        delete layout;
+        it->second->AddRef();
+        return it->second;
+    }
+
+    // Keep the bind group layouts alive, so their pointers stay unique while cached.
+    for (VulkanBindGroupLayout* bindGroupLayout : layout->bindGroupLayouts)
+    {
+        bindGroupLayout->AddRef();
+    }
+
     // Create pipeline layout
     VkPipelineLayoutCreateInfo createInfo = { };
     createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
@@ -4701,6 +6408,12 @@ VGPUPipelineLayout VulkanDevice::CreatePipelineLayout(const VGPUPipelineLayoutDe
         layout->SetLabel(descriptor->label);
     }
 
+    if (it == pipelineLayoutCache.end())
+    {
+        layout->cached = true;
+        pipelineLayoutCache[layout->hash] = layout;
+    }
+
     return layout;
 }
 
@@ -4830,6 +6543,7 @@ void VulkanBindGroup::Update(size_t entryCount, const VGPUBindGroupEntry* entrie
         }
     }
 
+    device->frameCounters.descriptorWrites.fetch_add(descriptorWriteCount, std::memory_order_relaxed);
     vkUpdateDescriptorSets(
         device->device,
         descriptorWriteCount,
@@ -4930,56 +6644,157 @@ VkResult SetupShaderStage(VkDevice device,
     return VK_SUCCESS;
 }
 
-VGPUPipeline VulkanDevice::CreateRenderPipeline(const VGPURenderPipelineDesc* desc)
+VulkanRenderPipelineDescCopy::VulkanRenderPipelineDescCopy(const VGPURenderPipelineDesc* source)
+    : desc(*source)
 {
-    VulkanPipelineLayout* layout = (VulkanPipelineLayout*)desc->layout;
-
-    // ShaderStages
-    std::vector<VkPipelineShaderStageCreateInfo> shaderStages(desc->shaderStageCount);
-    std::vector<std::string> stageEntryPoints(desc->shaderStageCount);
+    if (source->label)
+    {
+        label = source->label;
+        desc.label = label.c_str();
+    }
 
-    for (uint32_t i = 0; i < desc->shaderStageCount; i++)
+    // Size containers up front so the pointers stored in desc stay valid.
+    shaderStages.assign(source->shaderStages, source->shaderStages + source->shaderStageCount);
+    shaderBytecodes.resize(source->shaderStageCount);
+    entryPointNames.resize(source->shaderStageCount);
+    for (uint32_t i = 0; i < source->shaderStageCount; ++i)
     {
-        const VGPUShaderStageDesc& shaderDesc = desc->shaderStages[i];
-        VkResult res = SetupShaderStage(device, shaderStages[i], stageEntryPoints[i], shaderDesc);
-        if (res != VK_SUCCESS)
+        const uint8_t* bytecode = (const uint8_t*)source->shaderStages[i].bytecode;
+        shaderBytecodes[i].assign(bytecode, bytecode + source->shaderStages[i].size);
+        shaderStages[i].bytecode = shaderBytecodes[i].data();
+
+        if (source->shaderStages[i].entryPointName)
         {
-            return nullptr;
+            entryPointNames[i] = source->shaderStages[i].entryPointName;
+            shaderStages[i].entryPointName = entryPointNames[i].c_str();
         }
     }
+    desc.shaderStages = shaderStages.data();
 
-    // RenderingInfo
-    VkFormat colorAttachmentFormats[VGPU_MAX_COLOR_ATTACHMENTS];
-    VkPipelineRenderingCreateInfo renderingInfo = {};
-    renderingInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
-
-    for (uint32_t i = 0; i < desc->colorFormatCount; ++i)
+    vertexLayouts.assign(source->vertex.layouts, source->vertex.layouts + source->vertex.layoutCount);
+    vertexAttributes.resize(source->vertex.layoutCount);
+    for (uint32_t i = 0; i < source->vertex.layoutCount; ++i)
     {
-        VGPU_ASSERT(desc->colorFormats[i] != VGPUTextureFormat_Undefined);
-
-        colorAttachmentFormats[renderingInfo.colorAttachmentCount] = ToVkFormat(desc->colorFormats[i]);
-        renderingInfo.colorAttachmentCount++;
+        const VGPUVertexBufferLayout& layout = source->vertex.layouts[i];
+        vertexAttributes[i].assign(layout.attributes, layout.attributes + layout.attributeCount);
+        vertexLayouts[i].attributes = vertexAttributes[i].data();
     }
-    renderingInfo.pColorAttachmentFormats = colorAttachmentFormats;
+    desc.vertex.layouts = vertexLayouts.data();
 
-    // VertexInputState
-    std::vector<VkVertexInputBindingDescription> vertexInputBindings;
-    std::vector<VkVertexInputAttributeDescription> vertexInputAttributes;
+    colorFormats.assign(source->colorFormats, source->colorFormats + source->colorFormatCount);
+    desc.colorFormats = colorFormats.data();
+}
 
-    vertexInputBindings.resize(desc->vertex.layoutCount);
-    for (uint32_t binding = 0; binding < desc->vertex.layoutCount; ++binding)
+VulkanComputePipelineDescCopy::VulkanComputePipelineDescCopy(const VGPUComputePipelineDesc* source)
+    : desc(*source)
+{
+    if (source->label)
     {
-        const VGPUVertexBufferLayout& bufferLayout = desc->vertex.layouts[binding];
-
-        vertexInputBindings[binding].binding = binding;
-        vertexInputBindings[binding].stride = bufferLayout.stride;
-        vertexInputBindings[binding].inputRate = ToVkVertexInputRate(bufferLayout.stepMode);
+        label = source->label;
+        desc.label = label.c_str();
+    }
 
-        for (uint32_t attributeIndex = 0; attributeIndex < bufferLayout.attributeCount; ++attributeIndex)
-        {
-            const VGPUVertexAttribute& attribute = bufferLayout.attributes[attributeIndex];
+    const uint8_t* bytecode = (const uint8_t*)source->shader.bytecode;
+    shaderBytecode.assign(bytecode, bytecode + source->shader.size);
+    desc.shader.bytecode = shaderBytecode.data();
 
-            VkVertexInputAttributeDescription vertexInputAttribute;
+    if (source->shader.entryPointName)
+    {
+        entryPointName = source->shader.entryPointName;
+        desc.shader.entryPointName = entryPointName.c_str();
+    }
+}
+
+VGPUPipeline VulkanDevice::CreateRenderPipeline(const VGPURenderPipelineDesc* desc)
+{
+    VulkanPipeline* pipeline = new VulkanPipeline();
+    pipeline->renderer = this;
+    pipeline->type = VGPUPipelineType_Render;
+    pipeline->bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    pipeline->pipelineLayout = (VulkanPipelineLayout*)desc->layout;
+    pipeline->pipelineLayout->AddRef();
+
+    if (!InitRenderPipeline(pipeline, desc))
+    {
+        delete pipeline;
+        return nullptr;
+    }
+
+    return pipeline;
+}
+
+VGPUPipeline VulkanDevice::CreateRenderPipelineAsync(const VGPURenderPipelineDesc* desc, VGPUPipelineCallback callback, void* userData)
+{
+    std::shared_ptr<VulkanRenderPipelineDescCopy> descCopy = std::make_shared<VulkanRenderPipelineDescCopy>(desc);
+
+    VulkanPipeline* pipeline = new VulkanPipeline();
+    pipeline->renderer = this;
+    pipeline->type = VGPUPipelineType_Render;
+    pipeline->bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    pipeline->pipelineLayout = (VulkanPipelineLayout*)desc->layout;
+    pipeline->pipelineLayout->AddRef();
+
+    CompilePipelineAsync(pipeline, [this, pipeline, descCopy]() {
+        return InitRenderPipeline(pipeline, &descCopy->desc);
+    }, callback, userData);
+
+    return pipeline;
+}
+
+bool VulkanDevice::InitRenderPipeline(VulkanPipeline* pipeline, const VGPURenderPipelineDesc* desc)
+{
+    VulkanPipelineLayout* layout = pipeline->pipelineLayout;
+
+    // ShaderStages
+    std::vector<VkPipelineShaderStageCreateInfo> shaderStages(desc->shaderStageCount);
+    std::vector<std::string> stageEntryPoints(desc->shaderStageCount);
+
+    for (uint32_t i = 0; i < desc->shaderStageCount; i++)
+    {
+        const VGPUShaderStageDesc& shaderDesc = desc->shaderStages[i];
+        VkResult res = SetupShaderStage(device, shaderStages[i], stageEntryPoints[i], shaderDesc);
+        if (res != VK_SUCCESS)
+        {
+            for (uint32_t j = 0; j < i; ++j)
+            {
+                vkDestroyShaderModule(device, shaderStages[j].module, nullptr);
+            }
+            return false;
+        }
+    }
+
+    // RenderingInfo
+    VkFormat colorAttachmentFormats[VGPU_MAX_COLOR_ATTACHMENTS];
+    VkPipelineRenderingCreateInfo renderingInfo = {};
+    renderingInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+
+    for (uint32_t i = 0; i < desc->colorFormatCount; ++i)
+    {
+        VGPU_ASSERT(desc->colorFormats[i] != VGPUTextureFormat_Undefined);
+
+        colorAttachmentFormats[renderingInfo.colorAttachmentCount] = ToVkFormat(desc->colorFormats[i]);
+        renderingInfo.colorAttachmentCount++;
+    }
+    renderingInfo.pColorAttachmentFormats = colorAttachmentFormats;
+
+    // VertexInputState
+    std::vector<VkVertexInputBindingDescription> vertexInputBindings;
+    std::vector<VkVertexInputAttributeDescription> vertexInputAttributes;
+
+    vertexInputBindings.resize(desc->vertex.layoutCount);
+    for (uint32_t binding = 0; binding < desc->vertex.layoutCount; ++binding)
+    {
+        const VGPUVertexBufferLayout& bufferLayout = desc->vertex.layouts[binding];
+
+        vertexInputBindings[binding].binding = binding;
+        vertexInputBindings[binding].stride = bufferLayout.stride;
+        vertexInputBindings[binding].inputRate = ToVkVertexInputRate(bufferLayout.stepMode);
+
+        for (uint32_t attributeIndex = 0; attributeIndex < bufferLayout.attributeCount; ++attributeIndex)
+        {
+            const VGPUVertexAttribute& attribute = bufferLayout.attributes[attributeIndex];
+
+            VkVertexInputAttributeDescription vertexInputAttribute;
             vertexInputAttribute.location = attribute.shaderLocation;
             vertexInputAttribute.binding = binding;
             vertexInputAttribute.format = ToVkFormat(attribute.format);
@@ -5199,49 +7014,72 @@ VGPUPipeline VulkanDevice::CreateRenderPipeline(const VGPURenderPipelineDesc* de
     createInfo.layout = layout->handle;
     createInfo.renderPass = VK_NULL_HANDLE;
 
-    VkPipeline handle = VK_NULL_HANDLE;
-    const VkResult result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &createInfo, nullptr, &handle);
+    const VkResult result = vkCreateGraphicsPipelines(device, pipelineCache, 1, &createInfo, nullptr, &pipeline->handle);
+
+    for (size_t i = 0; i < shaderStages.size(); i++)
+    {
+        vkDestroyShaderModule(device, shaderStages[i].module, nullptr);
+    }
 
     if (result != VK_SUCCESS)
     {
-        return nullptr;
+        VK_LOG_ERROR(result, "Failed to create render pipeline");
+        return false;
     }
 
-    for (size_t i = 0; i < shaderStages.size(); i++)
+    if (desc->label)
     {
-        vkDestroyShaderModule(device, shaderStages[i].module, nullptr);
+        pipeline->SetLabel(desc->label);
     }
 
+    return true;
+}
+
+VGPUPipeline VulkanDevice::CreateComputePipeline(const VGPUComputePipelineDesc* desc)
+{
     VulkanPipeline* pipeline = new VulkanPipeline();
     pipeline->renderer = this;
-    pipeline->type = VGPUPipelineType_Render;
-    pipeline->pipelineLayout = layout;
+    pipeline->type = VGPUPipelineType_Compute;
+    pipeline->bindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
+    pipeline->pipelineLayout = (VulkanPipelineLayout*)desc->layout;
     pipeline->pipelineLayout->AddRef();
-    pipeline->handle = handle;
 
-    if (desc->label)
+    if (!InitComputePipeline(pipeline, desc))
     {
-        pipeline->SetLabel(desc->label);
+        delete pipeline;
+        return nullptr;
     }
 
     return pipeline;
 }
 
-VGPUPipeline VulkanDevice::CreateComputePipeline(const VGPUComputePipelineDesc* desc)
+VGPUPipeline VulkanDevice::CreateComputePipelineAsync(const VGPUComputePipelineDesc* desc, VGPUPipelineCallback callback, void* userData)
 {
+    std::shared_ptr<VulkanComputePipelineDescCopy> descCopy = std::make_shared<VulkanComputePipelineDescCopy>(desc);
+
     VulkanPipeline* pipeline = new VulkanPipeline();
     pipeline->renderer = this;
     pipeline->type = VGPUPipelineType_Compute;
+    pipeline->bindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
     pipeline->pipelineLayout = (VulkanPipelineLayout*)desc->layout;
     pipeline->pipelineLayout->AddRef();
 
+    CompilePipelineAsync(pipeline, [this, pipeline, descCopy]() {
+        return InitComputePipeline(pipeline, &descCopy->desc);
+    }, callback, userData);
+
+    return pipeline;
+}
+
+bool VulkanDevice::InitComputePipeline(VulkanPipeline* pipeline, const VGPUComputePipelineDesc* desc)
+{
     VkPipelineShaderStageCreateInfo stage;
     std::string entryPoint;
 
     VkResult result = SetupShaderStage(device, stage, entryPoint, desc->shader);
     if (result != VK_SUCCESS)
     {
-        return nullptr;
+        return false;
     }
 
     VkComputePipelineCreateInfo createInfo = {};
@@ -5249,15 +7087,15 @@ VGPUPipeline VulkanDevice::CreateComputePipeline(const VGPUComputePipelineDesc*
     createInfo.stage = stage;
     createInfo.layout = pipeline->pipelineLayout->handle;
 
-    result = vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &createInfo, nullptr, &pipeline->handle);
+    result = vkCreateComputePipelines(device, pipelineCache, 1, &createInfo, nullptr, &pipeline->handle);
 
     // Delete shader module.
     vkDestroyShaderModule(device, stage.module, nullptr);
 
     if (result != VK_SUCCESS)
     {
-        delete pipeline;
-        return nullptr;
+        VK_LOG_ERROR(result, "Failed to create compute pipeline");
+        return false;
     }
 
     if (desc->label)
@@ -5265,7 +7103,41 @@ VGPUPipeline VulkanDevice::CreateComputePipeline(const VGPUComputePipelineDesc*
         pipeline->SetLabel(desc->label);
     }
 
-    return pipeline;
+    return true;
+}
+
+void VulkanDevice::CompilePipelineAsync(VulkanPipeline* pipeline, std::function<bool()> compile, VGPUPipelineCallback callback, void* userData)
+{
+    {
+        std::lock_guard<std::mutex> lock(pipelineWorkersMutex);
+        if (!pipelineWorkers)
+        {
+            pipelineWorkers = std::make_unique<VGPUWorkerPool>();
+        }
+    }
+
+    std::shared_ptr<std::promise<void>> finished = std::make_shared<std::promise<void>>();
+    pipeline->status = VGPUPipelineStatus_Pending;
+    pipeline->compileFinished = finished->get_future().share();
+
+    // The job holds its own reference so the caller may release the pipeline before compilation ends.
+    pipeline->AddRef();
+    pipelineWorkers->Execute([this, pipeline, compile, callback, userData, finished]() {
+        VGPUPipelineStatus status;
+        {
+            VGPUTraceScope traceScope(this, "CompilePipeline");
+            status = compile() ? VGPUPipelineStatus_Ready : VGPUPipelineStatus_Failed;
+        }
+        pipeline->status = status;
+        finished->set_value();
+
+        if (callback)
+        {
+            callback(pipeline, status, userData);
+        }
+
+        pipeline->Release();
+    });
 }
 
 VGPUPipeline VulkanDevice::CreateRayTracingPipeline(const VGPURayTracingPipelineDesc* desc)
@@ -5534,6 +7406,7 @@ bool VulkanSwapChain::Update()
     {
         VulkanTexture* texture = new VulkanTexture();
         texture->renderer = renderer;
+        renderer->frameCounters.resourcesCreated.fetch_add(1, std::memory_order_relaxed);
         texture->dimension = VGPUTextureDimension_2D;
         texture->format = colorFormat;
         texture->handle = swapchainImages[i];
@@ -5605,6 +7478,16 @@ VulkanCommandBuffer::~VulkanCommandBuffer()
 {
     Reset();
 
+    for (VulkanBuffer* buffer : retiredAllocatorBuffers)
+    {
+        buffer->Release();
+    }
+
+    if (allocatorBuffer)
+    {
+        allocatorBuffer->Release();
+    }
+
     for (uint32_t j = 0; j < VGPU_MAX_INFLIGHT_FRAMES; ++j)
     {
         //vkFreeCommandBuffers(device, commandPools[j], 1, &commandBuffers[j]);
@@ -5618,6 +7501,7 @@ void VulkanCommandBuffer::Reset()
 {
     hasLabel = false;
     hasRenderPassLabel = false;
+    hasRenderPassScope = false;
     clearValueCount = 0u;
     insideRenderPass = false;
 
@@ -5636,17 +7520,69 @@ void VulkanCommandBuffer::Reset()
         descriptorSets[i] = VK_NULL_HANDLE;
     }
 
+    for (BoundDescriptorSets& bound : boundDescriptorSets)
+    {
+        if (bound.layout)
+        {
+            bound.layout->Release();
+        }
+        bound = {};
+    }
+
+    for (BoundVertexBuffer& vertexBuffer : boundVertexBuffers)
+    {
+        vertexBuffer = {};
+    }
+    boundIndexBuffer = VK_NULL_HANDLE;
+    hasBoundViewport = false;
+    hasBoundScissorRect = false;
+    hasBoundStencilReference = false;
+
     if (currentPipeline)
     {
         currentPipeline->Release();
         currentPipeline = nullptr;
     }
+
+    for (auto& it : trackedTextures)
+    {
+        it.first->Release();
+    }
+    for (auto& it : trackedBuffers)
+    {
+        it.first->Release();
+    }
+    trackedTextures.clear();
+    trackedBuffers.clear();
+    restingTextures.clear();
+    pendingImageBarriers.clear();
+    pendingBufferBarriers.clear();
+    pendingWriteStages = VK_PIPELINE_STAGE_2_NONE;
+    pendingWriteAccess = VK_ACCESS_2_NONE;
+    barrierBatch = 1;
+    renderPassTextures.clear();
+
+    statistics = {};
+    profiling = false;
+    profileScopes.clear();
+    profileStack.clear();
 }
 
 void VulkanCommandBuffer::Begin(uint32_t frameIndex, const char* label)
 {
     Reset();
 
+    // Handles from the previous recording are no longer in use, the GPU copies go through deferred deletion.
+    for (VulkanBuffer* buffer : retiredAllocatorBuffers)
+    {
+        buffer->Release();
+    }
+    retiredAllocatorBuffers.clear();
+
+    this->frameIndex = frameIndex;
+    allocatorOffset = 0;
+    allocatorRetiredBytes = 0;
+
     VK_CHECK(vkResetCommandPool(renderer->device, commandPools[frameIndex], 0));
 
     VkCommandBufferBeginInfo beginInfo = {};
@@ -5656,6 +7592,7 @@ void VulkanCommandBuffer::Begin(uint32_t frameIndex, const char* label)
     VK_CHECK(vkBeginCommandBuffer(commandBuffers[frameIndex], &beginInfo));
 
     commandBuffer = commandBuffers[frameIndex];
+    profiling = renderer->profilerActive && renderer->queues[queueType].timestampValidBits > 0;
 
     if (queueType == VGPUCommandQueue_Graphics)
     {
@@ -5668,10 +7605,14 @@ void VulkanCommandBuffer::Begin(uint32_t frameIndex, const char* label)
             scissors[i].extent.height = 65535;
         }
         vkCmdSetScissor(commandBuffer, 0, _VGPU_COUNT_OF(scissors), scissors);
+        boundScissorRect = scissors[0];
+        hasBoundScissorRect = true;
 
         const float blendConstants[] = { 1.0f, 1.0f, 1.0f, 1.0f };
         vkCmdSetBlendConstants(commandBuffer, blendConstants);
         vkCmdSetStencilReference(commandBuffer, VK_STENCIL_FRONT_AND_BACK, ~0u);
+        boundStencilReference = ~0u;
+        hasBoundStencilReference = true;
 
         if (renderer->features2.features.depthBounds == VK_TRUE)
         {
@@ -5686,8 +7627,45 @@ void VulkanCommandBuffer::Begin(uint32_t frameIndex, const char* label)
     }
 }
 
+void VulkanCommandBuffer::BeginProfileScope(const char* label)
+{
+    if (!profiling)
+        return;
+
+    VulkanProfileScope& scope = profileScopes.emplace_back();
+    scope.label = label;
+    scope.parent = profileStack.empty() ? VGPU_INVALID_PROFILE_SCOPE : profileStack.back();
+    scope.depth = (uint32_t)profileStack.size();
+    scope.queue = queueType;
+    profileStack.push_back((uint32_t)profileScopes.size() - 1);
+
+    VulkanProfilerFrame& frame = renderer->profilerFrames[frameIndex];
+    const uint32_t query = frame.queryCount.fetch_add(2, std::memory_order_relaxed);
+    if (query + 2 <= kProfilerQueryCount)
+    {
+        scope.query = query;
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, frame.queryPool, query);
+    }
+}
+
+void VulkanCommandBuffer::EndProfileScope()
+{
+    if (profileStack.empty())
+        return;
+
+    const VulkanProfileScope& scope = profileScopes[profileStack.back()];
+    profileStack.pop_back();
+
+    if (scope.query != kProfilerQueryCount)
+    {
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, renderer->profilerFrames[frameIndex].queryPool, scope.query + 1);
+    }
+}
+
 void VulkanCommandBuffer::PushDebugGroup(const char* groupLabel)
 {
+    BeginProfileScope(groupLabel);
+
     if (!renderer->debugUtils)
         return;
 
@@ -5704,10 +7682,12 @@ void VulkanCommandBuffer::PushDebugGroup(const char* groupLabel)
 
 void VulkanCommandBuffer::PopDebugGroup()
 {
-    if (!renderer->debugUtils)
-        return;
+    if (renderer->debugUtils)
+    {
+        vkCmdEndDebugUtilsLabelEXT(commandBuffer);
+    }
 
-    vkCmdEndDebugUtilsLabelEXT(commandBuffer);
+    EndProfileScope();
 }
 
 void VulkanCommandBuffer::InsertDebugMarker(const char* markerLabel)
@@ -5726,25 +7706,831 @@ void VulkanCommandBuffer::InsertDebugMarker(const char* markerLabel)
     vkCmdInsertDebugUtilsLabelEXT(commandBuffer, &label);
 }
 
+VGPUBufferAllocation VulkanCommandBuffer::Allocate(uint64_t size, uint64_t alignment)
+{
+    VGPUBufferAllocation allocation = {};
+    if (size == 0)
+        return allocation;
+
+    if (alignment == 0)
+    {
+        alignment = renderer->properties2.properties.limits.minUniformBufferOffsetAlignment;
+    }
+
+    uint64_t offset = AlignUp(allocatorOffset, alignment);
+    if (allocatorBuffer == nullptr || offset + size > allocatorSliceSize)
+    {
+        // Grow, handed out buffers stay alive until this command buffer records again.
+        constexpr uint64_t kMinSliceSize = 1024 * 1024;
+        uint64_t sliceSize = _VGPU_MAX(kMinSliceSize, allocatorSliceSize * 2);
+        sliceSize = _VGPU_MAX(sliceSize, vgpuNextPowerOfTwo(size));
+
+        if (allocatorBuffer)
+        {
+            FlushAllocator();
+            allocatorRetiredBytes += allocatorOffset;
+            retiredAllocatorBuffers.push_back(allocatorBuffer);
+        }
+
+        VGPUBufferDesc bufferDesc{};
+        bufferDesc.label = "CommandBuffer::Allocator";
+        bufferDesc.size = sliceSize * VGPU_MAX_INFLIGHT_FRAMES;
+        bufferDesc.usage = VGPUBufferUsage_Vertex | VGPUBufferUsage_Index | VGPUBufferUsage_Constant | VGPUBufferUsage_ShaderRead | VGPUBufferUsage_Indirect;
+        bufferDesc.cpuAccess = VGPUCpuAccessMode_Write;
+        allocatorBuffer = (VulkanBuffer*)renderer->CreateBuffer(&bufferDesc, nullptr);
+        if (allocatorBuffer == nullptr)
+        {
+            allocatorSliceSize = 0;
+            return allocation;
+        }
+
+        allocatorSliceSize = sliceSize;
+        offset = 0;
+    }
+
+    allocatorOffset = offset + size;
+    statistics.allocatedBytes += size;
+
+    const uint64_t frameBytes = allocatorRetiredBytes + allocatorOffset;
+    uint64_t highWaterMark = renderer->allocatorHighWaterMark.load(std::memory_order_relaxed);
+    while (frameBytes > highWaterMark
+        && !renderer->allocatorHighWaterMark.compare_exchange_weak(highWaterMark, frameBytes, std::memory_order_relaxed))
+    {
+    }
+
+    // Slices are power of two sized, so the slice base keeps the requested alignment.
+    const uint64_t bufferOffset = frameIndex * allocatorSliceSize + offset;
+    allocation.buffer = allocatorBuffer;
+    allocation.offset = bufferOffset;
+    allocation.data = (uint8_t*)allocatorBuffer->pMappedData + bufferOffset;
+    return allocation;
+}
+
+// Makes the bytes written into the current slice visible to the device, a no-op on host coherent memory.
+void VulkanCommandBuffer::FlushAllocator()
+{
+    if (allocatorBuffer == nullptr || allocatorOffset == 0)
+        return;
+
+    allocatorBuffer->FlushRange(frameIndex * allocatorSliceSize, allocatorOffset);
+}
+
+/* Resource state tracking */
+static bool NeedsBarrier(const VulkanResourceState& before, const VulkanResourceState& after)
+{
+    // Reads after reads in the same layout only widen the recorded stages, nothing waits on a state without accesses.
+    return before.layout != after.layout
+        || (before.access & kWriteAccessMask) != 0
+        || (before.access != VK_ACCESS_2_NONE && (after.access & kWriteAccessMask) != 0);
+}
+
+static VkImageMemoryBarrier2 MakeImageBarrier(const VulkanTexture* texture, uint32_t mipLevel, uint32_t arrayLayer,
+    const VulkanResourceState& before, const VulkanResourceState& after, bool discard)
+{
+    VkImageMemoryBarrier2 barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+    // Without prior stages the barrier chains with the semaphore waits of the submit instead.
+    barrier.srcStageMask = before.stages != VK_PIPELINE_STAGE_2_NONE ? before.stages : after.stages;
+    barrier.srcAccessMask = before.access & kWriteAccessMask;
+    barrier.dstStageMask = after.stages;
+    barrier.dstAccessMask = after.access;
+    barrier.oldLayout = discard ? VK_IMAGE_LAYOUT_UNDEFINED : before.layout;
+    barrier.newLayout = after.layout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = texture->handle;
+    barrier.subresourceRange.aspectMask = GetImageAspectFlags(texture->vkFormat);
+    barrier.subresourceRange.baseMipLevel = mipLevel;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.baseArrayLayer = arrayLayer;
+    barrier.subresourceRange.layerCount = 1;
+    return barrier;
+}
+
+static VkBufferMemoryBarrier2 MakeBufferBarrier(const VulkanBuffer* buffer, const VulkanResourceState& before, const VulkanResourceState& after)
+{
+    VkBufferMemoryBarrier2 barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+    barrier.srcStageMask = before.stages != VK_PIPELINE_STAGE_2_NONE ? before.stages : after.stages;
+    barrier.srcAccessMask = before.access & kWriteAccessMask;
+    barrier.dstStageMask = after.stages;
+    barrier.dstAccessMask = after.access;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer = buffer->handle;
+    barrier.offset = 0;
+    barrier.size = VK_WHOLE_SIZE;
+    return barrier;
+}
+
+// Merges neighbouring layers of one mip, or neighbouring mips over the same layers, into one barrier.
+static bool TryMergeImageBarrier(VkImageMemoryBarrier2& into, const VkImageMemoryBarrier2& barrier)
+{
+    if (into.image != barrier.image
+        || into.oldLayout != barrier.oldLayout
+        || into.newLayout != barrier.newLayout
+        || into.srcStageMask != barrier.srcStageMask
+        || into.srcAccessMask != barrier.srcAccessMask
+        || into.dstStageMask != barrier.dstStageMask
+        || into.dstAccessMask != barrier.dstAccessMask)
+    {
+        return false;
+    }
+
+    VkImageSubresourceRange& range = into.subresourceRange;
+    const VkImageSubresourceRange& other = barrier.subresourceRange;
+    if (range.baseMipLevel == other.baseMipLevel && range.levelCount == other.levelCount
+        && range.baseArrayLayer + range.layerCount == other.baseArrayLayer)
+    {
+        range.layerCount += other.layerCount;
+        return true;
+    }
+
+    if (range.baseArrayLayer == other.baseArrayLayer && range.layerCount == other.layerCount
+        && range.baseMipLevel + range.levelCount == other.baseMipLevel)
+    {
+        range.levelCount += other.levelCount;
+        return true;
+    }
+
+    return false;
+}
+
+static void AppendImageBarrier(std::vector<VkImageMemoryBarrier2>& barriers, const VkImageMemoryBarrier2& barrier)
+{
+    if (!barriers.empty() && TryMergeImageBarrier(barriers.back(), barrier))
+        return;
+
+    barriers.push_back(barrier);
+}
+
+void VulkanCommandBuffer::RequireTextureState(VulkanTexture* texture, uint32_t baseMipLevel, uint32_t levelCount, uint32_t baseArrayLayer, uint32_t layerCount,
+    const VulkanResourceState& state, bool discard)
+{
+    std::vector<TrackedState>& tracked = trackedTextures[texture];
+    if (tracked.empty())
+    {
+        texture->AddRef();
+        tracked.resize(texture->mipLevelCount * texture->arrayLayerCount);
+    }
+
+    for (uint32_t mipLevel = baseMipLevel; mipLevel < baseMipLevel + levelCount; ++mipLevel)
+    {
+        const size_t rowStart = pendingImageBarriers.size();
+        for (uint32_t arrayLayer = baseArrayLayer; arrayLayer < baseArrayLayer + layerCount; ++arrayLayer)
+        {
+            TrackedState& subresource = tracked[texture->GetSubresourceIndex(mipLevel, arrayLayer)];
+            if (!subresource.used)
+            {
+                // The first use is resolved against the global state at submit.
+                subresource.barrierBatch = barrierBatch;
+                subresource.used = true;
+                subresource.discard = discard;
+                subresource.first = state;
+                subresource.current = state;
+                continue;
+            }
+
+            if (!NeedsBarrier(subresource.current, state))
+            {
+                subresource.barrierBatch = barrierBatch;
+                subresource.current.stages |= state.stages;
+                subresource.current.access |= state.access;
+                if (!subresource.transitioned)
+                {
+                    subresource.first = subresource.current;
+                }
+                continue;
+            }
+
+            // Barriers of one batch are unordered, a second transition of the subresource needs its own batch.
+            if (subresource.barrierBatch == barrierBatch)
+            {
+                FlushBarriers(false);
+            }
+
+            AppendImageBarrier(pendingImageBarriers, MakeImageBarrier(texture, mipLevel, arrayLayer, subresource.current, state, discard));
+            subresource.current = state;
+            subresource.transitioned = true;
+            subresource.barrierBatch = barrierBatch;
+        }
+
+        // A row that collapsed into one barrier may extend the previous mip's barrier.
+        if (rowStart > 0
+            && pendingImageBarriers.size() == rowStart + 1
+            && TryMergeImageBarrier(pendingImageBarriers[rowStart - 1], pendingImageBarriers[rowStart]))
+        {
+            pendingImageBarriers.pop_back();
+        }
+    }
+}
+
+void VulkanCommandBuffer::RequireBufferState(VulkanBuffer* buffer, VkPipelineStageFlags2 stages, VkAccessFlags2 access)
+{
+    VulkanResourceState state;
+    state.stages = stages;
+    state.access = access;
+
+    auto it = trackedBuffers.find(buffer);
+    if (it == trackedBuffers.end())
+    {
+        buffer->AddRef();
+
+        TrackedState& tracked = trackedBuffers[buffer];
+        tracked.used = true;
+        tracked.first = state;
+        tracked.current = state;
+    }
+    else if (NeedsBarrier(it->second.current, state))
+    {
+        pendingBufferBarriers.push_back(MakeBufferBarrier(buffer, it->second.current, state));
+        it->second.current = state;
+        it->second.transitioned = true;
+    }
+    else
+    {
+        it->second.current.stages |= stages;
+        it->second.current.access |= access;
+        if (!it->second.transitioned)
+        {
+            it->second.first = it->second.current;
+        }
+    }
+
+    // Vertex, index, indirect and shader reads are not tracked, they wait on every earlier write.
+    if (access & kWriteAccessMask)
+    {
+        pendingWriteStages |= stages;
+        pendingWriteAccess |= access & kWriteAccessMask;
+    }
+}
+
+VkPipelineStageFlags2 VulkanCommandBuffer::GetShaderStages() const
+{
+    switch (queueType)
+    {
+        case VGPUCommandQueue_Graphics:
+        {
+            VkPipelineStageFlags2 stages = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+            if (renderer->meshShaderFeatures.meshShader == VK_TRUE)
+            {
+                stages |= VK_PIPELINE_STAGE_2_TASK_SHADER_BIT_EXT | VK_PIPELINE_STAGE_2_MESH_SHADER_BIT_EXT;
+            }
+            return stages;
+        }
+        case VGPUCommandQueue_Compute:
+            return VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        default:
+            return VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+    }
+}
+
+void VulkanCommandBuffer::AddRestingTexture(VulkanTexture* texture)
+{
+    // Shader-readable textures go back to their resting layout before the next pass, dispatch or submit.
+    if (texture->GetRestingLayout() != VK_IMAGE_LAYOUT_UNDEFINED
+        && std::find(restingTextures.begin(), restingTextures.end(), texture) == restingTextures.end())
+    {
+        restingTextures.push_back(texture);
+    }
+}
+
+void VulkanCommandBuffer::ApplyRestingLayouts()
+{
+    for (VulkanTexture* texture : restingTextures)
+    {
+        VulkanResourceState restingState;
+        restingState.layout = texture->GetRestingLayout();
+        restingState.stages = GetShaderStages();
+        restingState.access = queueType == VGPUCommandQueue_Copy ? VK_ACCESS_2_NONE : VK_ACCESS_2_SHADER_READ_BIT;
+
+        const std::vector<TrackedState>& tracked = trackedTextures[texture];
+        for (uint32_t mipLevel = 0; mipLevel < texture->mipLevelCount; ++mipLevel)
+        {
+            for (uint32_t arrayLayer = 0; arrayLayer < texture->arrayLayerCount; ++arrayLayer)
+            {
+                // Subresources required since the last flush are about to be used in their current layout.
+                const TrackedState& subresource = tracked[texture->GetSubresourceIndex(mipLevel, arrayLayer)];
+                if (subresource.used
+                    && subresource.barrierBatch != barrierBatch
+                    && subresource.current.layout != restingState.layout)
+                {
+                    RequireTextureState(texture, mipLevel, 1, arrayLayer, 1, restingState);
+                }
+            }
+        }
+    }
+
+    restingTextures.clear();
+}
+
+void VulkanCommandBuffer::FlushBarriers(bool flushPendingWrites)
+{
+    VkMemoryBarrier2 memoryBarrier = {};
+    const bool hasMemoryBarrier = flushPendingWrites && pendingWriteStages != VK_PIPELINE_STAGE_2_NONE;
+    if (hasMemoryBarrier)
+    {
+        VkPipelineStageFlags2 dstStages = GetShaderStages();
+        if (queueType == VGPUCommandQueue_Graphics)
+        {
+            dstStages |= VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT;
+        }
+        else if (queueType == VGPUCommandQueue_Compute)
+        {
+            dstStages |= VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT;
+        }
+
+        memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+        memoryBarrier.srcStageMask = pendingWriteStages;
+        memoryBarrier.srcAccessMask = pendingWriteAccess;
+        memoryBarrier.dstStageMask = dstStages;
+        memoryBarrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT;
+        pendingWriteStages = VK_PIPELINE_STAGE_2_NONE;
+        pendingWriteAccess = VK_ACCESS_2_NONE;
+    }
+
+    if (pendingImageBarriers.empty() && pendingBufferBarriers.empty() && !hasMemoryBarrier)
+        return;
+
+    EmitBarriers(commandBuffer, pendingImageBarriers, pendingBufferBarriers, hasMemoryBarrier ? &memoryBarrier : nullptr);
+    pendingImageBarriers.clear();
+    pendingBufferBarriers.clear();
+    barrierBatch++;
+}
+
+static VkPipelineStageFlags ToVkPipelineStageFlags(VkPipelineStageFlags2 stages, VkPipelineStageFlags noneStage)
+{
+    // Only legacy stage bits are ever recorded, NONE maps to TOP_OF_PIPE or BOTTOM_OF_PIPE.
+    const VkPipelineStageFlags result = (VkPipelineStageFlags)(stages & 0xFFFFFFFFull);
+    return result != 0 ? result : noneStage;
+}
+
+void VulkanCommandBuffer::EmitBarriers(VkCommandBuffer target,
+    const std::vector<VkImageMemoryBarrier2>& imageBarriers,
+    const std::vector<VkBufferMemoryBarrier2>& bufferBarriers,
+    const VkMemoryBarrier2* memoryBarrier)
+{
+    statistics.barrierCount += (uint32_t)(imageBarriers.size() + bufferBarriers.size()) + (memoryBarrier != nullptr ? 1u : 0u);
+
+    if (renderer->synchronization2)
+    {
+        VkDependencyInfo dependencyInfo = {};
+        dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependencyInfo.memoryBarrierCount = memoryBarrier != nullptr ? 1u : 0u;
+        dependencyInfo.pMemoryBarriers = memoryBarrier;
+        dependencyInfo.bufferMemoryBarrierCount = (uint32_t)bufferBarriers.size();
+        dependencyInfo.pBufferMemoryBarriers = bufferBarriers.data();
+        dependencyInfo.imageMemoryBarrierCount = (uint32_t)imageBarriers.size();
+        dependencyInfo.pImageMemoryBarriers = imageBarriers.data();
+        vkCmdPipelineBarrier2(target, &dependencyInfo);
+        return;
+    }
+
+    // Without synchronization2 everything goes out as one call with the union of the stage masks.
+    VkPipelineStageFlags2 srcStages = VK_PIPELINE_STAGE_2_NONE;
+    VkPipelineStageFlags2 dstStages = VK_PIPELINE_STAGE_2_NONE;
+
+    VkMemoryBarrier legacyMemoryBarrier = {};
+    legacyMemoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    if (memoryBarrier != nullptr)
+    {
+        legacyMemoryBarrier.srcAccessMask = (VkAccessFlags)memoryBarrier->srcAccessMask;
+        legacyMemoryBarrier.dstAccessMask = (VkAccessFlags)memoryBarrier->dstAccessMask;
+        srcStages |= memoryBarrier->srcStageMask;
+        dstStages |= memoryBarrier->dstStageMask;
+    }
+
+    std::vector<VkBufferMemoryBarrier> legacyBufferBarriers(bufferBarriers.size());
+    for (size_t i = 0; i < bufferBarriers.size(); ++i)
+    {
+        const VkBufferMemoryBarrier2& barrier = bufferBarriers[i];
+        VkBufferMemoryBarrier& legacy = legacyBufferBarriers[i];
+        legacy.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        legacy.srcAccessMask = (VkAccessFlags)barrier.srcAccessMask;
+        legacy.dstAccessMask = (VkAccessFlags)barrier.dstAccessMask;
+        legacy.srcQueueFamilyIndex = barrier.srcQueueFamilyIndex;
+        legacy.dstQueueFamilyIndex = barrier.dstQueueFamilyIndex;
+        legacy.buffer = barrier.buffer;
+        legacy.offset = barrier.offset;
+        legacy.size = barrier.size;
+        srcStages |= barrier.srcStageMask;
+        dstStages |= barrier.dstStageMask;
+    }
+
+    std::vector<VkImageMemoryBarrier> legacyImageBarriers(imageBarriers.size());
+    for (size_t i = 0; i < imageBarriers.size(); ++i)
+    {
+        const VkImageMemoryBarrier2& barrier = imageBarriers[i];
+        VkImageMemoryBarrier& legacy = legacyImageBarriers[i];
+        legacy.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        legacy.srcAccessMask = (VkAccessFlags)barrier.srcAccessMask;
+        legacy.dstAccessMask = (VkAccessFlags)barrier.dstAccessMask;
+        legacy.oldLayout = barrier.oldLayout;
+        legacy.newLayout = barrier.newLayout;
+        legacy.srcQueueFamilyIndex = barrier.srcQueueFamilyIndex;
+        legacy.dstQueueFamilyIndex = barrier.dstQueueFamilyIndex;
+        legacy.image = barrier.image;
+        legacy.subresourceRange = barrier.subresourceRange;
+        srcStages |= barrier.srcStageMask;
+        dstStages |= barrier.dstStageMask;
+    }
+
+    vkCmdPipelineBarrier(target,
+        ToVkPipelineStageFlags(srcStages, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT),
+        ToVkPipelineStageFlags(dstStages, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT),
+        0,
+        memoryBarrier != nullptr ? 1u : 0u, &legacyMemoryBarrier,
+        (uint32_t)legacyBufferBarriers.size(), legacyBufferBarriers.data(),
+        (uint32_t)legacyImageBarriers.size(), legacyImageBarriers.data());
+}
+
+VkCommandBuffer VulkanCommandBuffer::ResolveTrackedStates()
+{
+    // Transitions from the state left by earlier submits to the first use in this command buffer.
+    std::vector<VkImageMemoryBarrier2> imageBarriers;
+    std::vector<VkBufferMemoryBarrier2> bufferBarriers;
+
+    for (auto& it : trackedTextures)
+    {
+        VulkanTexture* texture = it.first;
+        const std::vector<TrackedState>& tracked = it.second;
+        if (texture->subresourceStates.empty())
+        {
+            texture->subresourceStates.resize(tracked.size());
+        }
+
+        for (uint32_t mipLevel = 0; mipLevel < texture->mipLevelCount; ++mipLevel)
+        {
+            for (uint32_t arrayLayer = 0; arrayLayer < texture->arrayLayerCount; ++arrayLayer)
+            {
+                const uint32_t index = texture->GetSubresourceIndex(mipLevel, arrayLayer);
+                const TrackedState& subresource = tracked[index];
+                if (!subresource.used)
+                    continue;
+
+                // Subresources discarded before their first use have nothing to transition from.
+                VulkanResourceState& global = texture->subresourceStates[index];
+                if (subresource.first.layout != VK_IMAGE_LAYOUT_UNDEFINED && NeedsBarrier(global, subresource.first))
+                {
+                    VulkanResourceState before = global;
+                    FilterStageAccess(before.stages, before.access, queueType);
+                    AppendImageBarrier(imageBarriers, MakeImageBarrier(texture, mipLevel, arrayLayer, before, subresource.first, subresource.discard));
+                }
+                global = subresource.current;
+            }
+        }
+    }
+
+    for (auto& it : trackedBuffers)
+    {
+        VulkanBuffer* buffer = it.first;
+        const TrackedState& tracked = it.second;
+        if (tracked.first.stages != VK_PIPELINE_STAGE_2_NONE && NeedsBarrier(buffer->state, tracked.first))
+        {
+            VulkanResourceState before = buffer->state;
+            FilterStageAccess(before.stages, before.access, queueType);
+            bufferBarriers.push_back(MakeBufferBarrier(buffer, before, tracked.first));
+        }
+        buffer->state = tracked.current;
+    }
+
+    if (imageBarriers.empty() && bufferBarriers.empty())
+        return VK_NULL_HANDLE;
+
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    VkCommandBuffer prologue = prologueCommandBuffers[frameIndex];
+    VK_CHECK(vkBeginCommandBuffer(prologue, &beginInfo));
+    EmitBarriers(prologue, imageBarriers, bufferBarriers, nullptr);
+    VK_CHECK(vkEndCommandBuffer(prologue));
+    return prologue;
+}
+
+void VulkanCommandBuffer::RequireTextureAccess(VGPUTexture texture, VGPURenderGraphAccess access)
+{
+    VulkanTexture* backendTexture = (VulkanTexture*)texture;
+
+    VulkanResourceState state;
+    switch (access)
+    {
+        case VGPURenderGraphAccess_ShaderRead:
+            state.layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            state.stages = GetShaderStages();
+            state.access = VK_ACCESS_2_SHADER_READ_BIT;
+            break;
+
+        case VGPURenderGraphAccess_ShaderWrite:
+            state.layout = VK_IMAGE_LAYOUT_GENERAL;
+            state.stages = GetShaderStages();
+            state.access = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT;
+            break;
+
+        case VGPURenderGraphAccess_CopySource:
+            state.layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            state.stages = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+            state.access = VK_ACCESS_2_TRANSFER_READ_BIT;
+            break;
+
+        case VGPURenderGraphAccess_CopyDestination:
+            state.layout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            state.stages = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+            state.access = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+            break;
+
+        default:
+            // Render passes require attachment states from their load actions.
+            return;
+    }
+
+    RequireTextureState(backendTexture, 0, backendTexture->mipLevelCount, 0, backendTexture->arrayLayerCount, state);
+}
+
+void VulkanCommandBuffer::RequireBufferAccess(VGPUBuffer buffer, VGPURenderGraphAccess access)
+{
+    VkPipelineStageFlags2 stages = VK_PIPELINE_STAGE_2_NONE;
+    VkAccessFlags2 accessMask = VK_ACCESS_2_NONE;
+    switch (access)
+    {
+        case VGPURenderGraphAccess_ShaderRead:
+            stages = GetShaderStages();
+            accessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_UNIFORM_READ_BIT;
+            if (queueType == VGPUCommandQueue_Graphics)
+            {
+                stages |= VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT;
+                accessMask |= VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_2_INDEX_READ_BIT | VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT;
+            }
+            else if (queueType == VGPUCommandQueue_Compute)
+            {
+                stages |= VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT;
+                accessMask |= VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT;
+            }
+            break;
+
+        case VGPURenderGraphAccess_ShaderWrite:
+            stages = GetShaderStages();
+            accessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT;
+            break;
+
+        case VGPURenderGraphAccess_CopySource:
+            stages = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+            accessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
+            break;
+
+        case VGPURenderGraphAccess_CopyDestination:
+            stages = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+            accessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+            break;
+
+        default:
+            return;
+    }
+
+    RequireBufferState((VulkanBuffer*)buffer, stages, accessMask);
+}
+
+void VulkanCommandBuffer::DiscardTexture(VGPUTexture texture)
+{
+    VulkanTexture* backendTexture = (VulkanTexture*)texture;
+
+    std::vector<TrackedState>& tracked = trackedTextures[backendTexture];
+    if (tracked.empty())
+    {
+        backendTexture->AddRef();
+        tracked.resize(backendTexture->mipLevelCount * backendTexture->arrayLayerCount);
+    }
+
+    // The next access transitions from UNDEFINED and waits on every earlier command, which covers aliased memory.
+    VulkanResourceState discarded;
+    discarded.stages = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+    discarded.access = VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+    for (TrackedState& subresource : tracked)
+    {
+        if (!subresource.used)
+        {
+            subresource.used = true;
+            subresource.first = {};
+        }
+        subresource.current = discarded;
+        subresource.transitioned = true;
+    }
+
+    restingTextures.erase(std::remove(restingTextures.begin(), restingTextures.end(), backendTexture), restingTextures.end());
+}
+
+void VulkanCommandBuffer::DiscardBuffer(VGPUBuffer buffer)
+{
+    VulkanBuffer* backendBuffer = (VulkanBuffer*)buffer;
+
+    auto it = trackedBuffers.find(backendBuffer);
+    if (it == trackedBuffers.end())
+    {
+        backendBuffer->AddRef();
+        it = trackedBuffers.emplace(backendBuffer, TrackedState()).first;
+        it->second.used = true;
+    }
+
+    it->second.current.stages = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+    it->second.current.access = VK_ACCESS_2_MEMORY_WRITE_BIT;
+    it->second.transitioned = true;
+}
+
+void VulkanCommandBuffer::RequireHostRead(VGPUBuffer buffer)
+{
+    // Waiting on the timeline only makes the copy available, the host domain needs its own barrier.
+    RequireBufferState((VulkanBuffer*)buffer, VK_PIPELINE_STAGE_2_HOST_BIT, VK_ACCESS_2_HOST_READ_BIT);
+}
+
 void VulkanCommandBuffer::ClearBuffer(VGPUBuffer buffer, uint64_t offset, uint64_t size)
 {
     VulkanBuffer* backendBuffer = (VulkanBuffer*)buffer;
 
-    //InsertBufferMemoryBarrier(buffer, BufferUsage::CopyDst);
-    VkDeviceSize commandSize = (size == VGPU_WHOLE_SIZE) ? VK_WHOLE_SIZE : size;
-    vkCmdFillBuffer(commandBuffer, backendBuffer->handle, offset, commandSize, 0u);
+    RequireBufferState(backendBuffer, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+    FlushBarriers(false);
+
+    VkDeviceSize commandSize = (size == VGPU_WHOLE_SIZE) ? VK_WHOLE_SIZE : size;
+    vkCmdFillBuffer(commandBuffer, backendBuffer->handle, offset, commandSize, 0u);
+}
+
+static VkImageSubresourceLayers ToVkImageSubresourceLayers(const VulkanTexture* texture, const VGPUTextureCopyLocation* location)
+{
+    // Copies address a single aspect, depth for depth/stencil formats.
+    VkImageAspectFlags aspectMask = GetImageAspectFlags(texture->vkFormat);
+    if (aspectMask & VK_IMAGE_ASPECT_DEPTH_BIT)
+    {
+        aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+    }
+
+    VkImageSubresourceLayers subresource = {};
+    subresource.aspectMask = aspectMask;
+    subresource.mipLevel = location->mipLevel;
+    subresource.baseArrayLayer = location->arrayLayer;
+    subresource.layerCount = 1;
+    return subresource;
+}
+
+static VkBufferImageCopy ToVkBufferImageCopy(const VGPUBufferCopyLocation* buffer, const VGPUTextureCopyLocation* texture, const VGPUExtent3D* extent)
+{
+    const VulkanTexture* vulkanTexture = (const VulkanTexture*)texture->texture;
+
+    VGPUPixelFormatInfo formatInfo;
+    vgpuGetPixelFormatInfo(vulkanTexture->format, &formatInfo);
+
+    // Vulkan expresses buffer pitch in texels rather than bytes.
+    VkBufferImageCopy region = {};
+    region.bufferOffset = buffer->offset;
+    region.bufferRowLength = buffer->bytesPerRow / formatInfo.bytesPerBlock * formatInfo.blockWidth;
+    region.bufferImageHeight = buffer->rowsPerImage * formatInfo.blockHeight;
+    region.imageSubresource = ToVkImageSubresourceLayers(vulkanTexture, texture);
+    region.imageOffset = { (int32_t)texture->origin.x, (int32_t)texture->origin.y, (int32_t)texture->origin.z };
+    region.imageExtent = { extent->width, extent->height, extent->depth };
+    return region;
+}
+
+void VulkanCommandBuffer::RequireCopyState(VulkanTexture* texture, const VGPUTextureCopyLocation* location, VkImageLayout layout, VkAccessFlags2 access)
+{
+    VulkanResourceState state;
+    state.layout = layout;
+    state.stages = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    state.access = access;
+    RequireTextureState(texture, location->mipLevel, 1, location->arrayLayer, 1, state);
+    AddRestingTexture(texture);
+}
+
+void VulkanCommandBuffer::CopyBufferToBuffer(VGPUBuffer source, uint64_t sourceOffset, VGPUBuffer destination, uint64_t destinationOffset, uint64_t size)
+{
+    VulkanBuffer* sourceBuffer = (VulkanBuffer*)source;
+    VulkanBuffer* destinationBuffer = (VulkanBuffer*)destination;
+
+    RequireBufferState(sourceBuffer, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT);
+    RequireBufferState(destinationBuffer, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+    FlushBarriers(false);
+
+    VkBufferCopy region = {};
+    region.srcOffset = sourceOffset;
+    region.dstOffset = destinationOffset;
+    region.size = size;
+    vkCmdCopyBuffer(commandBuffer, sourceBuffer->handle, destinationBuffer->handle, 1, &region);
+}
+
+void VulkanCommandBuffer::CopyBufferToTexture(const VGPUBufferCopyLocation* source, const VGPUTextureCopyLocation* destination, const VGPUExtent3D* extent)
+{
+    VulkanBuffer* sourceBuffer = (VulkanBuffer*)source->buffer;
+    VulkanTexture* destinationTexture = (VulkanTexture*)destination->texture;
+
+    RequireBufferState(sourceBuffer, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT);
+    RequireCopyState(destinationTexture, destination, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+    FlushBarriers(false);
+
+    const VkBufferImageCopy region = ToVkBufferImageCopy(source, destination, extent);
+    vkCmdCopyBufferToImage(commandBuffer, sourceBuffer->handle, destinationTexture->handle, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+}
+
+void VulkanCommandBuffer::CopyTextureToBuffer(const VGPUTextureCopyLocation* source, const VGPUBufferCopyLocation* destination, const VGPUExtent3D* extent)
+{
+    VulkanTexture* sourceTexture = (VulkanTexture*)source->texture;
+    VulkanBuffer* destinationBuffer = (VulkanBuffer*)destination->buffer;
+
+    RequireCopyState(sourceTexture, source, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_ACCESS_2_TRANSFER_READ_BIT);
+    RequireBufferState(destinationBuffer, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+    FlushBarriers(false);
+
+    const VkBufferImageCopy region = ToVkBufferImageCopy(destination, source, extent);
+    vkCmdCopyImageToBuffer(commandBuffer, sourceTexture->handle, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, destinationBuffer->handle, 1, &region);
+}
+
+void VulkanCommandBuffer::CopyTextureToTexture(const VGPUTextureCopyLocation* source, const VGPUTextureCopyLocation* destination, const VGPUExtent3D* extent)
+{
+    VulkanTexture* sourceTexture = (VulkanTexture*)source->texture;
+    VulkanTexture* destinationTexture = (VulkanTexture*)destination->texture;
+
+    RequireCopyState(sourceTexture, source, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_ACCESS_2_TRANSFER_READ_BIT);
+    RequireCopyState(destinationTexture, destination, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+    FlushBarriers(false);
+
+    VkImageCopy region = {};
+    region.srcSubresource = ToVkImageSubresourceLayers(sourceTexture, source);
+    region.srcOffset = { (int32_t)source->origin.x, (int32_t)source->origin.y, (int32_t)source->origin.z };
+    region.dstSubresource = ToVkImageSubresourceLayers(destinationTexture, destination);
+    region.dstOffset = { (int32_t)destination->origin.x, (int32_t)destination->origin.y, (int32_t)destination->origin.z };
+    region.extent = { extent->width, extent->height, extent->depth };
+    vkCmdCopyImage(commandBuffer, sourceTexture->handle, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, destinationTexture->handle, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+}
+
+// Vulkan keeps set N bound across layouts that share the push constant ranges and the set layouts 0..N, pipeline and
+// bind group layouts are deduplicated so comparing pointers is enough.
+static uint32_t GetCompatibleSetCount(const VulkanPipelineLayout* a, const VulkanPipelineLayout* b)
+{
+    if (a == nullptr || b == nullptr)
+        return 0;
+
+    if (a == b)
+        return a->bindGroupLayoutCount;
+
+    if (!IsSamePushConstantRanges(a->pushConstantRanges, b->pushConstantRanges))
+        return 0;
+
+    const uint32_t count = _VGPU_MIN(a->bindGroupLayoutCount, b->bindGroupLayoutCount);
+    uint32_t compatibleCount = 0;
+    while (compatibleCount < count && a->bindGroupLayouts[compatibleCount] == b->bindGroupLayouts[compatibleCount])
+        compatibleCount++;
+
+    return compatibleCount;
 }
 
 void VulkanCommandBuffer::SetPipeline(VGPUPipeline pipeline)
 {
     VulkanPipeline* backendPipeline = (VulkanPipeline*)pipeline;
     if (currentPipeline == backendPipeline)
+    {
+        statistics.redundantStateCount++;
+        return;
+    }
+
+    // Asynchronously created pipelines must finish compiling before being bound.
+    if (backendPipeline->Wait() != VGPUPipelineStatus_Ready)
+    {
+        vgpuLogError("Vulkan: Cannot bind a pipeline that failed to compile");
         return;
+    }
 
+    backendPipeline->AddRef();
+    if (currentPipeline)
+    {
+        currentPipeline->Release();
+    }
     currentPipeline = backendPipeline;
-    currentPipeline->AddRef();
 
     vkCmdBindPipeline(commandBuffer, currentPipeline->bindPoint, currentPipeline->handle);
+    statistics.pipelineBindCount++;
+
+    // The new layout decides which bound sets stay valid, FlushBindGroups rebinds the others.
+    bindGroupsDirty = true;
+
+    VulkanPipelineLayout* layout = currentPipeline->pipelineLayout;
+    if (layout != nullptr && layout->bindless)
+    {
+        const VkDescriptorSet bindlessSets[] = {
+            renderer->bindlessSampledImages.set,
+            renderer->bindlessStorageBuffers.set,
+            renderer->bindlessSamplers.set
+        };
+
+        vkCmdBindDescriptorSets(
+            commandBuffer,
+            currentPipeline->bindPoint,
+            layout->handle,
+            layout->bindGroupLayoutCount,
+            (uint32_t)_VGPU_COUNT_OF(bindlessSets),
+            bindlessSets,
+            0, nullptr
+        );
+
+        BoundDescriptorSets& bound = GetBoundDescriptorSets();
+        SetBoundLayout(bound, layout, _VGPU_MIN(bound.count, GetCompatibleSetCount(bound.layout, layout)));
+    }
 }
 
 
@@ -5753,14 +8539,24 @@ void VulkanCommandBuffer::SetBindGroup(uint32_t groupIndex, VGPUBindGroup bindGr
     VGPU_VERIFY(bindGroup != nullptr);
     VGPU_VERIFY(groupIndex < VGPU_MAX_BIND_GROUPS);
 
-    if (boundBindGroups[groupIndex] != bindGroup)
+    VulkanBindGroup* vulkanBindGroup = static_cast<VulkanBindGroup*>(bindGroup);
+    if (boundBindGroups[groupIndex] == vulkanBindGroup)
+    {
+        statistics.redundantStateCount++;
+        return;
+    }
+
+    // Descriptor sets of released groups are destroyed through deferred deletion, after this frame completed.
+    vulkanBindGroup->AddRef();
+    if (boundBindGroups[groupIndex])
     {
-        bindGroupsDirty = true;
-        boundBindGroups[groupIndex] = static_cast<VulkanBindGroup*>(bindGroup);
-        boundBindGroups[groupIndex]->AddRef();
-        descriptorSets[groupIndex] = boundBindGroups[groupIndex]->descriptorSet;
-        numBoundBindGroups = _VGPU_MAX(groupIndex + 1, numBoundBindGroups);
+        boundBindGroups[groupIndex]->Release();
     }
+
+    bindGroupsDirty = true;
+    boundBindGroups[groupIndex] = vulkanBindGroup;
+    descriptorSets[groupIndex] = vulkanBindGroup->descriptorSet;
+    numBoundBindGroups = _VGPU_MAX(groupIndex + 1, numBoundBindGroups);
 }
 
 void VulkanCommandBuffer::SetPushConstants(uint32_t pushConstantIndex, const void* data, uint32_t size)
@@ -5783,20 +8579,61 @@ void VulkanCommandBuffer::FlushBindGroups()
     if (!bindGroupsDirty)
         return;
 
+    bindGroupsDirty = false;
+
+    VulkanPipelineLayout* layout = currentPipeline->pipelineLayout;
+    BoundDescriptorSets& bound = GetBoundDescriptorSets();
+    const uint32_t setCount = layout->bindGroupLayoutCount;
+    const uint32_t validCount = _VGPU_MIN(bound.count, GetCompatibleSetCount(bound.layout, layout));
+
+    // Only the range between the first and the last set that changed is rebound, valid sets around it stay.
+    uint32_t first = 0;
+    while (first < setCount && first < validCount && bound.sets[first] == descriptorSets[first])
+        first++;
+
+    uint32_t last = setCount;
+    while (last > first && last <= validCount && bound.sets[last - 1] == descriptorSets[last - 1])
+        last--;
+
+    statistics.redundantStateCount += setCount - (last - first);
+    if (first == last)
+        return;
+
+    statistics.bindGroupBindCount += last - first;
     vkCmdBindDescriptorSets(
         commandBuffer,
         currentPipeline->bindPoint,
-        currentPipeline->pipelineLayout->handle,
-        0u,
-        currentPipeline->pipelineLayout->bindGroupLayoutCount,
-        descriptorSets,
+        layout->handle,
+        first,
+        last - first,
+        descriptorSets + first,
         0, nullptr
     );
-    bindGroupsDirty = false;
+
+    memcpy(bound.sets + first, descriptorSets + first, (last - first) * sizeof(VkDescriptorSet));
+    SetBoundLayout(bound, layout, setCount);
+}
+
+void VulkanCommandBuffer::SetBoundLayout(BoundDescriptorSets& bound, VulkanPipelineLayout* layout, uint32_t setCount)
+{
+    if (bound.layout != layout)
+    {
+        layout->AddRef();
+        if (bound.layout)
+        {
+            bound.layout->Release();
+        }
+        bound.layout = layout;
+    }
+
+    bound.count = setCount;
 }
 
 void VulkanCommandBuffer::PrepareDispatch()
 {
+    statistics.dispatchCount++;
+    ApplyRestingLayouts();
+    FlushBarriers(true);
     FlushBindGroups();
 }
 
@@ -5860,23 +8697,11 @@ VGPUTexture VulkanCommandBuffer::AcquireSwapchainTexture(VGPUSwapChain swapChain
 
     VulkanTexture* swapchainTexture = vulkanSwapChain->backbufferTextures[vulkanSwapChain->imageIndex];
 
-    // Transition from undefined -> render target
-    VkImageSubresourceRange range{};
-    range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    range.baseMipLevel = 0;
-    range.levelCount = VK_REMAINING_MIP_LEVELS;
-    range.baseArrayLayer = 0;
-    range.layerCount = VK_REMAINING_ARRAY_LAYERS;
-    InsertImageMemoryBarrier(
-        swapchainTexture->handle,
-        0,
-        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
-        VK_IMAGE_LAYOUT_UNDEFINED,
-        VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-        range
-    );
+    // Contents of earlier frames are not preserved, the first pass decides whether to clear.
+    VulkanResourceState state;
+    state.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    state.stages = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+    RequireTextureState(swapchainTexture, 0, 1, 0, 1, state, true);
 
     presentSwapChains.push_back(vulkanSwapChain);
 
@@ -5893,6 +8718,11 @@ void VulkanCommandBuffer::BeginRenderPass(const VGPURenderPassDesc* desc)
         PushDebugGroup(desc->label);
         hasRenderPassLabel = true;
     }
+    else if (profiling)
+    {
+        BeginProfileScope("RenderPass");
+        hasRenderPassScope = true;
+    }
 
     if (renderer->dynamicRendering)
     {
@@ -5915,15 +8745,44 @@ void VulkanCommandBuffer::BeginRenderPass(const VGPURenderPassDesc* desc)
             width = _VGPU_MIN(width, _VGPU_MAX(1U, texture->width >> level));
             height = _VGPU_MIN(height, _VGPU_MAX(1U, texture->height >> level));
 
+            // Transient contents never survive the pass, there is nothing to load or store.
+            const bool transient = (texture->usage & VGPUTextureUsage_Transient) != 0;
+            const VGPULoadAction loadAction = (transient && attachment->loadAction == VGPULoadAction_Load) ? VGPULoadAction_DontCare : attachment->loadAction;
+            const VGPUStoreAction storeAction = transient ? VGPUStoreAction_DontCare : attachment->storeAction;
+
+            VulkanResourceState state;
+            state.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            state.stages = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+            state.access = VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
+            RequireTextureState(texture, level, 1, slice, 1, state, loadAction != VGPULoadAction_Load);
+            renderPassTextures.push_back(texture);
+
             VkRenderingAttachmentInfo& attachmentInfo = colorAttachments[renderingInfo.colorAttachmentCount++];
             attachmentInfo.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
-            attachmentInfo.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
             attachmentInfo.pNext = nullptr;
             attachmentInfo.imageView = texture->GetRTV(level, slice);
             attachmentInfo.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
             attachmentInfo.resolveMode = VK_RESOLVE_MODE_NONE;
-            attachmentInfo.loadOp = ToVkAttachmentLoadOp(attachment->loadAction);
-            attachmentInfo.storeOp = ToVkAttachmentStoreOp(attachment->storeAction);
+            attachmentInfo.loadOp = ToVkAttachmentLoadOp(loadAction);
+            attachmentInfo.storeOp = ToVkAttachmentStoreOp(storeAction);
+
+            if (attachment->resolveTexture != nullptr)
+            {
+                VulkanTexture* resolveTexture = (VulkanTexture*)attachment->resolveTexture;
+                const VGPUFormatKind formatKind = vgpuGetPixelFormatKind(texture->format);
+
+                // The resolve overwrites the whole subresource.
+                VulkanResourceState resolveState;
+                resolveState.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+                resolveState.stages = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+                resolveState.access = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
+                RequireTextureState(resolveTexture, attachment->resolveLevel, 1, attachment->resolveSlice, 1, resolveState, true);
+                renderPassTextures.push_back(resolveTexture);
+
+                attachmentInfo.resolveMode = (formatKind == VGPUFormatKind_Uint || formatKind == VGPUFormatKind_Sint) ? VK_RESOLVE_MODE_SAMPLE_ZERO_BIT : VK_RESOLVE_MODE_AVERAGE_BIT;
+                attachmentInfo.resolveImageView = resolveTexture->GetRTV(attachment->resolveLevel, attachment->resolveSlice);
+                attachmentInfo.resolveImageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            }
 
             attachmentInfo.clearValue.color.float32[0] = attachment->clearColor.r;
             attachmentInfo.clearValue.color.float32[1] = attachment->clearColor.g;
@@ -5948,13 +8807,19 @@ void VulkanCommandBuffer::BeginRenderPass(const VGPURenderPassDesc* desc)
             width = _VGPU_MIN(width, _VGPU_MAX(1U, texture->width >> level));
             height = _VGPU_MIN(height, _VGPU_MAX(1U, texture->height >> level));
 
+            const bool transient = (texture->usage & VGPUTextureUsage_Transient) != 0;
+            const VGPULoadAction depthLoadAction = (transient && attachment->depthLoadAction == VGPULoadAction_Load) ? VGPULoadAction_DontCare : attachment->depthLoadAction;
+            const VGPUStoreAction depthStoreAction = transient ? VGPUStoreAction_DontCare : attachment->depthStoreAction;
+            const VGPULoadAction stencilLoadAction = (transient && attachment->stencilLoadAction == VGPULoadAction_Load) ? VGPULoadAction_DontCare : attachment->stencilLoadAction;
+            const VGPUStoreAction stencilStoreAction = transient ? VGPUStoreAction_DontCare : attachment->stencilStoreAction;
+
             depthAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
             depthAttachment.pNext = VK_NULL_HANDLE;
             depthAttachment.imageView = texture->GetRTV(level, slice);
-            depthAttachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL;
+            depthAttachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
             depthAttachment.resolveMode = VK_RESOLVE_MODE_NONE;
-            depthAttachment.loadOp = ToVkAttachmentLoadOp(attachment->depthLoadAction);
-            depthAttachment.storeOp = ToVkAttachmentStoreOp(attachment->depthStoreAction);
+            depthAttachment.loadOp = ToVkAttachmentLoadOp(depthLoadAction);
+            depthAttachment.storeOp = ToVkAttachmentStoreOp(depthStoreAction);
             depthAttachment.clearValue.depthStencil.depth = attachment->depthClearValue;
 
             if (!vgpuIsDepthOnlyFormat(depthStencilFormat))
@@ -5964,33 +8829,28 @@ void VulkanCommandBuffer::BeginRenderPass(const VGPURenderPassDesc* desc)
                 stencilAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
                 stencilAttachment.pNext = VK_NULL_HANDLE;
                 stencilAttachment.imageView = texture->GetRTV(level, slice);
-                stencilAttachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL;
+                stencilAttachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
                 stencilAttachment.resolveMode = VK_RESOLVE_MODE_NONE;
-                stencilAttachment.loadOp = ToVkAttachmentLoadOp(attachment->stencilLoadAction);
-                stencilAttachment.storeOp = ToVkAttachmentStoreOp(attachment->stencilStoreAction);
+                stencilAttachment.loadOp = ToVkAttachmentLoadOp(stencilLoadAction);
+                stencilAttachment.storeOp = ToVkAttachmentStoreOp(stencilStoreAction);
                 stencilAttachment.clearValue.depthStencil.stencil = attachment->stencilClearValue;
             }
 
-            // Barrier
-            VkImageSubresourceRange depthTextureRange{};
-            depthTextureRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
-            depthTextureRange.baseMipLevel = 0;
-            depthTextureRange.levelCount = VK_REMAINING_MIP_LEVELS;
-            depthTextureRange.baseArrayLayer = 0;
-            depthTextureRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+            // Both aspects share one layout, contents are only discarded when neither aspect loads.
+            const bool discard = depthLoadAction != VGPULoadAction_Load
+                && (!hasStencil || stencilLoadAction != VGPULoadAction_Load);
 
-            InsertImageMemoryBarrier(
-                texture->handle,
-                0,
-                VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
-                VK_IMAGE_LAYOUT_UNDEFINED,
-                VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL,
-                VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
-                VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
-                depthTextureRange
-            );
+            VulkanResourceState state;
+            state.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+            state.stages = VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT;
+            state.access = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            RequireTextureState(texture, level, 1, slice, 1, state, discard);
+            renderPassTextures.push_back(texture);
         }
 
+        ApplyRestingLayouts();
+        FlushBarriers(true);
+
         renderingInfo.renderArea.offset.x = 0;
         renderingInfo.renderArea.offset.y = 0;
         renderingInfo.renderArea.extent.width = width;
@@ -6023,14 +8883,14 @@ void VulkanCommandBuffer::BeginRenderPass(const VGPURenderPassDesc* desc)
     viewport.height = -static_cast<float>(height);
     viewport.minDepth = 0.0f;
     viewport.maxDepth = 1.0f;
-    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+    BindViewport(viewport);
 
     VkRect2D scissorRect{};
     scissorRect.offset.x = 0;
     scissorRect.offset.y = 0;
     scissorRect.extent.width = width;
     scissorRect.extent.height = height;
-    vkCmdSetScissor(commandBuffer, 0, 1, &scissorRect);
+    BindScissorRect(scissorRect);
 
     insideRenderPass = true;
 }
@@ -6046,14 +8906,52 @@ void VulkanCommandBuffer::EndRenderPass()
         //vkCmdEndRenderPass2(commandBuffer);
     }
 
+    for (VulkanTexture* texture : renderPassTextures)
+    {
+        AddRestingTexture(texture);
+    }
+    renderPassTextures.clear();
+
     if (hasRenderPassLabel)
     {
         PopDebugGroup();
+        hasRenderPassLabel = false;
+    }
+    else if (hasRenderPassScope)
+    {
+        EndProfileScope();
+        hasRenderPassScope = false;
     }
 
     insideRenderPass = false;
 }
 
+void VulkanCommandBuffer::BindViewport(const VkViewport& viewport)
+{
+    if (hasBoundViewport && memcmp(&boundViewport, &viewport, sizeof(VkViewport)) == 0)
+    {
+        statistics.redundantStateCount++;
+        return;
+    }
+
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+    boundViewport = viewport;
+    hasBoundViewport = true;
+}
+
+void VulkanCommandBuffer::BindScissorRect(const VkRect2D& rect)
+{
+    if (hasBoundScissorRect && memcmp(&boundScissorRect, &rect, sizeof(VkRect2D)) == 0)
+    {
+        statistics.redundantStateCount++;
+        return;
+    }
+
+    vkCmdSetScissor(commandBuffer, 0, 1, &rect);
+    boundScissorRect = rect;
+    hasBoundScissorRect = true;
+}
+
 void VulkanCommandBuffer::SetViewport(const VGPUViewport* viewport)
 {
     VkViewport vkViewport;
@@ -6064,7 +8962,7 @@ void VulkanCommandBuffer::SetViewport(const VGPUViewport* viewport)
     vkViewport.minDepth = viewport->minDepth;
     vkViewport.maxDepth = viewport->maxDepth;
 
-    vkCmdSetViewport(commandBuffer, 0, 1, &vkViewport);
+    BindViewport(vkViewport);
 }
 
 void VulkanCommandBuffer::SetViewports(uint32_t count, const VGPUViewport* viewports)
@@ -6080,6 +8978,12 @@ void VulkanCommandBuffer::SetViewports(uint32_t count, const VGPUViewport* viewp
         vkViewport = viewport;
         vkViewport.y = viewport.height - viewport.y;
         vkViewport.height = -viewport.height;
+
+        if (i == 0)
+        {
+            boundViewport = vkViewport;
+            hasBoundViewport = true;
+        }
     }
 
     vkCmdSetViewport(commandBuffer, 0, count, vkViewports);
@@ -6087,7 +8991,7 @@ void VulkanCommandBuffer::SetViewports(uint32_t count, const VGPUViewport* viewp
 
 void VulkanCommandBuffer::SetScissorRect(const VGPURect* rect)
 {
-    vkCmdSetScissor(commandBuffer, 0, 1, (VkRect2D*)&rect);
+    BindScissorRect(*(const VkRect2D*)rect);
 }
 
 void VulkanCommandBuffer::SetScissorRects(uint32_t count, const VGPURect* rects)
@@ -6095,12 +8999,31 @@ void VulkanCommandBuffer::SetScissorRects(uint32_t count, const VGPURect* rects)
     VGPU_ASSERT(count < renderer->properties2.properties.limits.maxViewports);
 
     vkCmdSetScissor(commandBuffer, 0, count, (const VkRect2D*)rects);
+    if (count > 0)
+    {
+        boundScissorRect = *(const VkRect2D*)rects;
+        hasBoundScissorRect = true;
+    }
 }
 
 void VulkanCommandBuffer::SetVertexBuffer(uint32_t index, VGPUBuffer buffer, uint64_t offset)
 {
     VulkanBuffer* vulkanBuffer = (VulkanBuffer*)buffer;
 
+    // Handles rather than objects, a released buffer's handle is not reused before this command buffer completes.
+    if (index < _VGPU_COUNT_OF(boundVertexBuffers))
+    {
+        BoundVertexBuffer& bound = boundVertexBuffers[index];
+        if (bound.handle == vulkanBuffer->handle && bound.offset == offset)
+        {
+            statistics.redundantStateCount++;
+            return;
+        }
+
+        bound.handle = vulkanBuffer->handle;
+        bound.offset = offset;
+    }
+
     vkCmdBindVertexBuffers(commandBuffer, index, 1, &vulkanBuffer->handle, &offset);
 }
 
@@ -6109,12 +9032,29 @@ void VulkanCommandBuffer::SetIndexBuffer(VGPUBuffer buffer, VGPUIndexType type,
     VulkanBuffer* vulkanBuffer = (VulkanBuffer*)buffer;
 
     const VkIndexType vkIndexType = (type == VGPUIndexType_Uint16) ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+    if (boundIndexBuffer == vulkanBuffer->handle && boundIndexBufferOffset == offset && boundIndexType == vkIndexType)
+    {
+        statistics.redundantStateCount++;
+        return;
+    }
+
     vkCmdBindIndexBuffer(commandBuffer, vulkanBuffer->handle, offset, vkIndexType);
+    boundIndexBuffer = vulkanBuffer->handle;
+    boundIndexBufferOffset = offset;
+    boundIndexType = vkIndexType;
 }
 
 void VulkanCommandBuffer::SetStencilReference(uint32_t reference)
 {
+    if (hasBoundStencilReference && boundStencilReference == reference)
+    {
+        statistics.redundantStateCount++;
+        return;
+    }
+
     vkCmdSetStencilReference(commandBuffer, VK_STENCIL_FRONT_AND_BACK, reference);
+    boundStencilReference = reference;
+    hasBoundStencilReference = true;
 }
 
 void VulkanCommandBuffer::BeginQuery(VGPUQueryHeap heap, uint32_t index)
@@ -6178,6 +9118,9 @@ void VulkanCommandBuffer::ResolveQuery(VGPUQueryHeap heap, uint32_t index, uint3
 
     VkQueryResultFlags flags = VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT;
 
+    RequireBufferState(vulkanDestBuffer, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+    FlushBarriers(false);
+
     switch (vulkanHeap->type)
     {
         case VGPUQueryType_BinaryOcclusion:
@@ -6209,6 +9152,7 @@ void VulkanCommandBuffer::ResetQuery(VGPUQueryHeap heap, uint32_t index, uint32_
 void VulkanCommandBuffer::PrepareDraw()
 {
     VGPU_ASSERT(insideRenderPass);
+    statistics.drawCount++;
 
     FlushBindGroups();
 }
@@ -6280,11 +9224,15 @@ void VulkanCommandBuffer::DispatchMeshIndirectCount(VGPUBuffer indirectBuffer, u
 /* VulkanRenderer */
 VGPUCommandBuffer VulkanDevice::BeginCommandBuffer(VGPUCommandQueue queueType, const char* label)
 {
-    VulkanCommandBuffer* commandBuffer = nullptr;
+    // Only Submit pushes to the free list, so popping concurrently is free of ABA.
+    std::atomic<VulkanCommandBuffer*>& freeList = freeCommandBuffers[queueType];
+    VulkanCommandBuffer* commandBuffer = freeList.load(std::memory_order_acquire);
+    while (commandBuffer != nullptr
+        && !freeList.compare_exchange_weak(commandBuffer, commandBuffer->nextFree, std::memory_order_acquire))
+    {
+    }
 
-    cmdBuffersLocker.lock();
-    uint32_t cmd_current = cmdBuffersCount++;
-    if (cmd_current >= commandBuffersPool.size())
+    if (commandBuffer == nullptr)
     {
         commandBuffer = new VulkanCommandBuffer();
         commandBuffer->renderer = this;
@@ -6306,37 +9254,68 @@ VGPUCommandBuffer VulkanDevice::BeginCommandBuffer(VGPUCommandQueue queueType, c
             commandBufferInfo.commandPool = commandBuffer->commandPools[i];
             commandBufferInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
             VK_CHECK(vkAllocateCommandBuffers(device, &commandBufferInfo, &commandBuffer->commandBuffers[i]));
+            // Records the transitions from the global resource state at submit.
+            VK_CHECK(vkAllocateCommandBuffers(device, &commandBufferInfo, &commandBuffer->prologueCommandBuffers[i]));
         }
 
         VkSemaphoreCreateInfo semaphoreInfo = {};
         semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
         VK_CHECK(vkCreateSemaphore(device, &semaphoreInfo, nullptr, &commandBuffer->semaphore));
 
+        std::lock_guard<std::mutex> lock(cmdBuffersLocker);
         commandBuffersPool.push_back(commandBuffer);
     }
-    else
-    {
-        commandBuffer = commandBuffersPool.back();
-    }
-
-    cmdBuffersLocker.unlock();
 
     // Begin recording
     commandBuffer->Begin(frameIndex, label);
 
-    return commandBuffersPool.back();
+    return commandBuffer;
+}
+
+void VulkanDevice::RecycleCommandBuffers()
+{
+    VulkanCommandBuffer* heads[_VGPUCommandQueue_Count] = {};
+
+    std::lock_guard<std::mutex> lock(cmdBuffersLocker);
+    for (VulkanCommandBuffer* commandBuffer : commandBuffersPool)
+    {
+        commandBuffer->nextFree = heads[commandBuffer->queueType];
+        heads[commandBuffer->queueType] = commandBuffer;
+    }
+
+    for (uint32_t i = 0; i < _VGPUCommandQueue_Count; ++i)
+    {
+        freeCommandBuffers[i].store(heads[i], std::memory_order_release);
+    }
 }
 
-void VulkanQueue::Submit(VulkanDevice* device, VkFence fence)
+void VulkanQueue::Submit(VulkanDevice* device, uint64_t signalValue, uint64_t uploadWaitValue)
 {
     if (queue == VK_NULL_HANDLE)
         return;
 
     std::scoped_lock lock(locker);
+    device->frameCounters.submits.fetch_add(1, std::memory_order_relaxed);
 
     if (device->synchronization2)
     {
         VGPU_ASSERT(submitSignalSemaphores.size() == submitSignalSemaphoreInfos.size());
+
+        if (uploadWaitValue > 0)
+        {
+            VkSemaphoreSubmitInfo& uploadWait = submitWaitSemaphoreInfos.emplace_back();
+            uploadWait.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+            uploadWait.semaphore = device->uploadTimeline;
+            uploadWait.value = uploadWaitValue;
+            uploadWait.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        }
+
+        VkSemaphoreSubmitInfo& timelineSignal = submitSignalSemaphoreInfos.emplace_back();
+        timelineSignal.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+        timelineSignal.semaphore = timelineSemaphore;
+        timelineSignal.value = signalValue;
+        timelineSignal.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
         VkSubmitInfo2 submitInfo = {};
         submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
         submitInfo.waitSemaphoreInfoCount = (uint32_t)submitWaitSemaphoreInfos.size();
@@ -6346,12 +9325,35 @@ void VulkanQueue::Submit(VulkanDevice* device, VkFence fence)
         submitInfo.signalSemaphoreInfoCount = (uint32_t)submitSignalSemaphoreInfos.size();
         submitInfo.pSignalSemaphoreInfos = submitSignalSemaphoreInfos.data();
 
-        VK_CHECK(vkQueueSubmit2(queue, 1, &submitInfo, fence));
+        VK_CHECK(vkQueueSubmit2(queue, 1, &submitInfo, VK_NULL_HANDLE));
     }
     else
     {
+        // Binary semaphores ignore their value, only the timeline ones carry one.
+        submitSignalSemaphores.push_back(timelineSemaphore);
+        if (uploadWaitValue > 0)
+        {
+            submitWaitSemaphores.push_back(device->uploadTimeline);
+            submitWaitStages.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+        }
+        submitWaitValues.assign(submitWaitSemaphores.size(), 0);
+        submitSignalValues.assign(submitSignalSemaphores.size(), 0);
+        submitSignalValues.back() = signalValue;
+        if (uploadWaitValue > 0)
+        {
+            submitWaitValues.back() = uploadWaitValue;
+        }
+
+        VkTimelineSemaphoreSubmitInfo timelineInfo = {};
+        timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineInfo.waitSemaphoreValueCount = (uint32_t)submitWaitValues.size();
+        timelineInfo.pWaitSemaphoreValues = submitWaitValues.data();
+        timelineInfo.signalSemaphoreValueCount = (uint32_t)submitSignalValues.size();
+        timelineInfo.pSignalSemaphoreValues = submitSignalValues.data();
+
         VkSubmitInfo submitInfo = {};
         submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext = &timelineInfo;
         submitInfo.waitSemaphoreCount = (uint32_t)submitWaitSemaphores.size();
         submitInfo.pWaitSemaphores = submitWaitSemaphores.data();
         submitInfo.pWaitDstStageMask = submitWaitStages.data();
@@ -6360,7 +9362,10 @@ void VulkanQueue::Submit(VulkanDevice* device, VkFence fence)
         submitInfo.signalSemaphoreCount = (uint32_t)submitSignalSemaphores.size();
         submitInfo.pSignalSemaphores = submitSignalSemaphores.data();
 
-        VK_CHECK(vkQueueSubmit(queue, 1, &submitInfo, fence));
+        VK_CHECK(vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE));
+
+        // Present only waits on the swapchain release semaphores.
+        submitSignalSemaphores.pop_back();
     }
 
     if (!submitSwapchains.empty())
@@ -6406,7 +9411,10 @@ void VulkanQueue::Submit(VulkanDevice* device, VkFence fence)
 
 uint64_t VulkanDevice::Submit(VGPUCommandBuffer* commandBuffers, uint32_t count)
 {
-    cmdBuffersCount = 0;
+    // Pending uploads go first, every queue waits for the newest token it has not waited on yet.
+    const uint64_t uploadToken = FlushUploads();
+    const uint64_t waitUploadToken = uploadToken > uploadWaitValue ? uploadToken : 0;
+    uploadWaitValue = uploadToken;
 
     // Submit current frame.
     {
@@ -6415,10 +9423,6 @@ uint64_t VulkanDevice::Submit(VGPUCommandBuffer* commandBuffers, uint32_t count)
             VulkanCommandBuffer* commandBuffer = static_cast<VulkanCommandBuffer*>(commandBuffers[i]);
             VulkanQueue& queue = queues[commandBuffer->queueType];
 
-            VkCommandBufferSubmitInfo& commandBufferSubmitInfo = queue.submitCommandBufferInfos.emplace_back();
-            commandBufferSubmitInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
-            commandBufferSubmitInfo.commandBuffer = commandBuffer->commandBuffer;
-
             queue.swapchainUpdates = commandBuffer->presentSwapChains;
             for (size_t j = 0; j < commandBuffer->presentSwapChains.size(); ++j)
             {
@@ -6449,36 +9453,83 @@ uint64_t VulkanDevice::Submit(VGPUCommandBuffer* commandBuffers, uint32_t count)
                     queue.submitSignalSemaphores.push_back(swapChain->releaseSemaphore);
                 }
 
-                VkImageSubresourceRange range{};
-                range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-                range.baseMipLevel = 0;
-                range.levelCount = VK_REMAINING_MIP_LEVELS;
-                range.baseArrayLayer = 0;
-                range.layerCount = VK_REMAINING_ARRAY_LAYERS;
-                commandBuffer->InsertImageMemoryBarrier(
-                    swapChain->backbufferTextures[swapChain->imageIndex]->handle,
-                    VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
-                    0,
-                    VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-                    VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
-                    VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-                    VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-                    range);
+                VulkanResourceState presentState;
+                presentState.layout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+                commandBuffer->RequireTextureState(swapChain->backbufferTextures[swapChain->imageIndex], 0, 1, 0, 1, presentState);
+            }
+
+            // Storage writes declared through RequireTextureAccess leave GENERAL before untracked bind group reads.
+            for (auto& it : commandBuffer->trackedTextures)
+            {
+                for (const VulkanCommandBuffer::TrackedState& subresource : it.second)
+                {
+                    if (subresource.current.layout == VK_IMAGE_LAYOUT_GENERAL)
+                    {
+                        commandBuffer->AddRestingTexture(it.first);
+                        break;
+                    }
+                }
             }
 
+            commandBuffer->ApplyRestingLayouts();
+            commandBuffer->FlushBarriers(true);
+
             if (commandBuffer->hasLabel)
             {
                 commandBuffer->PopDebugGroup();
             }
 
+            // Groups left open are closed at the end of the command buffer.
+            while (!commandBuffer->profileStack.empty())
+            {
+                commandBuffer->EndProfileScope();
+            }
+
+            if (!commandBuffer->profileScopes.empty())
+            {
+                std::vector<VulkanProfileScope>& frameScopes = profilerFrames[commandBuffer->frameIndex].scopes;
+                const uint32_t base = (uint32_t)frameScopes.size();
+                for (VulkanProfileScope& scope : commandBuffer->profileScopes)
+                {
+                    if (scope.parent != VGPU_INVALID_PROFILE_SCOPE)
+                        scope.parent += base;
+                    frameScopes.push_back(std::move(scope));
+                }
+                commandBuffer->profileScopes.clear();
+            }
+
             VK_CHECK(vkEndCommandBuffer(commandBuffer->commandBuffer));
+            commandBuffer->FlushAllocator();
+
+            // Command buffers resolve in submission order, each one sees the state left by the previous.
+            VkCommandBuffer prologue = commandBuffer->ResolveTrackedStates();
+            if (prologue != VK_NULL_HANDLE)
+            {
+                VkCommandBufferSubmitInfo& prologueSubmitInfo = queue.submitCommandBufferInfos.emplace_back();
+                prologueSubmitInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+                prologueSubmitInfo.commandBuffer = prologue;
+                queue.submitCommandBuffers.push_back(prologue);
+            }
+
+            pendingStatistics.commandBufferCount++;
+            pendingStatistics.drawCount += commandBuffer->statistics.drawCount;
+            pendingStatistics.dispatchCount += commandBuffer->statistics.dispatchCount;
+            pendingStatistics.pipelineBindCount += commandBuffer->statistics.pipelineBindCount;
+            pendingStatistics.bindGroupBindCount += commandBuffer->statistics.bindGroupBindCount;
+            pendingStatistics.redundantStateCount += commandBuffer->statistics.redundantStateCount;
+            pendingStatistics.barrierCount += commandBuffer->statistics.barrierCount;
+            pendingStatistics.allocatedBytes += commandBuffer->statistics.allocatedBytes;
+
+            VkCommandBufferSubmitInfo& commandBufferSubmitInfo = queue.submitCommandBufferInfos.emplace_back();
+            commandBufferSubmitInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+            commandBufferSubmitInfo.commandBuffer = commandBuffer->commandBuffer;
             queue.submitCommandBuffers.push_back(commandBuffer->commandBuffer);
         }
 
-        // Final submits with fences.
+        // Final submits signal every queue timeline with the same value.
         for (uint8_t i = 0; i < _VGPUCommandQueue_Count; ++i)
         {
-            queues[i].Submit(this, queues[i].frameFences[frameIndex]);
+            queues[i].Submit(this, frameCount + 1, waitUploadToken);
         }
     }
 
@@ -6489,21 +9540,295 @@ uint64_t VulkanDevice::Submit(VGPUCommandBuffer* commandBuffers, uint32_t count)
     // Initiate stalling CPU when GPU is not yet finished with next frame
     if (frameCount >= VGPU_MAX_INFLIGHT_FRAMES)
     {
+        const uint64_t waitValue = frameCount + 1 - VGPU_MAX_INFLIGHT_FRAMES;
+
+        VkSemaphore waitSemaphores[_VGPUCommandQueue_Count];
+        uint64_t waitValues[_VGPUCommandQueue_Count];
+        uint32_t waitCount = 0;
         for (uint8_t i = 0; i < _VGPUCommandQueue_Count; ++i)
         {
             if (queues[i].queue == VK_NULL_HANDLE)
                 continue;
 
-            VK_CHECK(vkWaitForFences(device, 1, &queues[i].frameFences[frameIndex], true, 0xFFFFFFFFFFFFFFFF));
-            VK_CHECK(vkResetFences(device, 1, &queues[i].frameFences[frameIndex]));
+            waitSemaphores[waitCount] = queues[i].timelineSemaphore;
+            waitValues[waitCount] = waitValue;
+            waitCount++;
         }
+
+        VkSemaphoreWaitInfo waitInfo = {};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = waitCount;
+        waitInfo.pSemaphores = waitSemaphores;
+        waitInfo.pValues = waitValues;
+
+        VGPUTraceScope traceScope(this, "WaitForFrame");
+        const auto waitStart = std::chrono::steady_clock::now();
+        VK_CHECK(vkWaitSemaphores(device, &waitInfo, UINT64_MAX));
+        pendingStatistics.submitWaitMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - waitStart).count();
     }
 
+    // The frame that last used this slot has completed, its timestamps are available.
+    ResolveProfilerFrame();
+
     // Safe delete deferred destroys
     ProcessDeletionQueue();
 
-    // Return current frame
-    return frameCount - 1;
+    // Refreshes the VK_EXT_memory_budget numbers VMA caches.
+    vmaSetCurrentFrameIndex(allocator, static_cast<uint32_t>(frameCount));
+    CheckMemoryBudget();
+
+    // All command buffers record into the pools of the new frame index from now on.
+    RecycleCommandBuffers();
+
+    // Publish the finished frame, counters bumped from here on belong to the next one.
+    pendingStatistics.frame = frameCount - 1;
+    pendingStatistics.submitCount = frameCounters.submits.exchange(0, std::memory_order_relaxed);
+    pendingStatistics.descriptorWriteCount = frameCounters.descriptorWrites.exchange(0, std::memory_order_relaxed);
+    pendingStatistics.resourcesCreated = frameCounters.resourcesCreated.exchange(0, std::memory_order_relaxed);
+    pendingStatistics.resourcesDestroyed = frameCounters.resourcesDestroyed.exchange(0, std::memory_order_relaxed);
+    pendingStatistics.uploadBytes = frameCounters.uploadBytes.exchange(0, std::memory_order_relaxed);
+    frameStatistics = pendingStatistics;
+    pendingStatistics = {};
+
+    // Return the value signaled on every queue timeline by this submission.
+    return frameCount;
+}
+
+void VulkanDevice::SetProfilerEnabled(bool enabled)
+{
+    if (enabled && (features1_2.hostQueryReset != VK_TRUE || properties2.properties.limits.timestampComputeAndGraphics != VK_TRUE))
+    {
+        vgpuLogWarn("Vulkan: GPU profiler requires hostQueryReset and timestampComputeAndGraphics");
+        return;
+    }
+
+    profilerEnabled = enabled;
+}
+
+bool VulkanDevice::GetFrameProfile(VGPUFrameProfile* profile)
+{
+    if (!profilerEnabled || !hasProfile)
+        return false;
+
+    profile->frame = profileFrame;
+    profile->scopeCount = (uint32_t)profileScopes.size();
+    profile->scopes = profileScopes.data();
+    return true;
+}
+
+bool VulkanDevice::BeginTrace(const char* path)
+{
+    if (!VGPUDeviceImpl::BeginTrace(path))
+        return false;
+
+    traceGpu = features1_2.hostQueryReset == VK_TRUE && properties2.properties.limits.timestampComputeAndGraphics == VK_TRUE;
+    if (!traceGpu)
+    {
+        vgpuLogWarn("Vulkan: Tracing without GPU spans, timestamps require hostQueryReset and timestampComputeAndGraphics");
+    }
+    else if (traceHostDomain == VK_TIME_DOMAIN_MAX_ENUM_KHR)
+    {
+        vgpuLogWarn("Vulkan: No calibrated timestamps, GPU spans are aligned to the CPU timeline approximately");
+    }
+
+    return true;
+}
+
+bool VulkanDevice::EndTrace()
+{
+    traceGpu = false;
+    return VGPUDeviceImpl::EndTrace();
+}
+
+uint64_t VulkanDevice::CalibrateTraceTimestamps(uint64_t* deviceTimestamp)
+{
+    if (traceHostDomain == VK_TIME_DOMAIN_MAX_ENUM_KHR)
+        return 0;
+
+    VkCalibratedTimestampInfoKHR infos[2] = {};
+    infos[0].sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_KHR;
+    infos[0].timeDomain = VK_TIME_DOMAIN_DEVICE_KHR;
+    infos[1].sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_KHR;
+    infos[1].timeDomain = traceHostDomain;
+
+    uint64_t timestamps[2] = {};
+    uint64_t maxDeviation = 0;
+    const VkResult result = vkGetCalibratedTimestampsKHR(device, 2, infos, timestamps, &maxDeviation);
+    if (result != VK_SUCCESS)
+    {
+        VK_LOG_ERROR(result, "Failed to calibrate timestamps");
+        return 0;
+    }
+
+    *deviceTimestamp = timestamps[0];
+
+#if defined(_WIN32)
+    // steady_clock scales the performance counter to nanoseconds the same way.
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+    return uint64_t(double(timestamps[1]) * (1000.0 * 1000.0 * 1000.0) / double(frequency.QuadPart));
+#else
+    return timestamps[1];
+#endif
+}
+
+void VulkanDevice::ResolveProfilerFrame()
+{
+    VulkanProfilerFrame& frame = profilerFrames[frameIndex];
+    if (frame.queryPool != VK_NULL_HANDLE)
+    {
+        const uint32_t recordedQueries = frame.queryCount.load(std::memory_order_relaxed);
+        const uint32_t queryCount = _VGPU_MIN(recordedQueries, kProfilerQueryCount);
+        if (recordedQueries > kProfilerQueryCount && !profilerOverflowReported)
+        {
+            vgpuLogWarn("Vulkan: GPU profiler ran out of timestamp queries, later scopes report no time");
+            profilerOverflowReported = true;
+        }
+
+        // Results come with an availability word each, without WAIT this never stalls.
+        profileResults.resize(queryCount * 2u);
+        if (queryCount > 0)
+        {
+            const VkResult result = vkGetQueryPoolResults(device, frame.queryPool, 0, queryCount,
+                profileResults.size() * sizeof(uint64_t), profileResults.data(), 2 * sizeof(uint64_t),
+                VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+            if (result != VK_SUCCESS && result != VK_NOT_READY)
+            {
+                VK_LOG_ERROR(result, "Failed to read GPU profiler timestamps");
+                std::fill(profileResults.begin(), profileResults.end(), 0ull);
+            }
+
+            vkResetQueryPool(device, frame.queryPool, 0, queryCount);
+        }
+
+        auto isAvailable = [&](const VulkanProfileScope& scope) {
+            return scope.query != kProfilerQueryCount && profileResults[scope.query * 2 + 1] != 0 && profileResults[scope.query * 2 + 3] != 0;
+        };
+
+        uint64_t origin = UINT64_MAX;
+        for (const VulkanProfileScope& scope : frame.scopes)
+        {
+            if (isAvailable(scope))
+                origin = _VGPU_MIN(origin, profileResults[scope.query * 2]);
+        }
+
+        // Device ticks paired with a steady clock time, frames resolve after they completed so the
+        // uncalibrated fallback puts the last GPU timestamp of the frame at the resolve time.
+        const std::shared_ptr<VGPUTraceRecorder> frameTrace = GetTrace();
+        uint64_t traceDeviceTimestamp = 0;
+        uint64_t traceHostTime = 0;
+        if (frameTrace != nullptr && origin != UINT64_MAX)
+        {
+            traceHostTime = CalibrateTraceTimestamps(&traceDeviceTimestamp);
+            if (traceHostTime == 0)
+            {
+                traceHostTime = VGPUTraceRecorder::Now();
+                traceDeviceTimestamp = origin;
+                for (const VulkanProfileScope& scope : frame.scopes)
+                {
+                    if (isAvailable(scope) && profileResults[scope.query * 2 + 2] - origin > traceDeviceTimestamp - origin)
+                        traceDeviceTimestamp = profileResults[scope.query * 2 + 2];
+                }
+            }
+        }
+
+        const double ticksToMilliseconds = 1000.0 / double(timestampFrequency);
+        const double ticksToNanoseconds = 1000.0 * 1000.0 * 1000.0 / double(timestampFrequency);
+        profileScopes.clear();
+        profileLabels.clear();
+        profileLabels.reserve(frame.scopes.size());
+        for (VulkanProfileScope& scope : frame.scopes)
+        {
+            profileLabels.push_back(std::move(scope.label));
+
+            VGPUProfileScope& result = profileScopes.emplace_back();
+            result.label = profileLabels.back().c_str();
+            result.parent = scope.parent;
+            result.depth = scope.depth;
+            result.queue = scope.queue;
+            result.begin = 0.0;
+            result.duration = 0.0;
+
+            if (isAvailable(scope))
+            {
+                const uint32_t validBits = queues[scope.queue].timestampValidBits;
+                const uint64_t mask = validBits >= 64 ? UINT64_MAX : (1ull << validBits) - 1;
+                const uint64_t begin = profileResults[scope.query * 2];
+                const uint64_t end = profileResults[scope.query * 2 + 2];
+                result.begin = double((begin - origin) & mask) * ticksToMilliseconds;
+                result.duration = double((end - begin) & mask) * ticksToMilliseconds;
+
+                if (traceHostTime != 0)
+                {
+                    // Sign extend the masked distance, scopes usually lie before the calibration point.
+                    int64_t delta = int64_t((begin - traceDeviceTimestamp) & mask);
+                    if (mask != UINT64_MAX && uint64_t(delta) > (mask >> 1))
+                        delta -= int64_t(mask) + 1;
+
+                    const uint64_t traceBegin = traceHostTime + int64_t(double(delta) * ticksToNanoseconds);
+                    const uint64_t traceEnd = traceBegin + uint64_t(double((end - begin) & mask) * ticksToNanoseconds);
+                    frameTrace->AddGpuSpan(scope.queue, result.label, traceBegin, traceEnd);
+                }
+            }
+        }
+
+        profileFrame = frameCount - VGPU_MAX_INFLIGHT_FRAMES;
+        hasProfile = true;
+        frame.scopes.clear();
+        frame.queryCount.store(0, std::memory_order_relaxed);
+    }
+
+    // The next frame records into this slot.
+    profilerActive = profilerEnabled || traceGpu;
+    if (profilerActive && frame.queryPool == VK_NULL_HANDLE)
+    {
+        VkQueryPoolCreateInfo createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        createInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        createInfo.queryCount = kProfilerQueryCount;
+
+        const VkResult result = vkCreateQueryPool(device, &createInfo, nullptr, &frame.queryPool);
+        if (result != VK_SUCCESS)
+        {
+            VK_LOG_ERROR(result, "Failed to create GPU profiler query pool");
+            profilerEnabled = false;
+            profilerActive = false;
+            traceGpu = false;
+            return;
+        }
+
+        vkResetQueryPool(device, frame.queryPool, 0, kProfilerQueryCount);
+    }
+}
+
+uint64_t VulkanDevice::GetCompletedValue(VGPUCommandQueue queue)
+{
+    if (queues[queue].queue == VK_NULL_HANDLE)
+        return 0;
+
+    uint64_t value = 0;
+    VK_CHECK(vkGetSemaphoreCounterValue(device, queues[queue].timelineSemaphore, &value));
+    return value;
+}
+
+VGPUBool32 VulkanDevice::WaitValue(VGPUCommandQueue queue, uint64_t value, uint64_t timeout)
+{
+    if (queues[queue].queue == VK_NULL_HANDLE)
+        return false;
+
+    VkSemaphoreWaitInfo waitInfo = {};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &queues[queue].timelineSemaphore;
+    waitInfo.pValues = &value;
+
+    const VkResult result = vkWaitSemaphores(device, &waitInfo, timeout);
+    if (result != VK_SUCCESS && result != VK_TIMEOUT)
+    {
+        VK_LOG_ERROR(result, "Failed to wait for queue timeline value");
+    }
+
+    return result == VK_SUCCESS;
 }
 
 static bool vulkan_isSupported(void)
@@ -0,0 +1,312 @@
+// Copyright (c) Amer Koleci and Contributors.
+// Licensed under the MIT License (MIT). See LICENSE in the repository root for more information.
+
+#include "vgpu_driver.h"
+#include <deque>
+
+namespace
+{
+    // D3D12 copy footprints need 256 byte row pitch and 512 byte placement, both also satisfy Vulkan.
+    constexpr uint32_t kRowPitchAlignment = 256u;
+    constexpr uint64_t kTexturePlacementAlignment = 512u;
+    constexpr uint64_t kBufferPlacementAlignment = 16u;
+}
+
+/// Tickets are handed out in recording order and sub-allocate one host readable buffer as a ring,
+/// the tail only moves past tickets that are both freed and completed. Copies that do not fit get
+/// a dedicated buffer rather than waiting on the GPU.
+class ReadbackRing final : public VGPUReadbackRingImpl
+{
+public:
+    ReadbackRing(VGPUDeviceImpl* device_, VGPUBuffer buffer_, uint64_t capacity_)
+        : device(device_)
+        , buffer(buffer_)
+        , capacity(capacity_)
+    {
+    }
+
+    ~ReadbackRing() override;
+
+    void SetLabel(const char* label) override { buffer->SetLabel(label); }
+
+    VGPUReadbackTicket CopyBuffer(VGPUCommandBuffer commandBuffer, VGPUBuffer source, uint64_t offset, uint64_t size) override;
+    VGPUReadbackTicket CopyTexture(VGPUCommandBuffer commandBuffer, const VGPUTextureCopyLocation* source, const VGPUExtent3D* extent) override;
+    bool IsReady(VGPUReadbackTicket ticket) override;
+    bool Wait(VGPUReadbackTicket ticket, uint64_t timeout) override;
+    bool GetData(VGPUReadbackTicket ticket, VGPUReadbackData* data) override;
+    void Free(VGPUReadbackTicket ticket) override;
+
+private:
+    struct Entry
+    {
+        VGPUBuffer dedicated = nullptr;
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        uint32_t bytesPerRow = 0;
+        uint32_t rowsPerImage = 0;
+        VGPUCommandQueue queue = VGPUCommandQueue_Graphics;
+        // Queue value of the submission carrying the copy.
+        uint64_t value = 0;
+        bool completed = false;
+        bool invalidated = false;
+        bool freed = false;
+    };
+
+    Entry* Allocate(VGPUCommandBuffer commandBuffer, uint64_t size, uint64_t alignment, VGPUBufferCopyLocation* location);
+    Entry* Find(VGPUReadbackTicket ticket);
+    bool IsCompleted(Entry& entry);
+    void Reclaim();
+
+    VGPUDeviceImpl* device;
+    VGPUBuffer buffer;
+    uint64_t capacity;
+
+    std::deque<Entry> entries;
+    VGPUReadbackTicket firstTicket = 1;
+    // End of the newest ring entry, only meaningful while ringEntryCount > 0.
+    uint64_t head = 0;
+    uint32_t ringEntryCount = 0;
+};
+
+ReadbackRing::~ReadbackRing()
+{
+    // Buffer destruction is deferred by the device, copies still in flight keep valid memory.
+    for (Entry& entry : entries)
+    {
+        if (entry.dedicated)
+            entry.dedicated->Release();
+    }
+
+    buffer->Release();
+}
+
+bool ReadbackRing::IsCompleted(Entry& entry)
+{
+    if (!entry.completed && device->GetCompletedValue(entry.queue) >= entry.value)
+        entry.completed = true;
+
+    return entry.completed;
+}
+
+void ReadbackRing::Reclaim()
+{
+    while (!entries.empty() && entries.front().freed && IsCompleted(entries.front()))
+    {
+        Entry& entry = entries.front();
+        if (entry.dedicated)
+        {
+            entry.dedicated->Release();
+        }
+        else
+        {
+            ringEntryCount--;
+        }
+
+        entries.pop_front();
+        firstTicket++;
+    }
+}
+
+ReadbackRing::Entry* ReadbackRing::Find(VGPUReadbackTicket ticket)
+{
+    if (ticket < firstTicket || ticket - firstTicket >= entries.size())
+        return nullptr;
+
+    Entry& entry = entries[ticket - firstTicket];
+    return entry.freed ? nullptr : &entry;
+}
+
+ReadbackRing::Entry* ReadbackRing::Allocate(VGPUCommandBuffer commandBuffer, uint64_t size, uint64_t alignment, VGPUBufferCopyLocation* location)
+{
+    Reclaim();
+
+    bool fits = false;
+    uint64_t offset = 0;
+    if (size <= capacity)
+    {
+        if (ringEntryCount == 0)
+        {
+            fits = true;
+        }
+        else
+        {
+            uint64_t tail = 0;
+            for (const Entry& entry : entries)
+            {
+                if (entry.dedicated == nullptr)
+                {
+                    tail = entry.offset;
+                    break;
+                }
+            }
+
+            offset = AlignUp(head, alignment);
+            if (head > tail)
+            {
+                // Free space is [head, capacity) followed by [0, tail).
+                if (offset + size > capacity)
+                {
+                    offset = 0;
+                    fits = size <= tail;
+                }
+                else
+                {
+                    fits = true;
+                }
+            }
+            else
+            {
+                fits = offset + size <= tail;
+            }
+        }
+    }
+
+    Entry entry;
+    entry.size = size;
+    entry.queue = commandBuffer->GetQueueType();
+    // Submit signals frameCount + 1 on every queue.
+    entry.value = device->GetFrameCount() + 1;
+
+    if (fits)
+    {
+        entry.offset = offset;
+        head = offset + size;
+        ringEntryCount++;
+        location->buffer = buffer;
+    }
+    else
+    {
+        VGPUBufferDesc bufferDesc = {};
+        bufferDesc.label = "ReadbackRing Overflow";
+        bufferDesc.size = size;
+        bufferDesc.cpuAccess = VGPUCpuAccessMode_Read;
+        entry.dedicated = device->CreateBuffer(&bufferDesc, nullptr);
+        if (entry.dedicated == nullptr)
+        {
+            vgpuLogError("ReadbackRing: Failed to create overflow buffer");
+            return nullptr;
+        }
+
+        location->buffer = entry.dedicated;
+    }
+
+    location->offset = entry.offset;
+    entries.push_back(entry);
+    return &entries.back();
+}
+
+VGPUReadbackTicket ReadbackRing::CopyBuffer(VGPUCommandBuffer commandBuffer, VGPUBuffer source, uint64_t offset, uint64_t size)
+{
+    if (size == VGPU_WHOLE_SIZE)
+        size = source->GetSize() - offset;
+
+    if (size == 0 || offset + size > source->GetSize())
+    {
+        vgpuLogWarn("ReadbackRing: Copy range exceeds the source buffer");
+        return VGPU_INVALID_READBACK_TICKET;
+    }
+
+    VGPUBufferCopyLocation destination = {};
+    if (Allocate(commandBuffer, size, kBufferPlacementAlignment, &destination) == nullptr)
+        return VGPU_INVALID_READBACK_TICKET;
+
+    commandBuffer->CopyBufferToBuffer(source, offset, destination.buffer, destination.offset, size);
+    commandBuffer->RequireHostRead(destination.buffer);
+    return firstTicket + entries.size() - 1;
+}
+
+VGPUReadbackTicket ReadbackRing::CopyTexture(VGPUCommandBuffer commandBuffer, const VGPUTextureCopyLocation* source, const VGPUExtent3D* extent)
+{
+    VGPUPixelFormatInfo formatInfo;
+    vgpuGetPixelFormatInfo(source->texture->GetFormat(), &formatInfo);
+
+    const uint32_t blocksX = (extent->width + formatInfo.blockWidth - 1) / formatInfo.blockWidth;
+    const uint32_t blocksY = (extent->height + formatInfo.blockHeight - 1) / formatInfo.blockHeight;
+    const uint32_t bytesPerRow = AlignUp(blocksX * formatInfo.bytesPerBlock, kRowPitchAlignment);
+    const uint64_t size = (uint64_t)bytesPerRow * blocksY * _VGPU_MAX(1u, extent->depth);
+
+    VGPUBufferCopyLocation destination = {};
+    Entry* entry = Allocate(commandBuffer, size, kTexturePlacementAlignment, &destination);
+    if (entry == nullptr)
+        return VGPU_INVALID_READBACK_TICKET;
+
+    entry->bytesPerRow = bytesPerRow;
+    entry->rowsPerImage = blocksY;
+    destination.bytesPerRow = bytesPerRow;
+    destination.rowsPerImage = blocksY;
+
+    commandBuffer->CopyTextureToBuffer(source, &destination, extent);
+    commandBuffer->RequireHostRead(destination.buffer);
+    return firstTicket + entries.size() - 1;
+}
+
+bool ReadbackRing::IsReady(VGPUReadbackTicket ticket)
+{
+    Entry* entry = Find(ticket);
+    return entry != nullptr && IsCompleted(*entry);
+}
+
+bool ReadbackRing::Wait(VGPUReadbackTicket ticket, uint64_t timeout)
+{
+    Entry* entry = Find(ticket);
+    if (entry == nullptr)
+        return false;
+
+    if (IsCompleted(*entry))
+        return true;
+
+    if (device->GetFrameCount() < entry->value)
+    {
+        vgpuLogWarn("ReadbackRing: Waiting on a ticket whose command buffer was not submitted");
+        return false;
+    }
+
+    if (device->WaitValue(entry->queue, entry->value, timeout))
+        entry->completed = true;
+
+    return entry->completed;
+}
+
+bool ReadbackRing::GetData(VGPUReadbackTicket ticket, VGPUReadbackData* data)
+{
+    Entry* entry = Find(ticket);
+    if (entry == nullptr || !IsCompleted(*entry))
+        return false;
+
+    VGPUBuffer source = entry->dedicated ? entry->dedicated : buffer;
+    if (!entry->invalidated)
+    {
+        source->InvalidateRange(entry->offset, entry->size);
+        entry->invalidated = true;
+    }
+
+    data->data = (const uint8_t*)source->GetMappedData() + entry->offset;
+    data->size = entry->size;
+    data->bytesPerRow = entry->bytesPerRow;
+    data->rowsPerImage = entry->rowsPerImage;
+    return true;
+}
+
+void ReadbackRing::Free(VGPUReadbackTicket ticket)
+{
+    Entry* entry = Find(ticket);
+    if (entry == nullptr)
+        return;
+
+    entry->freed = true;
+    Reclaim();
+}
+
+VGPUReadbackRingImpl* CreateReadbackRing(VGPUDeviceImpl* device, uint64_t size)
+{
+    VGPUBufferDesc bufferDesc = {};
+    bufferDesc.label = "ReadbackRing";
+    bufferDesc.size = size;
+    bufferDesc.cpuAccess = VGPUCpuAccessMode_Read;
+
+    VGPUBuffer buffer = device->CreateBuffer(&bufferDesc, nullptr);
+    if (buffer == nullptr)
+        return nullptr;
+
+    return new ReadbackRing(device, buffer, size);
+}
@@ -0,0 +1,837 @@
+// Copyright (c) Amer Koleci and Contributors.
+// Licensed under the MIT License (MIT). See LICENSE in the repository root for more information.
+
+#include "vgpu_driver.h"
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+
+namespace
+{
+    constexpr uint32_t kInvalidPass = 0xFFFFFFFFu;
+
+    bool IsWriteAccess(VGPURenderGraphAccess access)
+    {
+        return access == VGPURenderGraphAccess_ShaderWrite
+            || access == VGPURenderGraphAccess_RenderTarget
+            || access == VGPURenderGraphAccess_CopyDestination;
+    }
+
+    size_t HashTextureDesc(const VGPUTextureDesc& desc)
+    {
+        size_t hash = 0;
+        hash_combine(hash, (uint32_t)desc.dimension);
+        hash_combine(hash, (uint32_t)desc.format);
+        hash_combine(hash, (uint32_t)desc.usage);
+        hash_combine(hash, desc.width);
+        hash_combine(hash, desc.height);
+        hash_combine(hash, desc.depthOrArrayLayers);
+        hash_combine(hash, desc.mipLevelCount);
+        hash_combine(hash, desc.sampleCount);
+        hash_combine(hash, (uint32_t)desc.cpuAccess);
+        return hash;
+    }
+
+    size_t HashBufferDesc(const VGPUBufferDesc& desc)
+    {
+        size_t hash = 0;
+        hash_combine(hash, desc.size);
+        hash_combine(hash, (uint32_t)desc.usage);
+        hash_combine(hash, (uint32_t)desc.cpuAccess);
+        return hash;
+    }
+
+    // Compares the fields HashTextureDesc and HashBufferDesc cover, lookups by hash confirm their hits with these.
+    bool IsSameTextureDesc(const VGPUTextureDesc& lhs, const VGPUTextureDesc& rhs)
+    {
+        return lhs.dimension == rhs.dimension
+            && lhs.format == rhs.format
+            && lhs.usage == rhs.usage
+            && lhs.width == rhs.width
+            && lhs.height == rhs.height
+            && lhs.depthOrArrayLayers == rhs.depthOrArrayLayers
+            && lhs.mipLevelCount == rhs.mipLevelCount
+            && lhs.sampleCount == rhs.sampleCount
+            && lhs.cpuAccess == rhs.cpuAccess;
+    }
+
+    bool IsSameBufferDesc(const VGPUBufferDesc& lhs, const VGPUBufferDesc& rhs)
+    {
+        return lhs.size == rhs.size
+            && lhs.usage == rhs.usage
+            && lhs.cpuAccess == rhs.cpuAccess;
+    }
+
+    // Tightly packed size, only used for statistics when the backend cannot report allocation requirements.
+    uint64_t EstimateTextureSize(const VGPUTextureDesc& desc)
+    {
+        VGPUPixelFormatInfo formatInfo;
+        vgpuGetPixelFormatInfo(desc.format, &formatInfo);
+
+        const bool is3D = desc.dimension == VGPUTextureDimension_3D;
+        uint32_t width = desc.width;
+        uint32_t height = desc.height;
+        uint32_t depth = is3D ? desc.depthOrArrayLayers : 1u;
+
+        uint64_t size = 0;
+        for (uint32_t mipLevel = 0; mipLevel < desc.mipLevelCount; ++mipLevel)
+        {
+            const uint64_t blocksX = (width + formatInfo.blockWidth - 1) / formatInfo.blockWidth;
+            const uint64_t blocksY = (height + formatInfo.blockHeight - 1) / formatInfo.blockHeight;
+            size += blocksX * blocksY * depth * formatInfo.bytesPerBlock;
+
+            width = _VGPU_MAX(1u, width / 2);
+            height = _VGPU_MAX(1u, height / 2);
+            depth = _VGPU_MAX(1u, depth / 2);
+        }
+
+        return size * (is3D ? 1u : desc.depthOrArrayLayers) * _VGPU_MAX(1u, desc.sampleCount);
+    }
+}
+
+/// Passes are culled from the imported resources backwards, transient resources get memory for their
+/// live pass range only: placed in shared heaps when the backend supports it, pooled objects otherwise.
+class RenderGraph final : public VGPURenderGraphImpl
+{
+public:
+    explicit RenderGraph(VGPUDeviceImpl* device_)
+        : device(device_)
+    {
+    }
+
+    ~RenderGraph() override;
+
+    void SetLabel(const char* label) override { VGPU_UNUSED(label); }
+
+    VGPURenderGraphResource CreateTexture(const VGPUTextureDesc* desc) override;
+    VGPURenderGraphResource CreateBuffer(const VGPUBufferDesc* desc) override;
+    VGPURenderGraphResource ImportTexture(VGPUTexture texture) override;
+    VGPURenderGraphResource ImportBuffer(VGPUBuffer buffer) override;
+    VGPURenderGraphResource ImportSwapChain(VGPUSwapChain swapChain) override;
+    void AddPass(const VGPURenderGraphPassDesc* desc) override;
+    VGPUTexture GetTexture(VGPURenderGraphResource resource) const override;
+    VGPUBuffer GetBuffer(VGPURenderGraphResource resource) const override;
+    uint64_t Execute() override;
+    void GetStatistics(VGPURenderGraphStatistics* result) const override { *result = statistics; }
+
+private:
+    struct Resource
+    {
+        std::string label;
+        bool isTexture = true;
+        bool imported = false;
+        VGPUTextureDesc textureDesc = {};
+        VGPUBufferDesc bufferDesc = {};
+        size_t descHash = 0;
+        VGPUTexture texture = nullptr;
+        VGPUBuffer buffer = nullptr;
+        VGPUSwapChain swapChain = nullptr;
+
+        // Resolved by Execute.
+        bool needed = false;
+        bool async = false;
+        uint32_t firstPass = kInvalidPass;
+        uint32_t lastPass = 0;
+        bool placeable = false;
+        VGPUAllocationRequirements requirements = {};
+        uint64_t offset = 0;
+    };
+
+    struct Pass
+    {
+        std::string label;
+        VGPUCommandQueue queue = VGPUCommandQueue_Graphics;
+        std::vector<VGPURenderGraphPassResource> resources;
+        bool hasSideEffects = false;
+        VGPURenderGraphPassCallback callback = nullptr;
+        void* userData = nullptr;
+        bool culled = true;
+        bool async = false;
+    };
+
+    // Desc a cached object was created for, the hash keys only narrow the search.
+    struct TransientDesc
+    {
+        bool isTexture = true;
+        VGPUTextureDesc textureDesc = {};
+        VGPUBufferDesc bufferDesc = {};
+
+        explicit TransientDesc(const Resource& resource)
+            : isTexture(resource.isTexture)
+            , textureDesc(resource.textureDesc)
+            , bufferDesc(resource.bufferDesc)
+        {
+        }
+
+        bool Matches(const Resource& resource) const
+        {
+            if (isTexture != resource.isTexture)
+                return false;
+
+            return isTexture ? IsSameTextureDesc(textureDesc, resource.textureDesc) : IsSameBufferDesc(bufferDesc, resource.bufferDesc);
+        }
+    };
+
+    struct CachedRequirements
+    {
+        TransientDesc desc;
+        VGPUAllocationRequirements requirements;
+    };
+
+    // Heaps, placed and pooled objects survive executions and are released once an execution leaves them unused.
+    struct Heap
+    {
+        uint32_t memoryTypeBits = 0;
+        VGPUMemoryHeap heap = nullptr;
+        uint64_t alignment = 0;
+        bool used = false;
+    };
+
+    struct PhysicalObject
+    {
+        size_t key = 0;
+        TransientDesc desc;
+        // Placement of placed objects, pooled objects have no heap.
+        VGPUMemoryHeap heap = nullptr;
+        uint64_t offset = 0;
+        bool async = false;
+        VGPUTexture texture = nullptr;
+        VGPUBuffer buffer = nullptr;
+        uint64_t size = 0;
+        // Last pass of the transient currently using a pooled object.
+        uint32_t busyUntil = 0;
+        bool used = false;
+
+        explicit PhysicalObject(const Resource& resource)
+            : desc(resource)
+        {
+        }
+    };
+
+    void Cull();
+    void ScheduleAsyncCompute();
+    void AllocateTransients();
+    void PlaceTransients(std::vector<Resource*>& group, std::vector<Resource*>& pooled);
+    void PoolTransients(std::vector<Resource*>& pooled);
+    bool CreatePhysical(const Resource& resource, VGPUMemoryHeap heap, PhysicalObject& object);
+    void ReleaseUnused();
+    void Clear();
+
+    VGPUDeviceImpl* device;
+    std::vector<Resource> resources;
+    std::vector<Pass> passes;
+    VGPURenderGraphStatistics statistics = {};
+
+    std::unordered_map<size_t, CachedRequirements> requirementsCache;
+    std::vector<Heap> heaps;
+    std::vector<PhysicalObject> placedObjects;
+    std::vector<PhysicalObject> pooledObjects;
+};
+
+RenderGraph::~RenderGraph()
+{
+    Clear();
+
+    for (PhysicalObject& object : placedObjects)
+        object.used = false;
+    for (PhysicalObject& object : pooledObjects)
+        object.used = false;
+    for (Heap& heap : heaps)
+        heap.used = false;
+    ReleaseUnused();
+}
+
+VGPURenderGraphResource RenderGraph::CreateTexture(const VGPUTextureDesc* desc)
+{
+    Resource& resource = resources.emplace_back();
+    resource.label = desc->label ? desc->label : "";
+    resource.isTexture = true;
+    resource.textureDesc = *desc;
+    resource.textureDesc.label = nullptr;
+    resource.descHash = HashTextureDesc(*desc);
+    return (VGPURenderGraphResource)(resources.size() - 1);
+}
+
+VGPURenderGraphResource RenderGraph::CreateBuffer(const VGPUBufferDesc* desc)
+{
+    Resource& resource = resources.emplace_back();
+    resource.label = desc->label ? desc->label : "";
+    resource.isTexture = false;
+    resource.bufferDesc = *desc;
+    resource.bufferDesc.label = nullptr;
+    resource.bufferDesc.existingHandle = nullptr;
+    resource.descHash = HashBufferDesc(*desc);
+    return (VGPURenderGraphResource)(resources.size() - 1);
+}
+
+VGPURenderGraphResource RenderGraph::ImportTexture(VGPUTexture texture)
+{
+    texture->AddRef();
+
+    Resource& resource = resources.emplace_back();
+    resource.isTexture = true;
+    resource.imported = true;
+    resource.texture = texture;
+    return (VGPURenderGraphResource)(resources.size() - 1);
+}
+
+VGPURenderGraphResource RenderGraph::ImportBuffer(VGPUBuffer buffer)
+{
+    buffer->AddRef();
+
+    Resource& resource = resources.emplace_back();
+    resource.isTexture = false;
+    resource.imported = true;
+    resource.buffer = buffer;
+    return (VGPURenderGraphResource)(resources.size() - 1);
+}
+
+VGPURenderGraphResource RenderGraph::ImportSwapChain(VGPUSwapChain swapChain)
+{
+    swapChain->AddRef();
+
+    Resource& resource = resources.emplace_back();
+    resource.isTexture = true;
+    resource.imported = true;
+    resource.swapChain = swapChain;
+    return (VGPURenderGraphResource)(resources.size() - 1);
+}
+
+void RenderGraph::AddPass(const VGPURenderGraphPassDesc* desc)
+{
+    for (uint32_t i = 0; i < desc->resourceCount; ++i)
+    {
+        if (desc->resources[i].resource >= resources.size())
+        {
+            vgpuLogError("vgpuRenderGraphAddPass: Pass '%s' uses invalid resource %u", desc->label ? desc->label : "", desc->resources[i].resource);
+            return;
+        }
+    }
+
+    Pass& pass = passes.emplace_back();
+    pass.label = desc->label ? desc->label : "";
+    pass.queue = desc->queue;
+    pass.resources.assign(desc->resources, desc->resources + desc->resourceCount);
+    pass.hasSideEffects = desc->hasSideEffects;
+    pass.callback = desc->callback;
+    pass.userData = desc->userData;
+}
+
+VGPUTexture RenderGraph::GetTexture(VGPURenderGraphResource resource) const
+{
+    if (resource >= resources.size())
+        return nullptr;
+
+    return resources[resource].texture;
+}
+
+VGPUBuffer RenderGraph::GetBuffer(VGPURenderGraphResource resource) const
+{
+    if (resource >= resources.size())
+        return nullptr;
+
+    return resources[resource].buffer;
+}
+
+void RenderGraph::Cull()
+{
+    for (Resource& resource : resources)
+    {
+        resource.needed = resource.imported;
+    }
+
+    // Writes keep earlier contents, so a live pass needs every resource it touches, including the ones it writes.
+    for (size_t i = passes.size(); i-- > 0;)
+    {
+        Pass& pass = passes[i];
+        bool live = pass.hasSideEffects;
+        for (const VGPURenderGraphPassResource& usage : pass.resources)
+        {
+            if (IsWriteAccess(usage.access) && resources[usage.resource].needed)
+            {
+                live = true;
+                break;
+            }
+        }
+
+        pass.culled = !live;
+        if (pass.culled)
+        {
+            statistics.culledPassCount++;
+            continue;
+        }
+
+        for (const VGPURenderGraphPassResource& usage : pass.resources)
+        {
+            resources[usage.resource].needed = true;
+        }
+    }
+}
+
+void RenderGraph::ScheduleAsyncCompute()
+{
+    // Submit does not order queues against each other, so only compute passes whose resources are transients
+    // touched by no other queue leave the graphics command buffer.
+    for (Pass& pass : passes)
+    {
+        pass.async = !pass.culled && pass.queue == VGPUCommandQueue_Compute;
+        for (const VGPURenderGraphPassResource& usage : pass.resources)
+        {
+            if (resources[usage.resource].imported)
+            {
+                pass.async = false;
+            }
+        }
+    }
+
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+
+        for (Resource& resource : resources)
+        {
+            resource.async = true;
+        }
+
+        for (const Pass& pass : passes)
+        {
+            if (pass.culled || pass.async)
+                continue;
+
+            for (const VGPURenderGraphPassResource& usage : pass.resources)
+            {
+                resources[usage.resource].async = false;
+            }
+        }
+
+        for (Pass& pass : passes)
+        {
+            if (!pass.async)
+                continue;
+
+            for (const VGPURenderGraphPassResource& usage : pass.resources)
+            {
+                if (!resources[usage.resource].async)
+                {
+                    pass.async = false;
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    for (uint32_t passIndex = 0; passIndex < passes.size(); ++passIndex)
+    {
+        const Pass& pass = passes[passIndex];
+        if (pass.culled)
+            continue;
+
+        if (pass.async)
+        {
+            statistics.asyncComputePassCount++;
+        }
+
+        for (const VGPURenderGraphPassResource& usage : pass.resources)
+        {
+            Resource& resource = resources[usage.resource];
+            resource.firstPass = _VGPU_MIN(resource.firstPass, passIndex);
+            resource.lastPass = _VGPU_MAX(resource.lastPass, passIndex);
+        }
+    }
+}
+
+bool RenderGraph::CreatePhysical(const Resource& resource, VGPUMemoryHeap heap, PhysicalObject& object)
+{
+    const char* label = resource.label.empty() ? nullptr : resource.label.c_str();
+    if (resource.isTexture)
+    {
+        VGPUTextureDesc desc = resource.textureDesc;
+        desc.label = label;
+        object.texture = heap ? device->CreatePlacedTexture(heap, resource.offset, &desc) : device->CreateTexture(&desc, nullptr);
+        return object.texture != nullptr;
+    }
+
+    VGPUBufferDesc desc = resource.bufferDesc;
+    desc.label = label;
+    object.buffer = heap ? device->CreatePlacedBuffer(heap, resource.offset, &desc) : device->CreateBuffer(&desc, nullptr);
+    return object.buffer != nullptr;
+}
+
+void RenderGraph::PlaceTransients(std::vector<Resource*>& group, std::vector<Resource*>& pooled)
+{
+    // Largest first, each resource goes to the lowest offset free of resources with overlapping lifetimes.
+    std::sort(group.begin(), group.end(), [](const Resource* lhs, const Resource* rhs) {
+        return lhs->requirements.size > rhs->requirements.size;
+    });
+
+    uint64_t heapSize = 0;
+    uint64_t heapAlignment = 1;
+    std::vector<std::pair<uint64_t, uint64_t>> occupied;
+    for (size_t i = 0; i < group.size(); ++i)
+    {
+        Resource* resource = group[i];
+        const uint64_t alignment = _VGPU_MAX(resource->requirements.alignment, (uint64_t)1u);
+
+        occupied.clear();
+        for (size_t j = 0; j < i; ++j)
+        {
+            const Resource* other = group[j];
+            if (other->firstPass <= resource->lastPass && resource->firstPass <= other->lastPass)
+            {
+                occupied.emplace_back(other->offset, other->offset + other->requirements.size);
+            }
+        }
+        std::sort(occupied.begin(), occupied.end());
+
+        uint64_t offset = 0;
+        for (const auto& range : occupied)
+        {
+            if (AlignUp(offset, alignment) + resource->requirements.size <= range.first)
+                break;
+
+            offset = _VGPU_MAX(offset, range.second);
+        }
+
+        resource->offset = AlignUp(offset, alignment);
+        heapSize = _VGPU_MAX(heapSize, resource->offset + resource->requirements.size);
+        heapAlignment = _VGPU_MAX(heapAlignment, alignment);
+    }
+
+    const uint32_t memoryTypeBits = group.front()->requirements.memoryTypeBits;
+    auto it = std::find_if(heaps.begin(), heaps.end(), [memoryTypeBits](const Heap& heap) { return heap.memoryTypeBits == memoryTypeBits; });
+    if (it == heaps.end())
+    {
+        it = heaps.emplace(heaps.end());
+        it->memoryTypeBits = memoryTypeBits;
+    }
+
+    // Heaps only grow, placed objects in a replaced heap are released with the other unused objects.
+    if (it->heap == nullptr || it->heap->GetSize() < heapSize || it->alignment < heapAlignment)
+    {
+        VGPUAllocationRequirements heapRequirements = {};
+        heapRequirements.size = it->heap ? _VGPU_MAX(heapSize, it->heap->GetSize()) : heapSize;
+        heapRequirements.alignment = _VGPU_MAX(heapAlignment, it->alignment);
+        heapRequirements.memoryTypeBits = memoryTypeBits;
+
+        if (it->heap)
+        {
+            it->heap->Release();
+        }
+        it->heap = device->CreateMemoryHeap(&heapRequirements, VGPUMemoryClass_Default);
+        it->alignment = heapRequirements.alignment;
+    }
+
+    if (it->heap == nullptr)
+    {
+        heaps.erase(it);
+        pooled.insert(pooled.end(), group.begin(), group.end());
+        return;
+    }
+
+    it->used = true;
+    statistics.transientMemorySize += it->heap->GetSize();
+
+    for (Resource* resource : group)
+    {
+        size_t key = resource->descHash;
+        hash_combine(key, resource->isTexture);
+        hash_combine(key, it->heap);
+        hash_combine(key, resource->offset);
+
+        auto object = std::find_if(placedObjects.begin(), placedObjects.end(), [key, resource, &it](const PhysicalObject& object) {
+            return object.key == key && object.heap == it->heap && object.offset == resource->offset && object.desc.Matches(*resource);
+        });
+        if (object == placedObjects.end())
+        {
+            PhysicalObject newObject(*resource);
+            newObject.key = key;
+            newObject.heap = it->heap;
+            newObject.offset = resource->offset;
+            newObject.size = resource->requirements.size;
+            if (!CreatePhysical(*resource, it->heap, newObject))
+            {
+                vgpuLogError("RenderGraph: Failed to place transient resource '%s'", resource->label.c_str());
+                continue;
+            }
+            object = placedObjects.insert(placedObjects.end(), newObject);
+        }
+
+        object->used = true;
+        resource->texture = object->texture;
+        resource->buffer = object->buffer;
+    }
+}
+
+void RenderGraph::PoolTransients(std::vector<Resource*>& pooled)
+{
+    std::sort(pooled.begin(), pooled.end(), [](const Resource* lhs, const Resource* rhs) {
+        return lhs->firstPass < rhs->firstPass;
+    });
+
+    for (Resource* resource : pooled)
+    {
+        size_t key = resource->descHash;
+        hash_combine(key, resource->isTexture);
+        hash_combine(key, resource->async);
+
+        auto object = std::find_if(pooledObjects.begin(), pooledObjects.end(), [key, resource](const PhysicalObject& object) {
+            return object.key == key
+                && object.async == resource->async
+                && object.desc.Matches(*resource)
+                && (!object.used || object.busyUntil < resource->firstPass);
+        });
+
+        if (object == pooledObjects.end())
+        {
+            PhysicalObject newObject(*resource);
+            newObject.key = key;
+            newObject.async = resource->async;
+            newObject.size = resource->requirements.size;
+            if (!CreatePhysical(*resource, nullptr, newObject))
+            {
+                vgpuLogError("RenderGraph: Failed to create transient resource '%s'", resource->label.c_str());
+                continue;
+            }
+            object = pooledObjects.insert(pooledObjects.end(), newObject);
+        }
+
+        if (!object->used)
+        {
+            statistics.transientMemorySize += object->size;
+        }
+
+        object->used = true;
+        object->busyUntil = resource->lastPass;
+        resource->texture = object->texture;
+        resource->buffer = object->buffer;
+    }
+}
+
+void RenderGraph::AllocateTransients()
+{
+    std::vector<Resource*> placeable;
+    std::vector<Resource*> pooled;
+
+    for (Resource& resource : resources)
+    {
+        if (resource.imported || resource.firstPass == kInvalidPass)
+            continue;
+
+        if (resource.isTexture)
+            statistics.transientTextureCount++;
+        else
+            statistics.transientBufferCount++;
+
+        size_t requirementsKey = resource.descHash;
+        hash_combine(requirementsKey, resource.isTexture);
+
+        auto cached = requirementsCache.find(requirementsKey);
+        if (cached != requirementsCache.end() && cached->second.desc.Matches(resource))
+        {
+            resource.requirements = cached->second.requirements;
+            resource.placeable = resource.requirements.memoryTypeBits != 0;
+        }
+        else
+        {
+            // Transient heaps are device local, host visible buffers are pooled.
+            resource.placeable = resource.isTexture
+                ? device->GetTextureAllocationRequirements(&resource.textureDesc, &resource.requirements)
+                : resource.bufferDesc.cpuAccess == VGPUCpuAccessMode_None && device->GetBufferAllocationRequirements(&resource.bufferDesc, &resource.requirements);
+
+            if (!resource.placeable)
+            {
+                resource.requirements = {};
+                resource.requirements.size = resource.isTexture ? EstimateTextureSize(resource.textureDesc) : resource.bufferDesc.size;
+            }
+            // On hash collision the requirements stay uncached.
+            if (cached == requirementsCache.end())
+            {
+                requirementsCache.emplace(requirementsKey, CachedRequirements{ TransientDesc(resource), resource.requirements });
+            }
+        }
+
+        statistics.unaliasedMemorySize += resource.requirements.size;
+
+        // Async compute transients are never aliased, the queues run unordered against each other.
+        if (resource.placeable && !resource.async)
+            placeable.push_back(&resource);
+        else
+            pooled.push_back(&resource);
+    }
+
+    std::sort(placeable.begin(), placeable.end(), [](const Resource* lhs, const Resource* rhs) {
+        return lhs->requirements.memoryTypeBits < rhs->requirements.memoryTypeBits;
+    });
+
+    std::vector<Resource*> group;
+    for (size_t i = 0; i < placeable.size(); ++i)
+    {
+        group.push_back(placeable[i]);
+        if (i + 1 == placeable.size() || placeable[i + 1]->requirements.memoryTypeBits != placeable[i]->requirements.memoryTypeBits)
+        {
+            PlaceTransients(group, pooled);
+            group.clear();
+        }
+    }
+
+    PoolTransients(pooled);
+}
+
+void RenderGraph::ReleaseUnused()
+{
+    const auto release = [](std::vector<PhysicalObject>& objects) {
+        for (auto it = objects.begin(); it != objects.end();)
+        {
+            if (it->used)
+            {
+                it->used = false;
+                ++it;
+                continue;
+            }
+
+            if (it->texture)
+                it->texture->Release();
+            if (it->buffer)
+                it->buffer->Release();
+            it = objects.erase(it);
+        }
+    };
+
+    release(placedObjects);
+    release(pooledObjects);
+
+    for (auto it = heaps.begin(); it != heaps.end();)
+    {
+        if (it->used)
+        {
+            it->used = false;
+            ++it;
+            continue;
+        }
+
+        if (it->heap)
+            it->heap->Release();
+        it = heaps.erase(it);
+    }
+}
+
+void RenderGraph::Clear()
+{
+    for (Resource& resource : resources)
+    {
+        if (!resource.imported)
+            continue;
+
+        if (resource.swapChain)
+            resource.swapChain->Release();
+        else if (resource.texture)
+            resource.texture->Release();
+        else if (resource.buffer)
+            resource.buffer->Release();
+    }
+
+    resources.clear();
+    passes.clear();
+}
+
+uint64_t RenderGraph::Execute()
+{
+    statistics = {};
+    statistics.passCount = (uint32_t)passes.size();
+
+    Cull();
+    ScheduleAsyncCompute();
+    AllocateTransients();
+
+    VGPUCommandBuffer graphicsCommandBuffer = device->BeginCommandBuffer(VGPUCommandQueue_Graphics, "RenderGraph");
+    VGPUCommandBuffer computeCommandBuffer = nullptr;
+    if (statistics.asyncComputePassCount > 0)
+    {
+        computeCommandBuffer = device->BeginCommandBuffer(VGPUCommandQueue_Compute, "RenderGraph Async Compute");
+    }
+
+    for (Resource& resource : resources)
+    {
+        if (resource.swapChain && resource.firstPass != kInvalidPass)
+        {
+            resource.texture = graphicsCommandBuffer->AcquireSwapchainTexture(resource.swapChain);
+        }
+    }
+
+    for (uint32_t passIndex = 0; passIndex < passes.size(); ++passIndex)
+    {
+        const Pass& pass = passes[passIndex];
+        if (pass.culled)
+            continue;
+
+        // Passes drawing to a swap chain that could not be acquired (minimized window) are skipped.
+        bool resourcesValid = true;
+        for (const VGPURenderGraphPassResource& usage : pass.resources)
+        {
+            const Resource& resource = resources[usage.resource];
+            if (resource.texture == nullptr && resource.buffer == nullptr)
+            {
+                resourcesValid = false;
+            }
+        }
+
+        if (!resourcesValid)
+            continue;
+
+        VGPUCommandBuffer commandBuffer = pass.async ? computeCommandBuffer : graphicsCommandBuffer;
+        for (const VGPURenderGraphPassResource& usage : pass.resources)
+        {
+            const Resource& resource = resources[usage.resource];
+            if (resource.imported || resource.firstPass != passIndex)
+                continue;
+
+            if (resource.isTexture)
+                commandBuffer->DiscardTexture(resource.texture);
+            else
+                commandBuffer->DiscardBuffer(resource.buffer);
+        }
+
+        commandBuffer->PushDebugGroup(pass.label.c_str());
+        for (const VGPURenderGraphPassResource& usage : pass.resources)
+        {
+            const Resource& resource = resources[usage.resource];
+            if (resource.isTexture)
+                commandBuffer->RequireTextureAccess(resource.texture, usage.access);
+            else
+                commandBuffer->RequireBufferAccess(resource.buffer, usage.access);
+        }
+
+        if (pass.callback)
+        {
+            pass.callback(this, commandBuffer, pass.userData);
+        }
+        commandBuffer->PopDebugGroup();
+
+        // Dead transients skip their resting layout transition, their memory may be reused by the next pass.
+        for (const VGPURenderGraphPassResource& usage : pass.resources)
+        {
+            const Resource& resource = resources[usage.resource];
+            if (resource.imported || resource.lastPass != passIndex)
+                continue;
+
+            if (resource.isTexture)
+                commandBuffer->DiscardTexture(resource.texture);
+            else
+                commandBuffer->DiscardBuffer(resource.buffer);
+        }
+    }
+
+    VGPUCommandBuffer commandBuffers[2] = { graphicsCommandBuffer, computeCommandBuffer };
+    const uint64_t value = device->Submit(commandBuffers, computeCommandBuffer ? 2u : 1u);
+
+    ReleaseUnused();
+    Clear();
+    return value;
+}
+
+VGPURenderGraphImpl* CreateRenderGraph(VGPUDeviceImpl* device)
+{
+    return new RenderGraph(device);
+}
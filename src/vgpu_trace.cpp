@@ -0,0 +1,168 @@
+// Copyright (c) Amer Koleci and Contributors.
+// Licensed under the MIT License (MIT). See LICENSE in the repository root for more information.
+
+#include "vgpu_driver.h"
+#include <stdio.h>
+#include <string>
+
+namespace
+{
+    // Chrome trace processes, CPU threads and GPU queues get separate groups of tracks.
+    constexpr uint32_t kCpuProcess = 1u;
+    constexpr uint32_t kGpuProcess = 2u;
+
+    const char* ToString(VGPUCommandQueue queue)
+    {
+        switch (queue)
+        {
+            case VGPUCommandQueue_Compute:  return "Compute Queue";
+            case VGPUCommandQueue_Copy:     return "Copy Queue";
+            default:                        return "Graphics Queue";
+        }
+    }
+
+    void WriteEscaped(FILE* file, const char* text)
+    {
+        for (const char* c = text; *c != '\0'; ++c)
+        {
+            if (*c == '"' || *c == '\\')
+                fprintf(file, "\\%c", *c);
+            else if ((unsigned char)*c < 0x20)
+                fprintf(file, "\\u%04x", (unsigned)*c);
+            else
+                fputc(*c, file);
+        }
+    }
+}
+
+/// Spans are kept in memory and written in one go, the JSON loads in chrome://tracing and ui.perfetto.dev.
+class TraceRecorder final : public VGPUTraceRecorder
+{
+public:
+    TraceRecorder(FILE* file_)
+        : file(file_)
+        , origin(Now())
+    {
+    }
+
+    ~TraceRecorder() override
+    {
+        if (file)
+            fclose(file);
+    }
+
+    void AddCpuSpan(const char* name, uint64_t begin, uint64_t end) override;
+    void AddGpuSpan(VGPUCommandQueue queue, const char* label, uint64_t begin, uint64_t end) override;
+    bool Write() override;
+
+private:
+    struct CpuSpan
+    {
+        const char* name;
+        uint32_t thread;
+        uint64_t begin;
+        uint64_t end;
+    };
+
+    struct GpuSpan
+    {
+        std::string label;
+        VGPUCommandQueue queue;
+        uint64_t begin;
+        uint64_t end;
+    };
+
+    void WriteEvent(const char* name, uint32_t process, uint32_t thread, uint64_t begin, uint64_t end);
+
+    FILE* file;
+    uint64_t origin;
+
+    std::mutex mutex;
+    std::vector<std::thread::id> threads;
+    std::vector<CpuSpan> cpuSpans;
+    std::vector<GpuSpan> gpuSpans;
+};
+
+void TraceRecorder::AddCpuSpan(const char* name, uint64_t begin, uint64_t end)
+{
+    const std::thread::id threadId = std::this_thread::get_id();
+
+    std::scoped_lock lock(mutex);
+    uint32_t thread = 0;
+    while (thread < threads.size() && threads[thread] != threadId)
+        thread++;
+
+    if (thread == threads.size())
+        threads.push_back(threadId);
+
+    cpuSpans.push_back({ name, thread, begin, end });
+}
+
+void TraceRecorder::AddGpuSpan(VGPUCommandQueue queue, const char* label, uint64_t begin, uint64_t end)
+{
+    std::scoped_lock lock(mutex);
+    gpuSpans.push_back({ label, queue, begin, end });
+}
+
+void TraceRecorder::WriteEvent(const char* name, uint32_t process, uint32_t thread, uint64_t begin, uint64_t end)
+{
+    fprintf(file, ",\n{\"name\":\"");
+    WriteEscaped(file, name);
+    // Chrome trace times are microseconds.
+    fprintf(file, "\",\"ph\":\"X\",\"pid\":%u,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+        process, thread, double(begin - origin) / 1000.0, double(end - begin) / 1000.0);
+}
+
+bool TraceRecorder::Write()
+{
+    std::scoped_lock lock(mutex);
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    fprintf(file, "\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"args\":{\"name\":\"CPU\"}}", kCpuProcess);
+    fprintf(file, ",\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"args\":{\"name\":\"GPU\"}}", kGpuProcess);
+
+    for (uint32_t thread = 0; thread < threads.size(); ++thread)
+    {
+        fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"Thread %u\"}}", kCpuProcess, thread, thread);
+    }
+
+    for (uint32_t queue = 0; queue < _VGPUCommandQueue_Count; ++queue)
+    {
+        fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"%s\"}}", kGpuProcess, queue, ToString((VGPUCommandQueue)queue));
+    }
+
+    // Spans recorded before tracing began (GPU work of frames already in flight) are dropped.
+    for (const CpuSpan& span : cpuSpans)
+    {
+        if (span.begin >= origin)
+            WriteEvent(span.name, kCpuProcess, span.thread, span.begin, span.end);
+    }
+
+    for (const GpuSpan& span : gpuSpans)
+    {
+        if (span.begin >= origin && span.end >= span.begin)
+            WriteEvent(span.label.c_str(), kGpuProcess, (uint32_t)span.queue, span.begin, span.end);
+    }
+
+    fprintf(file, "\n]}\n");
+    const bool written = ferror(file) == 0;
+    fclose(file);
+    file = nullptr;
+
+    if (!written)
+        vgpuLogError("Failed to write trace file");
+
+    return written;
+}
+
+VGPUTraceRecorder* CreateTraceRecorder(const char* path)
+{
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr)
+    {
+        vgpuLogError("Failed to create trace file '%s'", path);
+        return nullptr;
+    }
+
+    return new TraceRecorder(file);
+}
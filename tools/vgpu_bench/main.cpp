@@ -0,0 +1,676 @@
+// Copyright © Amer Koleci and Contributors.
+// Distributed under the MIT license. See the LICENSE file in the project root for more information.
+
+// Headless CPU overhead benchmarks, no window or swapchain is created so it runs on any Vulkan ICD including
+// lavapipe and SwiftShader (select one with VK_DRIVER_FILES). Results are written as JSON and can be compared
+// against a previous run:
+//
+//   vgpu_bench [--output results.json] [--baseline baseline.json] [--threshold 10] [--filter draw] [--repeat 5] [--quick]
+//
+// --backend null runs against the Null backend and measures vgpu's own overhead without any driver work.
+// --deferred records through vgpuDeviceSetDeferredRecording, translation then counts towards the submit.
+//
+// With --baseline the exit code is non zero when any metric regressed by more than threshold percent.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+#include <vgpu.h>
+
+constexpr uint32_t kRenderTargetSize = 64u;
+constexpr uint32_t kBindGroupCount = 64u;
+constexpr uint32_t kBindGroupDraws = 100000u;
+constexpr uint32_t kCreateBufferCount = 1024u;
+constexpr uint32_t kCreateTextureCount = 256u;
+constexpr uint32_t kUploadBufferCount = 256u;
+constexpr uint64_t kUploadBufferSize = 256u * 1024u;
+constexpr uint32_t kPipelineCount = 64u;
+constexpr uint32_t kSubmitCount = 256u;
+
+struct Options
+{
+    const char* output = nullptr;
+    const char* baseline = nullptr;
+    const char* filter = nullptr;
+    VGPUBackend backend = VGPUBackend_Vulkan;
+    std::string assets = "assets/shaders/";
+    double threshold = 10.0;
+    uint32_t repeat = 5u;
+    bool quick = false;
+    bool deferred = false;
+};
+
+struct Result
+{
+    std::string name;
+    const char* unit;
+    double value;
+    bool lowerIsBetter;
+};
+
+Options options;
+std::vector<Result> results;
+
+VGPUDevice device = nullptr;
+VGPUTexture colorTexture = nullptr;
+VGPUBuffer vertexBuffer = nullptr;
+VGPUBindGroupLayout bindGroupLayout = nullptr;
+VGPUPipelineLayout pipelineLayout = nullptr;
+VGPUPipeline renderPipeline = nullptr;
+std::vector<uint8_t> vertexBytecode;
+std::vector<uint8_t> fragmentBytecode;
+
+using Clock = std::chrono::steady_clock;
+
+static double seconds_since(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Median of options.repeat runs after one warm up run, run returns the metric of one repetition.
+template <typename Run>
+static double measure(Run run)
+{
+    run();
+
+    std::vector<double> samples(options.repeat);
+    for (double& sample : samples)
+    {
+        sample = run();
+    }
+
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+static void add_result(const std::string& name, const char* unit, double value, bool lowerIsBetter = true)
+{
+    results.push_back({ name, unit, value, lowerIsBetter });
+    printf("%-32s %14.3f %s\n", name.c_str(), value, unit);
+}
+
+static std::vector<uint8_t> load_shader(const char* fileName)
+{
+    std::string shaderExt = ".spv";
+    if (vgpuDeviceGetBackend(device) == VGPUBackend_D3D12)
+    {
+        shaderExt = ".cso";
+    }
+
+    std::ifstream is(options.assets + fileName + shaderExt, std::ios::binary | std::ios::in | std::ios::ate);
+    if (!is.is_open())
+    {
+        std::cerr << "Warning: Could not open shader file \"" << fileName << "\", draw and pipeline scenarios are skipped\n";
+        return {};
+    }
+
+    size_t size = is.tellg();
+    is.seekg(0, std::ios::beg);
+
+    std::vector<uint8_t> bytecode(size);
+    is.read((char*)bytecode.data(), size);
+    return bytecode;
+}
+
+static VGPUPipeline create_pipeline(VGPUColorWriteMask writeMask, VGPUCullMode cullMode, VGPUFrontFace frontFace)
+{
+    VGPUShaderStageDesc shaderStages[2] = {};
+    shaderStages[0].stage = VGPUShaderStage_Vertex;
+    shaderStages[0].bytecode = vertexBytecode.data();
+    shaderStages[0].size = vertexBytecode.size();
+    shaderStages[0].entryPointName = "vertexMain";
+
+    shaderStages[1].stage = VGPUShaderStage_Fragment;
+    shaderStages[1].bytecode = fragmentBytecode.data();
+    shaderStages[1].size = fragmentBytecode.size();
+    shaderStages[1].entryPointName = "fragmentMain";
+
+    VGPUVertexAttribute vertexAttributes[2] = {};
+    vertexAttributes[0].format = VGPUVertexFormat_Float3;
+    vertexAttributes[0].offset = 0;
+    vertexAttributes[0].shaderLocation = 0;
+    vertexAttributes[1].format = VGPUVertexFormat_Float4;
+    vertexAttributes[1].offset = 12;
+    vertexAttributes[1].shaderLocation = 1;
+
+    VGPUVertexBufferLayout vertexBufferLayout{};
+    vertexBufferLayout.stride = 28;
+    vertexBufferLayout.attributeCount = 2;
+    vertexBufferLayout.attributes = vertexAttributes;
+
+    VGPUTextureFormat colorFormat = VGPUTextureFormat_RGBA8Unorm;
+
+    VGPURenderPipelineDesc renderPipelineDesc{};
+    renderPipelineDesc.label = "Bench";
+    renderPipelineDesc.layout = pipelineLayout;
+    renderPipelineDesc.shaderStageCount = 2u;
+    renderPipelineDesc.shaderStages = shaderStages;
+    renderPipelineDesc.vertex.layoutCount = 1u;
+    renderPipelineDesc.vertex.layouts = &vertexBufferLayout;
+    renderPipelineDesc.colorFormatCount = 1u;
+    renderPipelineDesc.colorFormats = &colorFormat;
+    renderPipelineDesc.blendState.renderTargets[0].colorWriteMask = writeMask;
+    renderPipelineDesc.rasterizerState.cullMode = cullMode;
+    renderPipelineDesc.rasterizerState.frontFace = frontFace;
+    return vgpuCreateRenderPipeline(device, &renderPipelineDesc);
+}
+
+static VGPUBindGroup create_bind_group(VGPUBuffer constantBuffer)
+{
+    VGPUBindGroupEntry bindGroupEntry{};
+    bindGroupEntry.binding = 0;
+    bindGroupEntry.buffer = constantBuffer;
+    bindGroupEntry.size = VGPU_WHOLE_SIZE;
+
+    VGPUBindGroupDesc bindGroupDesc{};
+    bindGroupDesc.entryCount = 1;
+    bindGroupDesc.entries = &bindGroupEntry;
+    return vgpuCreateBindGroup(device, bindGroupLayout, &bindGroupDesc);
+}
+
+static bool init_vgpu()
+{
+    VGPUDeviceDesc deviceDesc{};
+    deviceDesc.label = "vgpu_bench";
+    deviceDesc.validationMode = VGPUValidationMode_Disabled;
+    if (vgpuIsBackendSupported(options.backend))
+    {
+        deviceDesc.preferredBackend = options.backend;
+    }
+
+    device = vgpuCreateDevice(&deviceDesc);
+    if (device == nullptr)
+        return false;
+
+    vgpuDeviceSetDeferredRecording(device, options.deferred);
+
+    VGPUTextureDesc textureDesc = {};
+    textureDesc.label = "Color Target";
+    textureDesc.dimension = VGPUTextureDimension_2D;
+    textureDesc.width = kRenderTargetSize;
+    textureDesc.height = kRenderTargetSize;
+    textureDesc.depthOrArrayLayers = 1u;
+    textureDesc.format = VGPUTextureFormat_RGBA8Unorm;
+    textureDesc.usage = VGPUTextureUsage_RenderTarget;
+    textureDesc.mipLevelCount = 1u;
+    textureDesc.sampleCount = 1u;
+    colorTexture = vgpuCreateTexture(device, &textureDesc, nullptr);
+
+    // Small triangle keeps rasterization cost negligible on software ICDs.
+    const float vertices[] = {
+        /* positions            colors */
+         0.0f,  0.05f, 0.5f,    1.0f, 0.0f, 0.0f, 1.0f,
+         0.05f, -0.05f, 0.5f,   0.0f, 1.0f, 0.0f, 1.0f,
+        -0.05f, -0.05f, 0.5f,   0.0f, 0.0f, 1.0f, 1.0f,
+    };
+
+    VGPUBufferDesc vertexBufferDesc{};
+    vertexBufferDesc.label = "Vertex Buffer";
+    vertexBufferDesc.size = sizeof(vertices);
+    vertexBufferDesc.usage = VGPUBufferUsage_Vertex;
+    vertexBuffer = vgpuCreateBuffer(device, &vertexBufferDesc, vertices);
+
+    VGPUBindGroupLayoutEntry bindGroupLayoutEntry{};
+    bindGroupLayoutEntry.binding = 0;
+    bindGroupLayoutEntry.count = 1;
+    bindGroupLayoutEntry.visibility = VGPUShaderStage_Fragment;
+    bindGroupLayoutEntry.descriptorType = VGPUDescriptorType_ConstantBuffer;
+
+    VGPUBindGroupLayoutDesc bindGroupLayoutDesc{};
+    bindGroupLayoutDesc.entryCount = 1;
+    bindGroupLayoutDesc.entries = &bindGroupLayoutEntry;
+    bindGroupLayout = vgpuCreateBindGroupLayout(device, &bindGroupLayoutDesc);
+
+    VGPUPipelineLayoutDesc pipelineLayoutDesc{};
+    pipelineLayoutDesc.bindGroupLayoutCount = 1;
+    pipelineLayoutDesc.bindGroupLayouts = &bindGroupLayout;
+    pipelineLayout = vgpuCreatePipelineLayout(device, &pipelineLayoutDesc);
+
+    vertexBytecode = load_shader("triangleVertex");
+    fragmentBytecode = load_shader("triangleFragment");
+    if (!vertexBytecode.empty() && !fragmentBytecode.empty())
+    {
+        renderPipeline = create_pipeline(VGPUColorWriteMask_All, VGPUCullMode_None, VGPUFrontFace_Clockwise);
+    }
+
+    return colorTexture != nullptr && vertexBuffer != nullptr && pipelineLayout != nullptr;
+}
+
+static void begin_render_pass(VGPUCommandBuffer commandBuffer)
+{
+    VGPURenderPassColorAttachment colorAttachment = {};
+    colorAttachment.texture = colorTexture;
+    colorAttachment.loadAction = VGPULoadAction_Clear;
+    colorAttachment.storeAction = VGPUStoreAction_Store;
+
+    VGPURenderPassDesc renderPass{};
+    renderPass.colorAttachmentCount = 1u;
+    renderPass.colorAttachments = &colorAttachment;
+    vgpuBeginRenderPass(commandBuffer, &renderPass);
+    vgpuSetPipeline(commandBuffer, renderPipeline);
+    vgpuSetVertexBuffer(commandBuffer, 0, vertexBuffer, 0);
+}
+
+// CPU time to record and submit drawCount draws with no state changes in between.
+static void bench_draw_overhead(VGPUBindGroup bindGroup)
+{
+    const uint32_t drawCounts[] = { 10000u, 100000u, 1000000u };
+    for (uint32_t drawCount : drawCounts)
+    {
+        if (options.quick && drawCount > 100000u)
+            continue;
+
+        const double value = measure([&]() {
+            const Clock::time_point start = Clock::now();
+            VGPUCommandBuffer commandBuffer = vgpuBeginCommandBuffer(device, VGPUCommandQueue_Graphics, nullptr);
+            begin_render_pass(commandBuffer);
+            vgpuSetBindGroup(commandBuffer, 0, bindGroup);
+            for (uint32_t i = 0; i < drawCount; ++i)
+            {
+                vgpuDraw(commandBuffer, 0, 3, 1, 0);
+            }
+            vgpuEndRenderPass(commandBuffer);
+            vgpuDeviceSubmit(device, &commandBuffer, 1u);
+            const double seconds = seconds_since(start);
+
+            vgpuDeviceWaitIdle(device);
+            return seconds * 1e9 / drawCount;
+        });
+
+        add_result("draw_overhead_" + std::to_string(drawCount / 1000u) + "k", "ns/draw", value);
+    }
+}
+
+// A different bind group before every draw.
+static void bench_bind_group_churn(const std::vector<VGPUBindGroup>& bindGroups)
+{
+    const uint32_t drawCount = options.quick ? kBindGroupDraws / 10u : kBindGroupDraws;
+    const double value = measure([&]() {
+        const Clock::time_point start = Clock::now();
+        VGPUCommandBuffer commandBuffer = vgpuBeginCommandBuffer(device, VGPUCommandQueue_Graphics, nullptr);
+        begin_render_pass(commandBuffer);
+        for (uint32_t i = 0; i < drawCount; ++i)
+        {
+            vgpuSetBindGroup(commandBuffer, 0, bindGroups[i % bindGroups.size()]);
+            vgpuDraw(commandBuffer, 0, 3, 1, 0);
+        }
+        vgpuEndRenderPass(commandBuffer);
+        vgpuDeviceSubmit(device, &commandBuffer, 1u);
+        const double seconds = seconds_since(start);
+
+        vgpuDeviceWaitIdle(device);
+        return seconds * 1e9 / drawCount;
+    });
+
+    add_result("bind_group_churn", "ns/draw", value);
+}
+
+static void bench_buffer_creation()
+{
+    std::vector<VGPUBuffer> buffers(kCreateBufferCount);
+
+    VGPUBufferDesc bufferDesc{};
+    bufferDesc.size = 64u * 1024u;
+    bufferDesc.usage = VGPUBufferUsage_Vertex | VGPUBufferUsage_ShaderRead;
+
+    const double value = measure([&]() {
+        const Clock::time_point start = Clock::now();
+        for (VGPUBuffer& buffer : buffers)
+        {
+            buffer = vgpuCreateBuffer(device, &bufferDesc, nullptr);
+        }
+        const double seconds = seconds_since(start);
+
+        for (VGPUBuffer buffer : buffers)
+        {
+            vgpuBufferRelease(buffer);
+        }
+        return seconds * 1e6 / kCreateBufferCount;
+    });
+
+    add_result("buffer_creation", "us/buffer", value);
+}
+
+static void bench_texture_creation()
+{
+    std::vector<VGPUTexture> textures(kCreateTextureCount);
+
+    VGPUTextureDesc textureDesc = {};
+    textureDesc.dimension = VGPUTextureDimension_2D;
+    textureDesc.width = 256u;
+    textureDesc.height = 256u;
+    textureDesc.depthOrArrayLayers = 1u;
+    textureDesc.format = VGPUTextureFormat_RGBA8Unorm;
+    textureDesc.usage = VGPUTextureUsage_ShaderRead;
+    textureDesc.mipLevelCount = 1u;
+    textureDesc.sampleCount = 1u;
+
+    const double value = measure([&]() {
+        const Clock::time_point start = Clock::now();
+        for (VGPUTexture& texture : textures)
+        {
+            texture = vgpuCreateTexture(device, &textureDesc, nullptr);
+        }
+        const double seconds = seconds_since(start);
+
+        for (VGPUTexture texture : textures)
+        {
+            vgpuTextureRelease(texture);
+        }
+        return seconds * 1e6 / kCreateTextureCount;
+    });
+
+    add_result("texture_creation", "us/texture", value);
+}
+
+// Buffers with initial data, flushed once and waited for.
+static void bench_upload_throughput()
+{
+    std::vector<uint8_t> data(kUploadBufferSize);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = uint8_t(i);
+    }
+
+    std::vector<VGPUBuffer> buffers(kUploadBufferCount);
+
+    VGPUBufferDesc bufferDesc{};
+    bufferDesc.size = kUploadBufferSize;
+    bufferDesc.usage = VGPUBufferUsage_Vertex;
+
+    const double value = measure([&]() {
+        const Clock::time_point start = Clock::now();
+        for (VGPUBuffer& buffer : buffers)
+        {
+            buffer = vgpuCreateBuffer(device, &bufferDesc, data.data());
+        }
+        vgpuDeviceWaitUploads(device, vgpuDeviceFlushUploads(device), UINT64_MAX);
+        const double seconds = seconds_since(start);
+
+        for (VGPUBuffer buffer : buffers)
+        {
+            vgpuBufferRelease(buffer);
+        }
+        return double(kUploadBufferSize) * kUploadBufferCount / (1024.0 * 1024.0) / seconds;
+    });
+
+    add_result("upload_throughput", "MB/s", value, false);
+}
+
+// Every pipeline differs in fixed function state so none is served from a cache; only one cold pass is timed.
+static void bench_pipeline_creation()
+{
+    const VGPUCullMode cullModes[] = { VGPUCullMode_Back, VGPUCullMode_Front, VGPUCullMode_None };
+    const VGPUFrontFace frontFaces[] = { VGPUFrontFace_Clockwise, VGPUFrontFace_CounterClockwise };
+
+    std::vector<VGPUPipeline> pipelines;
+    pipelines.reserve(kPipelineCount);
+
+    const Clock::time_point start = Clock::now();
+    for (uint32_t i = 0; i < kPipelineCount; ++i)
+    {
+        const VGPUColorWriteMask writeMask = (VGPUColorWriteMask)(1u + i % 15u);
+        const VGPUCullMode cullMode = cullModes[(i / 15u) % 3u];
+        const VGPUFrontFace frontFace = frontFaces[i / 45u];
+        pipelines.push_back(create_pipeline(writeMask, cullMode, frontFace));
+    }
+    const double seconds = seconds_since(start);
+
+    for (VGPUPipeline pipeline : pipelines)
+    {
+        if (pipeline)
+            vgpuPipelineRelease(pipeline);
+    }
+
+    add_result("pipeline_creation", "ms/pipeline", seconds * 1e3 / kPipelineCount);
+}
+
+// Round trip of an empty command buffer, from begin to the CPU seeing its completion.
+static void bench_submit_latency()
+{
+    const double value = measure([&]() {
+        const Clock::time_point start = Clock::now();
+        for (uint32_t i = 0; i < kSubmitCount; ++i)
+        {
+            VGPUCommandBuffer commandBuffer = vgpuBeginCommandBuffer(device, VGPUCommandQueue_Graphics, nullptr);
+            const uint64_t submitted = vgpuDeviceSubmit(device, &commandBuffer, 1u);
+            vgpuDeviceWaitValue(device, VGPUCommandQueue_Graphics, submitted, UINT64_MAX);
+        }
+        return seconds_since(start) * 1e6 / kSubmitCount;
+    });
+
+    add_result("submit_latency", "us/submit", value);
+}
+
+static bool is_selected(const char* scenario)
+{
+    return options.filter == nullptr || strstr(scenario, options.filter) != nullptr;
+}
+
+static void write_escaped(FILE* file, const char* text)
+{
+    for (const char* c = text; *c != '\0'; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+            fputc('\\', file);
+        fputc(*c, file);
+    }
+}
+
+static const char* backend_name(VGPUBackend backend)
+{
+    switch (backend)
+    {
+        case VGPUBackend_D3D12: return "D3D12";
+        case VGPUBackend_WGPU:  return "WGPU";
+        case VGPUBackend_Null:  return "Null";
+        default:                return "Vulkan";
+    }
+}
+
+// One result per line, read_baseline relies on it.
+static bool write_results(const char* path)
+{
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr)
+    {
+        std::cerr << "Error: Could not create \"" << path << "\"\n";
+        return false;
+    }
+
+    VGPUAdapterProperties adapterProperties{};
+    vgpuDeviceGetAdapterProperties(device, &adapterProperties);
+
+    fprintf(file, "{\n  \"backend\": \"%s\",\n  \"adapter\": \"", backend_name(vgpuDeviceGetBackend(device)));
+    write_escaped(file, adapterProperties.name);
+    fprintf(file, "\",\n  \"deferred\": %s,\n  \"repeat\": %u,\n  \"quick\": %s,\n  \"results\": [\n",
+        options.deferred ? "true" : "false", options.repeat, options.quick ? "true" : "false");
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const Result& result = results[i];
+        fprintf(file, "    { \"name\": \"%s\", \"unit\": \"%s\", \"value\": %.6f, \"lowerIsBetter\": %s }%s\n",
+            result.name.c_str(), result.unit, result.value, result.lowerIsBetter ? "true" : "false",
+            i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+    return true;
+}
+
+static bool read_baseline(const char* path, std::vector<Result>& baseline)
+{
+    std::ifstream is(path);
+    if (!is.is_open())
+    {
+        std::cerr << "Error: Could not open baseline \"" << path << "\"\n";
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(is, line))
+    {
+        const size_t name = line.find("\"name\": \"");
+        const size_t value = line.find("\"value\": ");
+        if (name == std::string::npos || value == std::string::npos)
+            continue;
+
+        const size_t nameBegin = name + strlen("\"name\": \"");
+        Result result{};
+        result.name = line.substr(nameBegin, line.find('"', nameBegin) - nameBegin);
+        result.value = atof(line.c_str() + value + strlen("\"value\": "));
+        result.lowerIsBetter = line.find("\"lowerIsBetter\": false") == std::string::npos;
+        baseline.push_back(result);
+    }
+
+    return true;
+}
+
+// Returns the number of metrics worse than the baseline by more than the threshold.
+static uint32_t compare_results(const std::vector<Result>& baseline)
+{
+    uint32_t regressions = 0;
+    printf("\n%-32s %14s %14s %9s\n", "scenario", "baseline", "current", "change");
+    for (const Result& result : results)
+    {
+        auto it = std::find_if(baseline.begin(), baseline.end(), [&](const Result& other) { return other.name == result.name; });
+        if (it == baseline.end() || it->value <= 0.0)
+        {
+            printf("%-32s %14s %14.3f %9s\n", result.name.c_str(), "-", result.value, "new");
+            continue;
+        }
+
+        // Positive change is always worse.
+        const double change = (result.lowerIsBetter ? result.value / it->value : it->value / result.value) * 100.0 - 100.0;
+        const bool regressed = change > options.threshold;
+        printf("%-32s %14.3f %14.3f %+8.1f%%%s\n", result.name.c_str(), it->value, result.value, change, regressed ? "  REGRESSION" : "");
+        if (regressed)
+            regressions++;
+    }
+
+    return regressions;
+}
+
+static bool parse_options(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--output") == 0 && hasValue)
+            options.output = argv[++i];
+        else if (strcmp(argv[i], "--baseline") == 0 && hasValue)
+            options.baseline = argv[++i];
+        else if (strcmp(argv[i], "--threshold") == 0 && hasValue)
+            options.threshold = atof(argv[++i]);
+        else if (strcmp(argv[i], "--filter") == 0 && hasValue)
+            options.filter = argv[++i];
+        else if (strcmp(argv[i], "--repeat") == 0 && hasValue)
+            options.repeat = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--assets") == 0 && hasValue)
+            options.assets = std::string(argv[++i]) + "/";
+        else if (strcmp(argv[i], "--quick") == 0)
+            options.quick = true;
+        else if (strcmp(argv[i], "--deferred") == 0)
+            options.deferred = true;
+        else if (strcmp(argv[i], "--backend") == 0 && hasValue)
+        {
+            ++i;
+            if (strcmp(argv[i], "vulkan") == 0)
+                options.backend = VGPUBackend_Vulkan;
+            else if (strcmp(argv[i], "d3d12") == 0)
+                options.backend = VGPUBackend_D3D12;
+            else if (strcmp(argv[i], "null") == 0)
+                options.backend = VGPUBackend_Null;
+            else
+            {
+                std::cerr << "Unknown backend \"" << argv[i] << "\"\n";
+                return false;
+            }
+        }
+        else
+        {
+            std::cerr << "Usage: vgpu_bench [--output file] [--baseline file] [--threshold percent] [--filter name] [--repeat count] [--assets dir] [--backend vulkan|d3d12|null] [--deferred] [--quick]\n";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (!parse_options(argc, argv))
+        return EXIT_FAILURE;
+
+    vgpuSetLogLevel(VGPULogLevel_Warn);
+
+    if (!init_vgpu())
+    {
+        std::cerr << "Error: Failed to initialize device\n";
+        return EXIT_FAILURE;
+    }
+
+    std::vector<VGPUBuffer> constantBuffers(kBindGroupCount);
+    std::vector<VGPUBindGroup> bindGroups(kBindGroupCount);
+    for (uint32_t i = 0; i < kBindGroupCount; ++i)
+    {
+        const float color[4] = { float(i) / kBindGroupCount, 1.0f, 1.0f, 1.0f };
+        VGPUBufferDesc constantBufferDesc{};
+        constantBufferDesc.size = sizeof(color);
+        constantBufferDesc.usage = VGPUBufferUsage_Constant;
+        constantBuffers[i] = vgpuCreateBuffer(device, &constantBufferDesc, color);
+        bindGroups[i] = create_bind_group(constantBuffers[i]);
+    }
+    vgpuDeviceWaitUploads(device, vgpuDeviceFlushUploads(device), UINT64_MAX);
+
+    if (renderPipeline != nullptr)
+    {
+        if (is_selected("draw_overhead"))
+            bench_draw_overhead(bindGroups[0]);
+        if (is_selected("bind_group_churn"))
+            bench_bind_group_churn(bindGroups);
+        if (is_selected("pipeline_creation"))
+            bench_pipeline_creation();
+    }
+
+    if (is_selected("buffer_creation"))
+        bench_buffer_creation();
+    if (is_selected("texture_creation"))
+        bench_texture_creation();
+    if (is_selected("upload_throughput"))
+        bench_upload_throughput();
+    if (is_selected("submit_latency"))
+        bench_submit_latency();
+
+    int exitCode = EXIT_SUCCESS;
+    if (options.output != nullptr && !write_results(options.output))
+        exitCode = EXIT_FAILURE;
+
+    if (options.baseline != nullptr)
+    {
+        std::vector<Result> baseline;
+        if (!read_baseline(options.baseline, baseline) || compare_results(baseline) > 0)
+            exitCode = EXIT_FAILURE;
+    }
+
+    vgpuDeviceWaitIdle(device);
+    for (uint32_t i = 0; i < kBindGroupCount; ++i)
+    {
+        vgpuBindGroupRelease(bindGroups[i]);
+        vgpuBufferRelease(constantBuffers[i]);
+    }
+    if (renderPipeline != nullptr)
+        vgpuPipelineRelease(renderPipeline);
+    vgpuPipelineLayoutRelease(pipelineLayout);
+    vgpuBindGroupLayoutRelease(bindGroupLayout);
+    vgpuBufferRelease(vertexBuffer);
+    vgpuTextureRelease(colorTexture);
+    vgpuDeviceRelease(device);
+    return exitCode;
+}
@@ -0,0 +1,925 @@
+// Copyright © Amer Koleci and Contributors.
+// Distributed under the MIT license. See the LICENSE file in the project root for more information.
+
+// Replays a stream written between vgpuDeviceBeginCapture and vgpuDeviceEndCapture on any backend, without a window:
+//
+//   vgpu_replay capture.vgpucap [--backend vulkan|d3d12|null] [--loops 10]
+//
+// The first loop creates the objects in stream order, later loops only replay buffer writes and submits against the
+// same objects, so frame timings of driver, allocator or backend changes can be compared on the same workload.
+// Swapchains are replayed as offscreen textures and commands that use objects created before the capture are skipped.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+#include "vgpu_capture.h"
+
+struct Options
+{
+    const char* path = nullptr;
+    VGPUBackend backend = VGPUBackend_Vulkan;
+    uint32_t loops = 1u;
+};
+
+struct Packet
+{
+    VGPUCaptureOp op;
+    const uint8_t* data;
+    uint32_t size;
+};
+
+struct Object
+{
+    VGPUCaptureOp type;
+    void* handle;
+    // Acquired swapchain textures share the handle of their swapchain texture.
+    bool alias;
+};
+
+Options options;
+
+VGPUDevice device = nullptr;
+std::vector<uint8_t> stream;
+std::vector<Packet> packets;
+std::vector<Object> objects;
+// Allocations of the command buffer being replayed, referenced with VGPU_CAPTURE_ALLOCATION_BIT.
+std::vector<VGPUBufferAllocation> allocations;
+
+// Set when a command references an object the replay does not have.
+bool missing = false;
+uint64_t skippedCommands = 0;
+uint32_t failedObjects = 0;
+
+using Clock = std::chrono::steady_clock;
+
+static double milliseconds_since(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static bool load_capture(const char* path)
+{
+    std::ifstream is(path, std::ios::binary | std::ios::in | std::ios::ate);
+    if (!is.is_open())
+    {
+        std::cerr << "Error: Could not open capture \"" << path << "\"\n";
+        return false;
+    }
+
+    stream.resize((size_t)is.tellg());
+    is.seekg(0, std::ios::beg);
+    is.read((char*)stream.data(), stream.size());
+
+    VGPUCaptureReader reader(stream.data(), stream.size());
+    const VGPUCaptureHeader header = reader.Read<VGPUCaptureHeader>();
+    if (reader.HasError() || header.magic != VGPU_CAPTURE_MAGIC)
+    {
+        std::cerr << "Error: \"" << path << "\" is not a vgpu capture\n";
+        return false;
+    }
+
+    if (header.version != VGPU_CAPTURE_VERSION)
+    {
+        std::cerr << "Error: Capture version " << header.version << " does not match replay version " << VGPU_CAPTURE_VERSION << "\n";
+        return false;
+    }
+
+    while (!reader.IsEnd())
+    {
+        const VGPUCaptureOp op = reader.Read<VGPUCaptureOp>();
+        const uint32_t size = reader.Read<uint32_t>();
+        const uint8_t* data = static_cast<const uint8_t*>(reader.ReadBytes(size));
+        if (reader.HasError())
+        {
+            // A capture that was not ended still replays up to the last complete packet.
+            std::cerr << "Warning: Capture is truncated after " << packets.size() << " packets\n";
+            break;
+        }
+
+        packets.push_back({ op, data, size });
+    }
+
+    return true;
+}
+
+static void* get_object(uint32_t id)
+{
+    if (id == VGPU_CAPTURE_NULL_ID)
+        return nullptr;
+
+    if (id >= objects.size() || objects[id].handle == nullptr)
+    {
+        missing = true;
+        return nullptr;
+    }
+
+    return objects[id].handle;
+}
+
+static void set_object(uint32_t id, VGPUCaptureOp type, void* handle, bool alias = false)
+{
+    if (id == VGPU_CAPTURE_NULL_ID || id == VGPU_CAPTURE_UNKNOWN_ID)
+        return;
+
+    if (id >= objects.size())
+        objects.resize(id + 1, { VGPUCaptureOp::CreateBuffer, nullptr, false });
+
+    objects[id] = { type, handle, alias };
+    if (handle == nullptr)
+        failedObjects++;
+}
+
+static void release_object(const Object& object)
+{
+    if (object.handle == nullptr || object.alias)
+        return;
+
+    switch (object.type)
+    {
+        case VGPUCaptureOp::CreateBuffer:           vgpuBufferRelease((VGPUBuffer)object.handle); break;
+        case VGPUCaptureOp::CreateTexture:
+        case VGPUCaptureOp::CreateSwapChain:        vgpuTextureRelease((VGPUTexture)object.handle); break;
+        case VGPUCaptureOp::CreateSampler:          vgpuSamplerRelease((VGPUSampler)object.handle); break;
+        case VGPUCaptureOp::CreateBindGroupLayout:  vgpuBindGroupLayoutRelease((VGPUBindGroupLayout)object.handle); break;
+        case VGPUCaptureOp::CreatePipelineLayout:   vgpuPipelineLayoutRelease((VGPUPipelineLayout)object.handle); break;
+        case VGPUCaptureOp::CreateBindGroup:        vgpuBindGroupRelease((VGPUBindGroup)object.handle); break;
+        case VGPUCaptureOp::CreateRenderPipeline:
+        case VGPUCaptureOp::CreateComputePipeline:  vgpuPipelineRelease((VGPUPipeline)object.handle); break;
+        case VGPUCaptureOp::CreateQueryHeap:        vgpuQueryHeapRelease((VGPUQueryHeap)object.handle); break;
+        default:
+            break;
+    }
+}
+
+template <typename T>
+static void read_array(VGPUCaptureReader& reader, uint32_t count, std::vector<T>& values)
+{
+    values.resize(count);
+    if (const void* bytes = reader.ReadBytes(count * sizeof(T)))
+        memcpy(values.data(), bytes, count * sizeof(T));
+}
+
+static VGPUBuffer read_buffer(VGPUCaptureReader& reader, uint64_t* offset)
+{
+    const uint32_t id = reader.Read<uint32_t>();
+    *offset = reader.Read<uint64_t>();
+
+    if (id != VGPU_CAPTURE_UNKNOWN_ID && (id & VGPU_CAPTURE_ALLOCATION_BIT) != 0)
+    {
+        const uint32_t index = id & ~VGPU_CAPTURE_ALLOCATION_BIT;
+        if (index >= allocations.size())
+        {
+            missing = true;
+            return nullptr;
+        }
+
+        *offset += allocations[index].offset;
+        return allocations[index].buffer;
+    }
+
+    return (VGPUBuffer)get_object(id);
+}
+
+static VGPUBufferCopyLocation read_buffer_location(VGPUCaptureReader& reader)
+{
+    VGPUBufferCopyLocation location{};
+    location.buffer = read_buffer(reader, &location.offset);
+    location.bytesPerRow = reader.Read<uint32_t>();
+    location.rowsPerImage = reader.Read<uint32_t>();
+    return location;
+}
+
+static VGPUTextureCopyLocation read_texture_location(VGPUCaptureReader& reader)
+{
+    VGPUTextureCopyLocation location{};
+    location.texture = (VGPUTexture)get_object(reader.Read<uint32_t>());
+    location.mipLevel = reader.Read<uint32_t>();
+    location.arrayLayer = reader.Read<uint32_t>();
+    location.origin = reader.Read<VGPUOrigin3D>();
+    return location;
+}
+
+static VGPUShaderStageDesc read_shader_stage(VGPUCaptureReader& reader, std::vector<uint8_t>& bytecode)
+{
+    VGPUShaderStageDesc stage{};
+    stage.stage = reader.Read<VGPUShaderStage>();
+    stage.size = (size_t)reader.Read<uint64_t>();
+    // Copied out of the stream, shader modules need aligned bytecode.
+    read_array(reader, (uint32_t)stage.size, bytecode);
+    stage.bytecode = bytecode.data();
+    stage.entryPointName = reader.ReadString();
+    return stage;
+}
+
+// True (and counted) when the command just read references a missing object.
+static bool skip_command()
+{
+    if (!missing)
+        return false;
+
+    skippedCommands++;
+    return true;
+}
+
+static void record_commands(VGPUCommandBuffer commandBuffer, VGPUCaptureReader& reader)
+{
+    std::vector<VGPURenderPassColorAttachment> colorAttachments;
+    std::vector<VGPUViewport> viewports;
+    std::vector<VGPURect> rects;
+    allocations.clear();
+
+    while (!reader.IsEnd() && !reader.HasError())
+    {
+        missing = false;
+
+        const VGPUCaptureCommand command = reader.Read<VGPUCaptureCommand>();
+        switch (command)
+        {
+            case VGPUCaptureCommand::PushDebugGroup:
+                vgpuPushDebugGroup(commandBuffer, reader.ReadString());
+                break;
+
+            case VGPUCaptureCommand::PopDebugGroup:
+                vgpuPopDebugGroup(commandBuffer);
+                break;
+
+            case VGPUCaptureCommand::InsertDebugMarker:
+                vgpuInsertDebugMarker(commandBuffer, reader.ReadString());
+                break;
+
+            case VGPUCaptureCommand::ClearBuffer:
+            {
+                uint64_t offset;
+                VGPUBuffer buffer = read_buffer(reader, &offset);
+                const uint64_t size = reader.Read<uint64_t>();
+                if (!skip_command())
+                    vgpuClearBuffer(commandBuffer, buffer, offset, size);
+                break;
+            }
+
+            case VGPUCaptureCommand::Allocate:
+            {
+                const uint64_t size = reader.Read<uint64_t>();
+                const uint64_t alignment = reader.Read<uint64_t>();
+                if (size == 0)
+                    break;
+
+                const void* data = reader.ReadBytes((size_t)size);
+                VGPUBufferAllocation allocation = vgpuCommandBufferAllocate(commandBuffer, size, alignment);
+                if (allocation.data != nullptr && data != nullptr)
+                    memcpy(allocation.data, data, (size_t)size);
+                allocations.push_back(allocation);
+                break;
+            }
+
+            case VGPUCaptureCommand::CopyBufferToBuffer:
+            {
+                uint64_t sourceOffset;
+                uint64_t destinationOffset;
+                VGPUBuffer source = read_buffer(reader, &sourceOffset);
+                VGPUBuffer destination = read_buffer(reader, &destinationOffset);
+                const uint64_t size = reader.Read<uint64_t>();
+                if (!skip_command())
+                    vgpuCopyBufferToBuffer(commandBuffer, source, sourceOffset, destination, destinationOffset, size);
+                break;
+            }
+
+            case VGPUCaptureCommand::CopyBufferToTexture:
+            {
+                const VGPUBufferCopyLocation source = read_buffer_location(reader);
+                const VGPUTextureCopyLocation destination = read_texture_location(reader);
+                const VGPUExtent3D extent = reader.Read<VGPUExtent3D>();
+                if (!skip_command())
+                    vgpuCopyBufferToTexture(commandBuffer, &source, &destination, &extent);
+                break;
+            }
+
+            case VGPUCaptureCommand::CopyTextureToBuffer:
+            {
+                const VGPUTextureCopyLocation source = read_texture_location(reader);
+                const VGPUBufferCopyLocation destination = read_buffer_location(reader);
+                const VGPUExtent3D extent = reader.Read<VGPUExtent3D>();
+                if (!skip_command())
+                    vgpuCopyTextureToBuffer(commandBuffer, &source, &destination, &extent);
+                break;
+            }
+
+            case VGPUCaptureCommand::CopyTextureToTexture:
+            {
+                const VGPUTextureCopyLocation source = read_texture_location(reader);
+                const VGPUTextureCopyLocation destination = read_texture_location(reader);
+                const VGPUExtent3D extent = reader.Read<VGPUExtent3D>();
+                if (!skip_command())
+                    vgpuCopyTextureToTexture(commandBuffer, &source, &destination, &extent);
+                break;
+            }
+
+            case VGPUCaptureCommand::SetPipeline:
+            {
+                VGPUPipeline pipeline = (VGPUPipeline)get_object(reader.Read<uint32_t>());
+                if (!skip_command())
+                    vgpuSetPipeline(commandBuffer, pipeline);
+                break;
+            }
+
+            case VGPUCaptureCommand::SetBindGroup:
+            {
+                const uint32_t groupIndex = reader.Read<uint32_t>();
+                VGPUBindGroup bindGroup = (VGPUBindGroup)get_object(reader.Read<uint32_t>());
+                if (!skip_command())
+                    vgpuSetBindGroup(commandBuffer, groupIndex, bindGroup);
+                break;
+            }
+
+            case VGPUCaptureCommand::SetPushConstants:
+            {
+                const uint32_t pushConstantIndex = reader.Read<uint32_t>();
+                const uint32_t size = reader.Read<uint32_t>();
+                const void* data = reader.ReadBytes(size);
+                if (data != nullptr)
+                    vgpuSetPushConstants(commandBuffer, pushConstantIndex, data, size);
+                break;
+            }
+
+            case VGPUCaptureCommand::Dispatch:
+            {
+                const VGPUDispatchIndirectCommand groups = reader.Read<VGPUDispatchIndirectCommand>();
+                vgpuDispatch(commandBuffer, groups.x, groups.y, groups.z);
+                break;
+            }
+
+            case VGPUCaptureCommand::DispatchIndirect:
+            {
+                uint64_t offset;
+                VGPUBuffer buffer = read_buffer(reader, &offset);
+                if (!skip_command())
+                    vgpuDispatchIndirect(commandBuffer, buffer, offset);
+                break;
+            }
+
+            case VGPUCaptureCommand::AcquireSwapchainTexture:
+            {
+                void* texture = get_object(reader.Read<uint32_t>());
+                const uint32_t textureId = reader.Read<uint32_t>();
+                if (!skip_command())
+                    set_object(textureId, VGPUCaptureOp::CreateTexture, texture, true);
+                break;
+            }
+
+            case VGPUCaptureCommand::BeginRenderPass:
+            {
+                VGPURenderPassDesc desc{};
+                desc.label = reader.ReadString();
+                desc.colorAttachmentCount = reader.Read<uint32_t>();
+                colorAttachments.resize(desc.colorAttachmentCount);
+                for (VGPURenderPassColorAttachment& attachment : colorAttachments)
+                {
+                    VGPUTexture texture = (VGPUTexture)get_object(reader.Read<uint32_t>());
+                    VGPUTexture resolveTexture = (VGPUTexture)get_object(reader.Read<uint32_t>());
+                    attachment = reader.Read<VGPURenderPassColorAttachment>();
+                    attachment.texture = texture;
+                    attachment.resolveTexture = resolveTexture;
+                }
+                desc.colorAttachments = colorAttachments.data();
+
+                VGPURenderPassDepthStencilAttachment depthStencilAttachment{};
+                if (reader.Read<uint8_t>() != 0)
+                {
+                    VGPUTexture texture = (VGPUTexture)get_object(reader.Read<uint32_t>());
+                    depthStencilAttachment = reader.Read<VGPURenderPassDepthStencilAttachment>();
+                    depthStencilAttachment.texture = texture;
+                    desc.depthStencilAttachment = &depthStencilAttachment;
+                }
+
+                // Skipping the pass would unbalance EndRenderPass, record it without the missing attachments instead.
+                if (skip_command())
+                {
+                    desc.colorAttachmentCount = 0;
+                    desc.depthStencilAttachment = nullptr;
+                }
+                vgpuBeginRenderPass(commandBuffer, &desc);
+                break;
+            }
+
+            case VGPUCaptureCommand::EndRenderPass:
+                vgpuEndRenderPass(commandBuffer);
+                break;
+
+            case VGPUCaptureCommand::SetViewport:
+            {
+                const VGPUViewport viewport = reader.Read<VGPUViewport>();
+                vgpuSetViewport(commandBuffer, &viewport);
+                break;
+            }
+
+            case VGPUCaptureCommand::SetViewports:
+            {
+                const uint32_t count = reader.Read<uint32_t>();
+                read_array(reader, count, viewports);
+                vgpuSetViewports(commandBuffer, count, viewports.data());
+                break;
+            }
+
+            case VGPUCaptureCommand::SetScissorRect:
+            {
+                const VGPURect rect = reader.Read<VGPURect>();
+                vgpuSetScissorRect(commandBuffer, &rect);
+                break;
+            }
+
+            case VGPUCaptureCommand::SetScissorRects:
+            {
+                const uint32_t count = reader.Read<uint32_t>();
+                read_array(reader, count, rects);
+                vgpuSetScissorRects(commandBuffer, count, rects.data());
+                break;
+            }
+
+            case VGPUCaptureCommand::SetVertexBuffer:
+            {
+                const uint32_t index = reader.Read<uint32_t>();
+                uint64_t offset;
+                VGPUBuffer buffer = read_buffer(reader, &offset);
+                if (!skip_command())
+                    vgpuSetVertexBuffer(commandBuffer, index, buffer, offset);
+                break;
+            }
+
+            case VGPUCaptureCommand::SetIndexBuffer:
+            {
+                uint64_t offset;
+                VGPUBuffer buffer = read_buffer(reader, &offset);
+                const VGPUIndexType type = reader.Read<VGPUIndexType>();
+                if (!skip_command())
+                    vgpuSetIndexBuffer(commandBuffer, buffer, type, offset);
+                break;
+            }
+
+            case VGPUCaptureCommand::SetStencilReference:
+                vgpuSetStencilReference(commandBuffer, reader.Read<uint32_t>());
+                break;
+
+            case VGPUCaptureCommand::BeginQuery:
+            case VGPUCaptureCommand::EndQuery:
+            {
+                VGPUQueryHeap queryHeap = (VGPUQueryHeap)get_object(reader.Read<uint32_t>());
+                const uint32_t index = reader.Read<uint32_t>();
+                if (skip_command())
+                    break;
+
+                if (command == VGPUCaptureCommand::BeginQuery)
+                    vgpuBeginQuery(commandBuffer, queryHeap, index);
+                else
+                    vgpuEndQuery(commandBuffer, queryHeap, index);
+                break;
+            }
+
+            case VGPUCaptureCommand::ResolveQuery:
+            {
+                VGPUQueryHeap queryHeap = (VGPUQueryHeap)get_object(reader.Read<uint32_t>());
+                const uint32_t index = reader.Read<uint32_t>();
+                const uint32_t count = reader.Read<uint32_t>();
+                uint64_t offset;
+                VGPUBuffer buffer = read_buffer(reader, &offset);
+                if (!skip_command())
+                    vgpuResolveQuery(commandBuffer, queryHeap, index, count, buffer, offset);
+                break;
+            }
+
+            case VGPUCaptureCommand::ResetQuery:
+            {
+                VGPUQueryHeap queryHeap = (VGPUQueryHeap)get_object(reader.Read<uint32_t>());
+                const uint32_t index = reader.Read<uint32_t>();
+                const uint32_t count = reader.Read<uint32_t>();
+                if (!skip_command())
+                    vgpuResetQuery(commandBuffer, queryHeap, index, count);
+                break;
+            }
+
+            case VGPUCaptureCommand::Draw:
+            {
+                const VGPUDrawIndirectCommand draw = reader.Read<VGPUDrawIndirectCommand>();
+                vgpuDraw(commandBuffer, draw.vertexCount, draw.instanceCount, draw.firstVertex, draw.firstInstance);
+                break;
+            }
+
+            case VGPUCaptureCommand::DrawIndexed:
+            {
+                const VGPUDrawIndexedIndirectCommand draw = reader.Read<VGPUDrawIndexedIndirectCommand>();
+                vgpuDrawIndexed(commandBuffer, draw.indexCount, draw.instanceCount, draw.firstIndex, draw.baseVertex, draw.firstInstance);
+                break;
+            }
+
+            case VGPUCaptureCommand::DrawIndirect:
+            case VGPUCaptureCommand::DrawIndexedIndirect:
+            case VGPUCaptureCommand::DispatchMeshIndirect:
+            {
+                uint64_t offset;
+                VGPUBuffer buffer = read_buffer(reader, &offset);
+                if (skip_command())
+                    break;
+
+                if (command == VGPUCaptureCommand::DrawIndirect)
+                    vgpuDrawIndirect(commandBuffer, buffer, offset);
+                else if (command == VGPUCaptureCommand::DrawIndexedIndirect)
+                    vgpuDrawIndexedIndirect(commandBuffer, buffer, offset);
+                else
+                    vgpuDispatchMeshIndirect(commandBuffer, buffer, offset);
+                break;
+            }
+
+            case VGPUCaptureCommand::DispatchMesh:
+            {
+                const VGPUDispatchIndirectCommand groups = reader.Read<VGPUDispatchIndirectCommand>();
+                vgpuDispatchMesh(commandBuffer, groups.x, groups.y, groups.z);
+                break;
+            }
+
+            case VGPUCaptureCommand::DispatchMeshIndirectCount:
+            {
+                uint64_t offset;
+                uint64_t countOffset;
+                VGPUBuffer buffer = read_buffer(reader, &offset);
+                VGPUBuffer countBuffer = read_buffer(reader, &countOffset);
+                const uint32_t maxCount = reader.Read<uint32_t>();
+                if (!skip_command())
+                    vgpuDispatchMeshIndirectCount(commandBuffer, buffer, offset, countBuffer, countOffset, maxCount);
+                break;
+            }
+
+            default:
+                std::cerr << "Error: Unknown command " << (uint32_t)command << ", rest of the command buffer is skipped\n";
+                return;
+        }
+    }
+}
+
+static void create_buffer(VGPUCaptureReader& reader)
+{
+    const uint32_t id = reader.Read<uint32_t>();
+    VGPUBufferDesc desc = reader.Read<VGPUBufferDesc>();
+    desc.label = reader.ReadString();
+    const void* initialData = reader.Read<uint8_t>() != 0 ? reader.ReadBytes((size_t)desc.size) : nullptr;
+    set_object(id, VGPUCaptureOp::CreateBuffer, vgpuCreateBuffer(device, &desc, initialData));
+}
+
+static void create_texture(VGPUCaptureReader& reader)
+{
+    const uint32_t id = reader.Read<uint32_t>();
+    VGPUTextureDesc desc = reader.Read<VGPUTextureDesc>();
+    desc.label = reader.ReadString();
+
+    const uint32_t subresourceCount = reader.Read<uint32_t>();
+    std::vector<VGPUTextureData> initialData(subresourceCount);
+    const bool is3D = desc.dimension == VGPUTextureDimension_3D;
+    for (uint32_t i = 0; i < subresourceCount; ++i)
+    {
+        const uint32_t mipIndex = i % std::max(desc.mipLevelCount, 1u);
+        const uint32_t levelDepth = is3D ? std::max(1u, desc.depthOrArrayLayers >> mipIndex) : 1u;
+        initialData[i].rowPitch = reader.Read<uint32_t>();
+        initialData[i].slicePitch = reader.Read<uint32_t>();
+        initialData[i].pData = reader.ReadBytes((size_t)initialData[i].slicePitch * levelDepth);
+    }
+
+    set_object(id, VGPUCaptureOp::CreateTexture, vgpuCreateTexture(device, &desc, subresourceCount > 0 ? initialData.data() : nullptr));
+}
+
+static void create_sampler(VGPUCaptureReader& reader)
+{
+    const uint32_t id = reader.Read<uint32_t>();
+    VGPUSamplerDesc desc = reader.Read<VGPUSamplerDesc>();
+    desc.label = reader.ReadString();
+    set_object(id, VGPUCaptureOp::CreateSampler, vgpuCreateSampler(device, &desc));
+}
+
+static void create_bind_group_layout(VGPUCaptureReader& reader)
+{
+    const uint32_t id = reader.Read<uint32_t>();
+    std::vector<VGPUBindGroupLayoutEntry> entries;
+
+    VGPUBindGroupLayoutDesc desc{};
+    desc.label = reader.ReadString();
+    desc.entryCount = reader.Read<uint32_t>();
+    read_array(reader, (uint32_t)desc.entryCount, entries);
+    desc.entries = entries.data();
+    set_object(id, VGPUCaptureOp::CreateBindGroupLayout, vgpuCreateBindGroupLayout(device, &desc));
+}
+
+static void create_pipeline_layout(VGPUCaptureReader& reader)
+{
+    const uint32_t id = reader.Read<uint32_t>();
+    std::vector<VGPUBindGroupLayout> bindGroupLayouts;
+    std::vector<VGPUPushConstantRange> pushConstantRanges;
+
+    VGPUPipelineLayoutDesc desc{};
+    desc.label = reader.ReadString();
+    desc.bindGroupLayoutCount = reader.Read<uint32_t>();
+    for (size_t i = 0; i < desc.bindGroupLayoutCount; ++i)
+    {
+        bindGroupLayouts.push_back((VGPUBindGroupLayout)get_object(reader.Read<uint32_t>()));
+    }
+    desc.bindGroupLayouts = bindGroupLayouts.data();
+    desc.pushConstantRangeCount = reader.Read<uint32_t>();
+    read_array(reader, desc.pushConstantRangeCount, pushConstantRanges);
+    desc.pushConstantRanges = pushConstantRanges.data();
+    desc.bindless = reader.Read<VGPUBool32>();
+    set_object(id, VGPUCaptureOp::CreatePipelineLayout, missing ? nullptr : vgpuCreatePipelineLayout(device, &desc));
+}
+
+static void create_bind_group(VGPUCaptureReader& reader)
+{
+    const uint32_t id = reader.Read<uint32_t>();
+    VGPUBindGroupLayout layout = (VGPUBindGroupLayout)get_object(reader.Read<uint32_t>());
+    std::vector<VGPUBindGroupEntry> entries;
+
+    VGPUBindGroupDesc desc{};
+    desc.label = reader.ReadString();
+    desc.entryCount = reader.Read<uint32_t>();
+    entries.resize(desc.entryCount);
+    for (VGPUBindGroupEntry& entry : entries)
+    {
+        entry.binding = reader.Read<uint32_t>();
+        entry.arrayElement = reader.Read<uint32_t>();
+        entry.buffer = (VGPUBuffer)get_object(reader.Read<uint32_t>());
+        entry.offset = reader.Read<uint64_t>();
+        entry.size = reader.Read<uint64_t>();
+        entry.sampler = (VGPUSampler)get_object(reader.Read<uint32_t>());
+    }
+    desc.entries = entries.data();
+    set_object(id, VGPUCaptureOp::CreateBindGroup, missing ? nullptr : vgpuCreateBindGroup(device, layout, &desc));
+}
+
+static void create_render_pipeline(VGPUCaptureReader& reader)
+{
+    const uint32_t id = reader.Read<uint32_t>();
+
+    VGPURenderPipelineDesc desc{};
+    desc.label = reader.ReadString();
+    desc.layout = (VGPUPipelineLayout)get_object(reader.Read<uint32_t>());
+
+    desc.shaderStageCount = reader.Read<uint32_t>();
+    std::vector<std::vector<uint8_t>> bytecodes(desc.shaderStageCount);
+    std::vector<VGPUShaderStageDesc> shaderStages(desc.shaderStageCount);
+    for (uint32_t i = 0; i < desc.shaderStageCount; ++i)
+    {
+        shaderStages[i] = read_shader_stage(reader, bytecodes[i]);
+    }
+    desc.shaderStages = shaderStages.data();
+
+    desc.vertex.layoutCount = reader.Read<uint32_t>();
+    std::vector<std::vector<VGPUVertexAttribute>> attributes(desc.vertex.layoutCount);
+    std::vector<VGPUVertexBufferLayout> layouts(desc.vertex.layoutCount);
+    for (uint32_t i = 0; i < desc.vertex.layoutCount; ++i)
+    {
+        layouts[i].stride = reader.Read<uint32_t>();
+        layouts[i].stepMode = reader.Read<VGPUVertexStepMode>();
+        layouts[i].attributeCount = reader.Read<uint32_t>();
+        read_array(reader, layouts[i].attributeCount, attributes[i]);
+        layouts[i].attributes = attributes[i].data();
+    }
+    desc.vertex.layouts = layouts.data();
+
+    desc.blendState = reader.Read<VGPUBlendState>();
+    desc.rasterizerState = reader.Read<VGPURasterizerState>();
+    desc.depthStencilState = reader.Read<VGPUDepthStencilState>();
+    desc.primitiveTopology = reader.Read<VGPUPrimitiveTopology>();
+    desc.patchControlPoints = reader.Read<uint32_t>();
+
+    std::vector<VGPUTextureFormat> colorFormats;
+    desc.colorFormatCount = reader.Read<uint32_t>();
+    read_array(reader, desc.colorFormatCount, colorFormats);
+    desc.colorFormats = colorFormats.data();
+    desc.depthStencilFormat = reader.Read<VGPUTextureFormat>();
+    desc.sampleCount = reader.Read<uint32_t>();
+    set_object(id, VGPUCaptureOp::CreateRenderPipeline, missing ? nullptr : vgpuCreateRenderPipeline(device, &desc));
+}
+
+static void create_compute_pipeline(VGPUCaptureReader& reader)
+{
+    const uint32_t id = reader.Read<uint32_t>();
+    std::vector<uint8_t> bytecode;
+
+    VGPUComputePipelineDesc desc{};
+    desc.label = reader.ReadString();
+    desc.layout = (VGPUPipelineLayout)get_object(reader.Read<uint32_t>());
+    desc.shader = read_shader_stage(reader, bytecode);
+    set_object(id, VGPUCaptureOp::CreateComputePipeline, missing ? nullptr : vgpuCreateComputePipeline(device, &desc));
+}
+
+static void create_query_heap(VGPUCaptureReader& reader)
+{
+    const uint32_t id = reader.Read<uint32_t>();
+    VGPUQueryHeapDesc desc = reader.Read<VGPUQueryHeapDesc>();
+    desc.label = reader.ReadString();
+    set_object(id, VGPUCaptureOp::CreateQueryHeap, vgpuCreateQueryHeap(device, &desc));
+}
+
+static void create_swapchain(VGPUCaptureReader& reader)
+{
+    const uint32_t id = reader.Read<uint32_t>();
+
+    VGPUTextureDesc desc{};
+    desc.label = "SwapChain";
+    desc.dimension = VGPUTextureDimension_2D;
+    desc.width = reader.Read<uint32_t>();
+    desc.height = reader.Read<uint32_t>();
+    desc.format = reader.Read<VGPUTextureFormat>();
+    desc.usage = VGPUTextureUsage_RenderTarget | VGPUTextureUsage_ShaderRead;
+    desc.depthOrArrayLayers = 1u;
+    desc.mipLevelCount = 1u;
+    desc.sampleCount = 1u;
+    set_object(id, VGPUCaptureOp::CreateSwapChain, vgpuCreateTexture(device, &desc, nullptr));
+}
+
+static void write_buffer(VGPUCaptureReader& reader)
+{
+    VGPUBuffer buffer = (VGPUBuffer)get_object(reader.Read<uint32_t>());
+    const uint64_t size = reader.Read<uint64_t>();
+    const void* data = reader.ReadBytes((size_t)size);
+
+    void* mappedData = buffer ? vgpuBufferGetMappedData(buffer) : nullptr;
+    if (mappedData != nullptr && data != nullptr)
+        memcpy(mappedData, data, (size_t)std::min(size, vgpuBufferGetSize(buffer)));
+}
+
+static void submit(VGPUCaptureReader& reader)
+{
+    std::vector<VGPUCommandBuffer> commandBuffers(reader.Read<uint32_t>());
+    for (VGPUCommandBuffer& commandBuffer : commandBuffers)
+    {
+        const VGPUCommandQueue queue = reader.Read<VGPUCommandQueue>();
+        const char* label = reader.ReadString();
+        const uint64_t size = reader.Read<uint64_t>();
+        const uint8_t* data = static_cast<const uint8_t*>(reader.ReadBytes((size_t)size));
+
+        commandBuffer = vgpuBeginCommandBuffer(device, queue, label);
+        if (data != nullptr)
+        {
+            VGPUCaptureReader commands(data, (size_t)size);
+            record_commands(commandBuffer, commands);
+        }
+    }
+
+    if (!commandBuffers.empty())
+        vgpuDeviceSubmit(device, commandBuffers.data(), (uint32_t)commandBuffers.size());
+}
+
+// Replays one loop, returns the CPU time of each submit packet (decoding, recording and vgpuDeviceSubmit).
+static std::vector<double> replay(bool createObjects, double* creationMilliseconds)
+{
+    std::vector<double> frameMilliseconds;
+    *creationMilliseconds = 0.0;
+
+    for (const Packet& packet : packets)
+    {
+        VGPUCaptureReader reader(packet.data, packet.size);
+        missing = false;
+
+        const Clock::time_point start = Clock::now();
+        switch (packet.op)
+        {
+            case VGPUCaptureOp::CreateBuffer:           if (createObjects) create_buffer(reader); break;
+            case VGPUCaptureOp::CreateTexture:          if (createObjects) create_texture(reader); break;
+            case VGPUCaptureOp::CreateSampler:          if (createObjects) create_sampler(reader); break;
+            case VGPUCaptureOp::CreateBindGroupLayout:  if (createObjects) create_bind_group_layout(reader); break;
+            case VGPUCaptureOp::CreatePipelineLayout:   if (createObjects) create_pipeline_layout(reader); break;
+            case VGPUCaptureOp::CreateBindGroup:        if (createObjects) create_bind_group(reader); break;
+            case VGPUCaptureOp::CreateRenderPipeline:   if (createObjects) create_render_pipeline(reader); break;
+            case VGPUCaptureOp::CreateComputePipeline:  if (createObjects) create_compute_pipeline(reader); break;
+            case VGPUCaptureOp::CreateQueryHeap:        if (createObjects) create_query_heap(reader); break;
+            case VGPUCaptureOp::CreateSwapChain:        if (createObjects) create_swapchain(reader); break;
+            case VGPUCaptureOp::WriteBuffer:            write_buffer(reader); break;
+            case VGPUCaptureOp::WaitIdle:               vgpuDeviceWaitIdle(device); break;
+            case VGPUCaptureOp::Submit:
+                submit(reader);
+                frameMilliseconds.push_back(milliseconds_since(start));
+                continue;
+            default:
+                break;
+        }
+
+        if (packet.op != VGPUCaptureOp::WriteBuffer && packet.op != VGPUCaptureOp::WaitIdle)
+            *creationMilliseconds += milliseconds_since(start);
+    }
+
+    return frameMilliseconds;
+}
+
+static bool parse_options(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--loops") == 0 && hasValue)
+            options.loops = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--backend") == 0 && hasValue)
+        {
+            ++i;
+            if (strcmp(argv[i], "vulkan") == 0)
+                options.backend = VGPUBackend_Vulkan;
+            else if (strcmp(argv[i], "d3d12") == 0)
+                options.backend = VGPUBackend_D3D12;
+            else if (strcmp(argv[i], "null") == 0)
+                options.backend = VGPUBackend_Null;
+            else
+            {
+                std::cerr << "Unknown backend \"" << argv[i] << "\"\n";
+                return false;
+            }
+        }
+        else if (argv[i][0] != '-' && options.path == nullptr)
+            options.path = argv[i];
+        else
+        {
+            options.path = nullptr;
+            break;
+        }
+    }
+
+    if (options.path == nullptr)
+    {
+        std::cerr << "Usage: vgpu_replay capture [--backend vulkan|d3d12|null] [--loops count]\n";
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (!parse_options(argc, argv))
+        return EXIT_FAILURE;
+
+    vgpuSetLogLevel(VGPULogLevel_Warn);
+
+    if (!load_capture(options.path))
+        return EXIT_FAILURE;
+
+    VGPUDeviceDesc deviceDesc{};
+    deviceDesc.label = "vgpu_replay";
+    deviceDesc.validationMode = VGPUValidationMode_Disabled;
+    if (vgpuIsBackendSupported(options.backend))
+    {
+        deviceDesc.preferredBackend = options.backend;
+    }
+
+    device = vgpuCreateDevice(&deviceDesc);
+    if (device == nullptr)
+    {
+        std::cerr << "Error: Failed to initialize device\n";
+        return EXIT_FAILURE;
+    }
+
+    VGPUAdapterProperties adapterProperties{};
+    vgpuDeviceGetAdapterProperties(device, &adapterProperties);
+    printf("Capture:  %s, %u packets, %.2f MB\n", options.path, (uint32_t)packets.size(), double(stream.size()) / (1024.0 * 1024.0));
+    printf("Adapter:  %s\n", adapterProperties.name);
+
+    // Only frames of later loops are measured when there are any, the first one also pays for object creation.
+    std::vector<double> frameMilliseconds;
+    double creationMilliseconds = 0.0;
+    for (uint32_t loop = 0; loop < options.loops; ++loop)
+    {
+        double loopCreationMilliseconds = 0.0;
+        std::vector<double> loopFrames = replay(loop == 0, &loopCreationMilliseconds);
+        if (loop == 0)
+            creationMilliseconds = loopCreationMilliseconds;
+
+        if (loop > 0 || options.loops == 1)
+            frameMilliseconds.insert(frameMilliseconds.end(), loopFrames.begin(), loopFrames.end());
+    }
+    vgpuDeviceWaitIdle(device);
+
+    printf("Objects:  %u created in %.3f ms, %u failed\n", (uint32_t)objects.size() - 1u, creationMilliseconds, failedObjects);
+    if (!frameMilliseconds.empty())
+    {
+        double total = 0.0;
+        for (double frame : frameMilliseconds)
+            total += frame;
+
+        std::sort(frameMilliseconds.begin(), frameMilliseconds.end());
+        printf("Frames:   %u over %u loop(s)\n", (uint32_t)frameMilliseconds.size(), options.loops);
+        printf("Frame CPU: mean %.3f ms, median %.3f ms, min %.3f ms, max %.3f ms\n",
+            total / frameMilliseconds.size(),
+            frameMilliseconds[frameMilliseconds.size() / 2],
+            frameMilliseconds.front(),
+            frameMilliseconds.back());
+    }
+
+    if (skippedCommands > 0)
+        printf("Skipped:  %llu commands referencing objects created before the capture\n", (unsigned long long)skippedCommands);
+
+    for (const Object& object : objects)
+    {
+        release_object(object);
+    }
+    vgpuDeviceRelease(device);
+    return EXIT_SUCCESS;
+}